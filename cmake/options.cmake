@@ -20,6 +20,7 @@ option(ENABLE_AKG "enable akg" OFF)
 option(ENABLE_DEBUGGER "enable debugger" OFF)
 option(ENABLE_IBVERBS "enable IBVERBS for parameter server" OFF)
 option(ENABLE_PYTHON "Enable python" ON)
+option(ENABLE_COMPACT_MANAGER "Keep the node users of func graph manager in compact containers" OFF)
 
 if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
     if (WIN32)
@@ -97,6 +98,10 @@ if (ENABLE_TIMELINE)
     add_compile_definitions(ENABLE_TIMELINE)
 endif()
 
+if (ENABLE_COMPACT_MANAGER)
+    add_compile_definitions(ENABLE_COMPACT_MANAGER)
+endif()
+
 if (ENABLE_LOAD_ANF_IR)
     add_compile_definitions(ENABLE_LOAD_ANF_IR)
 endif()
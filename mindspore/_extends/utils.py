@@ -58,6 +58,19 @@ def cal_sha256(file_path):
     return sha256.hexdigest()
 
 
+def cal_sha256_of_data(data):
+    """
+    Calculate sha256 value of input data.
+
+    Args:
+        data (bytes): data to calculate.
+
+    Returns:
+        str, returns sha256 value of input data.
+    """
+    return hashlib.sha256(data).hexdigest()
+
+
 def cell_attr_register(fn=None, attrs=None):
     """
     Cell init attributes register.
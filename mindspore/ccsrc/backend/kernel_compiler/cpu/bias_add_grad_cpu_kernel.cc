@@ -21,9 +21,15 @@ namespace kernel {
 void BiasAddGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   input_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  if (input_shape_.size() != 4 && input_shape_.size() != 2) {
+  if (input_shape_.size() < 2) {
     MS_LOG(EXCEPTION) << "input data format not support";
   }
+  // The bias gradient sums over every axis except the channel axis 1.
+  std::vector<size_t> axis{0};
+  for (size_t i = 2; i < input_shape_.size(); ++i) {
+    axis.push_back(i);
+  }
+  plan_.Init(input_shape_, axis);
 }
 
 bool BiasAddGradCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> & /*workspace*/,
@@ -31,37 +37,13 @@ bool BiasAddGradCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const s
   if (inputs.size() != 1 || outputs.size() != 1) {
     MS_LOG(EXCEPTION) << "input output size not support";
   }
+  if (inputs[0]->size != plan_.input_size() * sizeof(float) ||
+      outputs[0]->size != plan_.output_size() * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  }
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
-
-  if (input_shape_.size() == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = h_size * input_shape_[2];
-    size_t n_size = c_size * input_shape_[1];
-    size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t c_offset = 0;
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = c_offset + n_offset + hw;
-          output_addr[c] += input_addr[offset];
-        }
-        n_offset += n_size;
-      }
-      c_offset += c_size;
-    }
-  } else if (input_shape_.size() == 2) {
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        output_addr[c] += input_addr[c + n_offset];
-        n_offset += input_shape_[1];
-      }
-    }
-  }
+  Reduce<float>(plan_, kReduceSum, input_addr, output_addr);
   return true;
 }
 }  // namespace kernel
@@ -21,6 +21,7 @@
 #include <memory>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/reduce_utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -35,6 +36,7 @@ class BiasAddGradCPUKernel : public CPUKernel {
 
  private:
   std::vector<size_t> input_shape_;
+  ReducePlan plan_;
 };
 MS_REG_CPU_KERNEL(BiasAddGrad, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   BiasAddGradCPUKernel);
@@ -16,6 +16,7 @@
 
 #include "backend/kernel_compiler/cpu/concat_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "common/permute.h"
 
 namespace mindspore {
 namespace kernel {
@@ -27,76 +28,50 @@ void ConcatCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (axis_ < 0) {
     axis_ = axis_ + SizeToInt(input_1_shape.size());
   }
-  axis_ += 4 - input_1_shape.size();
+  if (axis_ < 0 || axis_ >= SizeToInt(input_1_shape.size())) {
+    MS_LOG(EXCEPTION) << "Concat axis " << axis_ << " is out of range of a " << input_1_shape.size() << "-D input.";
+  }
 
+  outer_size_ = 1;
+  for (size_t i = 0; i < IntToSize(axis_); ++i) {
+    outer_size_ *= input_1_shape[i];
+  }
+  output_inner_size_ = 0;
+  input_inner_sizes_.clear();
   auto input_num = AnfAlgo::GetInputTensorNum(kernel_node);
   for (size_t i = 0; i < input_num; i++) {
     auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
-    CPUKernelUtils::ExpandDimsTo4(&input_shape);
-    input_shape_list_.push_back(input_shape);
+    size_t inner_size = 1;
+    for (size_t j = IntToSize(axis_); j < input_shape.size(); ++j) {
+      inner_size *= input_shape[j];
+    }
+    input_inner_sizes_.push_back(inner_size);
+    output_inner_size_ += inner_size;
   }
-
-  output_shape_ = AnfAlgo::GetOutputInferShape(kernel_node, 0);
-  CPUKernelUtils::ExpandDimsTo4(&output_shape_);
+  type_size_ = GetTypeByte(TypeIdToType(AnfAlgo::GetInputDeviceDataType(kernel_node, 0)));
 }
 
 bool ConcatCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspace*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  auto buff_size = outputs[0]->size;
-  size_t dim0 = output_shape_[0];
-  size_t dim1 = output_shape_[1];
-  size_t dim2 = output_shape_[2];
-
-  if (axis_ == 3) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        for (size_t k = 0; k < dim2; ++k) {
-          CopyDataToOutput(inputs, i, j, k, &output_addr, &buff_size);
-        }
-      }
-    }
-  } else if (axis_ == 2) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        CopyDataToOutput(inputs, i, j, 0, &output_addr, &buff_size);
-      }
-    }
-  } else if (axis_ == 1) {
-    for (size_t i = 0; i < dim0; ++i) {
-      CopyDataToOutput(inputs, i, 0, 0, &output_addr, &buff_size);
-    }
-  } else if (axis_ == 0) {
-    CopyDataToOutput(inputs, 0, 0, 0, &output_addr, &buff_size);
+  if (inputs.size() != input_inner_sizes_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "Concat expects " << input_inner_sizes_.size() << " inputs and one output.";
   }
-  return true;
-}
-
-void ConcatCPUKernel::CopyDataToOutput(const std::vector<kernel::AddressPtr> &inputs, size_t dim0, size_t dim1,
-                                       size_t dim2, float **output_addr, size_t *buff_size) {
-  for (size_t i = 0; i < input_shape_list_.size(); ++i) {
-    auto input_i_shape = input_shape_list_[i];
-    auto input_i_addr = reinterpret_cast<float *>(inputs[i]->addr);
-
-    size_t num = CPUKernelUtils::GetElementNumOnAxis(input_i_shape, axis_);
-    num *= input_i_shape[axis_];
-    auto pos = CPUKernelUtils::CalcOffset(input_i_shape, dim0, dim1, dim2, 0);
-    auto ret = memcpy_s(*output_addr, *buff_size, input_i_addr + pos, num * sizeof(float));
-    if (ret != EOK) {
-      MS_LOG(EXCEPTION) << "memcpy failed.";
-    }
-    *output_addr += num;
-    *buff_size -= num * sizeof(float);
+  if (outputs[0]->size < outer_size_ * output_inner_size_ * type_size_) {
+    MS_LOG(EXCEPTION) << "The output size " << outputs[0]->size << " of Concat is too small.";
   }
+  auto output_addr = reinterpret_cast<uint8_t *>(outputs[0]->addr);
+  size_t offset = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    size_t inner_size = input_inner_sizes_[i];
+    std::vector<common::PermuteDim> dims{{outer_size_, inner_size, output_inner_size_}, {inner_size, 1, 1}};
+    common::StridedCopy(inputs[i]->addr, output_addr + offset * type_size_, dims, type_size_);
+    offset += inner_size;
+  }
+  return true;
 }
 
 void ConcatCPUKernel::CheckParam(const CNodePtr &kernel_node) {
-  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
-  if (input_shape.size() > 4) {
-    MS_LOG(EXCEPTION) << "Input dims is " << input_shape.size() << ", but ConcatCPUKernel olny support 4d or lower.";
-  }
-
   size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
   if (output_num != 1) {
     MS_LOG(EXCEPTION) << "Output number is " << output_num << ", but ConcatCPUKernel needs 1 output.";
@@ -74,12 +74,15 @@ class CPUKernel : public kernel::KernelMod {
   std::vector<size_t> workspace_size_list_;
 };
 
+using CTask = std::function<void(size_t, size_t)>;
 class CPUKernelUtils {
  public:
   static void ExpandDimsTo4(std::vector<size_t> *shape);
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // Split [0, count) into blocks of at least min_block_size and run them on the shared host thread pool.
+  static void ParallelFor(const CTask &task, size_t count, size_t min_block_size = 1);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -14,10 +14,15 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/gather_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/gather_utils.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr size_t kMinRowsPerTask = 256;
+}  // namespace
+
 void GatherV2CPUKernel::InitKernel(const CNodePtr &kernel_node) {
   CheckParam(kernel_node);
   input_shape_ = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
@@ -27,85 +32,79 @@ void GatherV2CPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (axis_ < 0) {
     axis_ = axis_ + SizeToInt(input_shape_.size());
   }
-  axis_ += 4 - input_shape_.size();
-  CPUKernelUtils::ExpandDimsTo4(&input_shape_);
-  CPUKernelUtils::ExpandDimsTo4(&output_shape_);
-}
-
-bool GatherV2CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
-                               const std::vector<kernel::AddressPtr> & /*workspace*/,
-                               const std::vector<kernel::AddressPtr> &outputs) {
-  auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  auto buff_size = outputs[0]->size;
-  size_t dim0 = input_shape_[0];
-  size_t dim1 = input_shape_[1];
-  size_t dim2 = input_shape_[2];
-  if (axis_ == 3) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        for (size_t k = 0; k < dim2; ++k) {
-          CopyDataToOutput(inputs, i, j, k, &output_addr, &buff_size);
-        }
-      }
-    }
-  } else if (axis_ == 2) {
-    for (size_t i = 0; i < dim0; ++i) {
-      for (size_t j = 0; j < dim1; ++j) {
-        CopyDataToOutput(inputs, i, j, 0, &output_addr, &buff_size);
-      }
-    }
-  } else if (axis_ == 1) {
-    for (size_t i = 0; i < dim0; ++i) {
-      CopyDataToOutput(inputs, i, 0, 0, &output_addr, &buff_size);
-    }
-  } else if (axis_ == 0) {
-    CopyDataToOutput(inputs, 0, 0, 0, &output_addr, &buff_size);
+  if (axis_ < 0 || IntToSize(axis_) >= input_shape_.size()) {
+    MS_LOG(EXCEPTION) << "Axis " << axis_ << " is out of the rank of input " << input_shape_.size();
   }
-  return true;
+  size_t axis = IntToSize(axis_);
+  outer_size_ = 1;
+  for (size_t i = 0; i < axis; ++i) {
+    outer_size_ *= input_shape_[i];
+  }
+  axis_dim_size_ = input_shape_[axis];
+  inner_size_ = 1;
+  for (size_t i = axis + 1; i < input_shape_.size(); ++i) {
+    inner_size_ *= input_shape_[i];
+  }
+  indices_num_ = 1;
+  for (auto dim : indices_shape_) {
+    indices_num_ *= dim;
+  }
+  input_dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
+  indices_dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1);
 }
 
-void GatherV2CPUKernel::CopyDataToOutput(const std::vector<kernel::AddressPtr> &inputs, size_t dim0, size_t dim1,
-                                         size_t dim2, float **output_addr, size_t *buff_size) {
-  auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
-  auto indices_addr = reinterpret_cast<int *>(inputs[1]->addr);
-  size_t elem_num = inputs[1]->size / 4;
-  size_t num = CPUKernelUtils::GetElementNumOnAxis(input_shape_, axis_);
-  for (size_t i = 0; i < elem_num; ++i) {
+template <typename T, typename S>
+void GatherV2CPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr> &inputs,
+                                     const std::vector<kernel::AddressPtr> &outputs) {
+  auto input_addr = reinterpret_cast<const T *>(inputs[0]->addr);
+  auto indices_addr = reinterpret_cast<const S *>(inputs[1]->addr);
+  auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
+  for (size_t i = 0; i < indices_num_; ++i) {
     if (indices_addr[i] < 0) {
       MS_LOG(EXCEPTION) << "The indices value is less than 0.";
     }
-    size_t index = IntToSize(indices_addr[i]);
-    if (index >= input_shape_[IntToSize(axis_)]) {
-      auto ret = memset_s(*output_addr, *buff_size, 0., num * sizeof(float));
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "memset failed.";
-      }
-    } else {
-      size_t pos = 0;
-      if (axis_ == 3) {
-        pos = CPUKernelUtils::CalcOffset(input_shape_, dim0, dim1, dim2, index);
-      } else if (axis_ == 2) {
-        pos = CPUKernelUtils::CalcOffset(input_shape_, dim0, dim1, index, 0);
-      } else if (axis_ == 1) {
-        pos = CPUKernelUtils::CalcOffset(input_shape_, dim0, index, 0, 0);
-      } else if (axis_ == 0) {
-        pos = CPUKernelUtils::CalcOffset(input_shape_, index, 0, 0, 0);
-      }
-      auto ret = memcpy_s(*output_addr, *buff_size, input_addr + pos, num * sizeof(float));
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "memcpy failed.";
-      }
+  }
+  size_t indices_num = indices_num_;
+  size_t axis_dim_size = axis_dim_size_;
+  size_t inner_size = inner_size_;
+  // Output rows are numbered outer-major, every outer slice is a table of axis_dim_size rows.
+  auto task = [&](size_t start, size_t end) {
+    while (start < end) {
+      size_t outer = start / indices_num;
+      size_t index_begin = start % indices_num;
+      size_t index_end = std::min(indices_num, index_begin + end - start);
+      const T *table = input_addr + outer * axis_dim_size * inner_size;
+      GatherRows(table, axis_dim_size, inner_size, indices_addr, index_begin, index_end, 0,
+                 output_addr + start * inner_size);
+      start += index_end - index_begin;
     }
-    *output_addr += num;
-    *buff_size -= num * sizeof(float);
+  };
+  CPUKernelUtils::ParallelFor(task, outer_size_ * indices_num_, kMinRowsPerTask);
+}
+
+template <typename T>
+void GatherV2CPUKernel::LaunchKernel(const std::vector<kernel::AddressPtr> &inputs,
+                                     const std::vector<kernel::AddressPtr> &outputs) {
+  if (indices_dtype_ == kNumberTypeInt64) {
+    LaunchKernel<T, int64_t>(inputs, outputs);
+  } else {
+    LaunchKernel<T, int>(inputs, outputs);
   }
-}  // namespace kernel
+}
 
-void GatherV2CPUKernel::CheckParam(const CNodePtr &kernel_node) {
-  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
-  if (input_shape.size() > 4) {
-    MS_LOG(EXCEPTION) << "Input dims is " << input_shape.size() << ", but GatherV2CPUKernel olny support 4d or lower.";
+bool GatherV2CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                               const std::vector<kernel::AddressPtr> & /*workspace*/,
+                               const std::vector<kernel::AddressPtr> &outputs) {
+  // Elements are only moved, so float16 inputs are copied as raw 16 bit words.
+  if (input_dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<uint16_t>(inputs, outputs);
+  } else {
+    LaunchKernel<float>(inputs, outputs);
   }
+  return true;
+}
+
+void GatherV2CPUKernel::CheckParam(const CNodePtr &kernel_node) {
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
   if (input_num != 2) {
     MS_LOG(EXCEPTION) << "Argument number is " << input_num << ", but GatherV2CPUKernel needs 2.";
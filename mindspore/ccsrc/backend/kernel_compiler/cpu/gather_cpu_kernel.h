@@ -24,7 +24,7 @@ namespace mindspore {
 namespace kernel {
 class GatherV2CPUKernel : public CPUKernel {
  public:
-  GatherV2CPUKernel() : axis_(0) {}
+  GatherV2CPUKernel() = default;
   ~GatherV2CPUKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override;
@@ -33,15 +33,36 @@ class GatherV2CPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  void CopyDataToOutput(const std::vector<kernel::AddressPtr> &inputs, size_t dim0, size_t dim1, size_t dim2,
-                        float **output_addr, size_t *buff_size);
+  template <typename T>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+  template <typename T, typename S>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
   void CheckParam(const CNodePtr &kernel_node);
   std::vector<size_t> input_shape_;
   std::vector<size_t> indices_shape_;
   std::vector<size_t> output_shape_;
-  int axis_;
+  int axis_{0};
+  // The input is viewed as [outer_size_, axis_dim_size_, inner_size_].
+  size_t outer_size_{1};
+  size_t axis_dim_size_{1};
+  size_t inner_size_{1};
+  size_t indices_num_{1};
+  TypeId input_dtype_{kNumberTypeFloat32};
+  TypeId indices_dtype_{kNumberTypeInt32};
 };
 
+MS_REG_CPU_KERNEL(
+  GatherV2,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeFloat32),
+  GatherV2CPUKernel);
+MS_REG_CPU_KERNEL(
+  GatherV2,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeFloat16),
+  GatherV2CPUKernel);
+MS_REG_CPU_KERNEL(
+  GatherV2,
+  KernelAttr().AddInputAttr(kNumberTypeFloat16).AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeFloat16),
+  GatherV2CPUKernel);
 MS_REG_CPU_KERNEL(
   GatherV2,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeFloat32),
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GATHER_UTILS_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GATHER_UTILS_H_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace kernel {
+// Number of rows looked ahead when prefetching the table, enough to hide a DRAM access behind the current copies.
+constexpr size_t kGatherPrefetchDistance = 8;
+// Bytes of a row brought into cache ahead of time, longer rows are streamed by the hardware prefetcher.
+constexpr size_t kGatherPrefetchBytes = 256;
+constexpr size_t kCacheLineBytes = 64;
+
+inline void PrefetchRow(const void *row, size_t row_bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  const char *addr = reinterpret_cast<const char *>(row);
+  size_t bytes = std::min(row_bytes, kGatherPrefetchBytes);
+  for (size_t i = 0; i < bytes; i += kCacheLineBytes) {
+    __builtin_prefetch(addr + i, 0, 1);
+  }
+#endif
+}
+
+// Copying with a compile time length lets the compiler unroll the copy into full width vector moves.
+template <typename T, size_t N>
+inline void CopyFixedRow(T *dst, const T *src) {
+  std::copy_n(src, N, dst);
+}
+
+template <typename T>
+inline void CopyRow(T *dst, const T *src, size_t row_size) {
+  switch (row_size * sizeof(T)) {
+    case 32:
+      CopyFixedRow<T, 32 / sizeof(T)>(dst, src);
+      break;
+    case 64:
+      CopyFixedRow<T, 64 / sizeof(T)>(dst, src);
+      break;
+    case 128:
+      CopyFixedRow<T, 128 / sizeof(T)>(dst, src);
+      break;
+    case 256:
+      CopyFixedRow<T, 256 / sizeof(T)>(dst, src);
+      break;
+    case 512:
+      CopyFixedRow<T, 512 / sizeof(T)>(dst, src);
+      break;
+    case 1024:
+      CopyFixedRow<T, 1024 / sizeof(T)>(dst, src);
+      break;
+    default:
+      std::copy_n(src, row_size, dst);
+      break;
+  }
+}
+
+// Gather rows [start, end) of indices from a table of first_dim_size rows into output, which points to the output
+// row of indices[start]. Indices are shifted by offset first, rows out of [0, first_dim_size) are filled with zero.
+template <typename T, typename S>
+void GatherRows(const T *table, size_t first_dim_size, size_t row_size, const S *indices, size_t start, size_t end,
+                int64_t offset, T *output) {
+  auto valid_row = [first_dim_size, offset](S index) -> int64_t {
+    int64_t row = static_cast<int64_t>(index) - offset;
+    return (row >= 0 && static_cast<size_t>(row) < first_dim_size) ? row : -1;
+  };
+  size_t row_bytes = row_size * sizeof(T);
+  for (size_t i = start; i < end; ++i) {
+    if (i + kGatherPrefetchDistance < end) {
+      int64_t ahead = valid_row(indices[i + kGatherPrefetchDistance]);
+      if (ahead >= 0) {
+        PrefetchRow(table + ahead * row_size, row_bytes);
+      }
+    }
+    int64_t row = valid_row(indices[i]);
+    if (row >= 0) {
+      CopyRow(output, table + row * row_size, row_size);
+    } else {
+      std::fill_n(output, row_size, static_cast<T>(0.0f));
+    }
+    output += row_size;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GATHER_UTILS_H_
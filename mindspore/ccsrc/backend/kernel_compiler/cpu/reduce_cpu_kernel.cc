@@ -13,41 +13,44 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <map>
 #include <string>
 #include <vector>
 #include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "ir/tensor.h"
 
 namespace mindspore {
 namespace kernel {
-const size_t kReduceTypeMax = 0;
-const size_t kReduceTypeMean = 1;
-const size_t kReduceTypeSum = 2;
-const size_t kMaxDim = 100;
 void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
   if (kernel_name == "ReduceMax") {
-    reduce_type_ = kReduceTypeMax;
+    reduce_type_ = kReduceMax;
+  } else if (kernel_name == "ReduceMin") {
+    reduce_type_ = kReduceMin;
   } else if (kernel_name == "ReduceMean") {
-    reduce_type_ = kReduceTypeMean;
+    reduce_type_ = kReduceMean;
   } else if (kernel_name == "ReduceSum") {
-    reduce_type_ = kReduceTypeSum;
+    reduce_type_ = kReduceSum;
   } else {
     MS_LOG(EXCEPTION) << "Array reduce kernel type " << kernel_name << " is not supported.";
   }
+  dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  axis_.clear();
   auto axis_addr = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr(AXIS);
   if (axis_addr->isa<ValueTuple>()) {
     auto attr_axis = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, AXIS);
     if (attr_axis.size() > shape_.size()) {
-      MS_LOG(EXCEPTION) << "invalid axis size: " << axis_.size();
+      MS_LOG(EXCEPTION) << "invalid axis size: " << attr_axis.size();
     } else if (attr_axis.empty()) {
-      axis_.push_back(shape_.size() - 1);
+      // An empty axis reduces all dimensions.
+      for (size_t i = 0; i < shape_.size(); ++i) {
+        axis_.push_back(i);
+      }
     } else {
       for (auto axis : attr_axis) {
-        if (IntToSize(axis) >= (shape_.size())) {
+        if (axis >= SizeToInt(shape_.size()) || axis < -SizeToInt(shape_.size())) {
           MS_LOG(EXCEPTION) << "axis value is oversize.";
         }
         axis < 0 ? axis_.push_back(axis + shape_.size()) : axis_.push_back(axis);
@@ -55,107 +58,46 @@ void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     }
   } else if (axis_addr->isa<Int32Imm>()) {
     int axis = AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS);
-    if (axis >= 0 && IntToSize(axis) >= shape_.size()) {
+    if (axis >= SizeToInt(shape_.size()) || axis < -SizeToInt(shape_.size())) {
       MS_LOG(EXCEPTION) << "axis value is oversize.";
     }
     axis < 0 ? axis_.push_back(axis + shape_.size()) : axis_.push_back(axis);
   } else {
     MS_LOG(EXCEPTION) << "Attribute axis type is invalid.";
   }
-  for (size_t i = 0; i < shape_.size(); ++i) {
-    if (shape_[i] <= 0) {
-      MS_LOG(EXCEPTION) << "shape value is invalid.";
-    }
-    left_dims_ *= shape_[i];
-  }
-  for (size_t i = 0; i < axis_.size(); ++i) {
-    stride_ *= shape_[axis_[i]];
-  }
-  if (stride_ <= 0) {
-    MS_LOG(EXCEPTION) << "stride_ must greater than zero.";
+  plan_.Init(shape_, axis_);
+}
+
+template <typename T>
+void ReduceCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+  if (inputs[0]->size != plan_.input_size() * sizeof(T) || outputs[0]->size != plan_.output_size() * sizeof(T)) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
   }
-  left_dims_ = left_dims_ / stride_;
+  auto input = reinterpret_cast<T *>(inputs[0]->addr);
+  auto output = reinterpret_cast<T *>(outputs[0]->addr);
+  Reduce<T>(plan_, reduce_type_, input, output);
 }
+
 bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspaces*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  size_t out_float_size = left_dims_ * sizeof(float);
-  size_t in_float_size = stride_ * out_float_size;
-  if (inputs[0]->size != in_float_size || outputs[0]->size != out_float_size) {
-    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
   }
-  auto input = reinterpret_cast<float *>(inputs[0]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  int size = inputs[0]->size / sizeof(float);
-  std::vector<float> new_input(IntToSize(size), 0.0);
-  std::vector<size_t> transpose_axis;
-  for (size_t i = 0; i < shape_.size(); ++i) {
-    bool insert = true;
-    for (size_t j = 0; j < axis_.size(); ++j) {
-      if (axis_[j] == i) {
-        insert = false;
-        break;
-      }
-    }
-    if (insert) {
-      transpose_axis.push_back(i);
-    }
-  }
-  (void)transpose_axis.insert(transpose_axis.end(), axis_.begin(), axis_.end());
-  Transpose(size, input, shape_, transpose_axis, SizeToInt(shape_.size()), &new_input[0]);
-  ConvertDataToOutput(&new_input[0], output);
-  return true;
-}
-
-void ReduceCPUKernel::ConvertDataToOutput(const float *new_input, float *output) {
-  if (reduce_type_ == kReduceTypeMax) {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = new_input[i * stride_];
-      for (size_t k = 0; k < stride_; ++k) {
-        if (value < new_input[i * stride_ + k]) {
-          value = new_input[i * stride_ + k];
-        }
-      }
-      output[i] = value;
-    }
+  if (dtype_ == kNumberTypeFloat32) {
+    LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat64) {
+    LaunchKernel<double>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt32) {
+    LaunchKernel<int>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeInt64) {
+    LaunchKernel<int64_t>(inputs, outputs);
   } else {
-    for (size_t i = 0; i < left_dims_; ++i) {
-      float value = 0.0;
-      for (size_t k = 0; k < stride_; ++k) {
-        value += new_input[i * stride_ + k];
-      }
-      if (reduce_type_ == kReduceTypeMean) {
-        output[i] = value / stride_;
-      } else {
-        output[i] = value;
-      }
-    }
-  }
-}
-void ReduceCPUKernel::Transpose(const int size, const float *input, const std::vector<size_t> &input_shape,
-                                const std::vector<size_t> &input_axis, const int shape_size, float *output) {
-  int pos_array[kMaxDim];
-  int size_offset[kMaxDim];
-  size_offset[0] = size / SizeToInt(input_shape[0]);
-  for (int i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[i - 1] / SizeToInt(input_shape[i]);
+    MS_LOG(EXCEPTION) << "Reduce kernel does not support data type " << TypeIdLabel(dtype_);
   }
-  for (int position = 0; position < size; position += 1) {
-    int temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (int i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[i - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    int new_position = pos_array[SizeToInt(input_axis[shape_size - 1])];
-    int new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= SizeToInt(input_shape[SizeToInt(input_axis[j + 1])]);
-      new_position += pos_array[SizeToInt(input_axis[j])] * new_position_size;
-    }
-    output[new_position] = input[position];
-  }
-  return;
+  return true;
 }
 }  // namespace kernel
 }  // namespace mindspore
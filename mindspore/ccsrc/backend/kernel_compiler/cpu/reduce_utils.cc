@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/reduce_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+void ReducePlan::Init(const std::vector<size_t> &shape, const std::vector<size_t> &axis) {
+  std::vector<bool> reduce_flags(shape.size(), false);
+  for (auto i : axis) {
+    if (i >= shape.size()) {
+      MS_LOG(EXCEPTION) << "Reduce axis " << i << " is out of range of rank " << shape.size();
+    }
+    reduce_flags[i] = true;
+  }
+  std::vector<size_t> strides(shape.size(), 1);
+  for (size_t i = shape.size(); i > 1; --i) {
+    strides[i - 2] = strides[i - 1] * shape[i - 1];
+  }
+
+  kept_dims_.clear();
+  reduced_dims_.clear();
+  input_size_ = 1;
+  reduce_size_ = 1;
+  // Merge runs of kept or reduced axes, axes of size 1 do not change the layout and are dropped.
+  bool last_reduced = false;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (shape[i] == 0) {
+      MS_LOG(EXCEPTION) << "Reduce does not support empty tensor, shape[" << i << "] is 0.";
+    }
+    input_size_ *= shape[i];
+    if (shape[i] == 1) {
+      continue;
+    }
+    auto &dims = reduce_flags[i] ? reduced_dims_ : kept_dims_;
+    if (reduce_flags[i]) {
+      reduce_size_ *= shape[i];
+    }
+    bool adjacent = (!kept_dims_.empty() || !reduced_dims_.empty()) && last_reduced == reduce_flags[i];
+    if (adjacent) {
+      dims.back().size *= shape[i];
+      dims.back().stride = strides[i];
+    } else {
+      dims.push_back({shape[i], strides[i]});
+    }
+    last_reduced = reduce_flags[i];
+  }
+  output_size_ = input_size_ / reduce_size_;
+
+  if (reduced_dims_.empty()) {
+    strategy_ = kReduceCopy;
+  } else if (kept_dims_.empty()) {
+    strategy_ = kReduceAll;
+  } else if (last_reduced) {
+    strategy_ = kReduceContiguousInner;
+  } else if (kept_dims_.back().size > kReduceTileSize) {
+    strategy_ = kReduceTiled;
+  } else {
+    strategy_ = kReduceStridedOuter;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
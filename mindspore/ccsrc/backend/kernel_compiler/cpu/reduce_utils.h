@@ -0,0 +1,314 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_UTILS_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_UTILS_H_
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "common/thread_pool.h"
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace kernel {
+enum ReduceType { kReduceMax = 0, kReduceMin, kReduceSum, kReduceMean };
+
+enum ReduceStrategy {
+  // Nothing is reduced, the output is a copy of the input.
+  kReduceCopy = 0,
+  // Every axis is reduced, the input is split into chunks whose partial results are combined.
+  kReduceAll,
+  // The innermost axes are reduced, every output element reduces contiguous runs of the input.
+  kReduceContiguousInner,
+  // The innermost axes are kept, whole input rows are accumulated into an output row.
+  kReduceStridedOuter,
+  // Like kReduceStridedOuter but the output rows are split in tiles, so that the accumulated tile stays in cache.
+  kReduceTiled
+};
+
+struct ReduceDim {
+  size_t size;
+  size_t stride;
+};
+
+// Describes a reduction over arbitrary axes on the original memory layout. Adjacent axes that are both reduced or
+// both kept are merged, so the input is seen as alternating kept and reduced dims with their element strides.
+class ReducePlan {
+ public:
+  ReducePlan() = default;
+  ~ReducePlan() = default;
+
+  void Init(const std::vector<size_t> &shape, const std::vector<size_t> &axis);
+  size_t input_size() const { return input_size_; }
+  size_t output_size() const { return output_size_; }
+  size_t reduce_size() const { return reduce_size_; }
+  ReduceStrategy strategy() const { return strategy_; }
+  const std::vector<ReduceDim> &kept_dims() const { return kept_dims_; }
+  const std::vector<ReduceDim> &reduced_dims() const { return reduced_dims_; }
+
+ private:
+  size_t input_size_{1};
+  size_t output_size_{1};
+  size_t reduce_size_{1};
+  ReduceStrategy strategy_{kReduceCopy};
+  std::vector<ReduceDim> kept_dims_;
+  std::vector<ReduceDim> reduced_dims_;
+};
+
+// Columns accumulated at once by the strided strategies, 1024 elements keep the tile within L1.
+constexpr size_t kReduceTileSize = 1024;
+// Elements reduced by one task when everything is reduced into a single value.
+constexpr size_t kReduceMinChunkSize = 16384;
+
+// Steps through the offsets of a row major index space without dividing on every step.
+class OffsetWalker {
+ public:
+  explicit OffsetWalker(const std::vector<ReduceDim> &dims) : dims_(dims), index_(dims.size(), 0) {}
+  ~OffsetWalker() = default;
+
+  size_t offset() const { return offset_; }
+  void Seek(size_t pos) {
+    offset_ = 0;
+    for (size_t i = dims_.size(); i > 0; --i) {
+      index_[i - 1] = pos % dims_[i - 1].size;
+      pos /= dims_[i - 1].size;
+      offset_ += index_[i - 1] * dims_[i - 1].stride;
+    }
+  }
+  void Next() {
+    for (size_t i = dims_.size(); i > 0; --i) {
+      offset_ += dims_[i - 1].stride;
+      if (++index_[i - 1] < dims_[i - 1].size) {
+        return;
+      }
+      offset_ -= dims_[i - 1].stride * dims_[i - 1].size;
+      index_[i - 1] = 0;
+    }
+  }
+
+ private:
+  const std::vector<ReduceDim> &dims_;
+  std::vector<size_t> index_;
+  size_t offset_{0};
+};
+
+// Type used to accumulate elements of type T, narrow floating point types are accumulated in float.
+template <typename T>
+struct ReduceAccType {
+  using type = T;
+};
+
+template <>
+struct ReduceAccType<float16> {
+  using type = float;
+};
+
+struct ReduceSumOp {
+  template <typename A>
+  static A Apply(A acc, A value) {
+    return acc + value;
+  }
+};
+
+struct ReduceMaxOp {
+  template <typename A>
+  static A Apply(A acc, A value) {
+    return value > acc ? value : acc;
+  }
+};
+
+struct ReduceMinOp {
+  template <typename A>
+  static A Apply(A acc, A value) {
+    return value < acc ? value : acc;
+  }
+};
+
+// Reduce n >= 1 contiguous elements. Independent partial results break the dependency chain of the loop, which lets
+// the compiler keep them in vector registers even for floating point sums.
+template <typename Op, typename A, typename T>
+A ReduceContiguous(const T *input, size_t n) {
+  constexpr size_t kLanes = 8;
+  if (n < 2 * kLanes) {
+    A acc = static_cast<A>(input[0]);
+    for (size_t i = 1; i < n; ++i) {
+      acc = Op::Apply(acc, static_cast<A>(input[i]));
+    }
+    return acc;
+  }
+  A lanes[kLanes];
+  for (size_t j = 0; j < kLanes; ++j) {
+    lanes[j] = static_cast<A>(input[j]);
+  }
+  size_t i = kLanes;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (size_t j = 0; j < kLanes; ++j) {
+      lanes[j] = Op::Apply(lanes[j], static_cast<A>(input[i + j]));
+    }
+  }
+  A acc = lanes[0];
+  for (size_t j = 1; j < kLanes; ++j) {
+    acc = Op::Apply(acc, lanes[j]);
+  }
+  for (; i < n; ++i) {
+    acc = Op::Apply(acc, static_cast<A>(input[i]));
+  }
+  return acc;
+}
+
+template <typename Op, typename T>
+class ReduceRunner {
+ public:
+  using A = typename ReduceAccType<T>::type;
+
+  ReduceRunner(const ReducePlan &plan, bool mean) : plan_(plan), mean_(mean) {}
+  ~ReduceRunner() = default;
+
+  void Run(const T *input, T *output) const {
+    switch (plan_.strategy()) {
+      case kReduceCopy:
+        std::copy_n(input, plan_.input_size(), output);
+        break;
+      case kReduceAll:
+        ReduceAll(input, output);
+        break;
+      case kReduceContiguousInner:
+        ReduceContiguousInner(input, output);
+        break;
+      default:
+        ReduceStridedOuter(input, output);
+        break;
+    }
+  }
+
+ private:
+  T Finalize(A acc) const {
+    if (mean_) {
+      acc = acc / static_cast<A>(plan_.reduce_size());
+    }
+    return static_cast<T>(acc);
+  }
+
+  void ReduceAll(const T *input, T *output) const {
+    size_t size = plan_.input_size();
+    size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+    size_t chunk_num = std::max<size_t>(std::min(thread_num, size / kReduceMinChunkSize), 1);
+    size_t chunk_size = (size + chunk_num - 1) / chunk_num;
+    // Partial results are combined in chunk order, so the result does not depend on the scheduling.
+    std::vector<A> partials(chunk_num);
+    auto task = [&](size_t start, size_t end) {
+      for (size_t c = start; c < end; ++c) {
+        size_t begin = c * chunk_size;
+        partials[c] = ReduceContiguous<Op, A>(input + begin, std::min(chunk_size, size - begin));
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, chunk_num);
+    A acc = partials[0];
+    for (size_t c = 1; c < chunk_num; ++c) {
+      acc = Op::Apply(acc, partials[c]);
+    }
+    output[0] = Finalize(acc);
+  }
+
+  void ReduceContiguousInner(const T *input, T *output) const {
+    const auto &reduced = plan_.reduced_dims();
+    size_t inner_size = reduced.back().size;
+    std::vector<ReduceDim> outer_reduced(reduced.begin(), reduced.end() - 1);
+    size_t outer_count = plan_.reduce_size() / inner_size;
+    auto task = [&](size_t start, size_t end) {
+      OffsetWalker kept(plan_.kept_dims());
+      OffsetWalker outer(outer_reduced);
+      kept.Seek(start);
+      for (size_t i = start; i < end; ++i) {
+        const T *base = input + kept.offset();
+        outer.Seek(0);
+        A acc = ReduceContiguous<Op, A>(base, inner_size);
+        for (size_t r = 1; r < outer_count; ++r) {
+          outer.Next();
+          acc = Op::Apply(acc, ReduceContiguous<Op, A>(base + outer.offset(), inner_size));
+        }
+        output[i] = Finalize(acc);
+        kept.Next();
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, plan_.output_size(), std::max<size_t>(kReduceTileSize / inner_size, 1));
+  }
+
+  void ReduceStridedOuter(const T *input, T *output) const {
+    const auto &kept_dims = plan_.kept_dims();
+    size_t row_size = kept_dims.back().size;
+    std::vector<ReduceDim> outer_kept(kept_dims.begin(), kept_dims.end() - 1);
+    size_t row_count = plan_.output_size() / row_size;
+    size_t tile_size = plan_.strategy() == kReduceTiled ? kReduceTileSize : row_size;
+    size_t tile_num = (row_size + tile_size - 1) / tile_size;
+    size_t reduce_size = plan_.reduce_size();
+    auto task = [&](size_t start, size_t end) {
+      OffsetWalker kept(outer_kept);
+      OffsetWalker reduced(plan_.reduced_dims());
+      std::vector<A> acc(tile_size);
+      for (size_t unit = start; unit < end; ++unit) {
+        size_t row = unit / tile_num;
+        size_t col = (unit % tile_num) * tile_size;
+        size_t len = std::min(tile_size, row_size - col);
+        kept.Seek(row);
+        const T *base = input + kept.offset() + col;
+        for (size_t j = 0; j < len; ++j) {
+          acc[j] = static_cast<A>(base[j]);
+        }
+        reduced.Seek(0);
+        for (size_t r = 1; r < reduce_size; ++r) {
+          reduced.Next();
+          const T *src = base + reduced.offset();
+          for (size_t j = 0; j < len; ++j) {
+            acc[j] = Op::Apply(acc[j], static_cast<A>(src[j]));
+          }
+        }
+        T *dst = output + row * row_size + col;
+        for (size_t j = 0; j < len; ++j) {
+          dst[j] = Finalize(acc[j]);
+        }
+      }
+    };
+    size_t min_units = std::max<size_t>(kReduceTileSize / std::min(row_size, kReduceTileSize), 1);
+    CPUKernelUtils::ParallelFor(task, row_count * tile_num, min_units);
+  }
+
+  const ReducePlan &plan_;
+  bool mean_;
+};
+
+// Reduce input laid out as described by plan into output, which holds plan.output_size() elements.
+template <typename T>
+void Reduce(const ReducePlan &plan, ReduceType reduce_type, const T *input, T *output) {
+  switch (reduce_type) {
+    case kReduceMax:
+      ReduceRunner<ReduceMaxOp, T>(plan, false).Run(input, output);
+      break;
+    case kReduceMin:
+      ReduceRunner<ReduceMinOp, T>(plan, false).Run(input, output);
+      break;
+    case kReduceSum:
+      ReduceRunner<ReduceSumOp, T>(plan, false).Run(input, output);
+      break;
+    default:
+      ReduceRunner<ReduceSumOp, T>(plan, true).Run(input, output);
+      break;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_REDUCE_UTILS_H_
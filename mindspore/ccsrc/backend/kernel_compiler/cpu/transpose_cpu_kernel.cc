@@ -16,48 +16,33 @@
 
 #include "backend/kernel_compiler/cpu/transpose_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "common/permute.h"
 namespace mindspore {
 namespace kernel {
-const size_t kMaxDim = 100;
 void TransposeCPUFwdKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
-  axis_ = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "perm");
-  if (shape_.size() != axis_.size()) {
+  auto perm = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "perm");
+  if (shape_.size() != perm.size()) {
     MS_LOG(EXCEPTION) << "The size of input shape and transpose axis shape must be equal.";
   }
+  axis_.clear();
+  for (auto axis : perm) {
+    axis_.push_back(IntToSize(axis < 0 ? axis + SizeToInt(shape_.size()) : axis));
+  }
+  type_size_ = GetTypeByte(TypeIdToType(AnfAlgo::GetInputDeviceDataType(kernel_node, 0)));
 }
+
 bool TransposeCPUFwdKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
                                    const std::vector<kernel::AddressPtr> &outputs) {
-  auto input = reinterpret_cast<float *>(inputs[0]->addr);
-  auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  size_t size = IntToSize(inputs[0]->size / sizeof(float));
-  size_t shape_size = IntToSize(shape_.size());
-  if (shape_size > kMaxDim) {
-    MS_LOG(EXCEPTION) << "Input is " << shape_size << "-D, but transpose supports max " << kMaxDim << "-D inputs.";
-  }
-  size_t pos_array[kMaxDim];
-  size_t size_offset[kMaxDim];
-  size_offset[0] = size / shape_[0];
-  for (size_t i = 1; i < shape_size; i++) {
-    size_offset[i] = size_offset[SizeToInt(i) - 1] / shape_[i];
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "Transpose needs one input and one output.";
   }
-  for (size_t position = 0; position < size; position += 1) {
-    size_t temp_position = position;
-    pos_array[0] = temp_position / size_offset[0];
-    for (size_t i = 1; i < shape_size; i++) {
-      temp_position -= pos_array[SizeToInt(i) - 1] * size_offset[i - 1];
-      pos_array[i] = temp_position / size_offset[i];
-    }
-    size_t new_position = pos_array[axis_[SizeToInt(shape_size) - 1]];
-    size_t new_position_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      new_position_size *= shape_[axis_[j + 1]];
-      new_position += pos_array[axis_[j]] * new_position_size;
-    }
-    output[new_position] = input[position];
+  if (outputs[0]->size < inputs[0]->size) {
+    MS_LOG(EXCEPTION) << "The output size " << outputs[0]->size << " is less than the input size " << inputs[0]->size;
   }
+  common::Permute(inputs[0]->addr, outputs[0]->addr, shape_, axis_, type_size_);
   return true;
 }
 }  // namespace kernel
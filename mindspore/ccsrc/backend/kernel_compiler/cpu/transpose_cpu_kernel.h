@@ -34,9 +34,18 @@ class TransposeCPUFwdKernel : public CPUKernel {
 
  private:
   std::vector<size_t> shape_;
-  std::vector<int> axis_;
+  std::vector<size_t> axis_;
+  size_t type_size_{sizeof(float)};
 };
 
+MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  TransposeCPUFwdKernel);
+MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeFloat64).AddOutputAttr(kNumberTypeFloat64),
+                  TransposeCPUFwdKernel);
+MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
+                  TransposeCPUFwdKernel);
+MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeInt64).AddOutputAttr(kNumberTypeInt64),
+                  TransposeCPUFwdKernel);
 MS_REG_CPU_KERNEL(Transpose, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
                   TransposeCPUFwdKernel);
 }  // namespace kernel
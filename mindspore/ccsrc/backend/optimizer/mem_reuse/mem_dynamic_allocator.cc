@@ -27,6 +27,11 @@ DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return AllocMemBuf(size);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocMemBuf(size_t size) {
   size_t align_size = AlignMemorySize(size);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
   DeviceMemPtr device_addr = FindIdleMemBuf(align_size);
@@ -38,9 +43,10 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
 
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           std::vector<size_t> size_list) {
+  std::lock_guard<std::mutex> locker(mutex_);
   std::vector<DeviceMemPtr> device_addr_list;
   // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size);
+  auto device_addr = AllocMemBuf(total_size);
   if (!device_addr) {
     return device_addr_list;
   }
@@ -189,6 +195,7 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr device
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  std::lock_guard<std::mutex> locker(mutex_);
   auto mem_block = FindMemBlock(device_addr);
   if (mem_block == nullptr) {
     // May be destory the memory pool first, then destory the address, so this is normal case.
@@ -263,6 +270,7 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr devi
 }
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  std::lock_guard<std::mutex> locker(mutex_);
   MS_LOG(INFO) << "The dynamic memory pool total size is " << total_mem_statistics_ << ", total used size is "
                << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_ << ".";
   for (auto iter = global_mem_block_list_.begin(); iter != global_mem_block_list_.end(); ++iter) {
@@ -276,6 +284,7 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
+  std::lock_guard<std::mutex> locker(mutex_);
   MS_LOG(INFO) << "Start dump dynamic memory pool info.";
   DeviceAddrMapMemBuf mem_block_map;
   DynamicMemBufPtr mem_buf;
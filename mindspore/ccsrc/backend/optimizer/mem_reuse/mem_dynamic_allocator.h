@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <map>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 #include <utility>
@@ -72,7 +73,7 @@ class DynamicMemBlock {
 };
 using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 
-// The main class of dynamic memory pool.
+// The main class of dynamic memory pool, the memory can be allocated and freed from different threads.
 class DynamicMemPoolBestFit {
  public:
   DynamicMemPoolBestFit() = default;
@@ -106,6 +107,8 @@ class DynamicMemPoolBestFit {
   virtual size_t mem_alloc_unit_size() const { return DYNAMIC_MEM_ALLOC_UNIT_SIZE; }
 
  private:
+  // Alloc memory with the pool locked by the caller.
+  DeviceMemPtr AllocMemBuf(size_t size);
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -135,6 +138,7 @@ class DynamicMemPoolBestFit {
   size_t total_mem_statistics_{0};
   size_t total_used_mem_statistics_{0};
   size_t used_mem_peak_statistics_{0};
+  std::mutex mutex_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -373,14 +373,10 @@ void AscendSession::RunOpExecTask(const std::shared_ptr<KernelGraph> &kernel_gra
   MS_LOG(INFO) << "Finish!";
 }
 
-bool AscendSession::GraphCacheExist(const GraphInfo &graph_info) const {
-  return run_op_graphs_.find(graph_info) != run_op_graphs_.end();
-}
-
 void AscendSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
                             const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask) {
   MS_LOG(INFO) << "Build op " << op_run_info.op_name << " start !";
-  if (GraphCacheExist(graph_info)) {
+  if (GetSingleOpGraph(graph_info) != nullptr) {
     MS_LOG(INFO) << "Build op " << op_run_info.op_name << " graph cache has existed !";
     return;
   }
@@ -398,13 +394,14 @@ void AscendSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph
   // build kernel
   RunOpAdjustKernel(graph);
   BuildKernel(graph);
-  run_op_graphs_[graph_info] = graph;
+  CacheSingleOpGraph(graph_info, graph);
   MS_LOG(INFO) << "Build op " << op_run_info.op_name << " finish !";
 }
 
-py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
-                               const std::vector<tensor::TensorPtr> &input_tensors) {
-  auto graph = run_op_graphs_[graph_info];
+void AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+                          const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  auto graph = GetSingleOpGraph(graph_info);
   MS_EXCEPTION_IF_NULL(graph);
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " start!";
   // malloc mem
@@ -414,7 +411,6 @@ py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &gr
   // run op
   RunOpExecTask(graph);
   // get output
-  VectorRef outputs;
   if (op_run_info.value != nullptr) {
     std::vector<tensor::TensorPtr> pre_output_tensors;
     TensorValueToTensor(op_run_info.value, &pre_output_tensors);
@@ -422,22 +418,13 @@ py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &gr
       tensor::TensorPtr tensor = std::make_shared<tensor::Tensor>(pre_output->data_type(), pre_output->shape());
       tensor->set_device_address(pre_output->device_address());
       tensor->set_dirty(false);
-      outputs.emplace_back(tensor);
+      outputs->emplace_back(tensor);
     }
   } else {
-    UpdateOutputs(graph, &outputs, input_tensors);
-  }
-  // trans output to tuple
-  auto output_tensors = TransformBaseRefListToTuple(outputs);
-  if (!utils::isa<PyObjectRef>(output_tensors) ||
-      !py::isinstance<py::tuple>(utils::cast<PyObjectRef>(output_tensors).object_)) {
-    MS_LOG(EXCEPTION) << "The output tensors should be a tuple !";
+    UpdateOutputs(graph, outputs, input_tensors);
   }
-  py::object tuple_obj = utils::cast<PyObjectRef>(output_tensors).object_;
-  py::tuple tuple_tensors = py::cast<py::tuple>(tuple_obj);
   RunOpMemoryClear(graph.get());
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " finish!";
-  return tuple_tensors;
 }
 
 // compile graph steps
@@ -48,8 +48,8 @@ class AscendSession : public SessionBasic {
   void BuildGraph(GraphId) override;
   void BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
                const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask) override;
-  py::tuple RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
-                  const std::vector<tensor::TensorPtr> &input_tensors) override;
+  void RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+             const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) override;
 
   // get graph id in child graphs by ME front anf node pointer
   GraphId GetGraphIdByNode(const AnfNodePtr &front_anf) const override;
@@ -93,8 +93,6 @@ class AscendSession : public SessionBasic {
   const std::vector<GraphId> &GetGraphOrder(GraphId final_graph_id) const;
   // get graph order type vector by graph id
   const std::vector<GraphType> &GetGraphOrderType(GraphId final_graph_id) const;
-  // check if graph cache exist
-  bool GraphCacheExist(const GraphInfo &graph_info) const;
   // insert all assign to child graph
   void InsertAllAssigns();
   // sync intial tensors' data to device
@@ -46,6 +46,7 @@ static std::shared_ptr<std::map<ValuePtr, ParameterPtr>> python_paras;
 void ClearPythonParasMap() { python_paras = nullptr; }
 namespace {
 const int kSummaryGetItem = 2;
+const size_t kMaxSingleOpGraphCacheSize = 4096;
 
 ValuePtr GetParamDefaultValue(const AnfNodePtr &node) {
   if (node == nullptr) {
@@ -317,6 +318,32 @@ KernelGraphPtr SessionBasic::GetGraph(mindspore::GraphId graph_id) const {
   return it->second;
 }
 
+KernelGraphPtr SessionBasic::GetSingleOpGraph(const GraphInfo &graph_info) {
+  auto it = run_op_graphs_.find(graph_info);
+  if (it == run_op_graphs_.end()) {
+    return nullptr;
+  }
+  run_op_graph_lru_.splice(run_op_graph_lru_.begin(), run_op_graph_lru_, it->second);
+  return it->second->second;
+}
+
+void SessionBasic::CacheSingleOpGraph(const GraphInfo &graph_info, const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto it = run_op_graphs_.find(graph_info);
+  if (it != run_op_graphs_.end()) {
+    it->second->second = graph;
+    run_op_graph_lru_.splice(run_op_graph_lru_.begin(), run_op_graph_lru_, it->second);
+    return;
+  }
+  if (run_op_graphs_.size() >= kMaxSingleOpGraphCacheSize) {
+    MS_LOG(INFO) << "Single op graph cache is full, drop graph " << run_op_graph_lru_.back().second->graph_id();
+    (void)run_op_graphs_.erase(run_op_graph_lru_.back().first);
+    run_op_graph_lru_.pop_back();
+  }
+  run_op_graph_lru_.emplace_front(graph_info, graph);
+  run_op_graphs_[graph_info] = run_op_graph_lru_.begin();
+}
+
 void SessionBasic::InitInternalOutputParameter(const AnfNodePtr &out_node, const AnfNodePtr &parameter) {
   auto graph_id = GetGraphIdByNode(out_node);
   if (graph_id == kInvalidGraphId) {
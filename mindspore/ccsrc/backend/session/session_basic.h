@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_BACKEND_SESSION_SESSION_BASIC_H
 
 #include <vector>
+#include <list>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -72,9 +73,15 @@ class SessionBasic {
   virtual void BuildOp(const OpRunInfo &, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors,
                        const std::vector<int> &tensors_mask) {}
 
-  virtual py::tuple RunOp(const OpRunInfo &, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors) {
-    return py::tuple();
+  // run a single op graph built by BuildOp, it does not touch python objects so it can run without the GIL
+  virtual void RunOp(const OpRunInfo &, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors,
+                     VectorRef *outputs) {}
+  // whether BuildOp has a graph for the key, it only reads the key index of the single op graph cache
+  bool SingleOpGraphCached(const GraphInfo &graph_info) const {
+    return run_op_graphs_.find(graph_info) != run_op_graphs_.end();
   }
+  // trans BaseRef list to py::tuple
+  BaseRef TransformBaseRefListToTuple(const BaseRef &base_ref);
 
   virtual void RegisterSummaryCallBackFunc(const CallBackFunc &callback);
 
@@ -116,6 +123,10 @@ class SessionBasic {
   virtual void SetSummaryNodes(KernelGraph *graph);
   // Get graph by graph id ,if not exist return null ptr
   KernelGraphPtr GetGraph(GraphId graph_id) const;
+  // Get the cached single op graph and mark it as the most recently used one, if not exist return null ptr
+  KernelGraphPtr GetSingleOpGraph(const GraphInfo &graph_info);
+  // Cache a single op graph, the least recently used one is dropped when the cache is full
+  void CacheSingleOpGraph(const GraphInfo &graph_info, const KernelGraphPtr &graph);
   virtual void LoadInputData(const std::shared_ptr<KernelGraph> &kernel_graph,
                              const std::vector<tensor::TensorPtr> &inputs_const) const;
   void UpdateOutputs(const std::shared_ptr<KernelGraph> &kernel_graph, VectorRef *const outputs,
@@ -129,8 +140,6 @@ class SessionBasic {
   std::shared_ptr<KernelGraph> ConstructSingleOpGraph(const OpRunInfo &op_run_info,
                                                       const std::vector<tensor::TensorPtr> &input_tensors,
                                                       const std::vector<int> &tensors_mask);
-  // trans BaseRef list to py::tuple
-  BaseRef TransformBaseRefListToTuple(const BaseRef &base_ref);
   // create a new kernel graph and update the graph sum
   KernelGraphPtr NewKernelGraph();
   std::vector<AnfNodePtr> CreateParameterFromTuple(const AnfNodePtr &node, bool valid_input, KernelGraph *graph);
@@ -143,7 +152,9 @@ class SessionBasic {
   AnfNodePtr FindPullNode(const AnfNodePtr &push_node, const std::vector<AnfNodePtr> &node_list);
 
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
-  std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  // single op graphs of pynative, the most recently used one is at the front of run_op_graph_lru_
+  std::list<std::pair<GraphInfo, KernelGraphPtr>> run_op_graph_lru_;
+  std::unordered_map<GraphInfo, std::list<std::pair<GraphInfo, KernelGraphPtr>>::iterator> run_op_graphs_;
   std::unordered_map<FuncGraphPtr, KernelGraphPtr> front_backend_graph_map_;
   std::shared_ptr<Context> context_;
   CallBackFunc summary_callback_;
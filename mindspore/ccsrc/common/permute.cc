@@ -0,0 +1,330 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/permute.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include "common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+// Edge of the square tiles transposed at once, a 16 x 16 tile of 4 byte elements fits in two pages of L1.
+constexpr size_t kTileSize = 16;
+// Bytes one task copies at least, smaller tasks cost more to schedule than to run.
+constexpr size_t kMinTaskBytes = 64 * 1024;
+
+// Drop unit axes, order the rest by destination stride and merge neighbours that are contiguous on both sides.
+std::vector<PermuteDim> SimplifyDims(const std::vector<PermuteDim> &dims) {
+  std::vector<PermuteDim> sorted;
+  for (auto &dim : dims) {
+    if (dim.size != 1) {
+      sorted.push_back(dim);
+    }
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const PermuteDim &a, const PermuteDim &b) { return a.dst_stride > b.dst_stride; });
+  std::vector<PermuteDim> merged;
+  for (auto &dim : sorted) {
+    if (!merged.empty()) {
+      auto &outer = merged.back();
+      if (outer.src_stride == dim.size * dim.src_stride && outer.dst_stride == dim.size * dim.dst_stride) {
+        outer = {outer.size * dim.size, dim.src_stride, dim.dst_stride};
+        continue;
+      }
+    }
+    merged.push_back(dim);
+  }
+  return merged;
+}
+
+size_t ElementNum(const std::vector<PermuteDim> &dims) {
+  size_t num = 1;
+  for (auto &dim : dims) {
+    num *= dim.size;
+  }
+  return num;
+}
+
+// Steps through the source and destination offsets of a row major index space without dividing on every step.
+class DimWalker {
+ public:
+  explicit DimWalker(const std::vector<PermuteDim> &dims) : dims_(dims), index_(dims.size(), 0) {}
+  ~DimWalker() = default;
+
+  size_t src() const { return src_; }
+  size_t dst() const { return dst_; }
+  void Seek(size_t pos) {
+    src_ = 0;
+    dst_ = 0;
+    for (size_t i = dims_.size(); i > 0; --i) {
+      auto &dim = dims_[i - 1];
+      index_[i - 1] = pos % dim.size;
+      pos /= dim.size;
+      src_ += index_[i - 1] * dim.src_stride;
+      dst_ += index_[i - 1] * dim.dst_stride;
+    }
+  }
+  void Next() {
+    for (size_t i = dims_.size(); i > 0; --i) {
+      auto &dim = dims_[i - 1];
+      src_ += dim.src_stride;
+      dst_ += dim.dst_stride;
+      if (++index_[i - 1] < dim.size) {
+        return;
+      }
+      src_ -= dim.src_stride * dim.size;
+      dst_ -= dim.dst_stride * dim.size;
+      index_[i - 1] = 0;
+    }
+  }
+
+ private:
+  const std::vector<PermuteDim> &dims_;
+  std::vector<size_t> index_;
+  size_t src_{0};
+  size_t dst_{0};
+};
+
+// dst[j * dst_stride + i] = src[i * src_stride + j] for i < rows, j < cols.
+template <typename T>
+void TransposeTileScalar(const T *src, size_t src_stride, T *dst, size_t dst_stride, size_t rows, size_t cols) {
+  for (size_t j = 0; j < cols; ++j) {
+    for (size_t i = 0; i < rows; ++i) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+template <typename T>
+void TransposeTile(const T *src, size_t src_stride, T *dst, size_t dst_stride, size_t rows, size_t cols) {
+  TransposeTileScalar(src, src_stride, dst, dst_stride, rows, cols);
+}
+
+#ifdef __SSE__
+// 4 byte elements are moved as floats through 4 x 4 register transposes, the shuffles keep the bit patterns.
+template <>
+void TransposeTile<uint32_t>(const uint32_t *src, size_t src_stride, uint32_t *dst, size_t dst_stride, size_t rows,
+                             size_t cols) {
+  constexpr size_t kBlock = 4;
+  if (rows % kBlock != 0 || cols % kBlock != 0) {
+    TransposeTileScalar(src, src_stride, dst, dst_stride, rows, cols);
+    return;
+  }
+  for (size_t i = 0; i < rows; i += kBlock) {
+    for (size_t j = 0; j < cols; j += kBlock) {
+      auto in = reinterpret_cast<const float *>(src + i * src_stride + j);
+      __m128 row0 = _mm_loadu_ps(in);
+      __m128 row1 = _mm_loadu_ps(in + src_stride);
+      __m128 row2 = _mm_loadu_ps(in + 2 * src_stride);
+      __m128 row3 = _mm_loadu_ps(in + 3 * src_stride);
+      _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+      auto out = reinterpret_cast<float *>(dst + j * dst_stride + i);
+      _mm_storeu_ps(out, row0);
+      _mm_storeu_ps(out + dst_stride, row1);
+      _mm_storeu_ps(out + 2 * dst_stride, row2);
+      _mm_storeu_ps(out + 3 * dst_stride, row3);
+    }
+  }
+}
+#endif
+
+template <typename T>
+class StridedCopier {
+ public:
+  StridedCopier(const T *src, T *dst, std::vector<PermuteDim> dims) : src_(src), dst_(dst), dims_(std::move(dims)) {}
+  ~StridedCopier() = default;
+
+  void Run() {
+    if (dims_.empty()) {
+      dst_[0] = src_[0];
+      return;
+    }
+    const auto &inner = dims_.back();
+    if (inner.src_stride == 1 && inner.dst_stride == 1) {
+      RunContiguous();
+      return;
+    }
+    if (inner.dst_stride == 1) {
+      for (size_t i = 0; i + 1 < dims_.size(); ++i) {
+        if (dims_[i].src_stride == 1) {
+          RunTiled(i);
+          return;
+        }
+      }
+    }
+    RunElementwise();
+  }
+
+ private:
+  static size_t MinUnits(size_t unit_elements) {
+    return std::max<size_t>(kMinTaskBytes / std::max<size_t>(unit_elements * sizeof(T), 1), 1);
+  }
+
+  void Parallel(const RangeTask &task, size_t count, size_t min_block_size) const {
+    if (!ThreadPool::GetInstance().ParallelFor(task, count, min_block_size)) {
+      MS_LOG(EXCEPTION) << "Parallel strided copy failed.";
+    }
+  }
+
+  void RunContiguous() {
+    PermuteDim run = dims_.back();
+    std::vector<PermuteDim> outer(dims_.begin(), dims_.end() - 1);
+    if (outer.empty()) {
+      Parallel([this](size_t start, size_t end) { std::copy(src_ + start, src_ + end, dst_ + start); }, run.size,
+               MinUnits(1));
+      return;
+    }
+    auto task = [this, &outer, &run](size_t start, size_t end) {
+      DimWalker walker(outer);
+      walker.Seek(start);
+      for (size_t i = start; i < end; ++i) {
+        std::copy_n(src_ + walker.src(), run.size, dst_ + walker.dst());
+        walker.Next();
+      }
+    };
+    Parallel(task, ElementNum(outer), MinUnits(run.size));
+  }
+
+  // Tiles span the innermost destination axis a and the innermost source axis b.
+  void RunTiled(size_t src_inner) {
+    PermuteDim a = dims_.back();
+    PermuteDim b = dims_[src_inner];
+    std::vector<PermuteDim> outer;
+    for (size_t i = 0; i + 1 < dims_.size(); ++i) {
+      if (i != src_inner) {
+        outer.push_back(dims_[i]);
+      }
+    }
+    size_t a_tiles = (a.size + kTileSize - 1) / kTileSize;
+    size_t b_tiles = (b.size + kTileSize - 1) / kTileSize;
+    size_t tiles = a_tiles * b_tiles;
+    auto task = [&, this](size_t start, size_t end) {
+      DimWalker walker(outer);
+      walker.Seek(start / tiles);
+      for (size_t unit = start; unit < end; ++unit) {
+        size_t tile = unit % tiles;
+        if (tile == 0 && unit != start) {
+          walker.Next();
+        }
+        size_t a_begin = (tile % a_tiles) * kTileSize;
+        size_t b_begin = (tile / a_tiles) * kTileSize;
+        TransposeTile(src_ + walker.src() + a_begin * a.src_stride + b_begin, a.src_stride,
+                      dst_ + walker.dst() + a_begin + b_begin * b.dst_stride, b.dst_stride,
+                      std::min(kTileSize, a.size - a_begin), std::min(kTileSize, b.size - b_begin));
+      }
+    };
+    Parallel(task, ElementNum(outer) * tiles, MinUnits(kTileSize * kTileSize));
+  }
+
+  void RunElementwise() {
+    PermuteDim inner = dims_.back();
+    std::vector<PermuteDim> outer(dims_.begin(), dims_.end() - 1);
+    auto copy_row = [this, &inner](size_t src, size_t dst, size_t start, size_t end) {
+      for (size_t k = start; k < end; ++k) {
+        dst_[dst + k * inner.dst_stride] = src_[src + k * inner.src_stride];
+      }
+    };
+    if (outer.empty()) {
+      Parallel([&copy_row](size_t start, size_t end) { copy_row(0, 0, start, end); }, inner.size, MinUnits(1));
+      return;
+    }
+    auto task = [&outer, &inner, &copy_row](size_t start, size_t end) {
+      DimWalker walker(outer);
+      walker.Seek(start);
+      for (size_t i = start; i < end; ++i) {
+        copy_row(walker.src(), walker.dst(), 0, inner.size);
+        walker.Next();
+      }
+    };
+    Parallel(task, ElementNum(outer), MinUnits(inner.size));
+  }
+
+  const T *src_;
+  T *dst_;
+  std::vector<PermuteDim> dims_;
+};
+
+template <typename T>
+void StridedCopyImpl(const void *src, void *dst, const std::vector<PermuteDim> &dims) {
+  StridedCopier<T>(static_cast<const T *>(src), static_cast<T *>(dst), SimplifyDims(dims)).Run();
+}
+}  // namespace
+
+void StridedCopy(const void *src, void *dst, const std::vector<PermuteDim> &dims, size_t elem_size) {
+  MS_EXCEPTION_IF_NULL(src);
+  MS_EXCEPTION_IF_NULL(dst);
+  if (ElementNum(dims) == 0) {
+    return;
+  }
+  switch (elem_size) {
+    case sizeof(uint8_t):
+      StridedCopyImpl<uint8_t>(src, dst, dims);
+      break;
+    case sizeof(uint16_t):
+      StridedCopyImpl<uint16_t>(src, dst, dims);
+      break;
+    case sizeof(uint32_t):
+      StridedCopyImpl<uint32_t>(src, dst, dims);
+      break;
+    case sizeof(uint64_t):
+      StridedCopyImpl<uint64_t>(src, dst, dims);
+      break;
+    default: {
+      // Other element sizes are copied bytewise with the element as the innermost axis.
+      std::vector<PermuteDim> byte_dims;
+      for (auto &dim : dims) {
+        byte_dims.push_back({dim.size, dim.src_stride * elem_size, dim.dst_stride * elem_size});
+      }
+      byte_dims.push_back({elem_size, 1, 1});
+      StridedCopyImpl<uint8_t>(src, dst, byte_dims);
+      break;
+    }
+  }
+}
+
+void Permute(const void *src, void *dst, const std::vector<size_t> &shape, const std::vector<size_t> &perm,
+             size_t elem_size) {
+  if (perm.size() != shape.size()) {
+    MS_LOG(EXCEPTION) << "The size of perm " << perm.size() << " and shape " << shape.size() << " must be equal.";
+  }
+  std::vector<bool> used(shape.size(), false);
+  for (auto axis : perm) {
+    if (axis >= shape.size() || used[axis]) {
+      MS_LOG(EXCEPTION) << "Invalid perm axis " << axis << " for a " << shape.size() << "-D tensor.";
+    }
+    used[axis] = true;
+  }
+  std::vector<size_t> src_strides(shape.size(), 1);
+  for (size_t i = shape.size(); i > 1; --i) {
+    src_strides[i - 2] = src_strides[i - 1] * shape[i - 1];
+  }
+  std::vector<PermuteDim> dims(shape.size());
+  size_t dst_stride = 1;
+  for (size_t i = shape.size(); i > 0; --i) {
+    size_t axis = perm[i - 1];
+    dims[i - 1] = {shape[axis], src_strides[axis], dst_stride};
+    dst_stride *= shape[axis];
+  }
+  StridedCopy(src, dst, dims, elem_size);
+}
+}  // namespace common
+}  // namespace mindspore
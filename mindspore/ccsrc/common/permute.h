@@ -0,0 +1,47 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_PERMUTE_H_
+#define MINDSPORE_CCSRC_COMMON_PERMUTE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace common {
+// One axis of a strided copy, strides are counted in elements.
+struct PermuteDim {
+  size_t size;
+  size_t src_stride;
+  size_t dst_stride;
+};
+
+// Copy every element addressed by dims from src to dst, elements are elem_size bytes wide. Axes that are contiguous
+// in both buffers are merged first, then the copy is done in one of three ways:
+//   - runs that are contiguous on both sides are copied as a whole,
+//   - when the innermost axes differ, tiles of the two innermost axes are transposed in registers,
+//   - otherwise elements are copied one by one along the innermost destination axis.
+// The outer axes are split over the host thread pool.
+void StridedCopy(const void *src, void *dst, const std::vector<PermuteDim> &dims, size_t elem_size);
+
+// Write src, a row major tensor of the given shape, to dst with its axes permuted: axis i of dst is axis perm[i] of
+// src.
+void Permute(const void *src, void *dst, const std::vector<size_t> &shape, const std::vector<size_t> &perm,
+             size_t elem_size);
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_PERMUTE_H_
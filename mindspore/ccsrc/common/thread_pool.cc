@@ -0,0 +1,155 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/thread_pool.h"
+#include <algorithm>
+#include <exception>
+
+namespace mindspore {
+namespace common {
+namespace {
+constexpr size_t kMaxThreadNum = 64;
+}  // namespace
+
+ThreadPool::ThreadPool() {
+  size_t hardware_threads = std::thread::hardware_concurrency();
+  max_thread_num_ = std::min(std::max<size_t>(hardware_threads, 1), kMaxThreadNum);
+  // The caller of SyncRun is one of the workers.
+  for (size_t i = 1; i < max_thread_num_; ++i) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+  MS_LOG(INFO) << "Host thread pool starts with " << max_thread_num_ << " threads.";
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    exit_run_ = true;
+  }
+  task_cond_var_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+ThreadPool &ThreadPool::GetInstance() {
+  static ThreadPool instance;
+  return instance;
+}
+
+void ThreadPool::Execute(const QueuedTask &task) {
+  const SyncStatePtr &state = task.second;
+  try {
+    if ((*task.first)() != 0) {
+      state->success = false;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Task in thread pool failed: " << e.what();
+    state->success = false;
+  }
+  if (--state->remain == 0) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->cond_var.notify_all();
+  }
+}
+
+bool ThreadPool::RunOne() {
+  QueuedTask task;
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    if (task_queue_.empty()) {
+      return false;
+    }
+    task = task_queue_.front();
+    task_queue_.pop();
+  }
+  Execute(task);
+  return true;
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    QueuedTask task;
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      task_cond_var_.wait(lock, [this] { return exit_run_ || !task_queue_.empty(); });
+      if (exit_run_ && task_queue_.empty()) {
+        return;
+      }
+      task = task_queue_.front();
+      task_queue_.pop();
+    }
+    Execute(task);
+  }
+}
+
+bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
+  if (tasks.empty()) {
+    return true;
+  }
+  if (tasks.size() == 1 || threads_.empty()) {
+    bool success = true;
+    for (auto &task : tasks) {
+      if (task() != 0) {
+        success = false;
+      }
+    }
+    return success;
+  }
+  auto state = std::make_shared<SyncState>();
+  state->remain = tasks.size();
+  {
+    std::lock_guard<std::mutex> lock(task_mutex_);
+    for (size_t i = 1; i < tasks.size(); ++i) {
+      task_queue_.emplace(&tasks[i], state);
+    }
+  }
+  task_cond_var_.notify_all();
+
+  Execute({&tasks[0], state});
+  // Help draining the queue instead of blocking, the queued tasks may belong to a nested SyncRun.
+  while (state->remain > 0 && RunOne()) {
+  }
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cond_var.wait(lock, [&state] { return state->remain == 0; });
+  return state->success;
+}
+
+bool ThreadPool::ParallelFor(const RangeTask &task, size_t count, size_t min_block_size) {
+  if (count == 0) {
+    return true;
+  }
+  size_t max_block_num = (count + min_block_size - 1) / std::max<size_t>(min_block_size, 1);
+  size_t block_num = std::min(max_thread_num_, max_block_num);
+  if (block_num <= 1) {
+    task(0, count);
+    return true;
+  }
+  size_t block_size = (count + block_num - 1) / block_num;
+  std::vector<Task> tasks;
+  for (size_t start = 0; start < count; start += block_size) {
+    size_t end = std::min(start + block_size, count);
+    tasks.emplace_back([&task, start, end]() {
+      task(start, end);
+      return 0;
+    });
+  }
+  return SyncRun(tasks);
+}
+}  // namespace common
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+using Task = std::function<int()>;
+using RangeTask = std::function<void(size_t, size_t)>;
+
+// A process wide pool of worker threads shared by host side kernels and format conversions, so that they do not
+// spawn and join raw threads on every launch.
+class ThreadPool {
+ public:
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  static ThreadPool &GetInstance();
+  // Run all tasks and wait for them. The calling thread takes part in the work, so nested calls can not deadlock.
+  // Returns false if any task returns a non-zero value.
+  bool SyncRun(const std::vector<Task> &tasks);
+  // Split [0, count) into at most one block per thread, each holding at least min_block_size items.
+  bool ParallelFor(const RangeTask &task, size_t count, size_t min_block_size = 1);
+  size_t GetSyncRunThreadNum() const { return max_thread_num_; }
+
+ private:
+  struct SyncState {
+    std::atomic<size_t> remain{0};
+    std::atomic<bool> success{true};
+    std::mutex mutex;
+    std::condition_variable cond_var;
+  };
+  using SyncStatePtr = std::shared_ptr<SyncState>;
+  using QueuedTask = std::pair<const Task *, SyncStatePtr>;
+
+  ThreadPool();
+  void WorkerLoop();
+  bool RunOne();
+  static void Execute(const QueuedTask &task);
+
+  size_t max_thread_num_{1};
+  std::vector<std::thread> threads_;
+  std::queue<QueuedTask> task_queue_;
+  std::mutex task_mutex_;
+  std::condition_variable task_cond_var_;
+  bool exit_run_{false};
+};
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 #include "common/trans.h"
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <utility>
+#include "common/permute.h"
+#include "common/thread_pool.h"
 #include "utils/ms_utils.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -34,25 +37,27 @@ const std::map<TypeId, size_t> type_map = {{kNumberTypeBool, 1},    {kNumberType
                                            {kNumberTypeUInt32, 4},  {kNumberTypeUInt64, 8},  {kNumberTypeFloat, 4},
                                            {kNumberTypeFloat16, 2}, {kNumberTypeFloat32, 4}, {kNumberTypeFloat64, 8}};
 
-inline void SetData(size_t size, bool pad_zero, size_t src_idx, size_t dst_idx, const FormatArgs &args, void *result) {
-  switch (size) {
-    case 1:
-      static_cast<uint8_t *>(result)[dst_idx] = pad_zero ? 0 : static_cast<const uint8_t *>(args.data)[src_idx];
-      break;
-    case 2:
-      static_cast<uint16_t *>(result)[dst_idx] = pad_zero ? 0 : static_cast<const uint16_t *>(args.data)[src_idx];
-      break;
-    case 4:
-      static_cast<uint32_t *>(result)[dst_idx] = pad_zero ? 0 : static_cast<const uint32_t *>(args.data)[src_idx];
-      break;
-    case 8:
-      static_cast<uint64_t *>(result)[dst_idx] = pad_zero ? 0 : static_cast<const uint64_t *>(args.data)[src_idx];
-      break;
-    default:
-      MS_LOG(EXCEPTION) << "Trans data not support size " << size;
+// Copy the axes in dims plus a channel axis of c elements which is split into blocks of c0 channels on one side.
+// block holds the strides of one block and channel the strides of one channel inside a block. The last block may be
+// partial, its padding is left untouched.
+void CopySplitChannel(const void *src, void *dst, size_t size, std::vector<common::PermuteDim> dims, size_t c,
+                      size_t c0, const common::PermuteDim &block, const common::PermuteDim &channel) {
+  size_t full_blocks = c / c0;
+  auto full_dims = dims;
+  full_dims.push_back({full_blocks, block.src_stride, block.dst_stride});
+  full_dims.push_back({c0, channel.src_stride, channel.dst_stride});
+  common::StridedCopy(src, dst, full_dims, size);
+  size_t rest = c % c0;
+  if (rest != 0) {
+    dims.push_back({rest, channel.src_stride, channel.dst_stride});
+    common::StridedCopy(static_cast<const uint8_t *>(src) + full_blocks * block.src_stride * size,
+                        static_cast<uint8_t *>(dst) + full_blocks * block.dst_stride * size, dims, size);
   }
 }
 
+// Elements cast by one task, smaller tensors are cast on the calling thread.
+constexpr size_t kMinCastBlockSize = 32768;
+
 template <typename T>
 T DivCeil(T n1, T n2) {
   if (n2 != 0) {
@@ -79,6 +84,7 @@ enum DataTypeTransMode {
   FROM_INT8_TO_FLOAT16,
   FROM_INT8_TO_INT32,
   FROM_INT64_TO_INT32,
+  FROM_INT32_TO_INT64,
   FROM_UINT16_TO_INT32,
   FROM_BOOL_TO_FLOAT,
   FROM_BOOL_TO_INT32,
@@ -108,6 +114,7 @@ const std::map<std::pair<TypeId, TypeId>, DataTypeTransMode> mode_map{
   {std::pair<TypeId, TypeId>(kNumberTypeInt8, kNumberTypeFloat16), FROM_INT8_TO_FLOAT16},
   {std::pair<TypeId, TypeId>(kNumberTypeInt8, kNumberTypeInt32), FROM_INT8_TO_INT32},
   {std::pair<TypeId, TypeId>(kNumberTypeInt64, kNumberTypeInt32), FROM_INT64_TO_INT32},
+  {std::pair<TypeId, TypeId>(kNumberTypeInt32, kNumberTypeInt64), FROM_INT32_TO_INT64},
   {std::pair<TypeId, TypeId>(kNumberTypeUInt16, kNumberTypeInt32), FROM_UINT16_TO_INT32},
   {std::pair<TypeId, TypeId>(kNumberTypeBool, kNumberTypeInt32), FROM_BOOL_TO_INT32},
   {std::pair<TypeId, TypeId>(kNumberTypeBool, kNumberTypeFloat), FROM_BOOL_TO_FLOAT},
@@ -128,9 +135,15 @@ void CheckMemSize(const TypeIdArgs &args) {
 template <typename SrcT, typename DstT>
 void TransDataSrc2Dst(const TypeIdArgs &args, void *dst, const size_t data_size) {
   CheckMemSize(args);
-  for (size_t idx = 0; idx != data_size; idx++) {
-    SrcT src_data = static_cast<const SrcT *>(args.data)[idx];
-    static_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
+  auto src_data = static_cast<const SrcT *>(args.data);
+  auto dst_data = static_cast<DstT *>(dst);
+  auto task = [src_data, dst_data](size_t start, size_t end) {
+    for (size_t idx = start; idx < end; idx++) {
+      dst_data[idx] = static_cast<DstT>(src_data[idx]);
+    }
+  };
+  if (!common::ThreadPool::GetInstance().ParallelFor(task, data_size, kMinCastBlockSize)) {
+    MS_LOG(EXCEPTION) << "Trans data type failed.";
   }
 }
 
@@ -139,8 +152,13 @@ void TransDataSrc2Fp16(const TypeIdArgs &args, void *dst, const size_t data_size
   CheckMemSize(args);
   auto src_data = static_cast<const SrcT *>(args.data);
   auto half_data = static_cast<Eigen::half *>(dst);
-  for (size_t i = 0; i < data_size; i++) {
-    half_data[i] = Eigen::half(src_data[i]);
+  auto task = [src_data, half_data](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      half_data[i] = Eigen::half(src_data[i]);
+    }
+  };
+  if (!common::ThreadPool::GetInstance().ParallelFor(task, data_size, kMinCastBlockSize)) {
+    MS_LOG(EXCEPTION) << "Trans data type failed.";
   }
 }
 
@@ -148,8 +166,6 @@ bool CastKernel(const TypeIdArgs &args, void *dst, const size_t data_size, const
   using DtypeKernel = std::function<void(const TypeIdArgs &, void *, const size_t)>;
   const std::map<DataTypeTransMode, DtypeKernel> cast_kernel_map{
     {FROM_FLOAT_TO_INT32, TransDataSrc2Dst<float, int32_t>},
-    {FROM_FLOAT64_TO_FLOAT32, TransDataSrc2Dst<double, float>},
-    {FROM_FLOAT32_TO_FLOAT64, TransDataSrc2Dst<float, double>},
     {FROM_FLOAT16_TO_INT32, TransDataSrc2Dst<float16, int32_t>},
     {FROM_FLOAT16_TO_UINT8, TransDataSrc2Dst<float16, uint8_t>},
     {FROM_INT32_TO_FLOAT, TransDataSrc2Dst<int32_t, float>},
@@ -164,6 +180,7 @@ bool CastKernel(const TypeIdArgs &args, void *dst, const size_t data_size, const
     {FROM_INT8_TO_FLOAT16, TransDataSrc2Fp16<int8_t>},
     {FROM_INT8_TO_INT32, TransDataSrc2Dst<int8_t, int32_t>},
     {FROM_INT64_TO_INT32, TransDataSrc2Dst<int64_t, int32_t>},
+    {FROM_INT32_TO_INT64, TransDataSrc2Dst<int32_t, int64_t>},
     {FROM_UINT16_TO_INT32, TransDataSrc2Dst<uint16_t, int32_t>},
     {FROM_BOOL_TO_INT32, TransDataSrc2Dst<int8_t, int32_t>},
     {FROM_BOOL_TO_FLOAT, TransDataSrc2Dst<int8_t, float>},
@@ -176,6 +193,12 @@ bool CastKernel(const TypeIdArgs &args, void *dst, const size_t data_size, const
   } else if (mode == FROM_FLOAT16_TO_FLOAT) {
     device::HalfToFloat(dst, args.data, data_size);
     return true;
+  } else if (mode == FROM_FLOAT64_TO_FLOAT32) {
+    device::DoubleToFloat(dst, args.data, data_size);
+    return true;
+  } else if (mode == FROM_FLOAT32_TO_FLOAT64) {
+    device::FloatToDouble(dst, args.data, data_size);
+    return true;
   }
   auto iter = cast_kernel_map.find(mode);
   if (iter != cast_kernel_map.end()) {
@@ -548,26 +571,16 @@ bool NchwTo4D(const FormatArgs &args, void *result) {
     MS_LOG(ERROR) << "Check args failed.";
     return false;
   }
-  auto n = args.host_shape[kN];
-  auto c = args.host_shape[kC];
-  auto h = args.host_shape[kH];
-  auto w = args.host_shape[kW];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto src_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto dst_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            dst_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            dst_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  std::vector<size_t> perm;
+  if (args.device_format == kOpFormat_NHWC) {
+    perm = {kN, kH, kW, kC};
+  } else if (args.device_format == kOpFormat_HWCN) {
+    perm = {kH, kW, kC, kN};
+  } else {
+    MS_LOG(ERROR) << "Unexpected 4d format " << args.device_format;
+    return false;
   }
+  common::Permute(args.data, result, args.host_shape, perm, size);
   return true;
 }
 
@@ -584,21 +597,14 @@ bool ToNchw(const FormatArgs &args, void *result) {
   auto c = args.host_shape[kC];
   auto h = args.host_shape[kH];
   auto w = args.host_shape[kW];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto dst_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto src_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            src_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            src_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  // Axes of the device tensor, permuted back to nchw.
+  if (args.device_format == kOpFormat_NHWC) {
+    common::Permute(args.data, result, {n, h, w, c}, {0, 3, 1, 2}, size);
+  } else if (args.device_format == kOpFormat_HWCN) {
+    common::Permute(args.data, result, {h, w, c, n}, {3, 2, 0, 1}, size);
+  } else {
+    MS_LOG(ERROR) << "Unexpected 4d format " << args.device_format;
+    return false;
   }
   return true;
 }
@@ -629,7 +635,6 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
   auto hw = h * w;
   auto chw = c * hw;
   auto hwc0 = hw * c0;
-  auto nchw = n * chw;
 
   auto hf_cnt = DivCeil(n, kCubeSize);
   auto vf_cnt = c1 * hw;
@@ -642,25 +647,13 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
     return false;
   }
 
-  for (size_t vfi = 0; vfi < vf_cnt; vfi++) {
-    auto vf_base_i = vfi * hf_cnt;  // vertical fractal matrix base index
-    for (size_t hfi = 0; hfi < hf_cnt; hfi++) {
-      auto gfi = vf_base_i + hfi;  // global fractal matrix index
-      auto src_n_offset = hfi * chw * kCubeSize;
-      auto src_f_offset = src_n_offset + vfi % hw + vfi / hw * hwc0;
-      for (size_t row = 0; row < c0; row++) {
-        auto src_ci = vfi / hw * c0 + row;
-        auto src_row_offset = src_f_offset + row * hw;
-        for (size_t col = 0; col < kCubeSize; col++) {
-          auto src_ni = hfi * kCubeSize + col;
-          auto src_idx = src_row_offset + chw * col;
-          auto dst_idx = gfi * fractal_ele_cnt + col * c0 + row;
-          auto pad_zero = src_ni >= n || src_idx >= nchw || src_ci >= c;
-          SetData(size, pad_zero, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  // The fractal of (c1, hw, n1) holds n0 x c0 elements, so n has a destination stride of c0 across fractals.
+  if (n % kCubeSize != 0 || c % c0 != 0) {
+    std::fill_n(static_cast<uint8_t *>(result), dst_size, 0);
   }
+  auto hw_dst_stride = hf_cnt * fractal_ele_cnt;
+  CopySplitChannel(args.data, result, size, {{n, chw, c0}, {hw, 1, hw_dst_stride}}, c, c0,
+                   {0, hwc0, hw * hw_dst_stride}, {0, hw, 1});
   return true;
 }
 
@@ -696,23 +689,8 @@ bool FracZToNchw(const FormatArgs &args, void *result) {
   auto hw = h * w;
   auto chw = c * hw;
 
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t nc_idx = n_idx;
-          size_t src_idx = c1_idx * hwncc0 + h_idx * wncc0 + w_idx * ncc0 + nc_idx * c0 + c0_idx;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
-  }
+  CopySplitChannel(args.data, result, size, {{n, c0, chw}, {h, wncc0, w}, {w, ncc0, 1}}, c, c0, {0, hwncc0, c0 * hw},
+                   {0, 1, hw});
   return true;
 }
 
@@ -733,34 +711,26 @@ bool NchwToFracZc04(const FormatArgs &args, void *result) {
   auto w = args.host_shape[kW];
   const size_t c0 = 4;
   auto c1 = DivCeil(c, c0);
-  auto hwc0 = h * w * c0;
-  auto hwc = h * w * c;
-  auto nhwc = n * h * w * c;
+  auto hw = h * w;
+  auto chw = c * hw;
+  auto hwc0 = hw * c0;
   auto n_cnt = DivCeil(n, cube);
-  auto v_cnt = DivCeil(h * w * c0 * c1, cube);
-  size_t dst_idx = 0;
-
-  for (size_t vi = 0; vi < v_cnt; vi++) {
-    for (size_t ni = 0; ni < n_cnt; ni++) {
-      for (size_t col = 0; col < cube; col++) {
-        for (size_t row = 0; row < cube; row++) {
-          size_t cur_cube_n = cube * ni + col;
-          size_t cur_cube_c1hwc0 = cube * vi + row;
-          auto desc_g = cur_cube_n / n;
-          auto desc_n = cur_cube_n % n;
-          auto desc_c1 = cur_cube_c1hwc0 / hwc0;
-          auto desc_c0 = cur_cube_c1hwc0 % c0;
-          auto desc_h = (cur_cube_c1hwc0 - hwc0 * desc_c1) / (w * c0);
-          auto desc_w = (cur_cube_c1hwc0 - hwc0 * desc_c1 - w * c0 * desc_h) / c0;
-          auto c_idx = desc_c1 * c0 + desc_c0;
-          auto src_idx = desc_g * nhwc + desc_n * hwc + c_idx * h * w + desc_h * w + desc_w;
-          auto pad_zero = desc_g >= 1 || desc_n >= n || c_idx >= c;
-          SetData(size, pad_zero, src_idx, dst_idx, args, result);
-          dst_idx++;
-        }
-      }
-    }
-  }
+  auto v_cnt = DivCeil(hwc0 * c1, cube);
+  if (v_cnt * n_cnt * cube * cube * size != total_size) {
+    MS_LOG(ERROR) << "Illegal device shape for FracZc04, total_size:" << total_size;
+    return false;
+  }
+
+  // Lay the kernels out as a zero padded (c1hwc0, n) matrix first, then cut it into cube x cube fractals with the
+  // n axis outside.
+  auto padded_n = n_cnt * cube;
+  std::vector<uint8_t> matrix(v_cnt * cube * padded_n * size, 0);
+  CopySplitChannel(args.data, matrix.data(), size, {{n, chw, 1}, {hw, 1, c0 * padded_n}}, c, c0,
+                   {0, c0 * hw, hwc0 * padded_n}, {0, hw, padded_n});
+  common::StridedCopy(matrix.data(), result,
+                      {{v_cnt, cube * padded_n, n_cnt * cube * cube}, {n_cnt, cube, cube * cube}, {cube, 1, cube},
+                       {cube, padded_n, 1}},
+                      size);
   return true;
 }
 
@@ -837,30 +807,8 @@ bool NchwToFracNz(const FormatArgs &args, void *result) {
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
   auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        for (size_t i = 0; i < w0; ++i) {
-          size_t src_idx = src_h_head + w1_idx * w0 + i;
-          size_t dst_idx = h1h0_head + w1_idx * h1h0w0 + i;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t dst_idx = h1h0_head + num_w1 * h1h0w0 + w0_idx;
-        size_t src_idx = src_h_head + src_w_idx;
-        SetData(size, false, src_idx, dst_idx, args, result);
-      }
-    }
-  }
+  // Every row is cut into w1 column blocks of w0 elements, the padding of the blocks is left untouched.
+  CopySplitChannel(args.data, result, size, {{times, hw, w1h1h0w0}, {h, w, w0}}, w, w0, {0, w0, h1h0w0}, {0, 1, 1});
   return true;
 }
 
@@ -899,30 +847,7 @@ bool FracNzToNchw(const FormatArgs &args, void *result) {
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
   auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        for (size_t i = 0; i < w0; ++i) {
-          size_t src_idx = h1h0_head + w1_idx * h1h0w0 + i;
-          size_t dst_idx = src_h_head + w1_idx * w0 + i;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t src_idx = h1h0_head + num_w1 * h1h0w0 + w0_idx;
-        size_t dst_idx = src_h_head + src_w_idx;
-        SetData(size, false, src_idx, dst_idx, args, result);
-      }
-    }
-  }
+  CopySplitChannel(args.data, result, size, {{times, w1h1h0w0, hw}, {h, w0, w}}, w, w0, {0, h1h0w0, w0}, {0, 1, 1});
   return true;
 }
 
@@ -960,27 +885,12 @@ bool NchwToNc1hwc0(const FormatArgs &args, void *result) {
   auto hw = h * w;
   auto chw = c * hw;
   auto c1hwc0 = c1 * hw * c0;
-  auto wc0 = w * c0;
 
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * c1hwc0;
-    for (size_t c1_idx = 0; c1_idx < c1; c1_idx++) {
-      size_t c1_head_addr = n_head_addr + c1_idx * hw * c0;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c1_head_addr + h_idx * wc0;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t w_head_addr = h_head_addr + w_idx * c0;
-          for (size_t c0_idx = 0; c0_idx < c0; c0_idx++) {
-            size_t dst_idx = c0_idx + w_head_addr;
-            size_t c_idx = c0_idx + c1_idx * c0;
-            size_t src_idx = n_idx * chw + c_idx * hw + h_idx * w + w_idx;
-            auto pad_zero = c_idx >= c;
-            SetData(size, pad_zero, src_idx, dst_idx, args, result);
-          }
-        }
-      }
-    }
+  if (c % c0 != 0) {
+    std::fill_n(static_cast<uint8_t *>(result), total_size, 0);
   }
+  CopySplitChannel(args.data, result, size, {{n, chw, c1hwc0}, {hw, 1, c0}}, c, c0, {0, c0 * hw, hw * c0},
+                   {0, hw, 1});
   return true;
 }
 
@@ -1011,26 +921,14 @@ bool Nc1hwc0ToNchw(const FormatArgs &args, void *result) {
 
   auto hw = h * w;
   auto chw = c * hw;
-  auto wc0 = w * c0;
-  auto hwc0 = h * wc0;
+  auto hwc0 = hw * c0;
   auto c1hwc0 = c1 * hwc0;
 
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t src_idx = n_idx * c1hwc0 + c1_idx * hwc0 + h_idx * wc0 + w_idx * c0 + c0_idx;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  if (c1 * c0 < c) {
+    MS_LOG(ERROR) << "Illegal device shape, c1:" << c1 << ", c0:" << c0 << ", c:" << c;
+    return false;
   }
+  CopySplitChannel(args.data, result, size, {{n, c1hwc0, chw}, {hw, c0, 1}}, c, c0, {0, hwc0, c0 * hw}, {0, 1, hw});
   return true;
 }
 
@@ -1053,25 +951,21 @@ bool NchwToC1hwncoc0(const FormatArgs &args, void *result) {
   auto c1 = args.device_shape[0];
   auto co = args.device_shape[co_idx];
   auto c0 = args.device_shape[c0_idx];
-
-  for (size_t c1_i = 0; c1_i < c1; c1_i++) {
-    for (size_t h_i = 0; h_i < h; h_i++) {
-      for (size_t w_i = 0; w_i < w; w_i++) {
-        for (size_t n_i = 0; n_i < n; n_i++) {
-          for (size_t co_i = 0; co_i < co; co_i++) {
-            for (size_t c0_i = 0; c0_i < c0; c0_i++) {
-              size_t dst_idx = c1_i * h * w * n * co * c0 + h_i * w * n * co * c0 + w_i * n * co * c0 + n_i * co * c0 +
-                               co_i * c0 + c0_i;
-              size_t c_i = c0_i + c1_i * c0;
-              size_t src_idx = n_i * c * h * w + c_i * h * w + h_i * w + w_i;
-              auto pad_zero = !(c_i < c && c0_i == co_i);
-              SetData(size, pad_zero, src_idx, dst_idx, args, result);
-            }
-          }
-        }
-      }
-    }
+  if (co != c0 || c1 * c0 < c) {
+    MS_LOG(ERROR) << "Illegal device shape, c1:" << c1 << ", co:" << co << ", c0:" << c0 << ", c:" << c;
+    return false;
   }
+  auto hw = h * w;
+  auto chw = c * hw;
+  auto coc0 = co * c0;
+  auto ncoc0 = n * coc0;
+  auto wncoc0 = w * ncoc0;
+  auto hwncoc0 = h * wncoc0;
+
+  // Only the diagonal of every (co, c0) block holds data.
+  std::fill_n(static_cast<uint8_t *>(result), total_size, 0);
+  CopySplitChannel(args.data, result, size, {{n, chw, coc0}, {h, w, wncoc0}, {w, 1, ncoc0}}, c, c0,
+                   {0, c0 * hw, hwncoc0}, {0, hw, c0 + 1});
   return true;
 }
 
@@ -1091,23 +985,21 @@ bool C1hwncoc0ToNchw(const FormatArgs &args, void *result) {
   auto w = args.host_shape[kW];
   const int co_idx = 4;
   const int c0_idx = 5;
+  auto c1 = args.device_shape[0];
   auto co = args.device_shape[co_idx];
   auto c0 = args.device_shape[c0_idx];
-  for (size_t n_i = 0; n_i < n; n_i++) {
-    for (size_t c_i = 0; c_i < c; c_i++) {
-      for (size_t h_i = 0; h_i < h; h_i++) {
-        for (size_t w_i = 0; w_i < w; w_i++) {
-          size_t dst_idx = n_i * c * h * w + c_i * h * w + h_i * w + w_i;
-          size_t c1_i = c_i / kCubeSize;
-          size_t c0_i = c_i % kCubeSize;
-          size_t co_i = c0_i;
-          size_t src_idx =
-            c1_i * h * w * n * co * c0 + h_i * w * n * co * c0 + w_i * n * co * c0 + n_i * co * c0 + co_i * c0 + c0_i;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  if (co != c0 || c1 * c0 < c) {
+    MS_LOG(ERROR) << "Illegal device shape, c1:" << c1 << ", co:" << co << ", c0:" << c0 << ", c:" << c;
+    return false;
   }
+  auto hw = h * w;
+  auto chw = c * hw;
+  auto coc0 = co * c0;
+  auto ncoc0 = n * coc0;
+  auto wncoc0 = w * ncoc0;
+  auto hwncoc0 = h * wncoc0;
+  CopySplitChannel(args.data, result, size, {{n, coc0, chw}, {h, wncoc0, w}, {w, ncoc0, 1}}, c, c0,
+                   {0, hwncoc0, c0 * hw}, {0, c0 + 1, hw});
   return true;
 }
 }  // namespace trans
@@ -0,0 +1,349 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/optimizer/graph_structure.h"
+#include <string>
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "frontend/operator/ops.h"
+#include "utils/convert_utils_base.h"
+#include "utils/hashing.h"
+#include "utils/log_adapter.h"
+#include "utils/primitive_py.h"
+
+namespace mindspore {
+/* namespace to support opt */
+namespace opt {
+namespace {
+enum NodeTag : std::size_t { kParameterTag = 1, kHoleTag, kCNodeTag, kGraphTag };
+
+// These primitives call python functions held by the instance and not described by the attributes.
+bool IsInstanceBoundPrim(const PrimitivePtr &prim) {
+  return prim->prim_type() == kPrimTypeUserCustom || prim->name() == prim::kPrimHookBackward->name() ||
+         prim->name() == prim::kPrimBpropCut->name();
+}
+
+// The infer of a python primitive may read python members which are not attributes, they must be equal as well.
+bool IsSamePyMembers(const PrimitivePtr &prim, const PrimitivePtr &other_prim) {
+  auto prim_py = prim->cast<PrimitivePyPtr>();
+  auto other_prim_py = other_prim->cast<PrimitivePyPtr>();
+  if (prim_py == nullptr || other_prim_py == nullptr) {
+    return prim_py == other_prim_py;
+  }
+  std::string state;
+  std::string other_state;
+  return prim_py->GetInstanceState(&state) && other_prim_py->GetInstanceState(&other_state) && state == other_state;
+}
+}  // namespace
+
+GraphStructure::GraphStructure(const FuncGraphPtr &func_graph) : func_graph_(func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph_);
+  Build();
+}
+
+void GraphStructure::Build() {
+  (void)GraphIndex(func_graph_);
+  // Graphs used by a visited graph are appended to graphs_ while it is visited.
+  for (size_t i = 0; i < graphs_.size() && valid_; ++i) {
+    VisitGraph(graphs_[i]);
+  }
+}
+
+std::size_t GraphStructure::GraphIndex(const FuncGraphPtr &fg) {
+  auto iter = graph_index_.find(fg);
+  if (iter != graph_index_.end()) {
+    return iter->second;
+  }
+  auto index = graphs_.size();
+  graphs_.push_back(fg);
+  graph_index_[fg] = index;
+  return index;
+}
+
+void GraphStructure::VisitGraph(const FuncGraphPtr &fg) {
+  MS_EXCEPTION_IF_NULL(fg);
+  if (fg->get_return() == nullptr || !fg->transforms().empty()) {
+    valid_ = false;
+    return;
+  }
+  hash_ = hash_combine({hash_, kGraphTag, fg->parameters().size(), static_cast<std::size_t>(fg->has_vararg()),
+                        static_cast<std::size_t>(fg->has_kwarg()), IntToSize(fg->kwonlyargs_count()),
+                        fg->hyper_param_count(), fg->attrs().size(), fg->parameter_default_value().size()});
+  auto &holes = graph_holes_[fg];
+  holes.insert(fg->paramter_obj_nodes().begin(), fg->paramter_obj_nodes().end());
+  for (auto &param : fg->parameters()) {
+    VisitNode(param);
+  }
+  // Values are compared inline and the nodes of the graphs out of the structure are compared by identity, the
+  // weights read by a hole are not part of the structure.
+  auto include = [this](const AnfNodePtr &node) -> IncludeType {
+    if (node->isa<ValueNode>() || IsExternal(node)) {
+      return EXCLUDE;
+    }
+    return IsHole(node) ? NOFOLLOW : FOLLOW;
+  };
+  for (auto &node : TopoSort(fg->get_return(), SuccIncoming, include)) {
+    if (!valid_) {
+      return;
+    }
+    if (node_index_.find(node) == node_index_.end()) {
+      VisitNode(node);
+    }
+  }
+}
+
+void GraphStructure::VisitNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto owner = graph_index_.at(node->func_graph());
+  node_index_[node] = nodes_.size();
+  nodes_.push_back(node);
+  if (node->isa<Parameter>()) {
+    hash_ = hash_combine({hash_, kParameterTag, owner});
+    return;
+  }
+  if (IsHole(node)) {
+    if (!IsLiftableHole(node)) {
+      valid_ = false;
+      return;
+    }
+    holes_.push_back(node);
+    hash_ = hash_combine({hash_, kHoleTag, owner});
+    return;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr) {
+    valid_ = false;
+    return;
+  }
+  hash_ = hash_combine({hash_, kCNodeTag, owner, cnode->size()});
+  for (auto &input : cnode->inputs()) {
+    hash_ = hash_combine(hash_, InputHash(input));
+  }
+}
+
+bool GraphStructure::IsHole(const AnfNodePtr &node) const {
+  auto iter = graph_holes_.find(node->func_graph());
+  return iter != graph_holes_.end() && iter->second.count(node) != 0;
+}
+
+bool GraphStructure::IsExternal(const AnfNodePtr &node) const {
+  return node->func_graph() == nullptr || graph_index_.find(node->func_graph()) == graph_index_.end();
+}
+
+// A hole is moved to the callers of the shared graph, so it may only use the weights and the nodes of its own graph.
+bool GraphStructure::IsLiftableHole(const AnfNodePtr &hole) const {
+  std::vector<AnfNodePtr> todo = {hole};
+  std::unordered_set<AnfNodePtr> done;
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (!done.insert(node).second || node->isa<ValueNode>()) {
+      continue;
+    }
+    if (node->isa<Parameter>()) {
+      if (!node->cast<ParameterPtr>()->has_default()) {
+        return false;
+      }
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || cnode->func_graph() != hole->func_graph()) {
+      return false;
+    }
+    todo.insert(todo.end(), cnode->inputs().begin(), cnode->inputs().end());
+  }
+  return true;
+}
+
+std::size_t GraphStructure::InputHash(const AnfNodePtr &input) {
+  MS_EXCEPTION_IF_NULL(input);
+  if (input->isa<ValueNode>()) {
+    return ValueHash(GetValueNode(input));
+  }
+  if (IsExternal(input)) {
+    return std::hash<AnfNodePtr>{}(input);
+  }
+  auto iter = node_index_.find(input);
+  if (iter == node_index_.end()) {
+    valid_ = false;
+    return 0;
+  }
+  return iter->second;
+}
+
+std::size_t GraphStructure::ValueHash(const ValuePtr &value) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<FuncGraph>()) {
+    return hash_combine(kGraphTag, GraphIndex(value->cast<FuncGraphPtr>()));
+  }
+  if (value->isa<Primitive>()) {
+    auto prim = value->cast<PrimitivePtr>();
+    if (IsInstanceBoundPrim(prim)) {
+      valid_ = false;
+    }
+    return std::hash<std::string>{}(prim->name());
+  }
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    auto hash_value = static_cast<std::size_t>(tensor->data_type());
+    for (auto dim : tensor->shape()) {
+      hash_value = hash_combine(hash_value, static_cast<std::size_t>(dim));
+    }
+    return hash_value;
+  }
+  if (value->isa<ValueSequeue>()) {
+    std::size_t hash_value = 0;
+    for (auto &element : value->cast<ValueSequeuePtr>()->value()) {
+      hash_value = hash_combine(hash_value, ValueHash(element));
+    }
+    return hash_value;
+  }
+  if (value->isa<Scalar>() || value->isa<StringImm>()) {
+    return value->hash();
+  }
+  return std::hash<std::string>{}(value->type_name());
+}
+
+bool GraphStructure::IsSameStructure(const GraphStructure &other) const {
+  if (!valid_ || !other.valid_ || hash_ != other.hash_ || graphs_.size() != other.graphs_.size() ||
+      nodes_.size() != other.nodes_.size() || holes_.size() != other.holes_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < graphs_.size(); ++i) {
+    if (!IsSameGraphHeader(graphs_[i], other, other.graphs_[i])) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    auto &node = nodes_[i];
+    auto &other_node = other.nodes_[i];
+    if (graph_index_.at(node->func_graph()) != other.graph_index_.at(other_node->func_graph())) {
+      return false;
+    }
+    if (node->isa<Parameter>() || IsHole(node)) {
+      if (node->isa<Parameter>() != other_node->isa<Parameter>() || IsHole(node) != other.IsHole(other_node)) {
+        return false;
+      }
+      continue;
+    }
+    auto &inputs = node->cast<CNodePtr>()->inputs();
+    auto other_cnode = other_node->cast<CNodePtr>();
+    if (other.IsHole(other_node) || other_cnode == nullptr || other_cnode->size() != inputs.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      if (!IsSameInput(inputs[j], other, other_cnode->input(j))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool GraphStructure::IsSameGraphHeader(const FuncGraphPtr &fg, const GraphStructure &other,
+                                       const FuncGraphPtr &other_fg) const {
+  if (fg->parameters().size() != other_fg->parameters().size() || fg->has_vararg() != other_fg->has_vararg() ||
+      fg->has_kwarg() != other_fg->has_kwarg() || fg->kwonlyargs_count() != other_fg->kwonlyargs_count() ||
+      fg->hyper_param_count() != other_fg->hyper_param_count() || fg->attrs().size() != other_fg->attrs().size()) {
+    return false;
+  }
+  auto &other_attrs = other_fg->attrs();
+  for (auto &attr : fg->attrs()) {
+    auto iter = other_attrs.find(attr.first);
+    if (iter == other_attrs.end() || !IsSameValue(attr.second, other, iter->second)) {
+      return false;
+    }
+  }
+  auto &defaults = fg->parameter_default_value();
+  auto &other_defaults = other_fg->parameter_default_value();
+  if (defaults.size() != other_defaults.size()) {
+    return false;
+  }
+  for (auto iter = defaults.begin(), other_iter = other_defaults.begin(); iter != defaults.end();
+       ++iter, ++other_iter) {
+    if (iter->first != other_iter->first || !IsValueNode<Value>(iter->second) ||
+        !IsValueNode<Value>(other_iter->second) ||
+        !IsSameValue(GetValueNode(iter->second), other, GetValueNode(other_iter->second))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GraphStructure::IsSameInput(const AnfNodePtr &input, const GraphStructure &other,
+                                 const AnfNodePtr &other_input) const {
+  if (input->isa<ValueNode>() || other_input->isa<ValueNode>()) {
+    return input->isa<ValueNode>() && other_input->isa<ValueNode>() &&
+           IsSameValue(GetValueNode(input), other, GetValueNode(other_input));
+  }
+  bool is_external = IsExternal(input);
+  bool other_is_external = other.IsExternal(other_input);
+  if (is_external || other_is_external) {
+    return is_external && other_is_external && input == other_input;
+  }
+  auto iter = node_index_.find(input);
+  auto other_iter = other.node_index_.find(other_input);
+  return iter != node_index_.end() && other_iter != other.node_index_.end() && iter->second == other_iter->second;
+}
+
+bool GraphStructure::IsSameValue(const ValuePtr &value, const GraphStructure &other,
+                                 const ValuePtr &other_value) const {
+  if (value == nullptr || other_value == nullptr) {
+    return value == other_value;
+  }
+  if (value->isa<FuncGraph>() || other_value->isa<FuncGraph>()) {
+    if (!value->isa<FuncGraph>() || !other_value->isa<FuncGraph>()) {
+      return false;
+    }
+    auto iter = graph_index_.find(value->cast<FuncGraphPtr>());
+    auto other_iter = other.graph_index_.find(other_value->cast<FuncGraphPtr>());
+    return iter != graph_index_.end() && other_iter != other.graph_index_.end() && iter->second == other_iter->second;
+  }
+  if (value == other_value) {
+    return true;
+  }
+  if (value->isa<tensor::Tensor>()) {
+    return other_value->isa<tensor::Tensor>() &&
+           value->cast<tensor::TensorPtr>()->ValueEqual(*other_value->cast<tensor::TensorPtr>());
+  }
+  if (value->isa<ValueSequeue>()) {
+    if (!other_value->isa<ValueSequeue>() || value->type_name() != other_value->type_name()) {
+      return false;
+    }
+    auto &elements = value->cast<ValueSequeuePtr>()->value();
+    auto &other_elements = other_value->cast<ValueSequeuePtr>()->value();
+    if (elements.size() != other_elements.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < elements.size(); ++i) {
+      if (!IsSameValue(elements[i], other, other_elements[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Other values, like the meta func graphs and the namespaces, are only compared by name, so they must be the same.
+  if (value->isa<Primitive>()) {
+    return other_value->isa<Primitive>() && *value == *other_value &&
+           IsSamePyMembers(value->cast<PrimitivePtr>(), other_value->cast<PrimitivePtr>());
+  }
+  if (value->isa<Scalar>() || value->isa<StringImm>() || value->isa<Type>()) {
+    return *value == *other_value;
+  }
+  return false;
+}
+}  // namespace opt
+}  // namespace mindspore
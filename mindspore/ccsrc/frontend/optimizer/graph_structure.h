@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_GRAPH_STRUCTURE_H_
+#define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_GRAPH_STRUCTURE_H_
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ir/anf.h"
+#include "ir/func_graph.h"
+
+namespace mindspore {
+/* namespace to support opt */
+namespace opt {
+// Structure of a func graph together with all the graphs it uses, as it is after symbol resolve.
+//
+// The parameter obj nodes, which read the weights of a cell, are the holes of the structure. The graphs parsed from
+// different instances of a cell usually have the same structure and only differ in the weights in their holes, so
+// they can share one graph which takes the weights as arguments. Nodes are numbered in a fixed visiting order, the
+// hash and the comparison are both done on that numbering, so two graphs with the same structure also have their
+// holes in the same order.
+class GraphStructure {
+ public:
+  explicit GraphStructure(const FuncGraphPtr &func_graph);
+  ~GraphStructure() = default;
+
+  // False if the graphs hold something which can not be shared between cells, e.g. a custom bprop or a hook.
+  bool valid() const { return valid_; }
+  std::size_t hash() const { return hash_; }
+  const FuncGraphPtr &func_graph() const { return func_graph_; }
+  // The graphs in visiting order, func_graph first.
+  const std::vector<FuncGraphPtr> &graphs() const { return graphs_; }
+  // The parameter obj nodes in visiting order.
+  const std::vector<AnfNodePtr> &holes() const { return holes_; }
+  size_t size() const { return nodes_.size(); }
+
+  // Whether the graphs are the same except for the weights in the holes. Python primitives must also have equal python
+  // members, which their infers may read.
+  bool IsSameStructure(const GraphStructure &other) const;
+
+ private:
+  void Build();
+  void VisitGraph(const FuncGraphPtr &fg);
+  void VisitNode(const AnfNodePtr &node);
+  bool IsHole(const AnfNodePtr &node) const;
+  bool IsExternal(const AnfNodePtr &node) const;
+  bool IsLiftableHole(const AnfNodePtr &hole) const;
+  std::size_t GraphIndex(const FuncGraphPtr &fg);
+  std::size_t InputHash(const AnfNodePtr &input);
+  std::size_t ValueHash(const ValuePtr &value);
+  bool IsSameGraphHeader(const FuncGraphPtr &fg, const GraphStructure &other, const FuncGraphPtr &other_fg) const;
+  bool IsSameInput(const AnfNodePtr &input, const GraphStructure &other, const AnfNodePtr &other_input) const;
+  bool IsSameValue(const ValuePtr &value, const GraphStructure &other, const ValuePtr &other_value) const;
+
+  FuncGraphPtr func_graph_;
+  bool valid_{true};
+  std::size_t hash_{0};
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, std::size_t> graph_index_;
+  std::vector<AnfNodePtr> nodes_;
+  std::unordered_map<AnfNodePtr, std::size_t> node_index_;
+  std::vector<AnfNodePtr> holes_;
+  std::unordered_map<FuncGraphPtr, std::unordered_set<AnfNodePtr>> graph_holes_;
+};
+using GraphStructurePtr = std::shared_ptr<GraphStructure>;
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_GRAPH_STRUCTURE_H_
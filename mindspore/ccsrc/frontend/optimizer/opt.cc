@@ -25,8 +25,10 @@
 #include "ir/anf.h"
 #include "ir/manager.h"
 #include "frontend/optimizer/optimizer.h"
+#include "utils/compile_profiler.h"
 #include "utils/log_adapter.h"
 #include "utils/ordered_set.h"
+#include "utils/profile.h"
 
 namespace mindspore {
 /* namespace to support opt */
@@ -34,7 +36,9 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  substitution->prims_ = {prim};
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -61,7 +65,9 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  substitution->prims_ = prims;
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -105,8 +111,44 @@ static bool isTraversable(const AnfNodePtr &node) {
   return false;
 }
 
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prims_.empty()) {
+      general_.push_back(i);
+      continue;
+    }
+    for (auto &prim : list_[i]->prims_) {
+      MS_EXCEPTION_IF_NULL(prim);
+      auto &indexes = prim_index_[prim->name()];
+      if (indexes.empty() || indexes.back() != i) {
+        indexes.push_back(i);
+      }
+    }
+  }
+  // keep the order of the list when general Substitutions are tried together with primitive ones
+  for (auto &item : prim_index_) {
+    auto &indexes = item.second;
+    std::vector<size_t> merged;
+    (void)std::merge(indexes.begin(), indexes.end(), general_.begin(), general_.end(), std::back_inserter(merged));
+    indexes.swap(merged);
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::Candidates(const AnfNodePtr &node) const {
+  auto prim = GetCNodePrimitive(node);
+  if (prim != nullptr) {
+    auto iter = prim_index_.find(prim->name());
+    if (iter != prim_index_.end()) {
+      return iter->second;
+    }
+  }
+  return general_;
+}
+
 bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
-                                      const SubstitutionPtr &transform) const {
+                                      std::vector<SubstitutionStat> *stats) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
@@ -129,13 +171,22 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
     }
     node->seen_ = seen;
 
-    // select nodes that this transform can be applied.
-    bool is_match = transform->predicate_(node);
-
-    // apply transform on this node
+    // try the transforms which can be applied to this node until one of them changes it, the new node is visited
+    // again through its users.
     bool change = false;
-    if (is_match) {
+    for (auto index : Candidates(node)) {
+      auto &transform = list_[index];
+      if (!transform->predicate_(node)) {
+        continue;
+      }
+      double try_start = stats != nullptr ? GetTime() : 0;
       auto ret = (*transform)(optimizer, node);
+      if (stats != nullptr) {
+        auto &stat = (*stats)[index];
+        stat.tries++;
+        stat.time += GetTime() - try_start;
+        stat.hits += (ret != nullptr && ret != node) ? 1 : 0;
+      }
       if (ret != nullptr && ret != node) {
         change = true;
         changes = true;
@@ -146,7 +197,11 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
 #ifdef ENABLE_PROFILE
         MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
 #endif
+        if (stats != nullptr && !(*stats)[index].status.empty()) {
+          (*stats)[index].status.back() = true;
+        }
         node = ret;
+        break;
       }
     }
 
@@ -181,37 +236,50 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   return changes;
 }
 
+void SubstitutionList::DumpStats(const OptimizerPtr &optimizer, const std::vector<SubstitutionStat> &stats) const {
+  size_t space = 0;
+  for (auto &transform : list_) {
+    space = std::max(transform->name_.size(), space);
+  }
+  std::stringstream ss;
+  ss << std::endl
+     << "Pass: " << optimizer->name() << "(" << optimizer->CurPass_.counter << ")_" << optimizer->CurPass_.name
+     << std::endl;
+  ss << std::left << std::setw(space + 4) << "substitution"
+     << "\ttries\thits\ttime(ms)\tchanged in each iteration" << std::endl;
+  for (size_t i = 0; i < list_.size(); i++) {
+    ss << std::left << std::setw(space + 4) << list_[i]->name_ << "\t" << stats[i].tries << "\t" << stats[i].hits
+       << "\t" << stats[i].time * 1000 << "\t";
+    for (auto change : stats[i].status) {
+      ss << change << " ";
+    }
+    ss << std::endl;
+  }
+  MS_LOG(DEBUG) << ss.str();
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
   FuncGraphManagerPtr manager = optimizer->manager();
   manager->AddFuncGraph(func_graph);
 
-  // for transform status counting
-  size_t space = 0;
-  std::unordered_map<std::string, std::vector<bool>> status;
-  if (optimizer->is_on_debug_) {
-    for (size_t i = 0; i < list_.size(); i++) {
-      status[list_[i]->name_ + std::to_string(i)] = {};
-    }
+  // for transform status counting, only collected when the debug log or the compile profile is on
+  auto &profiler = CompileProfiler::GetInstance();
+  std::vector<SubstitutionStat> stats;
+  if (optimizer->is_on_debug_ || profiler.enabled()) {
+    stats.resize(list_.size());
   }
 
   bool loop = false;
   bool changes = false;
 
   do {
-    loop = false;
-    for (size_t i = 0; i < list_.size(); i++) {
-      auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
-      changes = changes || change;
-      loop = loop || change;
-
-      // record the status of each transform
-      if (optimizer->is_on_debug_) {
-        status[list_[i]->name_ + std::to_string(i)].push_back(change);
-        space = std::max(list_[i]->name_.size(), space);
-      }
+    for (auto &stat : stats) {
+      stat.status.push_back(false);
     }
+    loop = ApplyTransform(optimizer, func_graph->output(), stats.empty() ? nullptr : &stats);
+    changes = changes || loop;
 
     if (is_once_) {
       break;
@@ -220,19 +288,12 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
 
   // display the status of each transform
   if (optimizer->is_on_debug_) {
-    std::stringstream ss;
-    ss << std::endl
-       << "Pass: " << optimizer->name() << "(" << optimizer->CurPass_.counter << ")_" << optimizer->CurPass_.name
-       << std::endl;
-    for (size_t i = 0; i < list_.size(); i++) {
-      auto name = list_[i]->name_;
-      ss << std::left << std::setw(space + 4) << name << "\t";
-      for (auto change : status[name + std::to_string(i)]) {
-        ss << change << " ";
-      }
-      ss << std::endl;
+    DumpStats(optimizer, stats);
+  }
+  if (profiler.enabled()) {
+    for (size_t i = 0; i < stats.size(); ++i) {
+      profiler.AddStat(optimizer->name() + "." + list_[i]->name_, stats[i].time, stats[i].tries, stats[i].hits);
     }
-    MS_LOG(DEBUG) << ss.str();
   }
 
   return changes;
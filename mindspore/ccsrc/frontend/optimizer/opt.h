@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -40,6 +41,8 @@ class Substitution {
   OptimizerCallerPtr transform_;
   std::string name_;
   PredicateFuncType predicate_{nullptr};
+  // the primitives of the cnodes this Substitution can match, empty if it is selected by a general predicate
+  std::vector<PrimitivePtr> prims_;
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
@@ -59,17 +62,33 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
                                  const PredicateFuncType &predicate, const RenormAction &action_renorm = CHECK_RENORM);
 
+// Applies all Substitutions in one walk over the graph per iteration. Substitutions are indexed by the primitives
+// they match, so a node is only tested against the ones which can apply to it, in the order of the list.
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
-  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  struct SubstitutionStat {
+    size_t tries{0};
+    size_t hits{0};
+    double time{0};
+    // whether the Substitution changed the graph in each iteration
+    std::vector<bool> status;
+  };
+
+  const std::vector<size_t> &Candidates(const AnfNodePtr &node) const;
+  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                      std::vector<SubstitutionStat> *stats) const;
+  void DumpStats(const OptimizerPtr &optimizer, const std::vector<SubstitutionStat> &stats) const;
   std::vector<SubstitutionPtr> list_;
+  // indexes into list_ of the Substitutions a cnode of the primitive may match, general ones included
+  std::unordered_map<std::string, std::vector<size_t>> prim_index_;
+  // indexes into list_ of the Substitutions selected by a general predicate
+  std::vector<size_t> general_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
 };
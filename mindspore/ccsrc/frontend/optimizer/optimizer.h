@@ -34,6 +34,7 @@
 #include "frontend/optimizer/opt.h"
 #include "pipeline/jit/resource.h"
 #include "pipeline/jit/action.h"
+#include "utils/compile_profiler.h"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -142,6 +143,7 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
     if (!is_enable_) {
       return func_graph;
     }
+    CompileProfileScope optimizer_scope(name_, "optimizer", [this]() { return CountNodes(); });
     // Optimizer step counter;
     int counter = 1;
     bool changes = true;
@@ -152,6 +154,7 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
         for (size_t i = 0; i < passes_.size(); ++i) {
           const OptPass &opt = passes_[i];
           CurPass_ = {counter, pass_names_[i]};
+          CompileProfileScope pass_scope(pass_names_[i], "pass", [this]() { return CountNodes(); });
           auto opt_func = [&func_graph, &changes, &opt, this]() {
             if (opt.is_renormalize()) {
               auto resource_ptr = std::dynamic_pointer_cast<pipeline::Resource>(resource_);
@@ -228,6 +231,14 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
   bool is_on_debug_{false};
 
  private:
+  // Number of nodes in the graphs of the manager, -1 if there is no manager.
+  int64_t CountNodes() const {
+    if (resource_ == nullptr || resource_->manager() == nullptr) {
+      return -1;
+    }
+    return static_cast<int64_t>(resource_->manager()->all_nodes().size());
+  }
+
   const std::string name_;
   pipeline::ResourceBasePtr resource_;
   std::vector<OptPass> passes_;
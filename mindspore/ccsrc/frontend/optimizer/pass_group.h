@@ -47,6 +47,7 @@ class PassGroup {
   // @return false, graph not changed
   bool Run(const FuncGraphPtr &func_graph, const std::vector<PythonPassPtr> &passes) const;
   std::string name() const { return name_; }
+  bool empty() const { return passes_.empty(); }
 
  private:
   const std::string name_;
@@ -31,6 +31,7 @@ constexpr char kEnvPServerNum[] = "MS_SERVER_NUM";
 constexpr char kEnvWorkerNum[] = "MS_WORKER_NUM";
 constexpr char kEnvSchedulerHost[] = "MS_SCHED_HOST";
 constexpr char kEnvSchedulerPort[] = "MS_SCHED_PORT";
+constexpr char kEnvCheckpointPath[] = "MS_PS_CKPT_PATH";
 
 constexpr char kEnvRole[] = "MS_ROLE";
 constexpr char kEnvRoleOfPServer[] = "MS_PSERVER";
@@ -70,6 +71,8 @@ constexpr int kCheckReadyForPushCmd = 25;
 constexpr int kCheckReadyForPullCmd = 26;
 constexpr int kEmbeddingLookupCmd = 30;
 constexpr int kFinalizeCmd = 40;
+constexpr int kSaveCheckpointCmd = 50;
+constexpr int kLoadCheckpointCmd = 51;
 
 constexpr size_t kInvalidKey = UINT64_MAX;
 constexpr int kInvalidID = -1;
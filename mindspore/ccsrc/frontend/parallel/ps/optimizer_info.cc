@@ -34,6 +34,8 @@ size_t OptimizerInfo::grad_index() { return 0; }
 
 size_t OptimizerInfo::indices_index() { return 0; }
 
+std::vector<AddressPtr> OptimizerInfo::states() { return {}; }
+
 void OptimizerInfo::UpdateWeight(const WeightPtr &weight) {
   AddressPtr weight_addr = std::make_shared<kernel::Address>();
   weight_addr->addr = weight->data();
@@ -130,6 +132,8 @@ const AddressPtr &MomentumOptimInfo::gradient() { return inputs_[3]; }
 
 const AddressPtr &MomentumOptimInfo::indices() { return inputs_[3]; }
 
+std::vector<AddressPtr> MomentumOptimInfo::states() { return {inputs_[1]}; }
+
 size_t MomentumOptimInfo::grad_index() { return 1; }
 
 SparseAdamOptimInfo::SparseAdamOptimInfo(const AddressPtr &weight, const AddressPtr &m, const AddressPtr &v,
@@ -166,6 +170,8 @@ const AddressPtr &SparseAdamOptimInfo::gradient() { return inputs_[9]; }
 
 const AddressPtr &SparseAdamOptimInfo::indices() { return inputs_[10]; }
 
+std::vector<AddressPtr> SparseAdamOptimInfo::states() { return {inputs_[1], inputs_[2]}; }
+
 bool SparseAdamOptimInfo::IsSparse() const { return true; }
 
 size_t SparseAdamOptimInfo::grad_index() { return 6; }
@@ -187,6 +193,8 @@ const AddressPtr &SparseFtrlOptimInfo::gradient() { return inputs_[3]; }
 
 const AddressPtr &SparseFtrlOptimInfo::indices() { return inputs_[4]; }
 
+std::vector<AddressPtr> SparseFtrlOptimInfo::states() { return {inputs_[1], inputs_[2]}; }
+
 bool SparseFtrlOptimInfo::IsSparse() const { return true; }
 
 size_t SparseFtrlOptimInfo::grad_index() { return 0; }
@@ -39,6 +39,8 @@ class OptimizerInfo {
 
   virtual const AddressPtr &gradient() = 0;
   virtual const AddressPtr &indices() = 0;
+  // Optimizer slots which have the same shape as the weight, e.g. m and v of Adam.
+  virtual std::vector<AddressPtr> states();
   const std::vector<AddressPtr> &inputs();
   const std::vector<AddressPtr> &workspaces();
   const std::vector<AddressPtr> &outputs();
@@ -84,6 +86,7 @@ class MomentumOptimInfo : public DenseOptimInfo {
 
   const AddressPtr &gradient();
   const AddressPtr &indices();
+  std::vector<AddressPtr> states() override;
   size_t grad_index() override;
 };
 
@@ -98,6 +101,7 @@ class SparseAdamOptimInfo : public SparseOptimInfo {
   void Update(const Values &values, const Lengths &lens) override;
   const AddressPtr &gradient();
   const AddressPtr &indices();
+  std::vector<AddressPtr> states() override;
   bool IsSparse() const override;
   size_t grad_index() override;
   size_t indices_index() override;
@@ -111,6 +115,7 @@ class SparseFtrlOptimInfo : public SparseOptimInfo {
 
   const AddressPtr &gradient();
   const AddressPtr &indices();
+  std::vector<AddressPtr> states() override;
   bool IsSparse() const override;
   size_t grad_index() override;
   size_t indices_index() override;
@@ -37,8 +37,10 @@
 #include "frontend/parallel/ps/optimizer_info.h"
 #include "frontend/parallel/ps/optimizer_info_builder.h"
 #include "frontend/parallel/ps/util.h"
+#include "frontend/parallel/ps/shard_checkpoint.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "utils/ms_context.h"
+#include "utils/ms_utils.h"
 #include "backend/kernel_compiler/kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "backend/kernel_compiler/cpu/ps/pserver_kernel.h"
@@ -72,7 +74,9 @@ class ParameterServer {
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
-        thread_(nullptr) {}
+        thread_(nullptr),
+        checkpoint_(nullptr),
+        checkpoint_thread_(nullptr) {}
   ~ParameterServer() = default;
   ParameterServer(const ParameterServer &) = delete;
   ParameterServer &operator=(const ParameterServer &) = delete;
@@ -95,6 +99,8 @@ class ParameterServer {
     void HandleCheckReadyForPull(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleEmbeddingLookup(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleSaveCheckpoint(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleLoadCheckpoint(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
 
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
@@ -125,6 +131,13 @@ class ParameterServer {
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
   std::mutex &mutex();
+  void SaveCheckpoint(bool incremental);
+  void LoadCheckpoint();
+  void JoinCheckpointThread();
+  ShardSnapshotPtr TakeSnapshot(const Key &key, bool incremental);
+  void RestoreShard(const Key &key);
+  void MarkDirtyRows(const Key &key, const std::shared_ptr<OptimizerInfo> &optim_info);
+  size_t ShardRowCount(const Key &key);
 
   size_t pserver_num_;
   size_t worker_num_;
@@ -154,6 +167,17 @@ class ParameterServer {
 
   std::unique_ptr<std::thread> thread_;
 
+  // Server side checkpoint, enabled by setting MS_PS_CKPT_PATH on the servers.
+  std::unique_ptr<ShardCheckpoint> checkpoint_;
+  std::unique_ptr<std::thread> checkpoint_thread_;
+  // Rows of sparse weights touched since the last checkpoint, in local row ids.
+  std::unordered_map<Key, std::vector<bool>> dirty_rows_;
+  // Dirty rows of the checkpoint being saved, they are marked dirty again if saving it fails.
+  std::unordered_map<Key, std::vector<bool>> saving_rows_;
+  bool checkpoint_failed_{false};
+  // Restored shards which are not yet consumed by InitWeight, InitEmbeddingTable or the optimizer info builder.
+  std::unordered_map<Key, ShardSnapshotPtr> restored_shards_;
+
   friend class ServerHandler;
 };
 
@@ -183,6 +207,8 @@ void ParameterServer<T>::ServerHandler::Init() {
   handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
   handlers_[kEmbeddingLookupCmd] = &ServerHandler::HandleEmbeddingLookup;
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
+  handlers_[kSaveCheckpointCmd] = &ServerHandler::HandleSaveCheckpoint;
+  handlers_[kLoadCheckpointCmd] = &ServerHandler::HandleLoadCheckpoint;
 }
 
 template <typename T>
@@ -315,6 +341,21 @@ void ParameterServer<T>::ServerHandler::HandleFinalize(const ::ps::KVMeta &req_m
   ps_->Finalize();
 }
 
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleSaveCheckpoint(const ::ps::KVMeta &req_meta,
+                                                             const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
+  std::unique_lock<std::mutex> lock(ps_->mutex());
+  bool incremental = req_data.vals.size() > 0 && req_data.vals[0] > 0;
+  ps_->SaveCheckpoint(incremental);
+}
+
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleLoadCheckpoint(const ::ps::KVMeta &req_meta,
+                                                             const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
+  std::unique_lock<std::mutex> lock(ps_->mutex());
+  ps_->LoadCheckpoint();
+}
+
 template <typename T>
 bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   pserver_num_ = ::ps::NumServers();
@@ -325,6 +366,10 @@ bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   handler_->Init();
 
   InitOptimInfoBuilders();
+  auto checkpoint_path = common::GetEnv(kEnvCheckpointPath);
+  if (!checkpoint_path.empty()) {
+    checkpoint_.reset(new ShardCheckpoint(checkpoint_path, rank_id_));
+  }
   ps_->set_request_handle(*handler_);
   thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
   return true;
@@ -412,6 +457,7 @@ void ParameterServer<T>::InitWeight(const Key &key, const WeightPtr &weight) {
     weights_[key] = weight;
     tokens_[key] = 0;
     is_embedding_[key] = false;
+    RestoreShard(key);
   }
 }
 
@@ -448,6 +494,7 @@ void ParameterServer<T>::InitEmbeddingTable(
   weights_[key] = embedding;
   tokens_[key] = 0;
   is_embedding_[key] = true;
+  RestoreShard(key);
 
   grads_accum_counter_[key] = 0;
 }
@@ -487,6 +534,9 @@ void ParameterServer<T>::UpdateWeights() {
 
       optim_info->ComputeMean(worker_num_);
       optimizer->Execute(inputs, workspaces, outputs);
+      if (checkpoint_ != nullptr && optim_info->IsSparse()) {
+        MarkDirtyRows(key, optim_info);
+      }
       optim_info->Reset();
       if (!is_embedding_[key]) {
         tokens_[key] = worker_num_;
@@ -514,6 +564,7 @@ void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const
       builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
     optim_info.reset(optim);
     optim_infos_[key] = optim_info;
+    RestoreShard(key);
   } else {
     optim_info->Update(values, lengths);
     optim_info->Accumulate(values, lengths);
@@ -639,6 +690,165 @@ inline std::mutex &ParameterServer<T>::mutex() {
   return mutex_;
 }
 
+template <typename T>
+size_t ParameterServer<T>::ShardRowCount(const Key &key) {
+  // Dense weights are saved as a single row, sparse ones row by row so that deltas only hold touched rows.
+  if (optim_inputs_shape_.count(key) == 0 || weight_key_to_optims_.count(key) == 0) {
+    return 1;
+  }
+  const std::string &optim_name = weight_key_to_optims_[key];
+  if (optim_name != kSparseAdam && optim_name != kSparseFtrl) {
+    return 1;
+  }
+  const InputsShapePtr &inputs_shape = optim_inputs_shape_[key];
+  if (inputs_shape->empty()) {
+    return 1;
+  }
+  // The Adam kernels shard the var shape in place but the Ftrl one keeps the global shape, so the local row count is
+  // derived from the size of the local shard.
+  return CountShardRows(*(*inputs_shape)[0], weights_[key]->size());
+}
+
+template <typename T>
+void ParameterServer<T>::MarkDirtyRows(const Key &key, const std::shared_ptr<OptimizerInfo> &optim_info) {
+  size_t row_count = ShardRowCount(key);
+  auto &dirty = dirty_rows_[key];
+  if (dirty.size() != row_count) {
+    dirty.assign(row_count, false);
+  }
+  // The optimizer kernel has already converted the indices to local row ids, ids of other shards are out of range.
+  const AddressPtr &indices = optim_info->indices();
+  MarkRowsDirty(reinterpret_cast<const int *>(indices->addr), indices->size / sizeof(int), &dirty);
+}
+
+template <typename T>
+ShardSnapshotPtr ParameterServer<T>::TakeSnapshot(const Key &key, bool incremental) {
+  const WeightPtr &weight = weights_[key];
+  MS_EXCEPTION_IF_NULL(weight);
+  std::vector<const T *> sources = {weight->data()};
+  if (optim_infos_.count(key) > 0 && optim_infos_[key] != nullptr) {
+    for (const auto &state : optim_infos_[key]->states()) {
+      sources.push_back(reinterpret_cast<const T *>(state->addr));
+    }
+  }
+  auto dirty_iter = dirty_rows_.find(key);
+  const std::vector<bool> *dirty = nullptr;
+  if (incremental && dirty_iter != dirty_rows_.end() && dirty_iter->second.size() > 0) {
+    dirty = &dirty_iter->second;
+  }
+  return MakeShardSnapshot(key, ShardRowCount(key), weight->size(), sources, dirty);
+}
+
+template <typename T>
+void ParameterServer<T>::SaveCheckpoint(bool incremental) {
+  if (checkpoint_ == nullptr) {
+    MS_LOG(WARNING) << "Parameter server checkpoint is disabled, please set " << kEnvCheckpointPath;
+    return;
+  }
+  // Wait for the previous checkpoint, so the versions are committed in order.
+  JoinCheckpointThread();
+  if (incremental && !checkpoint_->HasCheckpoint()) {
+    MS_LOG(INFO) << "No full checkpoint exists yet, saving a full one instead of a delta.";
+    incremental = false;
+  }
+
+  // Only copying the shards happens under the lock, files are written while training goes on.
+  std::vector<ShardSnapshotPtr> snapshots;
+  for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+    snapshots.push_back(TakeSnapshot(iter->first, incremental));
+  }
+  // The dirty flags are handed over to the saving thread and restored by JoinCheckpointThread if saving fails.
+  saving_rows_.clear();
+  for (auto &dirty : dirty_rows_) {
+    saving_rows_[dirty.first] = dirty.second;
+    std::fill(dirty.second.begin(), dirty.second.end(), false);
+  }
+  checkpoint_failed_ = false;
+  checkpoint_thread_.reset(new std::thread([this, snapshots, incremental]() {
+    if (!checkpoint_->Save(snapshots, incremental)) {
+      MS_LOG(ERROR) << "Saving parameter server checkpoint of rank " << rank_id_ << " failed.";
+      checkpoint_failed_ = true;
+    }
+  }));
+}
+
+template <typename T>
+void ParameterServer<T>::JoinCheckpointThread() {
+  if (checkpoint_thread_ == nullptr) {
+    return;
+  }
+  checkpoint_thread_->join();
+  checkpoint_thread_.reset();
+  if (checkpoint_failed_) {
+    // The rows of the failed checkpoint have to go into the next delta.
+    for (const auto &saving : saving_rows_) {
+      auto &dirty = dirty_rows_[saving.first];
+      if (dirty.size() != saving.second.size()) {
+        dirty.assign(saving.second.size(), false);
+      }
+      for (size_t row = 0; row < dirty.size(); row++) {
+        dirty[row] = dirty[row] || saving.second[row];
+      }
+    }
+    checkpoint_failed_ = false;
+  }
+  saving_rows_.clear();
+}
+
+template <typename T>
+void ParameterServer<T>::LoadCheckpoint() {
+  if (checkpoint_ == nullptr) {
+    MS_LOG(WARNING) << "Parameter server checkpoint is disabled, please set " << kEnvCheckpointPath;
+    return;
+  }
+  JoinCheckpointThread();
+  if (!checkpoint_->Load(&restored_shards_)) {
+    MS_LOG(EXCEPTION) << "Loading parameter server checkpoint of rank " << rank_id_ << " failed.";
+  }
+  // Weights already initialized are overwritten now, the others when the worker initializes them.
+  std::vector<Key> keys;
+  for (const auto &shard : restored_shards_) {
+    keys.push_back(shard.first);
+  }
+  for (const auto &key : keys) {
+    RestoreShard(key);
+  }
+  dirty_rows_.clear();
+}
+
+template <typename T>
+void ParameterServer<T>::RestoreShard(const Key &key) {
+  auto iter = restored_shards_.find(key);
+  if (iter == restored_shards_.end() || weights_.count(key) == 0) {
+    return;
+  }
+  const ShardSnapshotPtr &shard = iter->second;
+  const WeightPtr &weight = weights_[key];
+  if (shard->tensors.empty() || shard->tensors[0].size() != weight->size()) {
+    MS_LOG(EXCEPTION) << "The checkpoint shard of key " << key << " mismatches the weight size " << weight->size();
+  }
+  std::copy(shard->tensors[0].begin(), shard->tensors[0].end(), weight->data());
+  MS_LOG(INFO) << "Restored weight of key " << key << " from checkpoint.";
+
+  // Optimizer states can only be restored once the optimizer info is built by the first push.
+  if (optim_infos_.count(key) == 0 || optim_infos_[key] == nullptr) {
+    return;
+  }
+  std::vector<AddressPtr> states = optim_infos_[key]->states();
+  if (states.size() + 1 != shard->tensors.size()) {
+    MS_LOG(WARNING) << "The checkpoint of key " << key << " has no optimizer states, only the weight is restored.";
+  } else {
+    for (size_t i = 0; i < states.size(); i++) {
+      const std::vector<float> &tensor = shard->tensors[i + 1];
+      if (tensor.size() * sizeof(T) != states[i]->size) {
+        MS_LOG(EXCEPTION) << "The checkpoint optimizer state " << i << " of key " << key << " mismatches.";
+      }
+      std::copy(tensor.begin(), tensor.end(), reinterpret_cast<T *>(states[i]->addr));
+    }
+  }
+  restored_shards_.erase(iter);
+}
+
 template <typename T>
 void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
   ::ps::Start(0);
@@ -648,6 +858,7 @@ void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
   }
   Init(func_graph);
   thread_->join();
+  JoinCheckpointThread();
   ::ps::Finalize(0, true);
   exit(1);
 }
@@ -0,0 +1,364 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/shard_checkpoint.h"
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "utils/log_adapter.h"
+#include "utils/system/env.h"
+#include "utils/system/crc32c.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr uint64_t kShardMagic = 0x4b43505353504d;  // "MPSSPCK"
+constexpr char kManifestName[] = "manifest";
+constexpr char kFullTag[] = "full";
+constexpr char kDeltaTag[] = "delta";
+
+bool CreateDirIfNotExist(const std::string &dir) {
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  MS_EXCEPTION_IF_NULL(fs);
+  if (fs->FileExist(dir)) {
+    return true;
+  }
+  return fs->CreateDir(dir);
+}
+
+template <typename V>
+void WriteValue(std::ofstream *ofs, V value) {
+  ofs->write(reinterpret_cast<const char *>(&value), sizeof(V));
+}
+
+template <typename V>
+bool ReadValue(std::ifstream *ifs, V *value) {
+  ifs->read(reinterpret_cast<char *>(value), sizeof(V));
+  return ifs->good();
+}
+}  // namespace
+
+size_t CountShardRows(const std::vector<size_t> &var_shape, size_t shard_size) {
+  if (var_shape.empty()) {
+    return 1;
+  }
+  size_t row_size = 1;
+  for (size_t i = 1; i < var_shape.size(); i++) {
+    row_size *= var_shape[i];
+  }
+  if (row_size == 0 || shard_size < row_size || shard_size % row_size != 0) {
+    return 1;
+  }
+  return shard_size / row_size;
+}
+
+void MarkRowsDirty(const int *ids, size_t id_num, std::vector<bool> *dirty) {
+  MS_EXCEPTION_IF_NULL(dirty);
+  for (size_t i = 0; i < id_num; i++) {
+    if (ids[i] >= 0 && static_cast<size_t>(ids[i]) < dirty->size()) {
+      (*dirty)[ids[i]] = true;
+    }
+  }
+}
+
+void ShardSnapshot::Merge(const ShardSnapshot &delta) {
+  // A full snapshot replaces the shard, its shape may have changed since the last one, e.g. after a reshape.
+  if (!delta.incremental) {
+    *this = delta;
+    return;
+  }
+  if (delta.key != key || delta.row_size != row_size || delta.tensors.size() != tensors.size()) {
+    MS_LOG(EXCEPTION) << "Checkpoint delta of key " << delta.key << " does not match the shard of key " << key;
+  }
+  for (size_t t = 0; t < tensors.size(); t++) {
+    float *dst = tensors[t].data();
+    const float *src = delta.tensors[t].data();
+    for (size_t i = 0; i < delta.row_ids.size(); i++) {
+      size_t row = delta.row_ids[i];
+      if (row >= row_count) {
+        MS_LOG(EXCEPTION) << "Row id " << row << " of key " << key << " exceeds row count " << row_count;
+      }
+      std::copy(src + i * row_size, src + (i + 1) * row_size, dst + row * row_size);
+    }
+  }
+}
+
+ShardCheckpoint::ShardCheckpoint(const std::string &dir, size_t rank_id) {
+  root_dir_ = dir + "/server_" + std::to_string(rank_id);
+  if (!CreateDirIfNotExist(dir) || !CreateDirIfNotExist(root_dir_)) {
+    MS_LOG(EXCEPTION) << "Create parameter server checkpoint dir " << root_dir_ << " failed.";
+  }
+  std::vector<ManifestEntry> entries;
+  if (ReadManifest(&entries) && !entries.empty()) {
+    next_version_ = entries.back().version + 1;
+  }
+}
+
+bool ShardCheckpoint::HasCheckpoint() const {
+  std::vector<ManifestEntry> entries;
+  return ReadManifest(&entries) && !entries.empty();
+}
+
+std::string ShardCheckpoint::VersionDir(size_t version) const { return root_dir_ + "/" + std::to_string(version); }
+
+bool ShardCheckpoint::Save(const std::vector<ShardSnapshotPtr> &snapshots, bool incremental) {
+  if (incremental && !HasCheckpoint()) {
+    MS_LOG(ERROR) << "Incremental checkpoint requires a previous full checkpoint in " << root_dir_;
+    return false;
+  }
+  size_t version = next_version_;
+  std::string version_dir = VersionDir(version);
+  if (!CreateDirIfNotExist(version_dir)) {
+    MS_LOG(ERROR) << "Create checkpoint dir " << version_dir << " failed.";
+    return false;
+  }
+
+  // Every shard is an independent file, so they are streamed out concurrently.
+  std::atomic<size_t> next_shard(0);
+  std::atomic<bool> success(true);
+  auto task = [&]() {
+    for (size_t i = next_shard++; i < snapshots.size(); i = next_shard++) {
+      const ShardSnapshot &snapshot = *snapshots[i];
+      std::string path = version_dir + "/" + std::to_string(snapshot.key) + ".ckpt";
+      if (!WriteShard(path, snapshot)) {
+        success = false;
+      }
+    }
+  };
+  size_t thread_num = std::min<size_t>(std::max<unsigned>(std::thread::hardware_concurrency(), 1), snapshots.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; i++) {
+    threads.emplace_back(task);
+  }
+  task();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (!success) {
+    MS_LOG(ERROR) << "Writing checkpoint version " << version << " to " << version_dir << " failed.";
+    return false;
+  }
+  // Record the keys of this version so that restoring does not need to list directories.
+  {
+    std::ofstream index(version_dir + "/index", std::ios::trunc);
+    for (const auto &snapshot : snapshots) {
+      index << snapshot->key << "\n";
+    }
+    index.flush();
+    if (!index.good()) {
+      MS_LOG(ERROR) << "Write checkpoint index of version " << version << " failed.";
+      return false;
+    }
+  }
+  if (!CommitManifest({version, incremental})) {
+    return false;
+  }
+  next_version_ = version + 1;
+  MS_LOG(INFO) << "Saved " << (incremental ? kDeltaTag : kFullTag) << " checkpoint version " << version << " of "
+               << snapshots.size() << " shards to " << version_dir;
+  return true;
+}
+
+bool ShardCheckpoint::Load(std::unordered_map<uint64_t, ShardSnapshotPtr> *shards) {
+  MS_EXCEPTION_IF_NULL(shards);
+  std::vector<ManifestEntry> entries;
+  if (!ReadManifest(&entries) || entries.empty()) {
+    MS_LOG(WARNING) << "No parameter server checkpoint found in " << root_dir_;
+    return false;
+  }
+  size_t base = entries.size() - 1;
+  while (base > 0 && entries[base].incremental) {
+    base--;
+  }
+  if (entries[base].incremental) {
+    MS_LOG(ERROR) << "No full checkpoint found in " << root_dir_;
+    return false;
+  }
+
+  shards->clear();
+  for (size_t i = base; i < entries.size(); i++) {
+    std::string version_dir = VersionDir(entries[i].version);
+    std::ifstream index(version_dir + "/index");
+    if (!index.is_open()) {
+      MS_LOG(ERROR) << "Open checkpoint index of version " << entries[i].version << " failed.";
+      return false;
+    }
+    uint64_t key;
+    while (index >> key) {
+      ShardSnapshot snapshot;
+      if (!ReadShard(version_dir + "/" + std::to_string(key) + ".ckpt", &snapshot)) {
+        return false;
+      }
+      auto iter = shards->find(key);
+      if (iter == shards->end()) {
+        if (snapshot.incremental) {
+          MS_LOG(ERROR) << "Delta of key " << key << " in version " << entries[i].version << " has no base shard.";
+          return false;
+        }
+        (*shards)[key] = std::make_shared<ShardSnapshot>(std::move(snapshot));
+      } else {
+        iter->second->Merge(snapshot);
+      }
+    }
+  }
+  MS_LOG(INFO) << "Loaded " << shards->size() << " shards from checkpoint version " << entries.back().version;
+  return true;
+}
+
+bool ShardCheckpoint::ReadManifest(std::vector<ManifestEntry> *entries) const {
+  MS_EXCEPTION_IF_NULL(entries);
+  std::ifstream ifs(root_dir_ + "/" + kManifestName);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+    size_t version = 0;
+    std::string tag;
+    if (!(iss >> version >> tag)) {
+      continue;
+    }
+    entries->push_back({version, tag == kDeltaTag});
+  }
+  return true;
+}
+
+bool ShardCheckpoint::CommitManifest(const ManifestEntry &entry) {
+  std::vector<ManifestEntry> entries;
+  (void)ReadManifest(&entries);
+  entries.push_back(entry);
+
+  std::string manifest = root_dir_ + "/" + kManifestName;
+  std::string tmp_manifest = manifest + ".tmp";
+  {
+    std::ofstream ofs(tmp_manifest, std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(ERROR) << "Open " << tmp_manifest << " failed.";
+      return false;
+    }
+    for (const auto &e : entries) {
+      ofs << e.version << " " << (e.incremental ? kDeltaTag : kFullTag) << "\n";
+    }
+    ofs.flush();
+    if (!ofs.good()) {
+      MS_LOG(ERROR) << "Write " << tmp_manifest << " failed.";
+      return false;
+    }
+  }
+  // rename is atomic, so readers either see the old manifest or the new one.
+  if (rename(tmp_manifest.c_str(), manifest.c_str()) != 0) {
+    MS_LOG(ERROR) << "Commit checkpoint manifest " << manifest << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool ShardCheckpoint::WriteShard(const std::string &path, const ShardSnapshot &snapshot) const {
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open checkpoint file " << path << " failed.";
+    return false;
+  }
+  size_t rows = snapshot.incremental ? snapshot.row_ids.size() : snapshot.row_count;
+  WriteValue<uint64_t>(&ofs, kShardMagic);
+  WriteValue<uint64_t>(&ofs, snapshot.key);
+  WriteValue<uint64_t>(&ofs, snapshot.incremental ? 1 : 0);
+  WriteValue<uint64_t>(&ofs, snapshot.row_count);
+  WriteValue<uint64_t>(&ofs, snapshot.row_size);
+  WriteValue<uint64_t>(&ofs, snapshot.tensors.size());
+  WriteValue<uint64_t>(&ofs, snapshot.row_ids.size());
+  for (auto row_id : snapshot.row_ids) {
+    WriteValue<uint64_t>(&ofs, row_id);
+  }
+  uint32_t crc = 0;
+  for (const auto &tensor : snapshot.tensors) {
+    if (tensor.size() != rows * snapshot.row_size) {
+      MS_LOG(ERROR) << "Tensor size " << tensor.size() << " of key " << snapshot.key << " mismatches "
+                    << rows * snapshot.row_size;
+      return false;
+    }
+    const char *data = reinterpret_cast<const char *>(tensor.data());
+    size_t size = tensor.size() * sizeof(float);
+    crc = system::Crc32c::MakeCrc32c(crc, data, size);
+    ofs.write(data, size);
+  }
+  WriteValue<uint32_t>(&ofs, crc);
+  ofs.flush();
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Write checkpoint file " << path << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool ShardCheckpoint::ReadShard(const std::string &path, ShardSnapshot *snapshot) const {
+  MS_EXCEPTION_IF_NULL(snapshot);
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open checkpoint file " << path << " failed.";
+    return false;
+  }
+  uint64_t magic = 0;
+  uint64_t key = 0;
+  uint64_t incremental = 0;
+  uint64_t row_count = 0;
+  uint64_t row_size = 0;
+  uint64_t tensor_num = 0;
+  uint64_t id_num = 0;
+  if (!ReadValue(&ifs, &magic) || magic != kShardMagic || !ReadValue(&ifs, &key) || !ReadValue(&ifs, &incremental) ||
+      !ReadValue(&ifs, &row_count) || !ReadValue(&ifs, &row_size) || !ReadValue(&ifs, &tensor_num) ||
+      !ReadValue(&ifs, &id_num)) {
+    MS_LOG(ERROR) << "Invalid checkpoint file header " << path;
+    return false;
+  }
+  snapshot->key = key;
+  snapshot->incremental = incremental != 0;
+  snapshot->row_count = row_count;
+  snapshot->row_size = row_size;
+  snapshot->row_ids.resize(id_num);
+  for (size_t i = 0; i < id_num; i++) {
+    uint64_t row_id = 0;
+    if (!ReadValue(&ifs, &row_id)) {
+      MS_LOG(ERROR) << "Read row ids of checkpoint file " << path << " failed.";
+      return false;
+    }
+    snapshot->row_ids[i] = row_id;
+  }
+  size_t rows = snapshot->incremental ? id_num : row_count;
+  uint32_t crc = 0;
+  snapshot->tensors.resize(tensor_num);
+  for (auto &tensor : snapshot->tensors) {
+    tensor.resize(rows * row_size);
+    char *data = reinterpret_cast<char *>(tensor.data());
+    size_t size = tensor.size() * sizeof(float);
+    ifs.read(data, size);
+    crc = system::Crc32c::MakeCrc32c(crc, data, size);
+  }
+  uint32_t expect_crc = 0;
+  if (!ReadValue(&ifs, &expect_crc) || crc != expect_crc) {
+    MS_LOG(ERROR) << "Checkpoint file " << path << " is truncated or corrupted.";
+    return false;
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_SHARD_CHECKPOINT_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_SHARD_CHECKPOINT_H_
+
+#include <cstdint>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// Server side snapshot of one weight shard. Its key is a ::ps::Key, spelled as uint64_t so that the checkpoint does not
+// depend on ps-lite. tensors[0] holds the weight rows, the following entries hold the optimizer state rows (e.g. m/v of
+// Adam, accum/linear of Ftrl) in the order returned by OptimizerInfo::states().
+// An incremental snapshot only holds the rows listed in row_ids, a full one holds all row_count rows.
+struct ShardSnapshot {
+  uint64_t key{0};
+  bool incremental{false};
+  size_t row_count{0};
+  size_t row_size{0};
+  std::vector<size_t> row_ids;
+  std::vector<std::vector<float>> tensors;
+
+  // Apply a later snapshot of the same key on top of this full snapshot. A full snapshot replaces this one, a delta
+  // must match its row size and tensor count.
+  void Merge(const ShardSnapshot &delta);
+};
+using ShardSnapshotPtr = std::shared_ptr<ShardSnapshot>;
+
+// Number of rows of a sparse weight shard holding shard_size elements. Only the first dimension of var_shape is split
+// between the servers, so the row size is the same whether or not the optimizer kernel sharded var_shape in place.
+// Returns 1, i.e. the shard is saved as a single row, if var_shape does not describe the shard.
+size_t CountShardRows(const std::vector<size_t> &var_shape, size_t shard_size);
+
+// Marks the rows in ids dirty. Ids out of the range of dirty are rows of other shards and are skipped.
+void MarkRowsDirty(const int *ids, size_t id_num, std::vector<bool> *dirty);
+
+// Copies the weight and optimizer state shards in sources into a snapshot of row_count rows. The snapshot is a delta of
+// the rows set in dirty if it is given, a full one otherwise.
+template <typename T>
+ShardSnapshotPtr MakeShardSnapshot(uint64_t key, size_t row_count, size_t shard_size,
+                                   const std::vector<const T *> &sources, const std::vector<bool> *dirty) {
+  ShardSnapshotPtr snapshot = std::make_shared<ShardSnapshot>();
+  snapshot->key = key;
+  snapshot->row_count = row_count;
+  snapshot->row_size = shard_size / row_count;
+  snapshot->incremental = dirty != nullptr && dirty->size() == row_count;
+  if (snapshot->incremental) {
+    for (size_t row = 0; row < dirty->size(); row++) {
+      if ((*dirty)[row]) {
+        snapshot->row_ids.push_back(row);
+      }
+    }
+  }
+  size_t row_size = snapshot->row_size;
+  for (const T *src : sources) {
+    std::vector<float> tensor;
+    if (snapshot->incremental) {
+      tensor.resize(snapshot->row_ids.size() * row_size);
+      for (size_t i = 0; i < snapshot->row_ids.size(); i++) {
+        const T *row = src + snapshot->row_ids[i] * row_size;
+        std::copy(row, row + row_size, tensor.begin() + i * row_size);
+      }
+    } else {
+      tensor.assign(src, src + shard_size);
+    }
+    snapshot->tensors.push_back(std::move(tensor));
+  }
+  return snapshot;
+}
+
+// Persists the shards owned by one parameter server. Layout on disk:
+//   <dir>/server_<rank>/manifest             one "<version> full|delta" line per committed checkpoint
+//   <dir>/server_<rank>/<version>/<key>.ckpt one file per weight key, written in parallel
+// A checkpoint version is only visible after its manifest line is committed, so a crash during saving leaves the
+// previous checkpoint intact. Restoring replays the newest full checkpoint followed by all later deltas.
+class ShardCheckpoint {
+ public:
+  ShardCheckpoint(const std::string &dir, size_t rank_id);
+  ~ShardCheckpoint() = default;
+
+  bool Save(const std::vector<ShardSnapshotPtr> &snapshots, bool incremental);
+  bool Load(std::unordered_map<uint64_t, ShardSnapshotPtr> *shards);
+  bool HasCheckpoint() const;
+
+ private:
+  struct ManifestEntry {
+    size_t version;
+    bool incremental;
+  };
+  bool ReadManifest(std::vector<ManifestEntry> *entries) const;
+  bool CommitManifest(const ManifestEntry &entry);
+  bool WriteShard(const std::string &path, const ShardSnapshot &snapshot) const;
+  bool ReadShard(const std::string &path, ShardSnapshot *snapshot) const;
+  std::string VersionDir(size_t version) const;
+
+  std::string root_dir_;
+  size_t next_version_{0};
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_SHARD_CHECKPOINT_H_
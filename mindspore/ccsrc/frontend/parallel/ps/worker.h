@@ -53,6 +53,8 @@ class Worker {
   void InitPSParamAndOptim(const std::string &param_name, tensor::TensorPtr tensor);
   void DoPSEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
                            const ::ps::SArray<int> &lens, ::ps::SArray<T> *lookup_result, int cmd);
+  void SaveServerCheckpoint(bool incremental);
+  void LoadServerCheckpoint();
   void Finalize();
 
  private:
@@ -134,6 +136,23 @@ void Worker<T>::DoPSEmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const :
   kv_worker_->EmbeddingLookup(keys, lookup_ids, lens, lookup_result, cmd);
 }
 
+// Ask every server to snapshot its shards to MS_PS_CKPT_PATH. Only one worker is supposed to trigger it.
+template <typename T>
+void Worker<T>::SaveServerCheckpoint(bool incremental) {
+  ::ps::SArray<::ps::Key> keys = {0};
+  ::ps::SArray<T> vals = {static_cast<T>(incremental ? 1 : 0)};
+  ::ps::SArray<int> lens = {1};
+  kv_worker_->PushData(keys, vals, lens, kSaveCheckpointCmd);
+}
+
+template <typename T>
+void Worker<T>::LoadServerCheckpoint() {
+  ::ps::SArray<::ps::Key> keys = {0};
+  ::ps::SArray<T> vals = {static_cast<T>(0)};
+  ::ps::SArray<int> lens = {1};
+  kv_worker_->PushData(keys, vals, lens, kLoadCheckpointCmd);
+}
+
 template <typename T>
 void Worker<T>::Finalize() {
   if (running_) {
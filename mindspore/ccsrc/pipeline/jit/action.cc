@@ -22,6 +22,8 @@
 #include <string>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "ir/func_graph_cloner.h"
 #include "ir/param_value.h"
@@ -37,6 +39,7 @@
 #include "utils/ms_context.h"
 #include "pipeline/jit/remove_value_node_dup.h"
 #include "frontend/optimizer/optimizer.h"
+#include "frontend/optimizer/graph_structure.h"
 #include "vm/transform.h"
 #include "parse/python_adapter.h"
 #include "frontend/optimizer/py_pass_manager.h"
@@ -136,17 +139,147 @@ bool ParseAction(const ResourcePtr &res) {
   return true;
 }
 
+namespace {
+// Combining analyzes the nodes of the shared graph once instead of once per graph, and costs every graph a call which
+// takes the shared graph, the parameters and the holes, plus the call node itself. Small graphs used by only a few
+// cells are cheaper to analyze again.
+bool IsWorthCombining(const std::vector<opt::GraphStructurePtr> &structures) {
+  auto &first = structures.front();
+  size_t call_size = first->func_graph()->parameters().size() + first->holes().size() + 2;
+  return (structures.size() - 1) * first->size() > structures.size() * call_size;
+}
+
+// Copies the nodes computing a parameter obj node of a used graph into the graph calling the combined graph.
+AnfNodePtr CopyParameterObjNode(const AnfNodePtr &node, const FuncGraphPtr &owner, const FuncGraphPtr &func_graph,
+                                std::unordered_map<AnfNodePtr, AnfNodePtr> *const copied) {
+  if (!node->isa<CNode>() || node->func_graph() != owner) {
+    return node;
+  }
+  auto iter = copied->find(node);
+  if (iter != copied->end()) {
+    return iter->second;
+  }
+  std::vector<AnfNodePtr> inputs;
+  for (auto &input : node->cast<CNodePtr>()->inputs()) {
+    inputs.push_back(CopyParameterObjNode(input, owner, func_graph, copied));
+  }
+  TraceManager::DebugTrace(std::make_shared<TraceCombileLikeGraphs>(node->debug_info()));
+  auto new_node = func_graph->NewCNode(inputs);
+  TraceManager::EndTrace();
+  (*copied)[node] = new_node;
+  return new_node;
+}
+
+// Shares one graph between the graphs with the same structure, the weights they read become arguments of it:
+// graph1(x){xx(fv1),xxx(fv2)}, graph2(x){xx(fv3),xxx(fv4)} ->
+// graph1(x){base_graph(x, fv1, fv2)}, graph2(x){base_graph(x, fv3, fv4)}, base_graph(x, fv...){xx,xxx}
+void CombineSameStructureGraphs(const FuncGraphManagerPtr &manager,
+                                const std::vector<opt::GraphStructurePtr> &structures) {
+  auto &first = structures.front();
+  auto fg = first->func_graph();
+  ClonerPtr cloner = std::make_shared<Cloner>(FuncGraphPtrList{fg}, false, false, true, std::make_shared<TraceCopy>(),
+                                              std::make_shared<TraceCombileLikeGraphs>());
+  cloner->Run();
+  auto base_graph = cloner->cloned_func_graph()[fg];
+  auto &node_users = manager->node_users();
+  for (auto &hole : first->holes()) {
+    TraceManager::DebugTrace(std::make_shared<TraceCombileLikeGraphs>(hole->debug_info()));
+    auto param = base_graph->add_parameter();
+    TraceManager::EndTrace();
+    for (auto &user : node_users[hole]) {
+      auto iter = cloner->cloned_node()->find(user.first);
+      if (iter != cloner->cloned_node()->end()) {
+        iter->second->cast<CNodePtr>()->set_input(user.second, param);
+      }
+    }
+  }
+  for (auto &structure : structures) {
+    auto g = structure->func_graph();
+    std::vector<AnfNodePtr> new_node_inputs = {NewValueNode(base_graph)};
+    (void)new_node_inputs.insert(new_node_inputs.end(), g->parameters().begin(), g->parameters().end());
+    std::unordered_map<AnfNodePtr, AnfNodePtr> copied;
+    for (auto &hole : structure->holes()) {
+      auto owner = hole->func_graph();
+      new_node_inputs.push_back(owner == g ? hole : CopyParameterObjNode(hole, owner, g, &copied));
+    }
+    g->set_output(g->NewCNode(new_node_inputs));
+  }
+  MS_LOG(INFO) << "Combine " << structures.size() << " graphs with the same structure as " << fg->ToString()
+               << " into " << base_graph->ToString() << ", size " << first->size() << ".";
+}
+
+// Cells which are not registered with their init args, or which hold other cells, are not in the obj_map. Their
+// graphs are grouped by structure instead, the outermost graphs are combined first.
+void CombineStructurallyLikeGraphs(const ResourcePtr &res, const std::unordered_set<FuncGraphPtr> &combined) {
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode == parallel::AUTO_PARALLEL || parallel_mode == parallel::SEMI_AUTO_PARALLEL) {
+    // The strategies are searched and saved per primitive instance.
+    return;
+  }
+  auto manager = res->manager();
+  auto top_graph = res->func_graph();
+  std::vector<std::vector<opt::GraphStructurePtr>> groups;
+  std::unordered_map<std::size_t, std::vector<size_t>> buckets;
+  for (auto &fg : manager->func_graphs()) {
+    if (fg == top_graph || combined.count(fg) != 0 || fg->has_vararg() || fg->has_kwarg() ||
+        fg->kwonlyargs_count() != 0 || fg->hyper_param_count() != 0) {
+      continue;
+    }
+    auto structure = std::make_shared<opt::GraphStructure>(fg);
+    auto &graphs = structure->graphs();
+    if (!structure->valid() || std::find(graphs.begin(), graphs.end(), top_graph) != graphs.end()) {
+      continue;
+    }
+    auto &bucket = buckets[structure->hash()];
+    auto iter = std::find_if(bucket.begin(), bucket.end(), [&groups, &structure](size_t index) {
+      return groups[index].front()->IsSameStructure(*structure);
+    });
+    if (iter != bucket.end()) {
+      groups[*iter].push_back(structure);
+    } else {
+      bucket.push_back(groups.size());
+      groups.push_back({structure});
+    }
+  }
+  // A graph using the graphs of another group is larger, so it is combined first and the inner groups are dropped.
+  std::stable_sort(groups.begin(), groups.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.front()->size() > rhs.front()->size();
+  });
+  std::unordered_set<FuncGraphPtr> used;
+  for (auto &group : groups) {
+    std::vector<opt::GraphStructurePtr> structures;
+    std::copy_if(group.begin(), group.end(), std::back_inserter(structures),
+                 [&used](const opt::GraphStructurePtr &structure) {
+                   auto &graphs = structure->graphs();
+                   return std::none_of(graphs.begin(), graphs.end(),
+                                       [&used](const FuncGraphPtr &fg) { return used.count(fg) != 0; });
+                 });
+    if (structures.size() <= 1 || !IsWorthCombining(structures)) {
+      continue;
+    }
+    CombineSameStructureGraphs(manager, structures);
+    for (auto &structure : structures) {
+      used.insert(structure->graphs().begin(), structure->graphs().end());
+    }
+  }
+}
+}  // namespace
+
 // obj_map's graphs have the same construct, these graphs can be optimized to one graph.
 // This step do this optimize: graph1(x){xx(fv1),xxx(fv2)}, graph2(x){xxx(fv3),xxx(fv4)}->
 // graph1(x){base_graph(x, fv1, fv2)}, graph1(x){base_graph(x, fv3, fv4)}, base_graph(x, fv...){xxx,xxx}
 // all obj_map's graph shared base_graph
 bool CombineLikeGraphs(const ResourcePtr &res) {
   auto &obj_map = parse::data_converter::GetObjGraphs();
+  std::unordered_set<FuncGraphPtr> combined;
 
   for (auto it : obj_map) {
     auto &graphs = it.second;
     MS_LOG(DEBUG) << "Start combine like graph:" << it.first << ", size:" << graphs.size();
     auto fg = graphs[0];
+    if (fg->paramter_obj_nodes().size() == 0 || graphs.size() <= 1) {
+      continue;
+    }
     FuncGraphPtrList func_graphs = {fg};
     ClonerPtr cloner = std::make_shared<Cloner>(func_graphs, false, false, true, std::make_shared<TraceCopy>(),
                                                 std::make_shared<TraceCombileLikeGraphs>());
@@ -154,9 +287,6 @@ bool CombineLikeGraphs(const ResourcePtr &res) {
     auto base_graph = cloner->cloned_func_graph()[fg];
     MS_LOG(DEBUG) << "Basegraph:" << base_graph->ToString();
 
-    if (fg->paramter_obj_nodes().size() == 0 || graphs.size() <= 1) {
-      continue;
-    }
     for (auto &fv : fg->paramter_obj_nodes()) {
       TraceManager::DebugTrace(std::make_shared<TraceCombileLikeGraphs>(fv->debug_info()));
       auto param = base_graph->add_parameter();
@@ -180,10 +310,12 @@ bool CombineLikeGraphs(const ResourcePtr &res) {
       (void)new_node_inputs.insert(new_node_inputs.end(), fvs.begin(), fvs.end());
       AnfNodePtr out = g->NewCNode(new_node_inputs);
       g->set_output(out);
+      (void)combined.insert(g);
       MS_LOG(DEBUG) << "Combine graph newout:" << out->DebugString(4);
     }
     MS_LOG(DEBUG) << "End combine graph:" << it.first;
   }
+  CombineStructurallyLikeGraphs(res, combined);
   return true;
 }
 
@@ -32,6 +32,8 @@ struct ExecutorInfo {
   FuncGraphPtr func_graph;
   ResourcePtr resource;
   std::size_t arg_list_size;
+  // json summary of the compile profile, empty if the profile is disabled
+  std::string compile_profile;
 };
 using ExecutorInfoPtr = std::shared_ptr<ExecutorInfo>;
 
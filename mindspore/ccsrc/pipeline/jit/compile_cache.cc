@@ -0,0 +1,479 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include "proto/onnx.pb.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "debug/anf_ir_utils.h"
+#include "frontend/operator/ops.h"
+#include "frontend/optimizer/py_pass_manager.h"
+#include "frontend/parallel/context.h"
+#include "pipeline/jit/base.h"
+#include "pipeline/jit/parse/python_adapter.h"
+#include "utils/flags.h"
+#include "utils/ms_context.h"
+#include "utils/system/env.h"
+#include "utils/load_onnx/anf_model_parser.h"
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+#include "frontend/parallel/ps/util.h"
+#endif
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr char kCompileCachePathEnv[] = "MS_COMPILE_CACHE_PATH";
+// Bump it when the key or the file layout changes, so old entries are never read.
+constexpr char kCompileCacheVersion[] = "2";
+constexpr char kCacheKeyProp[] = "compile_cache_key";
+constexpr char kDefaultParamProp[] = "default_param";
+constexpr char kGraphFlagPropPrefix[] = "graph_flag:";
+constexpr char kUtilsModule[] = "mindspore._extends.utils";
+constexpr char kCalSha256Func[] = "cal_sha256_of_data";
+
+// The digest names the cache file and stands for the constant tensors in the key, it must not change across processes.
+std::string Sha256(const std::string &data) {
+  py::object ret = parse::python_adapter::CallPyFn(kUtilsModule, kCalSha256Func, py::bytes(data));
+  return py::cast<std::string>(ret);
+}
+
+// Writes the graphs reachable from the root in a stable textual form. Nodes are numbered in topological order, so two
+// processes building the same network get the same text whatever the node addresses are.
+class GraphKeyWriter {
+ public:
+  explicit GraphKeyWriter(std::ostringstream *buf) : buf_(buf) {}
+  ~GraphKeyWriter() = default;
+
+  void Write(const FuncGraphPtr &root) {
+    MS_EXCEPTION_IF_NULL(root);
+    (void)GraphId(root);
+    WriteFlags(root);
+    auto nodes = TopoSort(root->get_return(), SuccDeeperSimple, AlwaysInclude);
+    for (auto &node : nodes) {
+      MS_EXCEPTION_IF_NULL(node);
+      node_ids_[node] = node_ids_.size();
+      if (node->isa<CNode>()) {
+        auto cnode = node->cast<CNodePtr>();
+        *buf_ << "C" << GraphId(cnode->func_graph());
+        for (auto &input : cnode->inputs()) {
+          *buf_ << " " << NodeId(input);
+        }
+      } else if (node->isa<Parameter>()) {
+        WriteParameter(node->cast<ParameterPtr>());
+      } else if (node->isa<ValueNode>()) {
+        *buf_ << "V";
+        WriteValue(GetValueNode(node));
+      }
+      *buf_ << "\n";
+    }
+  }
+
+ private:
+  size_t GraphId(const FuncGraphPtr &graph) {
+    auto iter = graph_ids_.find(graph);
+    if (iter != graph_ids_.end()) {
+      return iter->second;
+    }
+    size_t id = graph_ids_.size();
+    graph_ids_[graph] = id;
+    return id;
+  }
+
+  size_t NodeId(const AnfNodePtr &node) const {
+    auto iter = node_ids_.find(node);
+    if (iter == node_ids_.end()) {
+      MS_LOG(EXCEPTION) << "Node " << node->DebugString() << " is used before it is visited.";
+    }
+    return iter->second;
+  }
+
+  void WriteFlags(const FuncGraphPtr &graph) {
+    std::vector<std::string> flags;
+    for (auto &attr : graph->attrs()) {
+      if (attr.second != nullptr) {
+        flags.push_back(attr.first + "=" + attr.second->ToString());
+      }
+    }
+    std::sort(flags.begin(), flags.end());
+    for (auto &flag : flags) {
+      *buf_ << "F " << flag << "\n";
+    }
+  }
+
+  void WriteParameter(const ParameterPtr &param) {
+    MS_EXCEPTION_IF_NULL(param);
+    *buf_ << "P" << GraphId(param->func_graph()) << " " << param->name();
+    if (!param->has_default()) {
+      return;
+    }
+    // The weight values do not change the compiled graph, but their types and shapes do.
+    auto tensor = std::dynamic_pointer_cast<tensor::Tensor>(param->default_param());
+    if (tensor != nullptr) {
+      *buf_ << " " << TypeIdLabel(tensor->data_type()) << ShapeText(tensor->shape());
+    } else {
+      *buf_ << " " << param->default_param()->ToString();
+    }
+  }
+
+  void WriteValue(const ValuePtr &value) {
+    MS_EXCEPTION_IF_NULL(value);
+    if (value->isa<FuncGraph>()) {
+      *buf_ << "G" << GraphId(value->cast<FuncGraphPtr>());
+    } else if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      *buf_ << "O" << prim->name() << prim->GetAttrsText();
+    } else if (value->isa<tensor::Tensor>()) {
+      auto tensor = value->cast<tensor::TensorPtr>();
+      std::string data(static_cast<const char *>(tensor->data_c()), tensor->data().nbytes());
+      *buf_ << "T" << TypeIdLabel(tensor->data_type()) << ShapeText(tensor->shape()) << Sha256(data);
+    } else {
+      *buf_ << value->type_name() << ":" << value->ToString();
+    }
+  }
+
+  static std::string ShapeText(const std::vector<int> &shape) {
+    std::ostringstream oss;
+    oss << "(";
+    for (auto dim : shape) {
+      oss << dim << ",";
+    }
+    oss << ")";
+    return oss.str();
+  }
+
+  std::ostringstream *buf_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_ids_;
+  std::unordered_map<AnfNodePtr, size_t> node_ids_;
+};
+
+std::string GetMindSporeVersion() {
+  try {
+    return py::cast<std::string>(parse::python_adapter::GetPyFn("mindspore.version", "__version__"));
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Get MindSpore version failed: " << e.what();
+  }
+  return "unknown";
+}
+
+bool CreateDirIfNotExist(const std::string &dir) {
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  MS_EXCEPTION_IF_NULL(fs);
+  if (fs->FileExist(dir)) {
+    return true;
+  }
+  return fs->CreateDir(dir);
+}
+
+// The cached graph is handed to the backend as it is, so only graphs the MINDIR format keeps whole are stored.
+bool CanSerialize(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (!graph->func_graphs_used_total().empty()) {
+    MS_LOG(INFO) << "Graph " << graph->ToString() << " calls other graphs.";
+    return false;
+  }
+  if (graph->has_flag(GRAPH_FLAG_HAS_EFFECT)) {
+    MS_LOG(INFO) << "Graph " << graph->ToString() << " has side effects.";
+    return false;
+  }
+  for (auto &node : TopoSort(graph->get_return())) {
+    auto prim = GetCNodePrimitive(node);
+    if (prim == nullptr) {
+      continue;
+    }
+    // These primitives call back into python objects which can not be stored.
+    if (prim->prim_type() == kPrimTypeUserCustom || prim->HasPyInferTensor() ||
+        prim->name() == prim::kPrimHookBackward->name() || prim->name() == prim::kPrimBpropCut->name()) {
+      MS_LOG(INFO) << "Graph " << graph->ToString() << " uses primitive " << prim->name() << ".";
+      return false;
+    }
+  }
+  return true;
+}
+
+void AddMetadata(onnx::ModelProto *model, const std::string &key, const std::string &value) {
+  auto entry = model->add_metadata_props();
+  entry->set_key(key);
+  entry->set_value(value);
+}
+
+// Build the graph from the model and check that every node got back its abstract.
+FuncGraphPtr ParseGraph(const onnx::ModelProto &model) {
+  lite::MSANFModelParser parser;
+  auto graph = parser.Parse(model);
+  if (graph == nullptr || static_cast<int>(graph->parameters().size()) != model.graph().input_size()) {
+    return nullptr;
+  }
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (node->isa<CNode>() && node != graph->get_return() && node->abstract() == nullptr) {
+      MS_LOG(INFO) << "Node " << node->DebugString() << " has no abstract after reading back.";
+      return nullptr;
+    }
+  }
+  return graph;
+}
+}  // namespace
+
+std::string CompileCache::GetCachePath(const std::string &phase, bool use_vm) {
+  const char *path = getenv(kCompileCachePathEnv);
+  if (path == nullptr || std::string(path).empty()) {
+    return "";
+  }
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  if (!use_vm || context->backend_policy() == "ge" || GetPhasePrefix(phase).rfind("export", 0) == 0) {
+    MS_LOG(INFO) << "Compile cache is only used by the vm pipeline, phase " << phase << ".";
+    return "";
+  }
+  // A graph loaded from MS_IR_FILE replaces the parsed one, it is not what the key describes.
+  if (getenv("MS_IR_FILE") != nullptr) {
+    MS_LOG(INFO) << "Compile cache is disabled when MS_IR_FILE is set.";
+    return "";
+  }
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  auto parallel_mode = parallel_context->parallel_mode();
+  if (parallel_mode == parallel::AUTO_PARALLEL || parallel_mode == parallel::SEMI_AUTO_PARALLEL) {
+    MS_LOG(INFO) << "Compile cache does not keep the strategies of " << parallel_mode << ".";
+    return "";
+  }
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (parallel::ps::Util::IsParamServerMode()) {
+    MS_LOG(INFO) << "Compile cache is disabled in parameter server mode.";
+    return "";
+  }
+#endif
+  auto ppm = opt::python_pass::PyPassManager::GetInstance();
+  if (!ppm->GetPassGroup(opt::python_pass::Phase::OPT)->empty()) {
+    MS_LOG(INFO) << "Compile cache is disabled when python passes are registered.";
+    return "";
+  }
+  if (!CreateDirIfNotExist(path)) {
+    MS_LOG(WARNING) << "Create compile cache directory " << path << " failed.";
+    return "";
+  }
+  return path;
+}
+
+std::vector<ActionItem> CompileCache::WrapActions(const CompileCachePtr &cache,
+                                                  const std::vector<ActionItem> &actions) {
+  MS_EXCEPTION_IF_NULL(cache);
+  auto begin = std::find_if(actions.begin(), actions.end(),
+                            [](const ActionItem &item) { return item.first == "abstract_specialize"; });
+  auto end =
+    std::find_if(begin, actions.end(), [](const ActionItem &item) { return item.first == "validate"; });
+  if (end == actions.end()) {
+    return actions;
+  }
+  std::vector<ActionItem> wrapped(actions.begin(), begin);
+  wrapped.emplace_back("load_compile_cache", [cache](const ResourcePtr &res) {
+    (void)cache->Load(res);
+    return true;
+  });
+  for (auto iter = begin; iter != end + 1; ++iter) {
+    auto action = iter->second;
+    wrapped.emplace_back(iter->first, [cache, action](const ResourcePtr &res) { return cache->hit() || action(res); });
+  }
+  wrapped.emplace_back("save_compile_cache", [cache](const ResourcePtr &res) {
+    if (!cache->hit()) {
+      (void)cache->Save(res);
+    }
+    return true;
+  });
+  wrapped.insert(wrapped.end(), end + 1, actions.end());
+  return wrapped;
+}
+
+std::string CompileCache::GenerateKey(const ResourcePtr &res) const {
+  MS_EXCEPTION_IF_NULL(res);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  std::ostringstream buf;
+  buf << "version " << kCompileCacheVersion << " " << GetMindSporeVersion() << "\n";
+  buf << "phase " << GetPhasePrefix(phase_) << "\n";
+  buf << "context " << context->device_target() << " " << context->execution_mode() << " "
+      << context->enable_task_sink() << context->enable_graph_kernel() << context->enable_sparse()
+      << context->enable_reduce_precision() << "\n";
+  buf << "parallel " << parallel_context->parallel_mode() << " " << parallel_context->device_num() << " "
+      << parallel_context->global_rank() << "\n";
+  for (auto &arg : res->args_spec()) {
+    MS_EXCEPTION_IF_NULL(arg);
+    buf << "arg " << arg->ToString() << "\n";
+  }
+  GraphKeyWriter(&buf).Write(res->func_graph());
+  return buf.str();
+}
+
+bool CompileCache::Load(const ResourcePtr &res) {
+  MS_EXCEPTION_IF_NULL(res);
+  try {
+    key_text_ = GenerateKey(res);
+    key_ = Sha256(key_text_);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Generate compile cache key failed, compile without cache: " << e.what();
+    return false;
+  }
+  std::ifstream ifs(CacheFile(), std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "Compile cache miss, key " << key_ << ".";
+    return false;
+  }
+  onnx::ModelProto model;
+  if (!model.ParseFromIstream(&ifs)) {
+    MS_LOG(WARNING) << "Parse compile cache " << CacheFile() << " failed.";
+    return false;
+  }
+  std::unordered_set<std::string> default_params;
+  std::vector<std::pair<std::string, bool>> flags;
+  bool key_matched = false;
+  for (auto &prop : model.metadata_props()) {
+    if (prop.key() == kCacheKeyProp) {
+      // The file name is only a digest of the key, the whole key is compared so a collision is never taken for a hit.
+      key_matched = prop.value() == key_text_;
+    } else if (prop.key() == kDefaultParamProp) {
+      (void)default_params.insert(prop.value());
+    } else if (prop.key().rfind(kGraphFlagPropPrefix, 0) == 0) {
+      flags.emplace_back(prop.key().substr(strlen(kGraphFlagPropPrefix)), prop.value() == "1");
+    }
+  }
+  if (!key_matched) {
+    MS_LOG(WARNING) << "Compile cache " << CacheFile() << " was saved for another graph.";
+    return false;
+  }
+  auto graph = ParseGraph(model);
+  if (graph == nullptr) {
+    MS_LOG(WARNING) << "Compile cache " << CacheFile() << " is not usable.";
+    return false;
+  }
+
+  std::unordered_map<std::string, ParameterPtr> weights;
+  for (auto &node : res->func_graph()->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      weights[param->name()] = param;
+    }
+  }
+  size_t input_num = 0;
+  auto &params = graph->parameters();
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto param = params[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    const auto &input = model.graph().input(static_cast<int>(i));
+    param->set_name(input.doc_string());
+    if (default_params.count(input.name()) == 0) {
+      ++input_num;
+      continue;
+    }
+    auto iter = weights.find(input.doc_string());
+    if (iter == weights.end()) {
+      MS_LOG(WARNING) << "Weight " << input.doc_string() << " of compile cache is not in the network.";
+      return false;
+    }
+    param->set_default_param(iter->second->default_param());
+  }
+  if (input_num != res->args_spec().size()) {
+    MS_LOG(WARNING) << "Compile cache has " << input_num << " inputs, but " << res->args_spec().size()
+                    << " are given.";
+    return false;
+  }
+  for (auto &flag : flags) {
+    graph->set_flag(flag.first, flag.second);
+  }
+  auto manager = res->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->KeepRoots({graph});
+  res->set_func_graph(graph);
+  hit_ = true;
+  MS_LOG(INFO) << "Compile cache hit, load graph from " << CacheFile() << ".";
+  return true;
+}
+
+bool CompileCache::Save(const ResourcePtr &res) {
+  MS_EXCEPTION_IF_NULL(res);
+  auto graph = res->func_graph();
+  if (key_.empty() || graph == nullptr || !CanSerialize(graph)) {
+    MS_LOG(INFO) << "Skip saving compile cache for phase " << phase_ << ".";
+    return false;
+  }
+  onnx::ModelProto model;
+  try {
+    if (!model.ParseFromString(GetBinaryProtoString(graph))) {
+      MS_LOG(INFO) << "Export graph " << graph->ToString() << " for compile cache failed.";
+      return false;
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Export graph " << graph->ToString() << " for compile cache failed: " << e.what();
+    return false;
+  }
+  // Weights are bound to the live parameters on load, keeping them in the cache only costs disk and time.
+  auto graph_proto = model.mutable_graph();
+  graph_proto->clear_initializer();
+  auto &params = graph->parameters();
+  if (static_cast<int>(params.size()) != graph_proto->input_size()) {
+    return false;
+  }
+  for (size_t i = 0; i < params.size(); ++i) {
+    auto param = params[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    auto input = graph_proto->mutable_input(static_cast<int>(i));
+    input->set_doc_string(param->name());
+    if (param->has_default()) {
+      AddMetadata(&model, kDefaultParamProp, input->name());
+    }
+  }
+  for (auto &attr : graph->attrs()) {
+    if (attr.second != nullptr && attr.second->isa<BoolImm>()) {
+      AddMetadata(&model, kGraphFlagPropPrefix + attr.first, GetValue<bool>(attr.second) ? "1" : "0");
+    }
+  }
+  AddMetadata(&model, kCacheKeyProp, key_text_);
+  if (ParseGraph(model) == nullptr) {
+    MS_LOG(INFO) << "Graph " << graph->ToString() << " can not be read back, skip saving compile cache.";
+    return false;
+  }
+
+  // Jobs sharing the cache directory may save the same key at once, rename keeps the file whole for readers.
+  std::string file = CacheFile();
+  std::string tmp_file = file + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream ofs(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open() || !model.SerializeToOstream(&ofs)) {
+      MS_LOG(WARNING) << "Write compile cache " << tmp_file << " failed.";
+      (void)remove(tmp_file.c_str());
+      return false;
+    }
+  }
+  if (rename(tmp_file.c_str(), file.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename " << tmp_file << " to " << file << " failed.";
+    (void)remove(tmp_file.c_str());
+    return false;
+  }
+  MS_LOG(INFO) << "Save compile cache " << file << ".";
+  return true;
+}
+}  // namespace pipeline
+}  // namespace mindspore
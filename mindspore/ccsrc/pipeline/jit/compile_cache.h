@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "pipeline/jit/action.h"
+#include "pipeline/jit/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+// Keeps the graphs produced by the frontend passes on disk, so a restarted job with the same network and inputs does
+// not run the analysis and optimization actions again. It is enabled by setting MS_COMPILE_CACHE_PATH to a directory.
+//
+// The key is computed on the resolved graph right before abstract_specialize and covers the IR, the argument
+// abstracts, the context flags which change the frontend passes and the MindSpore version. On a hit the actions up to
+// validate are skipped and the graph read back from the cache goes on to task_emit. Weights are not stored, the
+// parameters of the cached graph are bound to the live ones by name. Any failure falls back to a normal compile.
+class CompileCache {
+ public:
+  CompileCache(const std::string &cache_path, const std::string &phase) : cache_path_(cache_path), phase_(phase) {}
+  ~CompileCache() = default;
+
+  // Returns the cache directory, or an empty string if graphs compiled for the phase can not be cached.
+  static std::string GetCachePath(const std::string &phase, bool use_vm);
+  // Adds the load and save actions around the frontend passes.
+  static std::vector<ActionItem> WrapActions(const std::shared_ptr<CompileCache> &cache,
+                                             const std::vector<ActionItem> &actions);
+
+  bool Load(const ResourcePtr &res);
+  bool Save(const ResourcePtr &res);
+  bool hit() const { return hit_; }
+
+ private:
+  // Returns the text the cache entry is looked up by, the file is named by its digest and keeps the whole text.
+  std::string GenerateKey(const ResourcePtr &res) const;
+  std::string CacheFile() const { return cache_path_ + "/" + key_ + ".mindir"; }
+
+  std::string cache_path_;
+  std::string phase_;
+  std::string key_text_;
+  std::string key_;
+  bool hit_{false};
+};
+using CompileCachePtr = std::shared_ptr<CompileCache>;
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
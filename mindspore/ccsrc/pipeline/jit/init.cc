@@ -22,6 +22,7 @@
 #include "frontend/operator/composite/composite.h"
 #include "ir/signature.h"
 #include "pipeline/pynative/pynative_execute.h"
+#include "pipeline/pynative/op_dispatch_queue.h"
 #include "utils/symbolic.h"
 #include "pybind_api/api_register.h"
 #include "pipeline/jit/parse/python_adapter.h"
@@ -66,6 +67,8 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("get_func_graph", &ExecutorPy::GetFuncGraph, py::arg("phase") = py::str(""), "Get graph pointer.")
     .def("get_func_graph_proto", &ExecutorPy::GetFuncGraphProto, py::arg("phase") = py::str(""),
          py::arg("type") = py::str("onnx_ir"), "Get graph proto string by specifying ir type.")
+    .def("get_compile_profile", &ExecutorPy::GetCompileProfile, py::arg("phase") = py::str(""),
+         "Get the compile profile of the graph as a json string.")
     .def("compile", &ExecutorPy::Compile, py::arg("obj"), py::arg("args"), py::arg("phase") = py::str(""),
          py::arg("use_vm") = py::bool_(false), "Compile obj by executor.")
     .def("updata_param_node_default_input", &ExecutorPy::UpdataParamNodeDefaultInput, py::arg("phase"),
@@ -96,6 +99,10 @@ PYBIND11_MODULE(_c_expression, m) {
               py::arg("phase") = py::str("dataset"), py::arg("need_run") = py::bool_(true), "Init and exec dataset.");
   (void)m.def("_set_dataset_mode_config", &mindspore::ConfigManager::SetDatasetModeConfig, "API for set dataset mode.");
   (void)m.def("init_backend", &mindspore::pipeline::InitBackend, "Init Backend.");
+  (void)m.def("save_ps_checkpoint", &mindspore::pipeline::SaveServerCheckpoint, py::arg("incremental") = false,
+              "Save the parameter server checkpoint.");
+  (void)m.def("load_ps_checkpoint", &mindspore::pipeline::LoadServerCheckpoint,
+              "Load the parameter server checkpoint.");
 
   (void)m.def("export_graph", &mindspore::pipeline::ExportGraph, "Export Graph.");
 
@@ -143,7 +150,15 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the GraphKernel switch to on or off.")
     .def("get_enable_graph_kernel", &mindspore::MsContext::enable_graph_kernel, "Get the value of GraphKernel switch.")
     .def("get_enable_sparse", &mindspore::MsContext::enable_sparse, "Get whether to enable sparsity.")
-    .def("set_enable_sparse", &mindspore::MsContext::set_enable_sparse, "Set whether to enable sparsity.");
+    .def("set_enable_sparse", &mindspore::MsContext::set_enable_sparse, "Set whether to enable sparsity.")
+    .def("get_enable_pynative_async", &mindspore::MsContext::enable_pynative_async,
+         "Get whether to run pynative ops asynchronously.")
+    .def("set_enable_pynative_async", &mindspore::MsContext::set_enable_pynative_async,
+         "Set whether to run pynative ops asynchronously.")
+    .def("get_enable_compile_profile", &mindspore::MsContext::enable_compile_profile,
+         "Get whether to profile the graph compilation.")
+    .def("set_enable_compile_profile", &mindspore::MsContext::set_enable_compile_profile,
+         "Set whether to profile the graph compilation.");
 
   (void)py::class_<mindspore::MpiConfig, std::shared_ptr<mindspore::MpiConfig>>(m, "MpiConfig")
     .def_static("get_instance", &mindspore::MpiConfig::GetInstance, "Get mpi config instance.")
@@ -287,6 +302,8 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("reset_algo_parameters", &CostModelContext::ResetAlgoParameters, "Reset the AlgoParameters.");
 
   (void)py::module::import("atexit").attr("register")(py::cpp_function{[&]() -> void {
+    // The backend thread of pynative ops must finish the ops left and be joined before the interpreter goes away.
+    mindspore::pynative::OpDispatchQueue::GetInstance().Stop();
     // only in case that c++ calling python interface, ClearResAtexit should be called.
     if (mindspore::parse::python_adapter::IsPythonEnv()) {
       mindspore::pipeline::ClearResAtexit();
@@ -26,10 +26,12 @@
 
 #include "ir/param_value.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
 #include "debug/anf_ir_utils.h"
+#include "utils/compile_profiler.h"
 #include "utils/config_manager.h"
 #include "utils/convert_utils.h"
 #include "utils/context/context_extends.h"
@@ -233,6 +235,13 @@ py::bytes ExecutorPy::GetFuncGraphProto(const std::string &phase, const std::str
   MS_LOG(EXCEPTION) << "Unknown ir type: " << ir_type;
 }
 
+py::str ExecutorPy::GetCompileProfile(const std::string &phase) {
+  if (info_.count(phase) == 0) {
+    MS_LOG(EXCEPTION) << "No phase in executor:" << GetPhasePrefix(phase);
+  }
+  return info_[phase]->compile_profile;
+}
+
 py::dict ExecutorPy::GetParameterLayout(const std::string &phase) {
   MS_LOG(DEBUG) << "GetParameterLayout!";
   std::string layout_graph = phase + kStepParallelGraph;
@@ -450,6 +459,10 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   ResourcePtr resource = std::make_shared<Resource>(obj);
 
   auto p_actions = GetPipline(resource, phase_s, use_vm);
+  std::string cache_path = CompileCache::GetCachePath(phase_s, use_vm);
+  if (!cache_path.empty()) {
+    p_actions = CompileCache::WrapActions(std::make_shared<CompileCache>(cache_path, phase_s), p_actions);
+  }
   std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
 
   // get the parameters items and add the value to args_spec
@@ -469,7 +482,14 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   executor_info->arg_list_size = size;
   executor_info->resource = resource;
   info_[phase_s] = executor_info;
+  auto &profiler = CompileProfiler::GetInstance();
+  profiler.Begin(phase_s, MsContext::GetInstance()->enable_compile_profile());
   pip->Run();
+  if (profiler.enabled()) {
+    executor_info->compile_profile = profiler.Summary();
+    (void)profiler.SaveChromeTrace(GetFilePathName("compile_profile_" + phase_s + ".json"));
+    profiler.End();
+  }
 
   // save the run graph func to MsPipeLine
   SaveCompiledGraph(phase_s);
@@ -503,6 +523,7 @@ void ExecutorPy::ReleaseResource(const py::object &phase) {
   if (res != nullptr) {
     res->Clean();
   }
+  CompileProfiler::GetInstance().End();
   // Reclaim all resource used by optimizer;
   ReclaimOptimizer();
 }
@@ -514,6 +535,8 @@ static std::string PrintArgs(const py::tuple &args) {
 
 bool ExecutorPy::Compile(const py::object &obj, const py::tuple &args, const py::object &phase, bool use_vm) {
   bool ret_value = false;
+  // Compiling reads the values of the args and the context flags the pynative ops still running may depend on.
+  pynative::WaitAsyncOps();
 
   try {
     MS_LOG(DEBUG) << PrintArgs(args);
@@ -625,6 +648,10 @@ void Pipeline::Run() {
 #endif
       bool result = true;
       WITH(MsProfile::GetProfile()->Step(action.first))[&result, &action, this]() {
+        CompileProfileScope action_scope(action.first, "action", [this]() -> int64_t {
+          auto manager = resource_->manager();
+          return manager == nullptr ? -1 : static_cast<int64_t>(manager->all_nodes().size());
+        });
         MS_LOG(DEBUG) << "Action " << action.first << " start ...";
 #ifdef ENABLE_LOAD_ANF_IR
         RunPipelineAction(action, resource_, &result);
@@ -739,6 +766,8 @@ py::object ExecutorPy::Run(const py::tuple &args, const py::object &phase) {
     MS_LOG(EXCEPTION) << "Run failed, phase input is not a str";
   }
   auto phase_s = py::cast<std::string>(phase);
+  // The inputs may be outputs of pynative ops which are still running.
+  pynative::WaitAsyncOps();
   std::string backend = MsContext::GetInstance()->backend_policy();
 #ifdef ENABLE_GE
   if (backend == "ge") {
@@ -969,6 +998,28 @@ void FinalizeBackend() {
   (void)context::CloseTsd(context_ptr);
 }
 
+void SaveServerCheckpoint(bool incremental) {
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (parallel::ps::Util::IsParamServerMode() && parallel::ps::Util::IsRoleOfWorker()) {
+    parallel::ps::Worker<float>::GetInstance().SaveServerCheckpoint(incremental);
+    return;
+  }
+#endif
+  MS_LOG(EXCEPTION) << "Saving the parameter server checkpoint is only supported on a worker in parameter server "
+                       "mode.";
+}
+
+void LoadServerCheckpoint() {
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (parallel::ps::Util::IsParamServerMode() && parallel::ps::Util::IsRoleOfWorker()) {
+    parallel::ps::Worker<float>::GetInstance().LoadServerCheckpoint();
+    return;
+  }
+#endif
+  MS_LOG(EXCEPTION) << "Loading the parameter server checkpoint is only supported on a worker in parameter server "
+                       "mode.";
+}
+
 void ClearResAtexit() {
   MS_LOG(DEBUG) << "Pipeline clear all resource";
   pynative::ClearPyNativeSession();
@@ -82,6 +82,7 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   ResourcePtr GetResource(const std::string &phase);
   FuncGraphPtr GetFuncGraph(const std::string &phase);
   py::bytes GetFuncGraphProto(const std::string &phase, const std::string &type);
+  py::str GetCompileProfile(const std::string &phase);
   std::size_t ArgListSize(const std::string &phase);
   compile::VmEvalFuncPtr GetVmEvalFunc(const std::string &phase);
   bool HasCompiled(const std::string &phase) const;
@@ -125,6 +126,9 @@ void InitHccl();
 void FinalizeHccl();
 void InitBackend();
 void FinalizeBackend();
+// Ask the parameter servers to save or restore their shards, only available on a worker in parameter server mode.
+void SaveServerCheckpoint(bool incremental);
+void LoadServerCheckpoint();
 
 void ClearResAtexit();
 void ReleaseGeTsd();
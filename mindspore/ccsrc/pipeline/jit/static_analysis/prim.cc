@@ -548,7 +548,7 @@ AbstractBasePtr PyInferRes2Abstract(const PrimitivePyPtr &prim_py, const py::dic
 }
 }  // end anonymous namespace
 
-EvalResultPtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &, const AbstractBasePtrList &args) {
+EvalResultPtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &engine, const AbstractBasePtrList &args) {
   auto ret_abstract = AbstractEval(args);
   if (ret_abstract != nullptr) {
     MS_LOG(DEBUG) << "PythonPrimEvaluator eval Undetermined";
@@ -560,6 +560,29 @@ EvalResultPtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &, const Abs
   if (iter != cache_->end()) {
     return iter->second;
   }
+  // Custom primitives share their name and class, only the other python primitives are looked up across instances.
+  // The python infer may also read members which are not attributes, the instances share a result only when those
+  // members are equal too.
+  bool use_shared_cache = engine != nullptr && !prim_py_->IsCustomPrim();
+  std::string shared_cache_key;
+  AttrValueMap attrs_before_infer;
+  if (use_shared_cache) {
+    shared_cache_key = prim_py_->name() + "@" + std::string(py::str(prim_py_->GetPyObj().get_type())) + ":";
+    use_shared_cache = prim_py_->GetInstanceState(&shared_cache_key);
+  }
+  if (use_shared_cache) {
+    attrs_before_infer = prim_py_->attrs();
+    auto shared_result = engine->prim_eval_cache().Get(shared_cache_key, attrs_before_infer, args);
+    if (shared_result != nullptr) {
+      MS_LOG(DEBUG) << "Reuse the infer result of another instance of " << prim_py_->ToString() << ".";
+      // Keep the instance in the same state as if its own infer had run.
+      for (auto &attr : *shared_result->attribute()) {
+        (void)prim_py_->AddAttr(attr.first, attr.second);
+      }
+      (*cache_)[args] = shared_result;
+      return shared_result;
+    }
+  }
   auto py_args = PreparePyInputs(prim_py_, args);
   prim_py_->BeginRecordAddAttr();
   py::dict output = prim_py_->RunInfer(py_args);
@@ -571,6 +594,9 @@ EvalResultPtr PythonPrimEvaluator::EvalPrim(const AnalysisEnginePtr &, const Abs
   MS_LOG(DEBUG) << "Python InferTensor result spec: " << res_spec->ToString() << ".";
   auto infer_result = std::make_shared<EvalResult>(res_spec, std::make_shared<AttrValueMap>(added_attrs));
   (*cache_)[args] = infer_result;
+  if (use_shared_cache) {
+    engine->prim_eval_cache().Put(shared_cache_key, attrs_before_infer, args, infer_result);
+  }
   return infer_result;
 }
 
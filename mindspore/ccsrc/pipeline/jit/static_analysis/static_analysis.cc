@@ -275,6 +275,57 @@ EvalResultPtr AnalysisEngine::Execute(const AbstractFunctionPtr &func, const Abs
   return ExecuteEvaluators(infs, nullptr, args_conf_list);
 }
 
+namespace {
+bool IsSameAttrs(const AttrValueMap &lhs, const AttrValueMap &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (auto &item : lhs) {
+    auto iter = rhs.find(item.first);
+    if (iter == rhs.end()) {
+      return false;
+    }
+    if (item.second == iter->second) {
+      continue;
+    }
+    if (item.second == nullptr || iter->second == nullptr || !(*item.second == *iter->second)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+EvalResultPtr PrimitiveEvalCache::Get(const std::string &key, const AttrValueMap &attrs,
+                                      const AbstractBasePtrList &args) const {
+  auto prim_iter = cache_.find(key);
+  if (prim_iter == cache_.end()) {
+    return nullptr;
+  }
+  auto args_iter = prim_iter->second.find(args);
+  if (args_iter == prim_iter->second.end()) {
+    return nullptr;
+  }
+  for (auto &entry : args_iter->second) {
+    if (IsSameAttrs(entry.attrs, attrs)) {
+      return entry.result;
+    }
+  }
+  return nullptr;
+}
+
+void PrimitiveEvalCache::Put(const std::string &key, const AttrValueMap &attrs, const AbstractBasePtrList &args,
+                             const EvalResultPtr &result) {
+  auto &entries = cache_[key][args];
+  for (auto &entry : entries) {
+    if (IsSameAttrs(entry.attrs, attrs)) {
+      entry.result = result;
+      return;
+    }
+  }
+  entries.push_back(Entry{attrs, result});
+}
+
 void AnalysisEngine::ClearEvaluatorCache() {
   for (std::pair<AbstractFunctionPtr, EvaluatorPtr> element : constructors_) {
     EvaluatorPtr evaluator = element.second;
@@ -294,6 +345,7 @@ void AnalysisEngine::ClearEvaluatorCache() {
     MS_EXCEPTION_IF_NULL(evaluator->cache());
     evaluator->cache()->clear();
   }
+  prim_eval_cache_.Clear();
 }
 
 void AnalysisEngine::Clear() {
@@ -174,6 +174,29 @@ struct AnalysisResult {
 
 using EvalTraceRevIter = std::list<std::pair<EvaluatorPtr, AbstractBasePtrList>>::reverse_iterator;
 
+// Results of python primitive inference shared by all the instances of a primitive. Every cell owns its primitive
+// instances, so a network built from repeated cells would otherwise call the same python infer once per layer. An
+// entry is only reused by an instance with the same python class, attributes and plain python members, the attributes
+// added by the infer are kept in the result and applied to the node in specialize.
+class PrimitiveEvalCache {
+ public:
+  PrimitiveEvalCache() = default;
+  ~PrimitiveEvalCache() = default;
+  void Clear() { cache_.clear(); }
+  EvalResultPtr Get(const std::string &key, const AttrValueMap &attrs, const AbstractBasePtrList &args) const;
+  void Put(const std::string &key, const AttrValueMap &attrs, const AbstractBasePtrList &args,
+           const EvalResultPtr &result);
+
+ private:
+  struct Entry {
+    AttrValueMap attrs;
+    EvalResultPtr result;
+  };
+  using ArgsCache =
+    std::unordered_map<AbstractBasePtrList, std::vector<Entry>, AbstractBasePtrListHasher, AbstractBasePtrListEqual>;
+  std::unordered_map<std::string, ArgsCache> cache_;
+};
+
 class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
  public:
   AnalysisEngine(const PrimEvaluatorMap &prim_evaluator_map, const FuncGraphManagerPtr &func_graph_manager)
@@ -194,6 +217,7 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
   void Clear();
   void ClearEvaluatorCache();
   AnalysisCache &cache() { return cache_; }
+  PrimitiveEvalCache &prim_eval_cache() { return prim_eval_cache_; }
   AnfNodeConfigPtr MakeConfig(const AnfNodePtr &node, const AnalysisContextPtr &context) {
     return std::make_shared<AnfNodeConfig>(shared_from_this(), node, context);
   }
@@ -237,6 +261,7 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
   // Use a list to trace multiple evaluators.
   std::list<std::pair<EvaluatorPtr, AbstractBasePtrList>> eval_trace_;
   std::map<EvaluatorPtr, EvaluatorPtr> multi_poss_;
+  PrimitiveEvalCache prim_eval_cache_;
 
   AnalysisContextPtr Run(const FuncGraphPtr &func_graph, const AnalysisContextPtr &context,
                          const ConfigPtrList &args_conf_list);
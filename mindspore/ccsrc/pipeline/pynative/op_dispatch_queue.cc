@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/pynative/op_dispatch_queue.h"
+
+#include <utility>
+
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace pynative {
+OpDispatchQueue &OpDispatchQueue::GetInstance() {
+  static OpDispatchQueue instance;
+  return instance;
+}
+
+OpDispatchQueue::~OpDispatchQueue() { Stop(); }
+
+void OpDispatchQueue::Push(const std::string &op_name, const std::function<void()> &task,
+                           const tensor::WaitEventPtr &event) {
+  MS_EXCEPTION_IF_NULL(event);
+  // Declared before the lock, so the finished tasks are released after unlocking.
+  std::vector<OpTask> finished_tasks;
+  std::string error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_tasks.swap(finished_tasks_);
+    error.swap(error_);
+    if (error.empty()) {
+      if (!worker_.joinable()) {
+        stop_ = false;
+        worker_ = std::thread(&OpDispatchQueue::WorkerLoop, this);
+      }
+      tasks_.push(OpTask{op_name, task, event});
+    }
+  }
+  if (!error.empty()) {
+    MS_LOG(EXCEPTION) << error;
+  }
+  task_cond_.notify_one();
+}
+
+void OpDispatchQueue::Wait() {
+  std::vector<OpTask> finished_tasks;
+  std::string error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cond_.wait(lock, [this] { return tasks_.empty() && !running_; });
+    finished_tasks.swap(finished_tasks_);
+    error.swap(error_);
+  }
+  if (!error.empty()) {
+    MS_LOG(EXCEPTION) << error;
+  }
+}
+
+void OpDispatchQueue::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_all();
+  // The worker runs the tasks left in the queue before it exits.
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  finished_tasks_.clear();
+  error_.clear();
+}
+
+void OpDispatchQueue::WorkerLoop() {
+  // The thread runs nothing but pynative ops, the python thread may turn the flag off for its own ops meanwhile.
+  MsContext::set_thread_pynative_infer(true);
+  while (true) {
+    OpTask task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+      running_ = true;
+    }
+    std::string error;
+    try {
+      task.run();
+    } catch (const std::exception &ex) {
+      error = "Run op[" + task.op_name + "] failed: " + ex.what();
+    } catch (...) {
+      error = "Run op[" + task.op_name + "] failed with an unknown exception.";
+    }
+    task.event->Done(error);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+      if (!error.empty()) {
+        MS_LOG(ERROR) << error;
+        if (error_.empty()) {
+          error_ = error;
+        }
+        // The ops pushed after the failed one may read its outputs, skip them all.
+        while (!tasks_.empty()) {
+          auto &skipped = tasks_.front();
+          skipped.event->Done("Skip op[" + skipped.op_name + "] since an earlier op failed. " + error);
+          finished_tasks_.push_back(std::move(skipped));
+          tasks_.pop();
+        }
+      }
+      finished_tasks_.push_back(std::move(task));
+    }
+    idle_cond_.notify_all();
+  }
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_PYNATIVE_OP_DISPATCH_QUEUE_H_
+#define MINDSPORE_CCSRC_PIPELINE_PYNATIVE_OP_DISPATCH_QUEUE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace pynative {
+// Runs the kernels of pynative ops on a backend thread in the order they are pushed, so python can go on with the
+// next ops while the previous ones run. The output tensors of a pushed op carry its wait event, reading them on the
+// host waits for the op.
+//
+// Tasks must not touch python objects. A finished task is kept until the python thread pushes or waits again, so
+// the python objects it captured are released with the GIL held.
+class OpDispatchQueue {
+ public:
+  static OpDispatchQueue &GetInstance();
+  ~OpDispatchQueue();
+
+  // Push the task of an op, the event is done when the task finishes. Raise the error of a failed op which has not
+  // been raised yet.
+  void Push(const std::string &op_name, const std::function<void()> &task, const tensor::WaitEventPtr &event);
+  // Wait until every pushed task finishes, raise the error of a failed op which has not been raised yet.
+  void Wait();
+  // Wait and stop the backend thread, it is started again by the next push.
+  void Stop();
+
+ private:
+  struct OpTask {
+    std::string op_name;
+    std::function<void()> run;
+    tensor::WaitEventPtr event;
+  };
+
+  OpDispatchQueue() = default;
+  void WorkerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable idle_cond_;
+  std::queue<OpTask> tasks_;
+  std::vector<OpTask> finished_tasks_;
+  bool running_{false};
+  bool stop_{false};
+  std::string error_;
+  std::thread worker_;
+};
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_PYNATIVE_OP_DISPATCH_QUEUE_H_
@@ -18,8 +18,10 @@
 
 #include <typeinfo>
 #include <map>
+#include <sstream>
 #include <set>
 #include <unordered_set>
+#include <list>
 #include <algorithm>
 
 #include "debug/trace.h"
@@ -42,6 +44,8 @@
 #include "pipeline/jit/action.h"
 
 #include "pipeline/pynative/base.h"
+#include "pipeline/pynative/op_dispatch_queue.h"
+#include "runtime/device/kernel_runtime_manager.h"
 #include "pybind_api/api_register.h"
 #include "vm/transform.h"
 
@@ -64,6 +68,7 @@ namespace mindspore {
 namespace pynative {
 
 static std::shared_ptr<session::SessionBasic> session = nullptr;
+const size_t kMaxSingleOpOutputInfoSize = 4096;
 PynativeExecutorPtr PynativeExecutor::executor_ = nullptr;
 std::mutex PynativeExecutor::instance_lock_;
 ResourcePtr PynativeExecutor::resource_;
@@ -142,6 +147,40 @@ static std::string GetId(const py::object &obj) {
   return py::cast<std::string>(ret);
 }
 
+// The dtypes and shapes of the tensor inputs and the values of the scalar inputs of a cell, a captured graph of the
+// cell is replayed only for inputs with the same signature.
+static void GetInputSignature(const py::object &obj, std::ostringstream *buf) {
+  if (py::isinstance<tensor::Tensor>(obj)) {
+    auto tensor_ptr = py::cast<tensor::TensorPtr>(obj);
+    *buf << "T" << tensor_ptr->data_type() << "[";
+    for (auto dim : tensor_ptr->shape()) {
+      *buf << dim << ",";
+    }
+    *buf << "]";
+  } else if (py::isinstance<py::tuple>(obj) || py::isinstance<py::list>(obj)) {
+    *buf << "(";
+    for (const auto &item : obj) {
+      GetInputSignature(py::reinterpret_borrow<py::object>(item), buf);
+      *buf << ",";
+    }
+    *buf << ")";
+  } else if (py::isinstance<py::bool_>(obj) || py::isinstance<py::int_>(obj) || py::isinstance<py::float_>(obj) ||
+             py::isinstance<py::str>(obj)) {
+    *buf << std::string(py::str(obj));
+  } else {
+    *buf << std::string(py::str(obj.get_type()));
+  }
+}
+
+static std::string GetInputSignature(const py::args &args) {
+  std::ostringstream buf;
+  for (size_t i = 0; i < args.size(); ++i) {
+    GetInputSignature(args[i], &buf);
+    buf << ";";
+  }
+  return buf.str();
+}
+
 static std::string GetOpId(const OpExecInfoPtr &op_exec_info) {
   auto id = GetId(op_exec_info->py_primitive->GetPyObj());
   op_exec_info->prim_id = id;
@@ -318,23 +357,32 @@ OpExecInfoPtr GenerateOpExecInfo(const py::args &args) {
 std::string GetSingleOpGraphInfo(const OpExecInfoPtr &op_exec_info,
                                  const std::vector<tensor::TensorPtr> &input_tensors) {
   MS_EXCEPTION_IF_NULL(op_exec_info);
+  const auto &op_prim = op_exec_info->py_primitive;
+  MS_EXCEPTION_IF_NULL(op_prim);
+  const auto &attr_key = op_prim->evaluate_added_attrs_key();
+  // The key is only used to look up the single op graph cache, so the shapes and dtypes are written as raw bytes
+  // instead of decimal text, and the text of the attrs is cached by the primitive.
   std::string graph_info;
-  // get input tensor info
+  size_t key_size = op_exec_info->prim_id.size() + attr_key.size() + 1;
   for (const auto &tensor : input_tensors) {
     MS_EXCEPTION_IF_NULL(tensor);
-    auto tensor_shape = tensor->shape();
-    (void)std::for_each(tensor_shape.begin(), tensor_shape.end(),
-                        [&](const auto &dim) { (void)graph_info.append(std::to_string(dim) + "_"); });
-    (void)graph_info.append(std::to_string(tensor->data_type()) + "_");
-  }
-  // get prim and abstract info
-  (void)graph_info.append(op_exec_info->prim_id + "_");
-  // get attr info
-  const auto &op_prim = op_exec_info->py_primitive;
-  MS_EXCEPTION_IF_NULL(op_prim);
-  const auto &attr_map = op_prim->evaluate_added_attrs();
-  (void)std::for_each(attr_map.begin(), attr_map.end(),
-                      [&](const auto &element) { (void)graph_info.append(element.second->ToString() + "_"); });
+    key_size += (tensor->shape().size() + 2) * sizeof(int);
+  }
+  graph_info.reserve(key_size);
+  auto append_int = [&graph_info](int value) {
+    (void)graph_info.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+  // get input tensor info
+  for (const auto &tensor : input_tensors) {
+    const auto &tensor_shape = tensor->shape();
+    append_int(SizeToInt(tensor_shape.size()));
+    (void)graph_info.append(reinterpret_cast<const char *>(tensor_shape.data()), tensor_shape.size() * sizeof(int));
+    append_int(static_cast<int>(tensor->data_type()));
+  }
+  // get prim and attr info
+  (void)graph_info.append(op_exec_info->prim_id);
+  graph_info.push_back('_');
+  (void)graph_info.append(attr_key);
   return graph_info;
 }
 
@@ -344,6 +392,8 @@ py::object RunOpInVM(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
   MS_EXCEPTION_IF_NULL(status);
   MS_EXCEPTION_IF_NULL(op_exec_info);
   MS_EXCEPTION_IF_NULL(op_exec_info->py_primitive);
+  // The vm reads the host data of the inputs.
+  WaitAsyncOps();
 
   auto &op_inputs = op_exec_info->op_inputs;
   if (op_exec_info->op_name == "HookBackward") {
@@ -530,6 +580,105 @@ void EraseValueNodeTensor(const std::vector<int> &tensors_mask, std::vector<tens
   *input_tensors = new_input_tensors;
 }
 
+// The dtypes and shapes of the outputs of single op graphs which ran synchronously once, the outputs of an op
+// dispatched asynchronously are created from them before its kernel runs. The least recently used entry is dropped
+// when the cache is full.
+using OutputInfoList = std::vector<std::pair<TypeId, std::vector<int>>>;
+using OutputInfoEntry = std::pair<std::string, OutputInfoList>;
+static std::list<OutputInfoEntry> single_op_output_info_list;
+static std::unordered_map<std::string, std::list<OutputInfoEntry>::iterator> single_op_output_infos;
+
+const OutputInfoList *FindSingleOpOutputInfo(const std::string &graph_info) {
+  auto iter = single_op_output_infos.find(graph_info);
+  if (iter == single_op_output_infos.end()) {
+    return nullptr;
+  }
+  single_op_output_info_list.splice(single_op_output_info_list.begin(), single_op_output_info_list, iter->second);
+  return &iter->second->second;
+}
+
+void SaveSingleOpOutputInfo(const std::string &graph_info, const VectorRef &outputs) {
+  OutputInfoList output_infos;
+  for (const auto &output : outputs) {
+    // Only the ops with a flat list of tensor outputs are dispatched asynchronously.
+    if (!utils::isa<tensor::TensorPtr>(output)) {
+      return;
+    }
+    auto tensor = utils::cast<tensor::TensorPtr>(output);
+    MS_EXCEPTION_IF_NULL(tensor);
+    output_infos.emplace_back(tensor->data_type(), tensor->shape());
+  }
+  auto cached = FindSingleOpOutputInfo(graph_info);
+  if (cached != nullptr) {
+    single_op_output_info_list.front().second = output_infos;
+    return;
+  }
+  if (single_op_output_infos.size() >= kMaxSingleOpOutputInfoSize) {
+    (void)single_op_output_infos.erase(single_op_output_info_list.back().first);
+    single_op_output_info_list.pop_back();
+  }
+  single_op_output_info_list.emplace_front(graph_info, output_infos);
+  single_op_output_infos[graph_info] = single_op_output_info_list.begin();
+}
+
+bool CanRunOpAsync(const OpExecInfoPtr &op_exec_info, const std::string &graph_info) {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (!ms_context->enable_pynative_async() || PynativeExecutor::GetInstance()->grad_flag()) {
+    return false;
+  }
+  // The forward value of an op in grad mode is kept by the frontend, the op must run right away.
+  if (op_exec_info->value != nullptr) {
+    return false;
+  }
+  // Building a graph touches the primitive and may call python, only the cached graphs can run on the backend thread.
+  return session->SingleOpGraphCached(graph_info) && FindSingleOpOutputInfo(graph_info) != nullptr;
+}
+
+py::object RunOpAsync(const OpExecInfoPtr &op_exec_info, const std::string &graph_info,
+                      const std::vector<tensor::TensorPtr> &input_tensors) {
+  auto event = std::make_shared<tensor::WaitEvent>();
+  auto cached = FindSingleOpOutputInfo(graph_info);
+  MS_EXCEPTION_IF_NULL(cached);
+  const auto output_infos = *cached;
+  std::vector<tensor::TensorPtr> outputs;
+  py::tuple result(output_infos.size());
+  for (size_t i = 0; i < output_infos.size(); ++i) {
+    auto output = std::make_shared<tensor::Tensor>(output_infos[i].first, output_infos[i].second);
+    output->set_wait_event(event);
+    outputs.push_back(output);
+    result[i] = output;
+  }
+  auto run_session = session;
+  auto task = [op_exec_info, graph_info, input_tensors, outputs, run_session]() {
+    static thread_local bool context_set = false;
+    auto ms_context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(ms_context);
+    if (!context_set) {
+      auto runtime = device::KernelRuntimeManager::Instance().GetKernelRuntime(ms_context->device_target(),
+                                                                               ms_context->device_id());
+      MS_EXCEPTION_IF_NULL(runtime);
+      runtime->SetContext();
+      context_set = true;
+    }
+    VectorRef run_outputs;
+    run_session->RunOp(*op_exec_info, graph_info, input_tensors, &run_outputs);
+    if (run_outputs.size() != outputs.size()) {
+      MS_LOG(EXCEPTION) << "The op has " << run_outputs.size() << " outputs, but " << outputs.size()
+                        << " outputs are returned to python.";
+    }
+    // The python thread may read the dtype and shape of the outputs now, only the device data is filled in.
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      auto run_output = utils::cast<tensor::TensorPtr>(run_outputs[i]);
+      MS_EXCEPTION_IF_NULL(run_output);
+      outputs[i]->set_device_address(run_output->device_address());
+      outputs[i]->set_dirty(run_output->is_dirty());
+    }
+  };
+  OpDispatchQueue::GetInstance().Push(op_exec_info->op_name, task, event);
+  return result;
+}
+
 py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *status) {
   MS_EXCEPTION_IF_NULL(op_exec_info);
   MS_LOG(INFO) << "Start run op[" << op_exec_info->op_name << "] with backend policy ms";
@@ -551,9 +700,33 @@ py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
   ConstructInputTensor(op_exec_info, &tensors_mask, &input_tensors);
   // get graph info for checking it whether existing in the cache
   std::string graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors);
+  PynativeExecutor::GetInstance()->CountSingleOpCache(session->SingleOpGraphCached(graph_info));
+  if (CanRunOpAsync(op_exec_info, graph_info)) {
+    EraseValueNodeTensor(tensors_mask, &input_tensors);
+    // The backend thread keeps enable_pynative_infer on for itself, it is only on for the python thread during a
+    // synchronous op.
+    auto result = RunOpAsync(op_exec_info, graph_info, input_tensors);
+    ms_context->set_enable_pynative_infer(false);
+    *status = PYNATIVE_SUCCESS;
+    MS_LOG(INFO) << "Dispatch op[" << op_exec_info->op_name << "] with backend policy ms";
+    return result;
+  }
+  OpDispatchQueue::GetInstance().Wait();
   session->BuildOp(*op_exec_info, graph_info, input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, &input_tensors);
-  py::tuple result = session->RunOp(*op_exec_info, graph_info, input_tensors);
+  VectorRef outputs;
+  {
+    py::gil_scoped_release gil_release;
+    session->RunOp(*op_exec_info, graph_info, input_tensors, &outputs);
+  }
+  SaveSingleOpOutputInfo(graph_info, outputs);
+  // trans output to tuple
+  auto output_tensors = session->TransformBaseRefListToTuple(outputs);
+  if (!utils::isa<PyObjectRef>(output_tensors) ||
+      !py::isinstance<py::tuple>(utils::cast<PyObjectRef>(output_tensors).object_)) {
+    MS_LOG(EXCEPTION) << "The output tensors should be a tuple !";
+  }
+  py::tuple result = py::cast<py::tuple>(utils::cast<PyObjectRef>(output_tensors).object_);
   ms_context->set_enable_pynative_infer(false);
   *status = PYNATIVE_SUCCESS;
   MS_LOG(INFO) << "End run op[" << op_exec_info->op_name << "] with backend policy ms";
@@ -604,6 +777,9 @@ ValuePtr PynativeExecutor::GetForwardValue(const OpExecInfoPtr &op_exec_info) {
   auto iter = op_forward_map_.find(op);
   if (iter != op_forward_map_.end()) {
     ++op_id_map_[id];
+    if (!top_cell_id_.empty()) {
+      top_capture_.forward_ops.push_back(op);
+    }
     MS_LOG(DEBUG) << "Get: " << op_exec_info->op_name << "(" << op << "), " << iter->second;
     return iter->second;
   }
@@ -693,11 +869,14 @@ void PynativeExecutor::SaveOpForwardValue(const OpExecInfoPtr &op_exec_info, con
   }
   op_forward_map_[op] = value;
   ++op_id_map_[id];
+  if (!top_cell_id_.empty()) {
+    top_capture_.forward_ops.push_back(op);
+  }
   MS_LOG(DEBUG) << "Save: " << op_exec_info->op_name << "(" << op << "), " << value;
 }
 
 void PynativeExecutor::SaveAllResult(const OpExecInfoPtr &op_exec_info, const CNodePtr &cnode, const py::tuple &out) {
-  if (!grad_flag_ || op_exec_info->value != nullptr) {
+  if (!grad_flag_) {
     return;
   }
   py::object out_real = out;
@@ -705,10 +884,13 @@ void PynativeExecutor::SaveAllResult(const OpExecInfoPtr &op_exec_info, const CN
     out_real = out[0];
   }
   auto value = PyAttrValue(out_real);
+  // The op is recorded with the value of this run, even if a value of the op was saved by a replayed capture.
   if (cnode != nullptr) {
     cnode->set_forward(value);
   }
-  SaveOpForwardValue(op_exec_info, value);
+  if (op_exec_info->value == nullptr) {
+    SaveOpForwardValue(op_exec_info, value);
+  }
 }
 
 AnfNodePtr PynativeExecutor::GetObjNode(const py::object &obj) {
@@ -779,6 +961,9 @@ py::tuple PynativeExecutor::RunOpInner(const py::args &args) {
   abstract::AbstractBasePtrList args_spec_list;
   std::vector<bool> op_masks;
   op_exec_info = GenerateOpExecInfo(args);
+  if (grad_flag_ && !top_cell_id_.empty()) {
+    top_capture_.op_trace.push_back(op_exec_info->prim_id);
+  }
   if (op_exec_info->op_name == prim::kPrimMixedPrecisionCast->name()) {
     return RunOpInner(op_exec_info);
   }
@@ -882,7 +1067,13 @@ py::tuple RunOp(const py::args &args) {
   }
 }
 
-void ClearPyNativeSession() { session = nullptr; }
+void WaitAsyncOps() { OpDispatchQueue::GetInstance().Wait(); }
+
+void ClearPyNativeSession() {
+  OpDispatchQueue::GetInstance().Stop();
+  single_op_output_infos.clear();
+  session = nullptr;
+}
 
 PynativeExecutor::~PynativeExecutor() { ClearRes(); }
 
@@ -890,12 +1081,17 @@ PynativeExecutor::PynativeExecutor() { grad_flag_ = false; }
 
 void PynativeExecutor::NewGraphInner(const py::object &cell, const py::args &args) {
   auto cell_id = GetId(cell);
-  if (cell_graph_map_.count(cell_id) != 0) {
-    if (cell_resource_map_.find(cell_id) != cell_resource_map_.end()) {
-      resource_ = cell_resource_map_[cell_id];
+  if (top_g_ == nullptr) {
+    auto input_signature = GetInputSignature(args);
+    auto iter = cell_capture_map_.find(cell_id);
+    if (iter != cell_capture_map_.end() && iter->second.input_signature != input_signature) {
+      MS_LOG(INFO) << "The inputs of cell " << cell_id << " changed, capture its graph again";
+      EraseCellCapture(cell_id);
+      iter = cell_capture_map_.end();
     }
-    MS_LOG(DEBUG) << "Newgraph already compiled";
-    return;
+    replaying_ = iter != cell_capture_map_.end();
+    top_cell_id_ = cell_id;
+    top_capture_ = CellCapture{input_signature, {}, {}};
   }
 
   auto g = std::make_shared<FuncGraph>();
@@ -903,7 +1099,9 @@ void PynativeExecutor::NewGraphInner(const py::object &cell, const py::args &arg
   if (top_g_ == nullptr) {
     top_g_ = curr_g_ = g;
     resource_ = std::make_shared<pipeline::Resource>();
-    cell_resource_map_[cell_id] = resource_;
+    if (!replaying_) {
+      cell_resource_map_[cell_id] = resource_;
+    }
     df_builder_ = std::make_shared<FuncGraph>();
     MS_LOG(DEBUG) << "First new graph" << top_g_.get();
     Pushp();
@@ -1015,12 +1213,18 @@ void PynativeExecutor::Popp() {
 }
 
 void PynativeExecutor::EndGraphInner(const py::object &cell, const py::object &out, const py::args &args) {
-  auto cell_id = GetId(cell);
-  if (cell_graph_map_.count(cell_id) != 0) {
-    MS_LOG(DEBUG) << "Endgraph already compiled";
+  if (curr_g_ == nullptr) {
+    MS_LOG(DEBUG) << "Endgraph without a graph";
     return;
   }
-  cell_graph_map_[cell_id] = curr_g_;
+  if (curr_g_ == top_g_) {
+    // The ops run after the top cell are not part of its graph.
+    auto cell_id = top_cell_id_;
+    top_cell_id_.clear();
+    if (replaying_ && EndReplay(cell_id)) {
+      return;
+    }
+  }
   auto out_id = GetId(out);
   if (!graph_info_map_[curr_g_].obj_node_map.count(out_id) && !graph_info_map_[curr_g_].param_map.count(out_id)) {
     // cell construct return x, y
@@ -1093,6 +1297,35 @@ void PynativeExecutor::EndGraphByOutId(const std::string &out_id, const py::obje
   }
 }
 
+bool PynativeExecutor::EndReplay(const std::string &cell_id) {
+  replaying_ = false;
+  if (top_capture_.op_trace == cell_capture_map_[cell_id].op_trace) {
+    MS_LOG(DEBUG) << "Endgraph replay the captured graph";
+    // The graph recorded in this run is dropped, the compiled one is run.
+    resource_ = cell_resource_map_[cell_id];
+    ad::CleanRes();
+    return true;
+  }
+  // Control flow of the cell took another branch, the graph recorded in this run is compiled instead.
+  MS_LOG(INFO) << "The ops run by cell " << cell_id << " differ from its captured graph, capture it again";
+  EraseCellCapture(cell_id);
+  cell_resource_map_[cell_id] = resource_;
+  return false;
+}
+
+void PynativeExecutor::EraseCellCapture(const std::string &cell_id) {
+  auto iter = cell_capture_map_.find(cell_id);
+  if (iter != cell_capture_map_.end()) {
+    // The forward values saved by the old capture do not match the new graph.
+    for (const auto &op : iter->second.forward_ops) {
+      (void)op_forward_map_.erase(op);
+    }
+    (void)cell_capture_map_.erase(iter);
+  }
+  (void)graph_map_.erase(cell_id);
+  (void)cell_resource_map_.erase(cell_id);
+}
+
 std::vector<AnfNodePtr> PynativeExecutor::GetWeightsArgs(const py::object &weights) {
   std::vector<AnfNodePtr> w_args;
   if (py::hasattr(weights, "__parameter_tuple__")) {
@@ -1200,6 +1433,7 @@ void PynativeExecutor::GradNetInner(const GradOperationPtr &grad, const py::obje
   resource_->results()[pipeline::kBackend] = compile::CreateBackend();
 
   graph_map_[cell_id] = g;
+  cell_capture_map_[cell_id] = top_capture_;
   PynativeOptimizeAction(resource_);
   TaskEmitAction(resource_);
   ExecuteAction(resource_);
@@ -1212,7 +1446,7 @@ void PynativeExecutor::Clear(const std::string &flag) {
   if (!flag.empty()) {
     MS_LOG(DEBUG) << "Clear res";
     (void)graph_map_.erase(flag);
-    (void)cell_graph_map_.erase(flag);
+    (void)cell_capture_map_.erase(flag);
     (void)cell_resource_map_.erase(flag);
     Clean();
     // Maybe exit in the pynative runing op, so need reset pynative flag.
@@ -1228,6 +1462,9 @@ void PynativeExecutor::Clear(const std::string &flag) {
   top_g_ = nullptr;
   df_builder_ = nullptr;
   curr_g_ = nullptr;
+  top_cell_id_.clear();
+  top_capture_ = CellCapture();
+  replaying_ = false;
   graph_info_map_.clear();
   op_id_map_.clear();
   // node_abs_map_.clear();
@@ -1249,6 +1486,7 @@ void PynativeExecutor::ClearRes() {
 }
 
 py::object PynativeExecutor::Run(const py::tuple &args, const py::object &phase) {
+  WaitAsyncOps();
   VectorRef arg_list;
   pipeline::ProcessVmArgInner(args, resource_, &arg_list);
   if (resource_->results().find(pipeline::kOutput) == resource_->results().end() ||
@@ -1311,7 +1549,11 @@ REGISTER_PYBIND_DEFINE(PynativeExecutor_, ([](const py::module *m) {
                            .def("__call__", &PynativeExecutor::Run, py::arg("args"), py::arg("phase") = py::str(""),
                                 "Executor run function.")
                            .def("set_grad_flag", &PynativeExecutor::set_grad_flag, py::arg("flag") = py::bool_(false),
-                                "Executor set grad flag.");
+                                "Executor set grad flag.")
+                           .def("single_op_cache_hits", &PynativeExecutor::single_op_cache_hits,
+                                "Number of ops run with a cached single op graph.")
+                           .def("single_op_cache_misses", &PynativeExecutor::single_op_cache_misses,
+                                "Number of ops which built their single op graph.");
                        }));
 }  // namespace pynative
 }  // namespace mindspore
@@ -56,6 +56,9 @@ py::tuple RunOp(const py::args &args);
 void ConvertInputs(const PrimitivePyPtr &prim, const py::list &py_args, py::tuple *const out_args,
                    py::list *const out_args_list);
 
+// Wait for the ops dispatched to the backend thread, it is needed before anything else runs on the device.
+void WaitAsyncOps();
+
 void ClearPyNativeSession();
 
 struct GraphInfo {
@@ -65,6 +68,14 @@ struct GraphInfo {
   std::vector<std::string> objects;
 };
 
+// The graph of a top cell captured under grad, replayed while its inputs and the ops it runs are unchanged.
+struct CellCapture {
+  std::string input_signature;
+  std::vector<std::string> op_trace;
+  // The keys of the forward values in op_forward_map_ saved or read by the ops of the cell.
+  std::vector<std::string> forward_ops;
+};
+
 class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
  public:
   static std::shared_ptr<PynativeExecutor> GetInstance() {
@@ -90,6 +101,10 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   void ClearRes();
   bool grad_flag() { return grad_flag_; }
   void set_grad_flag(bool flag) { grad_flag_ = flag; }
+  // how many ops found their single op graph in the cache, and how many had to build it
+  size_t single_op_cache_hits() const { return single_op_cache_hits_; }
+  size_t single_op_cache_misses() const { return single_op_cache_misses_; }
+  void CountSingleOpCache(bool hit) { hit ? ++single_op_cache_hits_ : ++single_op_cache_misses_; }
   AnfNodePtr GetInput(const py::object &obj, bool op_mask);
   AnfNodePtr GetObjNode(const py::object &obj);
   FuncGraphPtr curr_g() { return curr_g_; }
@@ -121,6 +136,8 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   AnfNodePtr MakeValueNode(const py::object &obj, const std::string &obj_id);
   py::tuple RunOpInner(const py::args &args);
   py::tuple RunOpInner(const OpExecInfoPtr &op_exec_info);
+  void EraseCellCapture(const std::string &cell_id);
+  bool EndReplay(const std::string &cell_id);
 
   ~PynativeExecutor();
 
@@ -131,7 +148,7 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   static ResourcePtr resource_;
   bool grad_flag_;
   std::unordered_map<std::string, FuncGraphPtr> graph_map_;
-  std::unordered_map<std::string, FuncGraphPtr> cell_graph_map_;
+  std::unordered_map<std::string, CellCapture> cell_capture_map_;
   std::unordered_map<std::string, ResourcePtr> cell_resource_map_;
   std::unordered_map<FuncGraphPtr, GraphInfo> graph_info_map_;
   std::unordered_map<std::string, ValuePtr> op_forward_map_;
@@ -141,6 +158,13 @@ class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
   FuncGraphPtr top_g_;
   FuncGraphPtr df_builder_;
   FuncGraphPtr curr_g_;
+  // The top cell being captured or replayed, it is cleared when the top cell ends. A replayed cell is recorded too,
+  // so its graph is compiled from the same run when it turns out to run other ops.
+  std::string top_cell_id_;
+  CellCapture top_capture_;
+  bool replaying_{false};
+  size_t single_op_cache_hits_{0};
+  size_t single_op_cache_misses_{0};
   std::unordered_map<std::string, AbstractListMap> prim_abs_list;
 };
 
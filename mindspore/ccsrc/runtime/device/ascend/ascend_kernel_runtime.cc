@@ -661,6 +661,16 @@ bool AscendKernelRuntime::InitDevice() {
   return true;
 }
 
+void AscendKernelRuntime::SetContext() {
+  if (rt_context_ == nullptr) {
+    return;
+  }
+  auto ret = rtCtxSetCurrent(rt_context_);
+  if (ret != RT_ERROR_NONE) {
+    MS_EXCEPTION(DeviceProcessError) << "Call rtCtxSetCurrent, ret[" << ret << "]";
+  }
+}
+
 bool AscendKernelRuntime::ResetDevice() {
   auto ret = rtCtxSetCurrent(rt_context_);
   if (ret != RT_ERROR_NONE) {
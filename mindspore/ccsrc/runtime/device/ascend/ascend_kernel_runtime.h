@@ -45,6 +45,7 @@ class AscendKernelRuntime : public KernelRuntime {
   bool LoadTask(const session::KernelGraph *graph) override;
   void ClearGraphRuntimeResource(uint32_t graph_id) override;
   bool SyncStream() override;
+  void SetContext() override;
 
  protected:
   DeviceAddressPtr CreateDeviceAddress(void *device_ptr, size_t device_size, const string &format,
@@ -13,41 +13,146 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+
 #include "runtime/device/convert_tensor_utils.h"
 #include <vector>
+#include "common/thread_pool.h"
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ENABLE_X86_HALF_CONVERT
+#endif
+
 namespace mindspore {
 namespace device {
-void HalfToFloat(void *dst, const void *src, size_t elem_num) {
-  auto half_data = static_cast<const Eigen::half *>(src);
-  auto float_data = static_cast<float *>(dst);
+namespace {
+// Elements converted by one task, smaller tensors are converted on the calling thread.
+constexpr size_t kMinConvertBlockSize = 32768;
+
+using HalfToFloatFunc = void (*)(float *, const Eigen::half *, size_t);
+using FloatToHalfFunc = void (*)(Eigen::half *, const float *, size_t);
+
+void HalfToFloatScalar(float *dst, const Eigen::half *src, size_t elem_num) {
   for (size_t i = 0; i < elem_num; ++i) {
-    float tmp = Eigen::half_impl::half_to_float(half_data[i]);
-    float_data[i] = tmp;
+    dst[i] = Eigen::half_impl::half_to_float(src[i]);
   }
 }
 
-void FloatToHalf(void *dst, const void *src, size_t elem_num) {
-  auto float_data = static_cast<const float *>(src);
-  auto half_data = static_cast<Eigen::half *>(dst);
+void FloatToHalfScalar(Eigen::half *dst, const float *src, size_t elem_num) {
   for (size_t i = 0; i < elem_num; ++i) {
-    half_data[i] = Eigen::half(float_data[i]);
+    dst[i] = Eigen::half(src[i]);
   }
 }
 
-void DoubleToFloat(void *dst, const void *src, size_t elem_num) {
-  auto double_data = static_cast<const double *>(src);
-  auto float_data = static_cast<float *>(dst);
-  for (size_t i = 0; i < elem_num; ++i) {
-    float_data[i] = static_cast<float>(double_data[i]);
+#ifdef ENABLE_X86_HALF_CONVERT
+// The hardware conversions round to nearest even like Eigen::half, so the results do not depend on the cpu. They are
+// compiled for their own target and only called after checking the cpu, the rest of the build keeps its flags.
+__attribute__((target("avx,f16c"))) void HalfToFloatF16c(float *dst, const Eigen::half *src, size_t elem_num) {
+  constexpr size_t kLanes = 8;
+  size_t i = 0;
+  for (; i + kLanes <= elem_num; i += kLanes) {
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
   }
+  HalfToFloatScalar(dst + i, src + i, elem_num - i);
 }
 
-void FloatToDouble(void *dst, const void *src, size_t elem_num) {
-  auto float_data = static_cast<const float *>(src);
-  auto double_data = static_cast<double *>(dst);
-  for (size_t i = 0; i < elem_num; ++i) {
-    double_data[i] = static_cast<double>(float_data[i]);
+__attribute__((target("avx,f16c"))) void FloatToHalfF16c(Eigen::half *dst, const float *src, size_t elem_num) {
+  constexpr size_t kLanes = 8;
+  size_t i = 0;
+  for (; i + kLanes <= elem_num; i += kLanes) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), half);
+  }
+  FloatToHalfScalar(dst + i, src + i, elem_num - i);
+}
+
+// The zero masked forms avoid reading an undefined pass through register.
+constexpr __mmask16 kAllLanes = 0xffff;
+
+__attribute__((target("avx512f"))) void HalfToFloatAvx512(float *dst, const Eigen::half *src, size_t elem_num) {
+  constexpr size_t kLanes = 16;
+  size_t i = 0;
+  for (; i + kLanes <= elem_num; i += kLanes) {
+    __m256i half = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm512_storeu_ps(dst + i, _mm512_maskz_cvtph_ps(kAllLanes, half));
+  }
+  HalfToFloatScalar(dst + i, src + i, elem_num - i);
+}
+
+__attribute__((target("avx512f"))) void FloatToHalfAvx512(Eigen::half *dst, const float *src, size_t elem_num) {
+  constexpr size_t kLanes = 16;
+  size_t i = 0;
+  for (; i + kLanes <= elem_num; i += kLanes) {
+    __m256i half = _mm512_maskz_cvtps_ph(kAllLanes, _mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), half);
+  }
+  FloatToHalfScalar(dst + i, src + i, elem_num - i);
+}
+#endif
+
+HalfToFloatFunc SelectHalfToFloat() {
+#ifdef ENABLE_X86_HALF_CONVERT
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return HalfToFloatAvx512;
   }
+  if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+    return HalfToFloatF16c;
+  }
+#endif
+  return HalfToFloatScalar;
+}
+
+FloatToHalfFunc SelectFloatToHalf() {
+#ifdef ENABLE_X86_HALF_CONVERT
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return FloatToHalfAvx512;
+  }
+  if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+    return FloatToHalfF16c;
+  }
+#endif
+  return FloatToHalfScalar;
+}
+
+template <typename DstT, typename SrcT, typename Func>
+void ParallelConvert(void *dst, const void *src, size_t elem_num, const Func &func) {
+  auto dst_data = static_cast<DstT *>(dst);
+  auto src_data = static_cast<const SrcT *>(src);
+  auto task = [dst_data, src_data, &func](size_t start, size_t end) {
+    func(dst_data + start, src_data + start, end - start);
+  };
+  if (!common::ThreadPool::GetInstance().ParallelFor(task, elem_num, kMinConvertBlockSize)) {
+    MS_LOG(EXCEPTION) << "Convert tensor data failed.";
+  }
+}
+}  // namespace
+
+void HalfToFloat(void *dst, const void *src, size_t elem_num) {
+  static const HalfToFloatFunc convert = SelectHalfToFloat();
+  ParallelConvert<float, Eigen::half>(dst, src, elem_num, convert);
+}
+
+void FloatToHalf(void *dst, const void *src, size_t elem_num) {
+  static const FloatToHalfFunc convert = SelectFloatToHalf();
+  ParallelConvert<Eigen::half, float>(dst, src, elem_num, convert);
+}
+
+void DoubleToFloat(void *dst, const void *src, size_t elem_num) {
+  ParallelConvert<float, double>(dst, src, elem_num, [](float *dst_data, const double *src_data, size_t num) {
+    for (size_t i = 0; i < num; ++i) {
+      dst_data[i] = static_cast<float>(src_data[i]);
+    }
+  });
+}
+
+void FloatToDouble(void *dst, const void *src, size_t elem_num) {
+  ParallelConvert<double, float>(dst, src, elem_num, [](double *dst_data, const float *src_data, size_t num) {
+    for (size_t i = 0; i < num; ++i) {
+      dst_data[i] = static_cast<double>(src_data[i]);
+    }
+  });
 }
 }  // namespace device
 }  // namespace mindspore
@@ -15,11 +15,24 @@
  */
 #include "runtime/device/cpu/cpu_device_address.h"
 #include <vector>
-#include "runtime/device/convert_tensor_utils.h"
+#include "common/trans.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+// Cast elem_num elements from src_type to dst_type, dst must hold elem_num elements of dst_type.
+bool CastData(const void *src, TypeId src_type, void *dst, TypeId dst_type, size_t elem_num) {
+  size_t src_type_size = trans::TypeIdSize(src_type);
+  if (src_type_size == 0) {
+    MS_LOG(ERROR) << "Invalid data type " << TypeIdLabel(src_type);
+    return false;
+  }
+  const trans::TypeIdArgs args{src, elem_num, src_type, dst_type, elem_num * src_type_size};
+  return trans::TransDataType(args, dst);
+}
+}  // namespace
+
 bool CPUDeviceAddress::SyncDeviceToHost(const std::vector<int> & /*shape*/, size_t size, TypeId type,
                                         void *host_ptr) const {
   if (ptr_ == nullptr) {
@@ -38,11 +51,8 @@ bool CPUDeviceAddress::SyncDeviceToHost(const std::vector<int> & /*shape*/, size
       MS_LOG(ERROR) << "Failed to copy tensor!";
       return false;
     }
-  } else if (type == kNumberTypeFloat16) {
-    FloatToHalf(host_ptr, ptr_, size / 2);
-  } else if (type == kNumberTypeFloat64) {
-    FloatToDouble(host_ptr, ptr_, size / sizeof(double));
-  } else {
+  } else if (trans::TypeIdSize(type) == 0 ||
+             !CastData(ptr_, type_id_, host_ptr, type, size / trans::TypeIdSize(type))) {
     MS_LOG(ERROR) << "Types not match. Device type: " << TypeIdLabel(type_id_) << ", host type: " << TypeIdLabel(type)
                   << "!";
     return false;
@@ -57,10 +67,17 @@ bool CPUDeviceAddress::SyncHostToDevice(const std::vector<int> & /*shape*/, size
     return true;
   }
 
-  if (type == kNumberTypeFloat16) {
-    HalfToFloat(ptr_, host_ptr, size / 2);
-  } else if (type == kNumberTypeFloat64) {
-    DoubleToFloat(ptr_, host_ptr, size / sizeof(double));
+  if (type == type_id_) {
+    auto ret_code = memcpy_s(ptr_, size_, host_ptr, size);
+    if (ret_code != EOK) {
+      MS_LOG(ERROR) << "Failed to copy tensor!";
+      return false;
+    }
+  } else if (trans::TypeIdSize(type) == 0 ||
+             !CastData(host_ptr, type, ptr_, type_id_, size / trans::TypeIdSize(type))) {
+    MS_LOG(ERROR) << "Types not match. Device type: " << TypeIdLabel(type_id_) << ", host type: " << TypeIdLabel(type)
+                  << "!";
+    return false;
   }
   return true;
 }
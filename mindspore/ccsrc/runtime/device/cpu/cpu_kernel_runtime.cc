@@ -45,7 +45,6 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  size_t type_size = sizeof(float);
   for (auto &item_node : kernel_graph->graph_value_nodes()) {
     MS_EXCEPTION_IF_NULL(item_node);
     if (item_node->isa<ValueNode>()) {
@@ -58,11 +57,17 @@ void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph
       }
       auto tensor = node_value->cast<TensorPtr>();
       MS_EXCEPTION_IF_NULL(tensor);
+      TypeId output_type_id = AnfAlgo::GetOutputDeviceDataType(item_node, 0);
+      if (output_type_id == kTypeUnknown) {
+        output_type_id = kNumberTypeFloat32;
+      }
+      size_t type_size = GetTypeByte(TypeIdToType(output_type_id));
       std::vector<int> data_shape = tensor->shape();
       size_t tensor_size = std::accumulate(data_shape.begin(), data_shape.end(), type_size, std::multiplies<size_t>());
-      DeviceAddressPtr address = CreateDeviceAddress(nullptr, tensor_size, kOpFormat_DEFAULT, kNumberTypeFloat32);
+      DeviceAddressPtr address = CreateDeviceAddress(nullptr, tensor_size, kOpFormat_DEFAULT, output_type_id);
       MS_EXCEPTION_IF_NULL(address);
-      if (tensor->data_type() == kNumberTypeFloat32 || tensor->data_type() == kNumberTypeInt32) {
+      // The host buffer is only shared when the kernels read it in its own dtype, otherwise it is cast.
+      if (tensor->data_type() == output_type_id) {
         address->ptr_ = tensor->data_c();
       } else {
         address->ptr_ = resource_manager_.MemMalloc(tensor_size);
@@ -79,13 +84,13 @@ void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph
 
 void CPUKernelRuntime::AssignInputNodeAddress(const session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
-  size_t type_size = sizeof(float);
   for (auto &item : kernel_graph->inputs()) {
     MS_EXCEPTION_IF_NULL(item);
     if (item->isa<Parameter>()) {
       auto output_num = AnfAlgo::GetOutputTensorNum(item);
       for (size_t index = 0; index < output_num; index++) {
         TypeId output_type_id = AnfAlgo::GetOutputDeviceDataType(item, index);
+        size_t type_size = GetTypeByte(TypeIdToType(output_type_id));
         std::vector<size_t> fmt_shape = AnfAlgo::GetOutputDeviceShape(item, index);
         size_t tensor_size =
           fmt_shape.empty() ? type_size
@@ -225,13 +230,13 @@ void CPUKernelRuntime::BindInputOutput(session::KernelGraph *kernel_graph, const
       if (tensor_address != nullptr && tensor_address != address) {
         (void)tensor->data_sync();
       }
-      if (tensor->data_type() == address->type_id_ || tensor->data_type() == kNumberTypeFloat32 ||
-          tensor->data_type() == kNumberTypeInt32) {
+      if (tensor->data_type() == address->type_id_) {
         address->ptr_ = tensor->data_c();
       } else {
         std::vector<int> data_shape = tensor->shape();
+        size_t type_size = GetTypeByte(TypeIdToType(address->type_id_));
         size_t tensor_size =
-          std::accumulate(data_shape.begin(), data_shape.end(), sizeof(float), std::multiplies<size_t>());
+          std::accumulate(data_shape.begin(), data_shape.end(), type_size, std::multiplies<size_t>());
         address->ptr_ = resource_manager_.MemMalloc(tensor_size);
         if (!address->SyncHostToDevice(data_shape, LongToSize(tensor->data().nbytes()), tensor->data_type(),
                                        tensor->data_c())) {
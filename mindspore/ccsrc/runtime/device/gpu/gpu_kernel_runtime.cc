@@ -44,6 +44,12 @@ using mindspore::device::memswap::SwapKind;
 static const size_t PARAMETER_OUTPUT_INDEX = 0;
 bool GPUKernelRuntime::SyncStream() { return GPUDeviceManager::GetInstance().SyncStream(stream_); }
 
+void GPUKernelRuntime::SetContext() {
+  if (!CudaDriver::set_current_device(UintToInt(device_id_))) {
+    MS_LOG(EXCEPTION) << "Failed to set current device to " << device_id_;
+  }
+}
+
 bool GPUKernelRuntime::Init() {
   if (device_init_ == true) {
     GPUMemoryAllocator::GetInstance().CheckMaxDeviceMemory();
@@ -39,6 +39,7 @@ class GPUKernelRuntime : public KernelRuntime {
   void ReleaseDeviceRes() override;
   void AssignMemory(session::KernelGraph *graph) override;
   bool Run(session::KernelGraph *graph, Debugger *debugger = nullptr) override;
+  void SetContext() override;
 #ifdef ENABLE_DUMP_E2E
   bool DumpData(session::KernelGraph *graph, Debugger *debugger = nullptr) override;
 #endif
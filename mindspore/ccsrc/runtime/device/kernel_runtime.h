@@ -71,6 +71,8 @@ class KernelRuntime {
   virtual void AssignStaticMemoryValueNode(session::KernelGraph *graph);
   virtual void ClearGraphRuntimeResource(uint32_t graph_id);
   virtual bool SyncStream() = 0;
+  // Make the device of this runtime current on the calling thread.
+  virtual void SetContext() {}
 
 #ifdef ENABLE_DUMP_E2E
   DumpConfPtr GetDumpConf();
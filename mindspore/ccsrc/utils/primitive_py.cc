@@ -16,6 +16,7 @@
 
 #include "utils/primitive_py.h"
 #include <mutex>
+#include <unordered_set>
 #include "ir/signature.h"
 #include "./common.h"
 #include "pipeline/jit/parse/python_adapter.h"
@@ -44,6 +45,23 @@ void SyncData(const py::object &arg) {
     (void)tensor->data_sync();
   }
 }
+
+// Only plain python values are compared by their text, any other value may hold state the text does not show.
+bool IsPlainPyValue(const py::handle &obj) {
+  if (obj.is_none() || py::isinstance<py::bool_>(obj) || py::isinstance<py::int_>(obj) ||
+      py::isinstance<py::float_>(obj) || py::isinstance<py::str>(obj)) {
+    return true;
+  }
+  if (py::isinstance<py::tuple>(obj) || py::isinstance<py::list>(obj)) {
+    for (auto item : obj) {
+      if (!IsPlainPyValue(item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
 }  // namespace
 std::map<std::string, py::object> PrimitivePy::hook_grad_;
 static ValuePtr PyArgToValue(const py::object &arg) {
@@ -157,6 +175,31 @@ py::dict PrimitivePy::GetAttrDict() {
   return attr_dict;
 }
 
+bool PrimitivePy::GetInstanceState(std::string *state) const {
+  MS_EXCEPTION_IF_NULL(state);
+  static const std::unordered_set<std::string> kPrimitiveMembers = {"name", "attrs", "init_attrs", "instance_name"};
+  if (!py::hasattr(python_obj_, "__dict__")) {
+    return true;
+  }
+  py::dict attrs = py::getattr(python_obj_, "attrs", py::dict());
+  std::map<std::string, std::string> members;
+  for (auto item : py::dict(python_obj_.attr("__dict__"))) {
+    auto name = py::cast<std::string>(item.first);
+    if (kPrimitiveMembers.count(name) != 0 || attrs.contains(item.first)) {
+      continue;
+    }
+    if (!IsPlainPyValue(item.second)) {
+      MS_LOG(DEBUG) << "Member " << name << " of " << ToString() << " is not a plain value.";
+      return false;
+    }
+    members[name] = std::string(py::repr(item.second));
+  }
+  for (auto &member : members) {
+    *state += member.first + "=" + member.second + ";";
+  }
+  return true;
+}
+
 void PrimitivePy::CopyHookFunction(const PrimitivePtr &primitive) {
   MS_EXCEPTION_IF_NULL(primitive);
   if (!primitive->isa<PrimitivePy>()) {
@@ -53,6 +53,9 @@ class PrimitivePy : public Primitive {
   void AddPyAttr(const py::str &name, const py::object &obj);
 
   py::dict GetAttrDict();
+  // Writes the python members of the instance which are not attributes, such as the is_ge and is_tbe flags some
+  // infers read. Returns false if a member is not a plain python value and can not be compared by its text.
+  bool GetInstanceState(std::string *state) const;
   void set_hook(const py::function &hook) { hook_ = hook; }
   py::function hook() const { return hook_; }
   BaseRef RunHookFunction(const VectorRef &args) const override;
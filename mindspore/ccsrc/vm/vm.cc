@@ -18,6 +18,7 @@
 
 #include "vm/vm.h"
 #include <algorithm>
+#include <iterator>
 #include "vm/vmimpl.h"
 #include "vm/backend.h"
 #include "pipeline/jit/parse/data_converter.h"
@@ -67,10 +68,84 @@ std::ostream &operator<<(std::ostream &os, const SwitchCondStatus &other) {
 //   sp_: stack pointer (for the value stack)
 FinalVM::FinalVM(const InstSet &insts, const BackendPtr &backend) : insts_(insts), pc_(0), sp_(0), backend_(backend) {
   MS_LOG(DEBUG) << "InstSet size:" << insts_.size();
+  LowerInsts();
   insts_stack_.emplace_back(BaseRef());
   retp_.push(-1);
 }
 
+void FinalVM::set_insts(const InstSet &value) {
+  insts_ = value;
+  LowerInsts();
+}
+
+namespace {
+// Decode args[begin:] into slots, fail if one of them is not an int.
+bool DecodeSlots(const VectorRef &args, size_t begin, std::vector<int> *slots) {
+  for (size_t i = begin; i < args.size(); ++i) {
+    if (!utils::isa<int>(args[i])) {
+      return false;
+    }
+    slots->push_back(utils::cast<int>(args[i]));
+  }
+  return true;
+}
+
+LoweredInst LowerInst(const InstType &inst) {
+  const auto &args = inst.second;
+  LoweredInst lowered{inst.first, false, {}, BaseRef()};
+  switch (inst.first) {
+    case Instruction::kCall:
+    case Instruction::kSwitchReturn:
+    case Instruction::kInput:
+    case Instruction::kPadStack:
+      lowered.decoded = args.size() == 1 && DecodeSlots(args, 0, &lowered.slots);
+      break;
+    case Instruction::kReturn:
+    case Instruction::kSwitchLayer:
+      lowered.decoded = args.size() == 2 && DecodeSlots(args, 0, &lowered.slots);
+      break;
+    case Instruction::kTailCall:
+    case Instruction::kSwitch:
+      lowered.decoded = args.size() == 3 && DecodeSlots(args, 0, &lowered.slots);
+      break;
+    case Instruction::kPartial:
+      lowered.decoded = !args.empty() && DecodeSlots(args, 0, &lowered.slots);
+      break;
+    case Instruction::kTuple:
+      lowered.decoded = DecodeSlots(args, 0, &lowered.slots);
+      break;
+    case Instruction::kPush:
+      if (args.size() == 1) {
+        lowered.value = args[0];
+        lowered.decoded = true;
+      }
+      break;
+    case Instruction::kPrim:
+      if (args.size() >= 2 && utils::isa<PrimitivePtr>(args[0])) {
+        lowered.value = args[0];
+        lowered.decoded = DecodeSlots(args, 1, &lowered.slots);
+      }
+      break;
+    case Instruction::kExternal:
+      // The second operand is not used by the vm.
+      if (!args.empty() && utils::isa<RunFunctionRef>(args[0])) {
+        lowered.value = args[0];
+        lowered.decoded = DecodeSlots(args, 2, &lowered.slots);
+      }
+      break;
+    default:
+      break;
+  }
+  return lowered;
+}
+}  // namespace
+
+void FinalVM::LowerInsts() {
+  lowered_insts_.clear();
+  lowered_insts_.reserve(insts_.size());
+  (void)std::transform(insts_.begin(), insts_.end(), std::back_inserter(lowered_insts_), LowerInst);
+}
+
 void FinalVM::Push(const BaseRef &v) {
   MS_LOG(DEBUG) << "Push " << v.ToString() << " sp_:" << sp_;
   insts_stack_[IntToSize(sp_++)] = v;
@@ -187,14 +262,58 @@ BaseRef FinalVM::Eval(const VectorRef &args) {
   }
 
   while (pc_ >= 0) {
-    auto inst = insts_[IntToSize(pc_)];
-    MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.first];
+    auto cur_pc = IntToSize(pc_);
+    const auto &inst = lowered_insts_[cur_pc];
+    MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.inst];
     ++pc_;
-    auto iter = inst_function_map.find(inst.first);
-    if (iter != inst_function_map.end()) {
-      iter->second(inst.second);
-    } else {
-      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.first] << "}";
+    if (!inst.decoded) {
+      RunInst(insts_[cur_pc]);
+      continue;
+    }
+    const auto &slots = inst.slots;
+    switch (inst.inst) {
+      case Instruction::kCall:
+        Call(slots[0]);
+        break;
+      case Instruction::kTailCall:
+        TailCall(slots[0], slots[1], slots[2]);
+        break;
+      case Instruction::kReturn:
+        Return(slots[0], slots[1]);
+        break;
+      case Instruction::kPartial:
+        Partial(slots);
+        break;
+      case Instruction::kSwitch:
+        Switch(slots[0], slots[1], slots[2]);
+        break;
+      case Instruction::kSwitchReturn:
+        Pop(1);
+        Popsp();
+        break;
+      case Instruction::kTuple:
+        Tuple(slots);
+        break;
+      case Instruction::kInput:
+        Input(slots[0]);
+        break;
+      case Instruction::kExternal:
+        External(inst.value, slots);
+        break;
+      case Instruction::kPush:
+        Push(inst.value);
+        break;
+      case Instruction::kPrim:
+        PushPrim(inst.value, slots);
+        break;
+      case Instruction::kPadStack:
+        PadStack(slots[0]);
+        break;
+      case Instruction::kSwitchLayer:
+        SwitchLayer(slots[0], slots[1]);
+        break;
+      default:
+        MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.inst] << "}";
     }
   }
 
@@ -202,6 +321,52 @@ BaseRef FinalVM::Eval(const VectorRef &args) {
   return insts_stack_[0];
 }
 
+void FinalVM::RunInst(const InstType &inst) {
+  switch (inst.first) {
+    case Instruction::kCall:
+      InstCall(inst.second);
+      break;
+    case Instruction::kTailCall:
+      InstTailCall(inst.second);
+      break;
+    case Instruction::kReturn:
+      InstReturn(inst.second);
+      break;
+    case Instruction::kPartial:
+      InstPartial(inst.second);
+      break;
+    case Instruction::kSwitch:
+      InstSwitch(inst.second);
+      break;
+    case Instruction::kSwitchReturn:
+      InstSwitchReturn(inst.second);
+      break;
+    case Instruction::kTuple:
+      InstTuple(inst.second);
+      break;
+    case Instruction::kInput:
+      InstInput(inst.second);
+      break;
+    case Instruction::kExternal:
+      InstExternal(inst.second);
+      break;
+    case Instruction::kPush:
+      InstPush(inst.second);
+      break;
+    case Instruction::kPrim:
+      InstPushPrim(inst.second);
+      break;
+    case Instruction::kPadStack:
+      InstPadStack(inst.second);
+      break;
+    case Instruction::kSwitchLayer:
+      InstSwitchLayer(inst.second);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.first] << "}";
+  }
+}
+
 void FinalVM::InstCall(const VectorRef &args) {
   MS_LOG(DEBUG) << "Start";
   const size_t args_size = 1;
@@ -211,7 +376,10 @@ void FinalVM::InstCall(const VectorRef &args) {
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
+  Call(utils::cast<int>(args[0]));
+}
+
+void FinalVM::Call(int jmp) {
   MS_LOG(DEBUG) << "Call pushp:" << pc_ << ", jmp:" << jmp << ", sp:" << sp_;
   Pushp();
   DoJmp(Ref(jmp));
@@ -227,10 +395,10 @@ void FinalVM::InstTailCall(const VectorRef &args) {
     return;
   }
 
-  int jmp = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
-  int nargs = utils::cast<int>(args[2]);
+  TailCall(utils::cast<int>(args[0]), utils::cast<int>(args[1]), utils::cast<int>(args[2]));
+}
 
+void FinalVM::TailCall(int jmp, int height, int nargs) {
   auto new_jmp = Ref(jmp);
   MoveStack(nargs, height);
   MS_LOG(DEBUG) << "TailCall pushp:" << pc_ << ", jmp:" << jmp;
@@ -257,9 +425,10 @@ void FinalVM::InstReturn(const VectorRef &args) {
     return;
   }
 
-  int rpos = utils::cast<int>(args[0]);
-  int height = utils::cast<int>(args[1]);
+  Return(utils::cast<int>(args[0]), utils::cast<int>(args[1]));
+}
 
+void FinalVM::Return(int rpos, int height) {
   auto rv = Ref(rpos);
   Pop(height);
   Push(rv);
@@ -275,12 +444,16 @@ void FinalVM::InstRealPartial(const VectorRef &args) {
     return;
   }
 
-  int fn_ = utils::cast<int>(args[0]);
-  auto fn = utils::cast<int>(Ref(fn_));
-  MS_LOG(DEBUG) << "Partial argssize:" << args.size();
-  std::vector<BaseRef> outs(args.size() - 1);
-  (void)std::transform(args.begin() + 1, args.end(), outs.begin(),
-                       [&, this](const BaseRef &a) { return Ref(utils::cast<int>(a)); });
+  std::vector<int> slots(args.size());
+  (void)std::transform(args.begin(), args.end(), slots.begin(), [](const BaseRef &a) { return utils::cast<int>(a); });
+  Partial(slots);
+}
+
+void FinalVM::Partial(const std::vector<int> &slots) {
+  auto fn = utils::cast<int>(Ref(slots[0]));
+  MS_LOG(DEBUG) << "Partial argssize:" << slots.size();
+  std::vector<BaseRef> outs(slots.size() - 1);
+  (void)std::transform(slots.begin() + 1, slots.end(), outs.begin(), [this](int a) { return Ref(a); });
   Push(std::make_shared<StructPartial>(fn, VectorRef(outs)));
 }
 
@@ -298,10 +471,10 @@ void FinalVM::InstRealSwitch(const VectorRef &args) {
     return;
   }
 
-  int cond = utils::cast<int>(args[0]);
-  int vtrue = utils::cast<int>(args[1]);
-  int vfalse = utils::cast<int>(args[2]);
+  Switch(utils::cast<int>(args[0]), utils::cast<int>(args[1]), utils::cast<int>(args[2]));
+}
 
+void FinalVM::Switch(int cond, int vtrue, int vfalse) {
   BaseRef c = Ref(cond);
   MS_LOG(DEBUG) << vtrue << " false:" << vfalse << " InstSwitch: " << c.ToString();
   bool bool_value = false;
@@ -332,8 +505,11 @@ void FinalVM::InstSwitchLayer(const VectorRef &args) {
     return;
   }
 
-  int idx = utils::cast<int>(args[0]);
-  VectorRef branches = utils::cast<VectorRef>(Ref(utils::cast<int>(args[1])));
+  SwitchLayer(utils::cast<int>(args[0]), utils::cast<int>(args[1]));
+}
+
+void FinalVM::SwitchLayer(int idx, int branches_idx) {
+  VectorRef branches = utils::cast<VectorRef>(Ref(branches_idx));
   int size = static_cast<int>(branches.size());
 
   BaseRef index = Ref(idx);
@@ -346,7 +522,7 @@ void FinalVM::InstSwitchLayer(const VectorRef &args) {
     idx_value += size;
   }
   if (idx_value < 0 || idx_value >= size) {
-    MS_LOG(EXCEPTION) << __FUNCTION__ << " given index " << idx_value << " out of range. Please make sure the value "
+    MS_LOG(EXCEPTION) << "InstSwitchLayer given index " << idx_value << " out of range. Please make sure the value "
                       << "of index in [" << -size << ", " << size << "), and the type is int32.";
   }
   Push(branches[idx_value]);
@@ -355,10 +531,14 @@ void FinalVM::InstSwitchLayer(const VectorRef &args) {
 
 void FinalVM::InstTuple(const VectorRef &args) {
   MS_LOG(DEBUG) << "Start";
+  std::vector<int> slots(args.size());
+  (void)std::transform(args.begin(), args.end(), slots.begin(), [](const BaseRef &a) { return utils::cast<int>(a); });
+  Tuple(slots);
+}
+
+void FinalVM::Tuple(const std::vector<int> &slots) {
   VectorRef tuple;
-  auto iter = args.begin();
-  for (; iter != args.end(); ++iter) {
-    auto a = utils::cast<int>(*iter);
+  for (auto a : slots) {
     tuple.push_back(Ref(a));
   }
   Push(tuple);
@@ -388,7 +568,10 @@ void FinalVM::InstInput(const VectorRef &args) {
     return;
   }
 
-  int rpos = utils::cast<int>(args[0]);
+  Input(utils::cast<int>(args[0]));
+}
+
+void FinalVM::Input(int rpos) {
   Push(Ref(rpos));
   MS_LOG(DEBUG) << "End";
 }
@@ -402,7 +585,10 @@ void FinalVM::InstPadStack(const VectorRef &args) {
     return;
   }
 
-  int sz = utils::cast<int>(args[0]);
+  PadStack(utils::cast<int>(args[0]));
+}
+
+void FinalVM::PadStack(int sz) {
   MS_LOG(DEBUG) << insts_stack_.size() << " need padstack " << sz << " sp_ " << sp_;
   size_t stack_size = insts_stack_.size();
   int need = sz - (static_cast<int>(stack_size) - sp_);
@@ -420,11 +606,18 @@ void FinalVM::InstExternal(const VectorRef &args) {
     MS_LOG(EXCEPTION) << "Args is empty!";
   }
 
+  std::vector<int> slots;
+  for (size_t i = 2; i < args.size(); ++i) {
+    slots.push_back(utils::cast<int>(args[i]));
+  }
+  External(args[0], slots);
+}
+
+void FinalVM::External(const BaseRef &fn_ref, const std::vector<int> &slots) {
   VectorRef tuple;
-  RunFunctionRef run_ref = utils::cast<RunFunctionRef>(args[0]);
+  RunFunctionRef run_ref = utils::cast<RunFunctionRef>(fn_ref);
   compile::RunFuncPtr fn = run_ref.func_;
-  for (size_t i = 2; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[i]);
+  for (auto index : slots) {
     tuple.push_back(Ref(index));
   }
 
@@ -450,10 +643,17 @@ void FinalVM::InstPushPrim(const VectorRef &args) {
     return;
   }
 
-  auto prim = utils::cast<PrimitivePtr>(args[0]);
-  VectorRef tuple;
+  std::vector<int> slots;
   for (size_t i = 1; i < args.size(); ++i) {
-    auto index = utils::cast<int>(args[i]);
+    slots.push_back(utils::cast<int>(args[i]));
+  }
+  PushPrim(args[0], slots);
+}
+
+void FinalVM::PushPrim(const BaseRef &prim_ref, const std::vector<int> &slots) {
+  auto prim = utils::cast<PrimitivePtr>(prim_ref);
+  VectorRef tuple;
+  for (auto index : slots) {
     tuple.push_back(Ref(index));
   }
 
@@ -57,7 +57,17 @@ enum Instruction {
 
 using InstType = std::pair<Instruction, VectorRef>;
 using InstSet = std::vector<InstType>;
-using InstFunctionMap = std::map<Instruction, std::function<void(const VectorRef &)>>;
+
+// An instruction lowered once before it runs: the int operands are decoded into slots, the primitive of kPrim, the
+// function of kExternal and the value of kPush are kept in value. An instruction whose operands do not fit its kind
+// is not decoded and runs through the handler taking the VectorRef operands.
+struct LoweredInst {
+  Instruction inst;
+  bool decoded;
+  std::vector<int> slots;
+  BaseRef value;
+};
+using LoweredInstSet = std::vector<LoweredInst>;
 
 const std::vector<std::string> inst_str{"call",          "tail_call", "return",    "partial",     "switch",
                                         "switch_return", "tuple",     "input",     "external",    "push",
@@ -114,7 +124,7 @@ class FinalVM {
   void InstPushPrim(const VectorRef &args);
   void InstSwitchReturn(const VectorRef &args);
   void InstSwitchLayer(const VectorRef &args);
-  void set_insts(const InstSet &value) { insts_ = value; }
+  void set_insts(const InstSet &value);
   BaseRef RunHook(const PrimitivePtr &prim, const VectorRef &arg);
 
  protected:
@@ -130,27 +140,28 @@ class FinalVM {
   void SyncData(const py::object &args);
 
  private:
+  void LowerInsts();
+  void RunInst(const InstType &inst);
+  void Call(int jmp);
+  void TailCall(int jmp, int height, int nargs);
+  void Return(int rpos, int height);
+  void Partial(const std::vector<int> &slots);
+  void Switch(int cond, int vtrue, int vfalse);
+  void SwitchLayer(int idx, int branches_idx);
+  void Tuple(const std::vector<int> &slots);
+  void Input(int rpos);
+  void PadStack(int sz);
+  void External(const BaseRef &fn, const std::vector<int> &slots);
+  void PushPrim(const BaseRef &prim, const std::vector<int> &slots);
+
   InstSet insts_;
-  std::deque<BaseRef> insts_stack_;
+  LoweredInstSet lowered_insts_;
+  std::vector<BaseRef> insts_stack_;
   std::stack<int> retp_;
   std::stack<int> retsp_;
   int pc_;
   int sp_;
   BackendPtr backend_;
-  const InstFunctionMap inst_function_map = {
-    {Instruction::kCall, [this](const VectorRef &args) { InstCall(args); }},
-    {Instruction::kTailCall, [this](const VectorRef &args) { InstTailCall(args); }},
-    {Instruction::kReturn, [this](const VectorRef &args) { InstReturn(args); }},
-    {Instruction::kPartial, [this](const VectorRef &args) { InstPartial(args); }},
-    {Instruction::kSwitch, [this](const VectorRef &args) { InstSwitch(args); }},
-    {Instruction::kTuple, [this](const VectorRef &args) { InstTuple(args); }},
-    {Instruction::kPush, [this](const VectorRef &args) { InstPush(args); }},
-    {Instruction::kInput, [this](const VectorRef &args) { InstInput(args); }},
-    {Instruction::kPadStack, [this](const VectorRef &args) { InstPadStack(args); }},
-    {Instruction::kExternal, [this](const VectorRef &args) { InstExternal(args); }},
-    {Instruction::kPrim, [this](const VectorRef &args) { InstPushPrim(args); }},
-    {Instruction::kSwitchReturn, [this](const VectorRef &args) { InstSwitchReturn(args); }},
-    {Instruction::kSwitchLayer, [this](const VectorRef &args) { InstSwitchLayer(args); }}};
 };
 
 using FinalVMPtr = std::shared_ptr<FinalVM>;
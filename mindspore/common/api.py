@@ -15,6 +15,7 @@
 # limitations under the License.
 # ============================================================================
 """Providing interface methods."""
+import json
 import types
 from collections import OrderedDict
 from functools import wraps
@@ -506,6 +507,24 @@ class _Executor:
             return None
         return self._executor.get_func_graph_proto(exec_id, ir_type)
 
+    def get_compile_profile(self, exec_id, use_prefix=False):
+        """
+        Get the compile profile of a graph, which is recorded if `enable_compile_profile` is set in context.
+
+        Returns:
+            dict, the phase, the events of the pipeline actions, optimizers and passes with their time, node counts
+            and memory growth, and the substitutions with their time, tries and hits. None if the graph is not compiled
+            or the profile is disabled.
+        """
+        if use_prefix:
+            exec_id = self.phase_prefix + exec_id
+        if self._executor.has_compiled(exec_id) is False:
+            return None
+        profile = self._executor.get_compile_profile(exec_id)
+        if not profile:
+            return None
+        return json.loads(profile)
+
     def export(self, file_name, graph_id):
         """
         Export graph.
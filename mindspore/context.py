@@ -391,6 +391,22 @@ class _Context:
     def enable_sparse(self, enable_sparse):
         self._context_handle.set_enable_sparse(enable_sparse)
 
+    @property
+    def enable_pynative_async(self):
+        return self._context_handle.get_enable_pynative_async()
+
+    @enable_pynative_async.setter
+    def enable_pynative_async(self, enable_pynative_async):
+        self._context_handle.set_enable_pynative_async(enable_pynative_async)
+
+    @property
+    def enable_compile_profile(self):
+        return self._context_handle.get_enable_compile_profile()
+
+    @enable_compile_profile.setter
+    def enable_compile_profile(self, enable_compile_profile):
+        self._context_handle.set_enable_compile_profile(enable_compile_profile)
+
 def check_input_format(x):
     import re
     pattern = r'[1-9][0-9]*(\.)?[0-9]*GB|0\.[0-9]*GB'
@@ -529,7 +545,7 @@ def reset_auto_parallel_context():
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool)
+                 enable_sparse=bool, enable_pynative_async=bool, enable_compile_profile=bool)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -586,6 +602,13 @@ def set_context(**kwargs):
             a file by default, and turn off printing to the screen. If the file already exists, add a timestamp
             suffix to the file.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
+        enable_pynative_async (bool): Whether to launch the kernels of ops on a backend thread in PYNATIVE_MODE.
+            The outputs of an op are returned before its kernel runs, reading their values waits for it, and the
+            error of a failed op is raised by the next op or read. Only used on "Ascend" and "GPU". Default: False.
+        enable_compile_profile (bool): Whether to record the time, graph size and memory growth of the pipeline actions,
+            optimizer passes and substitutions when compiling a graph. The profile is returned by
+            `_Executor.get_compile_profile` and saved as a Chrome trace file "compile_profile_<phase>.json" in
+            save_graphs_path. Default: False.
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -313,15 +313,15 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool
   }
 }
 
-void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphManager::ProcessEdge(const AnfNodePtr &node, int index, const AnfNodePtr &inp,
+                                   EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(inp);
   if (direction == kDecEdge) {
     MS_LOG(DEBUG) << "Remove node " << node->ToString() << " input[" << index << "] " << inp->ToString();
-    auto &users_node = node_users_[inp];
-    if (!users_node.contains(make_pair(node, index))) {
+    auto users_iter = node_users_.find(inp);
+    if (users_iter == node_users_.end() || !users_iter->second.erase(make_pair(node, index))) {
       return;
     }
-    (void)users_node.erase(make_pair(node, index));
     DropEdge(node, index, inp);
   } else {
     MS_LOG(DEBUG) << "Add node " << node->ToString() << " input[" << index << "] " << inp->ToString();
@@ -329,8 +329,7 @@ void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, E
       MS_LOG(DEBUG) << "Input[" << index << "] is const graph " << inp->ToString();
       AddFuncGraph(GetValueNode<FuncGraphPtr>(inp));
     }
-    auto &users_node = node_users_[inp];
-    users_node.add(make_pair(node, index));
+    node_users_[inp].add(make_pair(node, index));
     AddEdge(node, index, inp);
   }
 }
@@ -472,7 +471,7 @@ void FuncGraphManager::MoveAllCNodeDropGraph(FuncGraphPtr source, FuncGraphPtr t
   }
 }
 
-void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
+void FuncGraphManager::AddEdge(const AnfNodePtr &node, int index, const AnfNodePtr &input) {
   auto fg = node->func_graph();
   if (input->isa<ValueNode>()) {
     fg->AddValueNode(input);
@@ -493,7 +492,7 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
   }
 }
 
-void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
+void FuncGraphManager::DropEdge(const AnfNodePtr &node, int index, const AnfNodePtr &input) {
   auto fg = node->func_graph();
   if (input->isa<ValueNode>()) {
     fg->DropValueNode(input);
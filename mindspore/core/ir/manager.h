@@ -34,6 +34,7 @@
 #include "utils/signal.h"
 #include "utils/ordered_set.h"
 #include "utils/ordered_map.h"
+#include "utils/compact_ordered_map.h"
 #include "ir/graph_utils.h"
 #include "utils/counter.h"
 #include "utils/hashing.h"
@@ -57,9 +58,16 @@ struct AnfNodeIndexPairEqual {
     return lhs == rhs;
   }
 };
+#ifdef ENABLE_COMPACT_MANAGER
+// The user edges are kept in flat slot arrays, which saves the list and map nodes of each edge on large graphs.
+using AnfNodeIndexSet = CompactOrderedSet<std::pair<AnfNodePtr, int>, AnfNodeIndexPairHasher, AnfNodeIndexPairEqual>;
+// NodeUsersMap, for node B input i use node A, it will be one item in map with key: A, and value: (B, i)
+using NodeUsersMap = CompactOrderedMap<AnfNodePtr, AnfNodeIndexSet>;
+#else
 using AnfNodeIndexSet = OrderedSet<std::pair<AnfNodePtr, int>, AnfNodeIndexPairHasher, AnfNodeIndexPairEqual>;
 // NodeUsersMap, for node B input i use node A, it will be one item in map with key: A, and value: (B, i)
 using NodeUsersMap = OrderedMap<AnfNodePtr, AnfNodeIndexSet>;
+#endif
 using FuncGraphSetPair = std::pair<FuncGraphPtr, FuncGraphSet>;
 using FuncGraphSetPtr = std::shared_ptr<FuncGraphSet>;
 using EdgeTuple = std::pair<AnfNodePtr, std::pair<int, AnfNodePtr>>;
@@ -359,14 +367,14 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
  private:
   void AddIntoManaged(const FuncGraphPtr &fg);
-  void ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction);
+  void ProcessEdge(const AnfNodePtr &node, int index, const AnfNodePtr &inp, EdgeProcessDirection direction);
   void ProcessInputs(const AnfNodePtr &node, EdgeProcessDirection direction);
   void AcquireNodes(const std::vector<AnfNodePtr> &nodes);
   FuncGraphSetPtr MaybeDropNodes(const std::vector<AnfNodePtr> &nodes);
   void ParseChanges(const std::vector<Change> &changes, EdgeTupleCounter *add_edges, EdgeTupleCounter *rm_edges,
                     Counter<AnfNodePtr> *adds, Counter<AnfNodePtr> *rms);
-  void AddEdge(AnfNodePtr node, int index, AnfNodePtr input);
-  void DropEdge(AnfNodePtr node, int index, AnfNodePtr input);
+  void AddEdge(const AnfNodePtr &node, int index, const AnfNodePtr &input);
+  void DropEdge(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target);
 
   FuncGraphSet roots_;        // managed roots
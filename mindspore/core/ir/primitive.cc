@@ -16,6 +16,7 @@
 
 #include "ir/primitive.h"
 
+#include <map>
 #include <utility>
 #include "abstract/abstract_function.h"
 
@@ -79,6 +80,21 @@ bool Primitive::operator==(const Primitive &other) const {
   return all;
 }
 
+const std::string &Primitive::evaluate_added_attrs_key() const {
+  if (evaluate_added_attrs_key_valid_) {
+    return evaluate_added_attrs_key_;
+  }
+  // Sort by name, the iteration order of the unordered map may differ between two records of the same attrs.
+  std::map<std::string, ValuePtr> sorted_attrs(evaluate_added_attrs_.begin(), evaluate_added_attrs_.end());
+  evaluate_added_attrs_key_.clear();
+  for (auto &attr : sorted_attrs) {
+    MS_EXCEPTION_IF_NULL(attr.second);
+    (void)evaluate_added_attrs_key_.append(attr.first + "=" + attr.second->ToString() + "_");
+  }
+  evaluate_added_attrs_key_valid_ = true;
+  return evaluate_added_attrs_key_;
+}
+
 std::string Primitive::GetAttrsText() const {
   if (attrs_.empty()) {
     return "";
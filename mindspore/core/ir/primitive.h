@@ -48,6 +48,7 @@ class Primitive : public Named {
   std::string ToString() const override { return name(); }
   void BeginRecordAddAttr() {
     evaluate_added_attrs_.clear();
+    evaluate_added_attrs_key_valid_ = false;
     record_evaluate_add_attr_ = true;
   }
   void EndRecordAddAttr() { record_evaluate_add_attr_ = false; }
@@ -55,6 +56,7 @@ class Primitive : public Named {
     attrs_[name] = attr;
     if (record_evaluate_add_attr_) {
       evaluate_added_attrs_[name] = attr;
+      evaluate_added_attrs_key_valid_ = false;
     }
     return *this;
   }
@@ -77,6 +79,8 @@ class Primitive : public Named {
 
   const std::unordered_map<std::string, ValuePtr> &attrs() const { return attrs_; }
   const std::unordered_map<std::string, ValuePtr> &evaluate_added_attrs() const { return evaluate_added_attrs_; }
+  // Text of the evaluate added attrs, it is only rebuilt after the attrs are recorded again.
+  const std::string &evaluate_added_attrs_key() const;
   void set_evaluate_added_attrs(const std::unordered_map<std::string, ValuePtr> &attrs) {
     for (auto &attr : attrs) {
       MS_LOG(INFO) << " set evalu attrl " << name() << attr.first;
@@ -125,6 +129,8 @@ class Primitive : public Named {
   bool record_evaluate_add_attr_;
   bool is_const_value_;
   std::string id_{""};
+  mutable std::string evaluate_added_attrs_key_;
+  mutable bool evaluate_added_attrs_key_valid_{false};
 };
 
 inline std::ostream &operator<<(std::ostream &os, const PrimitivePtr &p) {
@@ -384,7 +384,8 @@ Tensor::Tensor(const Tensor &tensor)
       data_(tensor.data_),
       dirty_(tensor.dirty_),
       id_(tensor.id_),
-      device_sync_(tensor.device_sync_) {}
+      device_sync_(tensor.device_sync_),
+      wait_event_(tensor.wait_event_) {}
 
 Tensor::Tensor(const Tensor &tensor, TypeId data_type)
     : MetaTensor(data_type, tensor.shape_),
@@ -439,6 +440,7 @@ Tensor &Tensor::AssignValue(const Tensor &tensor) {
     MetaTensor::operator=(tensor);
     dirty_ = tensor.dirty_;
     device_sync_ = tensor.device_sync_;
+    wait_event_ = tensor.wait_event_;
     data_ = tensor.data_;
     id_ = tensor.id_;
   }
@@ -483,6 +485,7 @@ std::string Tensor::ToStringRepr() const {
 }
 
 void Tensor::data_sync() const {
+  Wait();
   if (device_sync_ != nullptr) {
     if (!device_sync_->SyncDeviceToHost(shape(), static_cast<size_t>(data().nbytes()), data_type(), data_c())) {
       MS_LOG(EXCEPTION) << "SyncDeviceToHost when asnumpy.";
@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 #include <numeric>
+#include <mutex>
+#include <condition_variable>
 
 #include "Eigen/Core"
 #include "ir/device_sync.h"
@@ -59,6 +61,43 @@ class TensorData {
 
 using TensorDataPtr = std::shared_ptr<TensorData>;
 
+// The event of an op which writes its output tensors on another thread, readers of the tensors wait for it.
+class WaitEvent {
+ public:
+  WaitEvent() = default;
+  ~WaitEvent() = default;
+
+  void Wait() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_var_.wait(lock, [this] { return done_; });
+    if (!error_.empty()) {
+      MS_LOG(EXCEPTION) << error_;
+    }
+  }
+
+  // Wake up the readers, a non empty error is raised from every Wait.
+  void Done(const std::string &error = "") {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = error;
+      done_ = true;
+    }
+    cond_var_.notify_all();
+  }
+
+  bool done() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_;
+  }
+
+ private:
+  bool done_{false};
+  std::string error_;
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cond_var_;
+};
+using WaitEventPtr = std::shared_ptr<WaitEvent>;
+
 // Tensor entity class
 class Tensor : public MetaTensor {
  public:
@@ -187,9 +226,16 @@ class Tensor : public MetaTensor {
 
   void *data_c() const { return data_->data(); }
 
-  // brief Sync data with device.
+  // brief Sync data with device, wait for the op writing the tensor first.
   void data_sync() const;
 
+  // brief Wait for the op writing the tensor if it runs on another thread.
+  void Wait() const {
+    if (wait_event_ != nullptr) {
+      wait_event_->Wait();
+    }
+  }
+
   // brief Get the internal data object.
   //
   // return The reference to internal data object.
@@ -224,12 +270,15 @@ class Tensor : public MetaTensor {
 
   std::string id() const { return id_; }
 
+  void set_wait_event(const WaitEventPtr &wait_event) { wait_event_ = wait_event; }
+
  private:
   bool init_flag_{false};
   TensorDataPtr data_{nullptr};
   bool dirty_{true};
   std::string id_{""};
   DeviceSyncPtr device_sync_{nullptr};
+  WaitEventPtr wait_event_{nullptr};
 };
 using TensorPtr = std::shared_ptr<Tensor>;
 using TensorPtrList = std::vector<std::shared_ptr<Tensor>>;
@@ -0,0 +1,626 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_COMPACT_ORDERED_MAP_H_
+#define MINDSPORE_CORE_UTILS_COMPACT_ORDERED_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace compact {
+// Insertion ordered hash table which keeps its elements in flat slot arrays instead of one list node and one map
+// node per element. It is the storage of CompactOrderedSet and CompactOrderedMap.
+//
+// Slots are allocated in chunks of 2, 4, 8, ... slots, so a slot never moves once created: references and iterators
+// stay valid until the element itself is erased, the same as the std::list based OrderedSet and OrderedMap.
+// Insertion order is kept by prev/next slot indexes, erased slots are reused by later insertions. Small tables are
+// searched linearly, an open addressing index of slot indexes is only built when a table grows beyond
+// kLinearSearchLimit elements, which is the common case for the user sets of the nodes of a graph.
+template <typename KeyT, typename EntryT, typename KeyOf, typename Hash, typename Equal>
+class OrderedTable {
+ public:
+  static constexpr int32_t kNil = -1;
+
+  template <bool is_const>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = EntryT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<is_const, const EntryT *, EntryT *>::type;
+    using reference = typename std::conditional<is_const, const EntryT &, EntryT &>::type;
+    using table_pointer = typename std::conditional<is_const, const OrderedTable *, OrderedTable *>::type;
+
+    Iterator() = default;
+    Iterator(table_pointer table, int32_t slot) : table_(table), slot_(slot) {}
+    // Allow iterator to const_iterator conversion.
+    template <bool other_const, typename = typename std::enable_if<is_const && !other_const>::type>
+    Iterator(const Iterator<other_const> &other) : table_(other.table()), slot_(other.slot()) {}
+
+    reference operator*() const { return table_->At(slot_).entry; }
+    pointer operator->() const { return &table_->At(slot_).entry; }
+    Iterator &operator++() {
+      slot_ = table_->At(slot_).next;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    Iterator &operator--() {
+      slot_ = (slot_ == kNil) ? table_->tail_ : table_->At(slot_).prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+    bool operator==(const Iterator &other) const { return slot_ == other.slot_; }
+    bool operator!=(const Iterator &other) const { return slot_ != other.slot_; }
+    table_pointer table() const { return table_; }
+    int32_t slot() const { return slot_; }
+
+   private:
+    table_pointer table_{nullptr};
+    int32_t slot_{kNil};
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  OrderedTable() = default;
+  ~OrderedTable() = default;
+  OrderedTable(const OrderedTable &other) { CopyFrom(other); }
+  OrderedTable(OrderedTable &&other) noexcept { Swap(other); }
+  OrderedTable &operator=(const OrderedTable &other) {
+    if (this != &other) {
+      Clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+  OrderedTable &operator=(OrderedTable &&other) noexcept {
+    if (this != &other) {
+      Clear();
+      Swap(other);
+    }
+    return *this;
+  }
+
+  iterator begin() { return iterator(this, head_); }
+  iterator end() { return iterator(this, kNil); }
+  const_iterator begin() const { return const_iterator(this, head_); }
+  const_iterator end() const { return const_iterator(this, kNil); }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  EntryT &front() { return At(head_).entry; }
+  const EntryT &front() const { return At(head_).entry; }
+  EntryT &back() { return At(tail_).entry; }
+  const EntryT &back() const { return At(tail_).entry; }
+
+  int32_t Find(const KeyT &key) const {
+    if (index_.empty()) {
+      for (int32_t slot = head_; slot != kNil; slot = At(slot).next) {
+        if (equal_(KeyOf()(At(slot).entry), key)) {
+          return slot;
+        }
+      }
+      return kNil;
+    }
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t pos = hasher_(key) & mask;; pos = (pos + 1) & mask) {
+      int32_t slot = index_[pos];
+      if (slot == kNil) {
+        return kNil;
+      }
+      if (slot != kErased && equal_(KeyOf()(At(slot).entry), key)) {
+        return slot;
+      }
+    }
+  }
+
+  // Insert the entry made by make_entry if no element has the key, return the slot of the key and whether inserted.
+  template <typename MakeEntry>
+  std::pair<int32_t, bool> Emplace(const KeyT &key, MakeEntry &&make_entry) {
+    int32_t slot = Find(key);
+    if (slot != kNil) {
+      return std::make_pair(slot, false);
+    }
+    slot = NewSlot();
+    auto &new_slot = At(slot);
+    new_slot.entry = make_entry();
+    new_slot.prev = tail_;
+    new_slot.next = kNil;
+    if (tail_ == kNil) {
+      head_ = slot;
+    } else {
+      At(tail_).next = slot;
+    }
+    tail_ = slot;
+    ++size_;
+    if (!index_.empty()) {
+      IndexInsert(slot);
+    } else if (size_ > kLinearSearchLimit) {
+      Reindex(size_);
+    }
+    return std::make_pair(slot, true);
+  }
+
+  // Erase the element in slot, return the slot of the element after it.
+  int32_t Erase(int32_t slot) {
+    auto &erased = At(slot);
+    int32_t next = erased.next;
+    if (!index_.empty()) {
+      IndexErase(slot);
+    }
+    if (erased.prev == kNil) {
+      head_ = erased.next;
+    } else {
+      At(erased.prev).next = erased.next;
+    }
+    if (erased.next == kNil) {
+      tail_ = erased.prev;
+    } else {
+      At(erased.next).prev = erased.prev;
+    }
+    // Release what the element holds now, the slot itself is kept for reuse.
+    erased.entry = EntryT();
+    erased.prev = kNil;
+    erased.next = free_head_;
+    free_head_ = slot;
+    --size_;
+    return next;
+  }
+
+  void Clear() {
+    chunks_.clear();
+    index_.clear();
+    capacity_ = 0;
+    allocated_ = 0;
+    size_ = 0;
+    index_used_ = 0;
+    head_ = kNil;
+    tail_ = kNil;
+    free_head_ = kNil;
+  }
+
+  void Reserve(std::size_t num_entries) {
+    if (num_entries > kLinearSearchLimit && num_entries > size_) {
+      Reindex(num_entries);
+    }
+  }
+
+  void Swap(OrderedTable &other) {
+    std::swap(chunks_, other.chunks_);
+    std::swap(index_, other.index_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(allocated_, other.allocated_);
+    std::swap(size_, other.size_);
+    std::swap(index_used_, other.index_used_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(free_head_, other.free_head_);
+  }
+
+ private:
+  static constexpr int32_t kErased = -2;
+  static constexpr std::size_t kLinearSearchLimit = 8;
+  static constexpr std::size_t kMinIndexSize = 32;
+
+  struct Slot {
+    EntryT entry;
+    int32_t prev{kNil};
+    int32_t next{kNil};
+  };
+
+  // Chunk c holds the slots [2^(c+1) - 2, 2^(c+2) - 2).
+  static std::size_t ChunkOf(std::size_t slot) {
+    std::size_t n = slot + 2;
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(n))) - 1;
+#else
+    std::size_t log2 = 0;
+    while (n >>= 1) {
+      ++log2;
+    }
+    return log2 - 1;
+#endif
+  }
+
+  Slot &At(int32_t slot) const {
+    auto s = static_cast<std::size_t>(slot);
+    std::size_t chunk = ChunkOf(s);
+    return chunks_[chunk][s + 2 - (static_cast<std::size_t>(2) << chunk)];
+  }
+
+  int32_t NewSlot() {
+    if (free_head_ != kNil) {
+      int32_t slot = free_head_;
+      free_head_ = At(slot).next;
+      return slot;
+    }
+    if (allocated_ == capacity_) {
+      std::size_t chunk_size = static_cast<std::size_t>(2) << chunks_.size();
+      chunks_.emplace_back(new Slot[chunk_size]);
+      capacity_ += chunk_size;
+    }
+    return static_cast<int32_t>(allocated_++);
+  }
+
+  void IndexInsert(int32_t slot) {
+    if ((index_used_ + 1) * 4 > index_.size() * 3) {
+      // Reindex puts the new slot in, it is already linked.
+      Reindex(size_);
+      return;
+    }
+    const std::size_t mask = index_.size() - 1;
+    std::size_t pos = hasher_(KeyOf()(At(slot).entry)) & mask;
+    while (index_[pos] != kNil && index_[pos] != kErased) {
+      pos = (pos + 1) & mask;
+    }
+    if (index_[pos] == kNil) {
+      ++index_used_;
+    }
+    index_[pos] = slot;
+  }
+
+  void IndexErase(int32_t slot) {
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t pos = hasher_(KeyOf()(At(slot).entry)) & mask;; pos = (pos + 1) & mask) {
+      if (index_[pos] == slot) {
+        index_[pos] = kErased;
+        return;
+      }
+      if (index_[pos] == kNil) {
+        MS_LOG(EXCEPTION) << "Slot " << slot << " is not in the index of the ordered table.";
+      }
+    }
+  }
+
+  void Reindex(std::size_t num_entries) {
+    std::size_t index_size = kMinIndexSize;
+    while (index_size * 3 < num_entries * 4 + 4) {
+      index_size <<= 1;
+    }
+    index_.assign(index_size, kNil);
+    index_used_ = 0;
+    const std::size_t mask = index_size - 1;
+    for (int32_t slot = head_; slot != kNil; slot = At(slot).next) {
+      std::size_t pos = hasher_(KeyOf()(At(slot).entry)) & mask;
+      while (index_[pos] != kNil) {
+        pos = (pos + 1) & mask;
+      }
+      index_[pos] = slot;
+      ++index_used_;
+    }
+  }
+
+  void CopyFrom(const OrderedTable &other) {
+    if (other.size_ > kLinearSearchLimit) {
+      Reindex(other.size_);
+    }
+    for (int32_t slot = other.head_; slot != kNil; slot = other.At(slot).next) {
+      const EntryT &entry = other.At(slot).entry;
+      (void)Emplace(KeyOf()(entry), [&entry]() { return entry; });
+    }
+  }
+
+  std::vector<std::unique_ptr<Slot[]>> chunks_;
+  std::vector<int32_t> index_;
+  std::size_t capacity_{0};
+  std::size_t allocated_{0};
+  std::size_t size_{0};
+  std::size_t index_used_{0};
+  int32_t head_{kNil};
+  int32_t tail_{kNil};
+  int32_t free_head_{kNil};
+  Hash hasher_;
+  Equal equal_;
+};
+
+template <typename T>
+struct IdentityKey {
+  const T &operator()(const T &e) const { return e; }
+};
+
+template <typename K, typename V>
+struct PairFirstKey {
+  const K &operator()(const std::pair<K, V> &e) const { return e.first; }
+};
+}  // namespace compact
+
+// Drop-in replacement of OrderedSet backed by compact::OrderedTable.
+template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>>
+class CompactOrderedSet {
+ public:
+  using element_type = T;
+  using hasher = Hash;
+  using equal = KeyEqual;
+  using table_type = compact::OrderedTable<T, T, compact::IdentityKey<T>, Hash, KeyEqual>;
+  using vector_type = std::vector<element_type>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using ordered_set_type = CompactOrderedSet<element_type, hasher, equal>;
+
+  CompactOrderedSet() = default;
+  ~CompactOrderedSet() = default;
+  CompactOrderedSet(const CompactOrderedSet &os) = default;
+  CompactOrderedSet(CompactOrderedSet &&os) noexcept = default;
+  CompactOrderedSet &operator=(const CompactOrderedSet &os) = default;
+  CompactOrderedSet &operator=(CompactOrderedSet &&os) noexcept = default;
+
+  explicit CompactOrderedSet(const std::list<element_type> &other) { update(other); }
+  explicit CompactOrderedSet(const vector_type &other) { update(other); }
+
+  void add(const element_type &e) { (void)insert(e); }
+
+  std::pair<iterator, bool> insert(const element_type &e) {
+    auto result = table_.Emplace(e, [&e]() { return e; });
+    return std::make_pair(iterator(&table_, result.first), result.second);
+  }
+
+  bool erase(const element_type &e) {
+    auto slot = table_.Find(e);
+    if (slot == table_type::kNil) {
+      return false;
+    }
+    (void)table_.Erase(slot);
+    return true;
+  }
+
+  iterator erase(const iterator &itr) { return iterator(&table_, table_.Erase(itr.slot())); }
+
+  std::size_t size() const { return table_.size(); }
+  bool empty() const { return table_.empty(); }
+
+  std::string toString() {
+    std::ostringstream res;
+    res << "orderset content:\n";
+    for (auto &item : table_) {
+      res << std::to_string(reinterpret_cast<uintptr_t>(item.get())) << " ";
+    }
+    return res.str();
+  }
+
+  void clear() { table_.Clear(); }
+
+  bool operator==(const CompactOrderedSet &other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+  }
+
+  T pop() {
+    if (!table_.empty()) {
+      T res = table_.front();
+      (void)table_.Erase(begin().slot());
+      return res;
+    }
+    MS_LOG(EXCEPTION) << "pop() on empty OrderedSet";
+  }
+
+  T back() {
+    if (!table_.empty()) {
+      return table_.back();
+    }
+    MS_LOG(EXCEPTION) << "back() on empty OrderedSet";
+  }
+
+  bool is_disjoint(const CompactOrderedSet &other) {
+    for (auto &item : other) {
+      if (contains(item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool is_subset(const CompactOrderedSet &other) {
+    for (auto &item : table_) {
+      if (!other.contains(item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void update(const CompactOrderedSet &other) {
+    for (auto &item : other) {
+      add(item);
+    }
+  }
+  void update(const std::shared_ptr<CompactOrderedSet> &other) { update(*other); }
+  void update(const std::list<element_type> &other) {
+    for (auto &item : other) {
+      add(item);
+    }
+  }
+  void update(const vector_type &other) {
+    for (auto &item : other) {
+      add(item);
+    }
+  }
+
+  ordered_set_type get_union(const CompactOrderedSet &other) {
+    ordered_set_type res(*this);
+    res.update(other);
+    return res;
+  }
+  ordered_set_type operator|(const CompactOrderedSet &other) { return get_union(other); }
+
+  ordered_set_type intersection(const CompactOrderedSet &other) {
+    ordered_set_type res;
+    for (auto &item : table_) {
+      if (other.contains(item)) {
+        res.add(item);
+      }
+    }
+    return res;
+  }
+  ordered_set_type operator&(const CompactOrderedSet &other) { return intersection(other); }
+
+  ordered_set_type symmetric_difference(const CompactOrderedSet &other) {
+    ordered_set_type res(*this);
+    for (auto &item : other) {
+      if (contains(item)) {
+        (void)res.erase(item);
+      } else {
+        res.add(item);
+      }
+    }
+    return res;
+  }
+  ordered_set_type operator^(const CompactOrderedSet &other) { return symmetric_difference(other); }
+
+  void difference_update(const CompactOrderedSet &other) {
+    for (auto &item : other) {
+      (void)erase(item);
+    }
+  }
+  void difference_update(const std::list<element_type> &other) {
+    for (auto &item : other) {
+      (void)erase(item);
+    }
+  }
+  void difference_update(const vector_type &other) {
+    for (auto &item : other) {
+      (void)erase(item);
+    }
+  }
+
+  ordered_set_type difference(const CompactOrderedSet &other) {
+    ordered_set_type res(*this);
+    res.difference_update(other);
+    return res;
+  }
+  ordered_set_type operator-(const CompactOrderedSet &other) { return difference(other); }
+
+  bool contains(const element_type &e) const { return table_.Find(e) != table_type::kNil; }
+  std::size_t count(const element_type &e) const { return contains(e) ? 1 : 0; }
+
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+  const_iterator cbegin() const { return table_.begin(); }
+  const_iterator cend() const { return table_.end(); }
+
+ private:
+  table_type table_;
+};
+
+// Drop-in replacement of OrderedMap backed by compact::OrderedTable.
+template <typename KeyT, typename ValueT, class Hash = std::hash<KeyT>, class Equal = std::equal_to<KeyT>>
+class CompactOrderedMap {
+ public:
+  using key_t = KeyT;
+  using value_t = ValueT;
+  using hasher = Hash;
+  using equal = Equal;
+  using pair_type = std::pair<key_t, value_t>;
+  using table_type = compact::OrderedTable<KeyT, pair_type, compact::PairFirstKey<KeyT, ValueT>, Hash, Equal>;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using value_type = pair_type;
+  using size_type = std::size_t;
+
+  iterator begin() { return table_.begin(); }
+  iterator end() { return table_.end(); }
+  const_iterator begin() const { return table_.begin(); }
+  const_iterator end() const { return table_.end(); }
+  const_iterator cbegin() const { return table_.begin(); }
+  const_iterator cend() const { return table_.end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  pair_type &front() { return table_.front(); }
+  const pair_type &front() const { return table_.front(); }
+  pair_type &back() { return table_.back(); }
+  const pair_type &back() const { return table_.back(); }
+
+  CompactOrderedMap() = default;
+  ~CompactOrderedMap() = default;
+  CompactOrderedMap(const CompactOrderedMap &os) = default;
+  CompactOrderedMap(CompactOrderedMap &&os) noexcept = default;
+  CompactOrderedMap &operator=(const CompactOrderedMap &os) = default;
+  CompactOrderedMap &operator=(CompactOrderedMap &&os) noexcept = default;
+
+  void clear() { table_.Clear(); }
+  void swap(CompactOrderedMap &rhs) { table_.Swap(rhs.table_); }
+  void reserve(size_type num_entries) { table_.Reserve(num_entries); }
+
+  std::pair<iterator, bool> add(const key_t &key) {
+    auto result = table_.Emplace(key, [&key]() { return pair_type(key, ValueT()); });
+    return std::make_pair(iterator(&table_, result.first), result.second);
+  }
+
+  ValueT &operator[](const key_t &key) { return add(key).first->second; }
+
+  std::pair<iterator, bool> insert(const pair_type &kv) {
+    auto result = table_.Emplace(kv.first, [&kv]() { return kv; });
+    return std::make_pair(iterator(&table_, result.first), result.second);
+  }
+
+  std::pair<iterator, bool> insert(pair_type &&kv) {
+    auto result = table_.Emplace(kv.first, [&kv]() { return std::move(kv); });
+    return std::make_pair(iterator(&table_, result.first), result.second);
+  }
+
+  bool empty() const { return table_.empty(); }
+  size_type size() const { return table_.size(); }
+  size_type count(const key_t &key) const { return table_.Find(key) == table_type::kNil ? 0 : 1; }
+
+  iterator find(const key_t &key) { return iterator(&table_, table_.Find(key)); }
+  const_iterator find(const key_t &key) const { return const_iterator(&table_, table_.Find(key)); }
+
+  void pop_back() { (void)table_.Erase(std::prev(end()).slot()); }
+  void pop_front() { (void)table_.Erase(begin().slot()); }
+
+  iterator erase(const iterator &itr) { return iterator(&table_, table_.Erase(itr.slot())); }
+
+  size_type erase(const key_t &key) {
+    auto slot = table_.Find(key);
+    if (slot == table_type::kNil) {
+      return 0;
+    }
+    (void)table_.Erase(slot);
+    return 1;
+  }
+
+ private:
+  table_type table_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_UTILS_COMPACT_ORDERED_MAP_H_
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/compile_profiler.h"
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "utils/log_adapter.h"
+#include "utils/profile.h"
+
+namespace mindspore {
+namespace {
+int64_t GetPeakRssKb() {
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  // ru_maxrss is in kilobytes on linux
+  return static_cast<int64_t>(usage.ru_maxrss);
+}
+
+// The peak never goes down, so the memory of a stage is measured by the current resident size instead.
+int64_t GetCurrentRssKb() {
+  std::ifstream ifs("/proc/self/statm");
+  int64_t size_pages = 0;
+  int64_t resident_pages = 0;
+  if (!(ifs >> size_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+std::string JsonString(const std::string &str) {
+  std::ostringstream oss;
+  oss << '"';
+  for (auto c : str) {
+    switch (c) {
+      case '"':
+        oss << "\\\"";
+        break;
+      case '\\':
+        oss << "\\\\";
+        break;
+      case '\n':
+        oss << "\\n";
+        break;
+      case '\t':
+        oss << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          oss << c;
+        }
+    }
+  }
+  oss << '"';
+  return oss.str();
+}
+
+void EventArgs(std::ostringstream *oss, const CompileProfileEvent &event) {
+  *oss << "{\"nodes_before\": " << event.nodes_before << ", \"nodes_after\": " << event.nodes_after
+       << ", \"rss_kb\": " << event.rss_kb << ", \"rss_delta_kb\": " << event.rss_delta_kb << "}";
+}
+}  // namespace
+
+CompileProfiler &CompileProfiler::GetInstance() {
+  static CompileProfiler instance;
+  return instance;
+}
+
+void CompileProfiler::Begin(const std::string &phase, bool enable) {
+  enabled_ = enable;
+  phase_ = phase;
+  begin_time_ = GetTime();
+  depth_ = 0;
+  events_.clear();
+  stats_.clear();
+}
+
+void CompileProfiler::End() { enabled_ = false; }
+
+size_t CompileProfiler::Open(const std::string &name, const std::string &category, int64_t nodes) {
+  CompileProfileEvent event;
+  event.name = name;
+  event.category = category;
+  event.depth = depth_++;
+  event.start = GetTime() - begin_time_;
+  event.nodes_before = nodes;
+  event.rss_kb = GetCurrentRssKb();
+  events_.push_back(event);
+  return events_.size() - 1;
+}
+
+void CompileProfiler::Close(size_t index, int64_t nodes) {
+  if (index >= events_.size()) {
+    MS_LOG(EXCEPTION) << "Compile profile event " << index << " does not exist, there are " << events_.size()
+                      << " events.";
+  }
+  auto &event = events_[index];
+  event.duration = GetTime() - begin_time_ - event.start;
+  event.nodes_after = nodes;
+  event.rss_delta_kb = GetCurrentRssKb() - event.rss_kb;
+  depth_ = event.depth;
+}
+
+void CompileProfiler::AddStat(const std::string &name, double time, size_t tries, size_t hits) {
+  auto &stat = stats_[name];
+  stat.time += time;
+  stat.tries += tries;
+  stat.hits += hits;
+}
+
+std::string CompileProfiler::ChromeTrace() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3);
+  oss << "{\"traceEvents\": [\n";
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const auto &event = events_[i];
+    oss << "  {\"name\": " << JsonString(event.name) << ", \"cat\": " << JsonString(event.category)
+        << ", \"ph\": \"X\", \"ts\": " << event.start * 1e6 << ", \"dur\": " << event.duration * 1e6
+        << ", \"pid\": 1, \"tid\": 1, \"args\": ";
+    EventArgs(&oss, event);
+    oss << "}" << (i + 1 < events_.size() ? ",\n" : "\n");
+  }
+  oss << "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"phase\": " << JsonString(phase_) << "}}\n";
+  return oss.str();
+}
+
+std::string CompileProfiler::Summary() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(6);
+  oss << "{\"phase\": " << JsonString(phase_) << ", \"peak_rss_kb\": " << GetPeakRssKb() << ", \"events\": [";
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const auto &event = events_[i];
+    oss << (i == 0 ? "" : ", ") << "{\"name\": " << JsonString(event.name)
+        << ", \"category\": " << JsonString(event.category) << ", \"depth\": " << event.depth
+        << ", \"start\": " << event.start << ", \"time\": " << event.duration
+        << ", \"nodes_before\": " << event.nodes_before << ", \"nodes_after\": " << event.nodes_after
+        << ", \"rss_kb\": " << event.rss_kb << ", \"rss_delta_kb\": " << event.rss_delta_kb << "}";
+  }
+  oss << "], \"substitutions\": [";
+  bool first = true;
+  for (const auto &item : stats_) {
+    oss << (first ? "" : ", ") << "{\"name\": " << JsonString(item.first) << ", \"time\": " << item.second.time
+        << ", \"tries\": " << item.second.tries << ", \"hits\": " << item.second.hits << "}";
+    first = false;
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+bool CompileProfiler::SaveChromeTrace(const std::string &file_path) const {
+  std::ofstream ofs(file_path, std::ios::trunc | std::ios::out);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed, the compile profile is not saved.";
+    return false;
+  }
+  ofs << ChromeTrace();
+  ofs.close();
+  MS_LOG(INFO) << "Save the compile profile of phase " << phase_ << " to " << file_path;
+  return true;
+}
+
+CompileProfileScope::CompileProfileScope(const std::string &name, const std::string &category,
+                                         const std::function<int64_t()> &count_nodes) {
+  auto &profiler = CompileProfiler::GetInstance();
+  if (!profiler.enabled()) {
+    return;
+  }
+  active_ = true;
+  count_nodes_ = count_nodes;
+  index_ = profiler.Open(name, category, count_nodes_ ? count_nodes_() : -1);
+}
+
+CompileProfileScope::~CompileProfileScope() {
+  auto &profiler = CompileProfiler::GetInstance();
+  // the profile may have been ended or begun again by a nested compilation
+  if (!active_ || !profiler.enabled() || index_ >= profiler.events().size()) {
+    return;
+  }
+  try {
+    profiler.Close(index_, count_nodes_ ? count_nodes_() : -1);
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Close compile profile event failed: " << e.what();
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_UTILS_COMPILE_PROFILER_H_
+#define MINDSPORE_CORE_UTILS_COMPILE_PROFILER_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+struct CompileProfileEvent {
+  std::string name;
+  std::string category;
+  int depth{0};
+  // seconds from the beginning of the profile
+  double start{0};
+  double duration{0};
+  // number of graph nodes, -1 if they are not counted
+  int64_t nodes_before{-1};
+  int64_t nodes_after{-1};
+  // resident memory of the process when the event begins, and its growth until the event ends
+  int64_t rss_kb{0};
+  int64_t rss_delta_kb{0};
+};
+
+// Substitutions are tried on every node, so they are summed up instead of being recorded one event per try.
+struct CompileProfileStat {
+  double time{0};
+  size_t tries{0};
+  size_t hits{0};
+};
+
+// Records the wall time, graph size and memory growth of the stages of a graph compilation: pipeline actions, optimizers,
+// their passes and substitutions. Nothing is recorded out of Begin and End, a stage costs one branch then, so the
+// profiler is always built in and switched on by the context flag enable_compile_profile.
+class CompileProfiler {
+ public:
+  static CompileProfiler &GetInstance();
+
+  // Drop the last profile and start recording the compilation of phase if enable is true.
+  void Begin(const std::string &phase, bool enable);
+  void End();
+  bool enabled() const { return enabled_; }
+
+  // Open an event nested in the events still open, returns its index for Close.
+  size_t Open(const std::string &name, const std::string &category, int64_t nodes);
+  void Close(size_t index, int64_t nodes);
+  void AddStat(const std::string &name, double time, size_t tries, size_t hits);
+
+  const std::vector<CompileProfileEvent> &events() const { return events_; }
+  const std::map<std::string, CompileProfileStat> &stats() const { return stats_; }
+  // The events in the Chrome trace event format, which can be loaded by chrome://tracing.
+  std::string ChromeTrace() const;
+  // The events and the substitution stats as a json object.
+  std::string Summary() const;
+  bool SaveChromeTrace(const std::string &file_path) const;
+
+ private:
+  CompileProfiler() = default;
+
+  bool enabled_{false};
+  std::string phase_;
+  double begin_time_{0};
+  int depth_{0};
+  std::vector<CompileProfileEvent> events_;
+  std::map<std::string, CompileProfileStat> stats_;
+};
+
+// Records an event of the compile profile for the lifetime of the scope. count_nodes is only called when the profiler
+// is enabled.
+class CompileProfileScope {
+ public:
+  CompileProfileScope(const std::string &name, const std::string &category,
+                      const std::function<int64_t()> &count_nodes = nullptr);
+  ~CompileProfileScope();
+  CompileProfileScope(const CompileProfileScope &) = delete;
+  CompileProfileScope &operator=(const CompileProfileScope &) = delete;
+
+ private:
+  bool active_{false};
+  size_t index_{0};
+  std::function<int64_t()> count_nodes_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_UTILS_COMPILE_PROFILER_H_
@@ -25,6 +25,7 @@ namespace mindspore {
 std::atomic<bool> thread_1_must_end(false);
 
 std::shared_ptr<MsContext> MsContext::inst_context_ = nullptr;
+thread_local bool MsContext::thread_pynative_infer_ = false;
 std::map<std::string, MsBackendPolicy> MsContext::policy_map_ = {{"ge", kMsBackendGePrior},
                                                                  {"vm", kMsBackendVmOnly},
                                                                  {"ms", kMsBackendMsPrior},
@@ -74,6 +75,8 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   print_file_path_ = "";
   enable_graph_kernel_ = false;
   enable_sparse_ = false;
+  enable_pynative_async_ = false;
+  enable_compile_profile_ = false;
 }
 
 std::shared_ptr<MsContext> MsContext::GetInstance() {
@@ -16,6 +16,7 @@
 
 #ifndef MINDSPORE_CORE_UTILS_MS_CONTEXT_H_
 #define MINDSPORE_CORE_UTILS_MS_CONTEXT_H_
+#include <atomic>
 #include <thread>
 #include <memory>
 #include <map>
@@ -63,8 +64,11 @@ class MsContext {
   int execution_mode() const { return execution_mode_; }
   void set_execution_mode(int execution_mode);
 
-  bool enable_pynative_infer() const { return enable_pynative_infer_; }
+  // The flag is on for the op which is running on this thread, or for every op run on a thread which turned it on
+  // for itself, such as the backend thread of pynative ops.
+  bool enable_pynative_infer() const { return enable_pynative_infer_ || thread_pynative_infer_; }
   void set_enable_pynative_infer(bool enable_pynative_infer) { enable_pynative_infer_ = enable_pynative_infer; }
+  static void set_thread_pynative_infer(bool thread_pynative_infer) { thread_pynative_infer_ = thread_pynative_infer; }
 
   bool enable_pynative_hook() const { return enable_pynative_hook_; }
   void set_enable_pynative_hook(bool enable_pynative_hook) { enable_pynative_hook_ = enable_pynative_hook; }
@@ -158,6 +162,12 @@ class MsContext {
 
   bool enable_sparse() const { return enable_sparse_; }
   void set_enable_sparse(bool enable_sparse) { enable_sparse_ = enable_sparse; }
+
+  bool enable_pynative_async() const { return enable_pynative_async_; }
+  void set_enable_pynative_async(bool enable_pynative_async) { enable_pynative_async_ = enable_pynative_async; }
+
+  bool enable_compile_profile() const { return enable_compile_profile_; }
+  void set_enable_compile_profile(bool enable_compile_profile) { enable_compile_profile_ = enable_compile_profile; }
   static void device_seter(DeviceSeter device) { seter_ = device; }
   static void device_type_seter(DeviceTypeSeter device_type) { device_type_seter_ = device_type; }
 
@@ -172,7 +182,8 @@ class MsContext {
   std::string device_target_;
   uint32_t device_id_;
   int execution_mode_;
-  bool enable_pynative_infer_;
+  std::atomic<bool> enable_pynative_infer_;
+  static thread_local bool thread_pynative_infer_;
   bool enable_pynative_hook_;
   bool save_graphs_flag_;
   std::string save_graphs_path_;
@@ -201,6 +212,8 @@ class MsContext {
   std::string print_file_path_;
   bool enable_graph_kernel_;
   bool enable_sparse_;
+  bool enable_pynative_async_;
+  bool enable_compile_profile_;
 };
 }  // namespace mindspore
 
@@ -54,7 +54,9 @@ class MS_API LiteSession {
 
   /// \brief Compile MindSpore lite model.
   ///
-  /// \note CompileGraph should called before RunGraph.
+  /// \note CompileGraph should called before RunGraph. Sessions compiled from the same model share the packed
+  /// weights of their CPU kernels, each session only owns its activations, so a pool of sessions can serve requests
+  /// in parallel. Sessions with one thread run on the calling thread.
   ///
   /// \param[in] model Define the model to be compiled.
   ///
@@ -78,7 +80,8 @@ class MS_API LiteSession {
   /// \param[in] before Define a call_back_function called before running each node
   /// \param[in] after Define a call_back_function called after running each node
   ///
-  /// \note RunGraph should called after CompileGraph.
+  /// \note RunGraph should called after CompileGraph. The callbacks always see the tensors in NHWC, a tensor kept in
+  /// NHWC4 between kernels is shown as a read only NHWC copy which is valid in the callback only.
   ///
   /// \return ErrorCode of run graph.
   virtual int RunGraph(const KernelCallBack &before = nullptr, const KernelCallBack &after = nullptr) = 0;
@@ -94,6 +97,18 @@ class MS_API LiteSession {
   ///
   /// \return A vector of MindSpore Lite MSTensor.
   virtual std::vector<tensor::MSTensor *> GetOutputsByName(const std::string &node_name) const = 0;
+
+  /// \brief Resize inputs of model, the shapes of the other tensors are inferred again.
+  ///
+  /// \note The data of the resized inputs and of the outputs is freed, get it again by MutableData. The model should
+  /// not be freed before Resize is called. Only the graphs of kernels which support resizing can be resized, the
+  /// shapes are kept when an error is returned.
+  ///
+  /// \param[in] inputs Define the inputs of model to be resized, which are got by GetInputs.
+  /// \param[in] dims Define the new shapes of inputs.
+  ///
+  /// \return ErrorCode of resize inputs.
+  virtual int Resize(const std::vector<tensor::MSTensor *> &inputs, const std::vector<std::vector<int>> &dims) = 0;
 };
 }  // namespace session
 }  // namespace mindspore
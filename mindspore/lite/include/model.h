@@ -47,6 +47,16 @@ class MS_API Model {
   /// \return Pointer of MindSpore Lite Model.
   static std::shared_ptr<Model> Import(const char *model_buf, size_t size);
 
+  /// \brief Static method to create a Model pointer by mapping a model file into memory.
+  ///
+  /// \note The weights are referenced in place instead of being copied, which saves a copy of the model and the
+  /// time to read it. Weights prepacked by the converter are adopted by kernels without being packed again.
+  ///
+  /// \param[in] model_path Define the path of the model file.
+  ///
+  /// \return Pointer of MindSpore Lite Model.
+  static std::shared_ptr<Model> ImportFromFile(const char *model_path);
+
   /// \brief Constructor of MindSpore Lite Model using default value for parameters.
   ///
   /// \return Instance of MindSpore Lite Model.
@@ -73,6 +83,9 @@ class MS_API Model {
   std::shared_ptr<ModelImpl> model_impl();
 
   /// \brief Free MetaGraph in MindSpore Lite Model.
+  ///
+  /// \note Kernels reference the weights prepacked by the converter in the model buffer, so the MetaGraph of such a
+  /// model must not be freed while sessions compiled from it are alive.
   void FreeMetaGraph();
 
  protected:
@@ -17,6 +17,7 @@
 #include "src/common/ms_tensor_utils.h"
 
 #include <vector>
+#include "src/runtime/kernel/arm/nnacl/pack.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -37,5 +38,61 @@ std::vector<MSTensor *> PackToMSTensors(const std::vector<Tensor *> &in_tensors)
   }
   return ret;
 }
+
+namespace {
+// a read only NHWC view of a NHWC4 tensor
+class NhwcTensorView : public LiteTensor {
+ public:
+  explicit NhwcTensorView(Tensor *nhwc4_tensor)
+      : LiteTensor(new Tensor(nhwc4_tensor->data_type(), nhwc4_tensor->shape(), schema::Format_NHWC,
+                              nhwc4_tensor->TensorType())),
+        nhwc4_tensor_(nhwc4_tensor) {}
+
+  ~NhwcTensorView() override = default;
+
+  void *MutableData() const override {
+    auto *nhwc_tensor = this->tensor();
+    if (nhwc_tensor->Data() == nullptr) {
+      if (nhwc4_tensor_->Data() == nullptr || nhwc_tensor->MallocData() != 0) {
+        return nullptr;
+      }
+      PackNHWC4ToNHWCFp32(nhwc4_tensor_->Data(), nhwc_tensor->Data(), nhwc_tensor->Batch(),
+                          nhwc_tensor->Height() * nhwc_tensor->Width(), nhwc_tensor->Channel());
+    }
+    return nhwc_tensor->Data();
+  }
+
+ private:
+  Tensor *nhwc4_tensor_;
+};
+}  // namespace
+
+std::vector<MSTensor *> PackToNhwcMSTensors(const std::vector<Tensor *> &in_tensors) {
+  std::vector<MSTensor *> ret;
+  for (auto *lite_tensor : in_tensors) {
+    MS_ASSERT(lite_tensor != nullptr);
+    MSTensor *ms_tensor = nullptr;
+    if (lite_tensor->GetFormat() == schema::Format_NHWC4 && lite_tensor->data_type() == kNumberTypeFloat32) {
+      ms_tensor = new (std::nothrow) NhwcTensorView(lite_tensor);
+    } else {
+      ms_tensor = new (std::nothrow) LiteTensor(lite_tensor);
+    }
+    if (ms_tensor == nullptr) {
+      MS_LOG(ERROR) << "new LiteTensor failed";
+      return ret;
+    }
+    ret.emplace_back(ms_tensor);
+  }
+  return ret;
+}
+
+void FreeNhwcMSTensors(const std::vector<MSTensor *> &ms_tensors) {
+  for (auto *ms_tensor : ms_tensors) {
+    // the other tensors wrap the tensors of the kernels
+    if (dynamic_cast<NhwcTensorView *>(ms_tensor) != nullptr) {
+      delete ms_tensor;
+    }
+  }
+}
 }  // namespace tensor
 }  // namespace mindspore
@@ -24,6 +24,13 @@
 namespace mindspore {
 namespace tensor {
 std::vector<MSTensor *> PackToMSTensors(const std::vector<mindspore::lite::tensor::Tensor *> &in_tensors);
+
+// Packs the tensors for the callbacks of RunGraph, which read them as NHWC. A tensor kept in NHWC4 between kernels is
+// shown through a NHWC copy, which is only made when the callback reads its data.
+std::vector<MSTensor *> PackToNhwcMSTensors(const std::vector<mindspore::lite::tensor::Tensor *> &in_tensors);
+
+// Frees the NHWC copies of PackToNhwcMSTensors, they are valid in the callback only.
+void FreeNhwcMSTensors(const std::vector<MSTensor *> &ms_tensors);
 }
 }  // namespace mindspore
 
@@ -34,7 +34,9 @@ int Executor::Run(std::vector<tensor::Tensor *> &inputs, std::vector<tensor::Ten
       return RET_ERROR;
     }
   }
-  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  if (!static_memory_) {
+    kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  }
   for (auto *kernel : kernels) {
     MS_ASSERT(nullptr != kernel);
     auto &outputs = kernel->GetOutputs();
@@ -47,9 +49,13 @@ int Executor::Run(std::vector<tensor::Tensor *> &inputs, std::vector<tensor::Ten
     callbackParam.type_callback_param = kernel->type_str();
 
     if (before != nullptr) {
-      if (!before(PackToMSTensors(kernel->GetInputs()), PackToMSTensors(kernel->GetOutputs()), callbackParam)) {
+      auto callback_inputs = PackToNhwcMSTensors(kernel->GetInputs());
+      auto callback_outputs = PackToNhwcMSTensors(kernel->GetOutputs());
+      if (!before(callback_inputs, callback_outputs, callbackParam)) {
         MS_LOG(ERROR) << "run kernel before_callback failed, name: " << kernel->Name();
       }
+      FreeNhwcMSTensors(callback_inputs);
+      FreeNhwcMSTensors(callback_outputs);
     }
     auto ret = kernel->Run();
     if (0 != ret) {
@@ -58,9 +64,16 @@ int Executor::Run(std::vector<tensor::Tensor *> &inputs, std::vector<tensor::Ten
     }
 
     if (after != nullptr) {
-      if (!after(PackToMSTensors(kernel->GetInputs()), PackToMSTensors(kernel->GetOutputs()), callbackParam)) {
+      auto callback_inputs = PackToNhwcMSTensors(kernel->GetInputs());
+      auto callback_outputs = PackToNhwcMSTensors(kernel->GetOutputs());
+      if (!after(callback_inputs, callback_outputs, callbackParam)) {
         MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->Name();
       }
+      FreeNhwcMSTensors(callback_inputs);
+      FreeNhwcMSTensors(callback_outputs);
+    }
+    if (static_memory_) {
+      continue;
     }
     for (auto input_kernel : kernel->GetInKernels()) {
       MS_EXCEPTION_IF_NULL(input_kernel);
@@ -29,6 +29,9 @@ class Executor {
 
   int Prepare(std::vector<kernel::LiteKernel *> &kernels) { return 0; }
 
+  // The outputs of the kernels are planned by MemoryPlanner, they are neither malloced nor freed when running.
+  void set_static_memory(bool static_memory) { static_memory_ = static_memory; }
+
   int Run(std::vector<tensor::Tensor *> &inputs, std::vector<tensor::Tensor *> &outputs,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr);
@@ -42,6 +45,7 @@ class Executor {
 
  protected:
   Context *context = nullptr;
+  bool static_memory_ = false;
 };
 
 }  // namespace mindspore::lite
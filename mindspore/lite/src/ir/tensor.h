@@ -147,15 +147,36 @@ class Tensor : public mindspore::tensor::MetaTensor {
       free(this->data_);
     } else {
       allocator_->Free(this->data_);
-      this->data_ = nullptr;
     }
+    this->data_ = nullptr;
 
     return 0;
   }
 
   void *Data() { return data_; }
 
-  void SetData(void *data) { this->data_ = data; }
+  void SetData(void *data) {
+    this->data_ = data;
+    this->model_weight_ = false;
+  }
+
+  // weights packed by the converter for the kernel which consumes the tensor, they are not owned by the tensor
+  void SetPackedData(schema::PackedWeightLayout layout, void *data, size_t size) {
+    this->packed_layout_ = layout;
+    this->packed_data_ = data;
+    this->packed_size_ = size;
+  }
+
+  schema::PackedWeightLayout PackedLayout() const { return this->packed_layout_; }
+
+  void *PackedData() const { return this->packed_data_; }
+
+  size_t PackedSize() const { return this->packed_size_; }
+
+  // the data is a weight in a model buffer, which does not change while the model is alive
+  void SetModelWeight(bool model_weight) { this->model_weight_ = model_weight; }
+
+  bool IsModelWeight() const { return this->model_weight_; }
 
   schema::NodeType TensorType() { return this->tensorType; }
 
@@ -178,6 +199,10 @@ class Tensor : public mindspore::tensor::MetaTensor {
  protected:
   void *data_ = nullptr;
   void *device_data_ = nullptr;
+  schema::PackedWeightLayout packed_layout_ = schema::PackedWeightLayout_NONE;
+  void *packed_data_ = nullptr;
+  size_t packed_size_ = 0;
+  bool model_weight_ = false;
   schema::NodeType tensorType;
   schema::Format format_;
   size_t refCount = 0;
@@ -67,6 +67,14 @@ class LiteKernel {
   virtual int Init() { return -1; }
   virtual int ReSize() { return -1; }
   virtual int Run() { return -1; }
+  // Whether ReSize updates everything the kernel derived from the shapes of its tensors in Init, so it runs right at
+  // the shapes inferred again for new input shapes. LiteSession::Resize fails on a graph with any other kernel.
+  virtual bool SupportResize() const { return false; }
+
+  // The formats the kernel reads its first input in and writes its first output in, the scheduler keeps the tensors
+  // between kernels in NHWC4 only where both sides support it.
+  virtual bool SupportInputFormat(schema::Format format) const { return format == schema::Format_NHWC; }
+  virtual bool SupportOutputFormat(schema::Format format) const { return format == schema::Format_NHWC; }
 
   std::string Name() { return this->name; }
   virtual void train() { train_mode = true; }
@@ -63,6 +63,12 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
       MS_ASSERT(dstTensor->Size() == srcTensor->data()->size());
       // no copy data, do copy when call LiteKernel::Init
       dstTensor->SetData(const_cast<unsigned char *>(srcTensor->data()->data()));
+      dstTensor->SetModelWeight(true);
+      if (srcTensor->packedLayout() != schema::PackedWeightLayout_NONE && srcTensor->packedData() != nullptr) {
+        dstTensor->SetPackedData(srcTensor->packedLayout(),
+                                 const_cast<unsigned char *>(srcTensor->packedData()->data()),
+                                 srcTensor->packedData()->size());
+      }
     }
     this->tensors.emplace_back(dstTensor);
   }
@@ -126,6 +132,16 @@ void LiteSession::InitGraphInOutTensor(const lite::Model *model) {
   }
 }
 
+void LiteSession::PlanMemory() {
+  if (context_->device_ctx_.type != DT_CPU) {
+    return;
+  }
+  auto ret = memory_planner_.Plan(kernels, graph_outputs_);
+  if (ret != RET_OK) {
+    MS_LOG(INFO) << "The intermediate tensors are not planned, they are malloced when running the graph.";
+  }
+}
+
 int LiteSession::CompileGraph(Model *model) {
   // model.MetaGraph ==> kernels
   if (model == nullptr) {
@@ -149,6 +165,18 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  auto meta_graph = model->GetMetaGraph();
+  MS_ASSERT(meta_graph != nullptr);
+  for (size_t i = 0; i < meta_graph->outputIndex()->size(); i++) {
+    auto out_tensor_index = size_t(meta_graph->outputIndex()->GetAs<uint32_t>(i));
+    MS_ASSERT(out_tensor_index < this->tensors.size());
+    graph_outputs_.emplace_back(this->tensors.at(out_tensor_index));
+  }
+  for (auto *kernel : kernels) {
+    primitives_.emplace_back(model->GetOp(kernel->Name()));
+  }
+  PlanMemory();
+
   return RET_OK;
 }
 
@@ -169,6 +197,7 @@ int LiteSession::RunGraph(const session::KernelCallBack &before, const session::
   MS_EXCEPTION_IF_NULL(this->context_);
   SetMaxWokerNum(context_->thread_num_);
   Executor executor;
+  executor.set_static_memory(memory_planner_.planned());
   if (before == nullptr && after == nullptr) {
     return executor.Run(this->inputs, this->outputs, this->kernels, this->context_->allocator.get());
   } else {
@@ -176,6 +205,105 @@ int LiteSession::RunGraph(const session::KernelCallBack &before, const session::
   }
 }
 
+int LiteSession::InferKernelShapes() {
+  for (size_t i = 0; i < kernels.size(); i++) {
+    auto *kernel = kernels[i];
+    MS_ASSERT(kernel != nullptr);
+    // the outputs malloced by the last run, or kept as graph outputs, have the old sizes
+    for (auto *output : kernel->GetOutputs()) {
+      output->FreeData();
+    }
+    auto *primitive = primitives_.at(i);
+    if (primitive == nullptr) {
+      MS_LOG(ERROR) << "Primitive of kernel " << kernel->Name() << " is not found, it can not be resized.";
+      return RET_ERROR;
+    }
+    auto ret = primitive->InferShape(kernel->GetInputs(), kernel->GetOutputs());
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "InferShape failed, name: " << kernel->Name() << ", type: " << kernel->type_str();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int LiteSession::ResizeKernels() {
+  for (auto *kernel : kernels) {
+    auto ret = kernel->ReSize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "ReSize failed, name: " << kernel->Name() << ", type: " << kernel->type_str();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
+                        const std::vector<std::vector<int>> &dims) {
+  if (inputs.size() != dims.size()) {
+    MS_LOG(ERROR) << "Size of inputs " << inputs.size() << " is not equal to size of dims " << dims.size();
+    return RET_PARAM_INVALID;
+  }
+  if (context_->device_ctx_.type != DT_CPU) {
+    MS_LOG(ERROR) << "Resize is only supported on cpu.";
+    return RET_ERROR;
+  }
+  for (auto *kernel : kernels) {
+    if (!kernel->SupportResize()) {
+      MS_LOG(ERROR) << "Kernel " << kernel->Name() << " of type " << kernel->type_str() << " does not support resize.";
+      return RET_ERROR;
+    }
+  }
+  auto graph_inputs = GetInputs();
+  std::vector<tensor::Tensor *> in_tensors;
+  std::vector<std::vector<int>> old_dims;
+  bool changed = false;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i] == nullptr || !IsContain(graph_inputs, inputs[i])) {
+      MS_LOG(ERROR) << "The " << i << "th tensor to resize is not an input of the graph.";
+      return RET_PARAM_INVALID;
+    }
+    auto *in_tensor = static_cast<tensor::LiteTensor *>(inputs[i])->tensor();
+    MS_ASSERT(in_tensor != nullptr);
+    in_tensors.emplace_back(in_tensor);
+    old_dims.emplace_back(in_tensor->shape());
+    changed = changed || in_tensor->shape() != dims[i];
+  }
+  if (!changed) {
+    return RET_OK;
+  }
+  for (size_t i = 0; i < in_tensors.size(); i++) {
+    in_tensors[i]->FreeData();
+    in_tensors[i]->set_shape(dims[i]);
+  }
+  memory_planner_.Unbind();
+  Scheduler::ResetLayout(kernels);
+  // The kernels are untouched until every shape is inferred, so a graph the new shapes do not fit is restored by
+  // inferring the old shapes only. Kernels are resized back only when one of them fails to resize, e.g. out of memory.
+  auto ret = InferKernelShapes();
+  bool kernels_resized = ret == RET_OK;
+  if (kernels_resized) {
+    ret = ResizeKernels();
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Resize the graph failed, restore the shapes of the inputs.";
+    for (size_t i = 0; i < in_tensors.size(); i++) {
+      in_tensors[i]->set_shape(old_dims[i]);
+    }
+    auto restore_ret = InferKernelShapes();
+    if (restore_ret == RET_OK && kernels_resized) {
+      restore_ret = ResizeKernels();
+    }
+    if (restore_ret != RET_OK) {
+      MS_LOG(ERROR) << "Restore the shapes of the graph failed.";
+      return ret;
+    }
+  }
+  Scheduler::PropagateLayout(kernels, graph_outputs_);
+  PlanMemory();
+  return ret;
+}
+
 std::vector<mindspore::tensor::MSTensor *> LiteSession::GetOutputs() const {
   std::vector<mindspore::tensor::MSTensor *> ret;
   for (auto &iter : this->output_map) {
@@ -219,6 +347,7 @@ void LiteSession::BindThread(bool ifBind) {
 }
 
 LiteSession::~LiteSession() {
+  memory_planner_.Release();
   for (auto *tensor : tensors) {
     // weight data can not be to free, we will free weight data when freeing meta_graph
     if (tensor->TensorType() == schema::NodeType_ValueNode && !IsContain(this->inputs, tensor)) {
@@ -26,6 +26,7 @@
 #include "include/model.h"
 #include "include/context.h"
 #include "src/lite_kernel.h"
+#include "src/runtime/memory_planner.h"
 #include "schema/model_generated.h"
 
 namespace mindspore {
@@ -53,14 +54,28 @@ class LiteSession : public session::LiteSession {
 
   std::vector<mindspore::tensor::MSTensor *> GetOutputsByName(const std::string &name) const override;
 
+  int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs,
+             const std::vector<std::vector<int>> &dims) override;
+
+  // Bytes of the arena planned for the intermediate tensors, 0 if they are malloced when running.
+  size_t GetPlannedMemorySize() const { return memory_planner_.planned_size(); }
+
  protected:
   int ConvertTensors(const lite::Model *model);
 
   void InitGraphInOutTensor(const lite::Model *model);
 
+  void PlanMemory();
+
+  int InferKernelShapes();
+
+  int ResizeKernels();
+
  protected:
   Context *context_ = nullptr;
   std::vector<kernel::LiteKernel *> kernels;
+  // primitives of kernels to infer the shapes again when resizing
+  std::vector<lite::Primitive *> primitives_;
   std::vector<tensor::Tensor *> tensors;
   // graph input tensors
   std::vector<tensor::Tensor *> inputs;
@@ -70,6 +85,8 @@ class LiteSession : public session::LiteSession {
   std::unordered_map<std::string, std::vector<mindspore::tensor::MSTensor *>> input_map;
   // graph output node name -- output tensors
   std::unordered_map<std::string, std::vector<mindspore::tensor::MSTensor *>> output_map;
+  std::vector<tensor::Tensor *> graph_outputs_;
+  MemoryPlanner memory_planner_;
 };
 }  // namespace lite
 }  // namespace mindspore
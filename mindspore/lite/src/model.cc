@@ -19,6 +19,8 @@
 #else
 #include "src/model_impl.h"
 #endif
+#include <fstream>
+#include <string>
 #include "include/model.h"
 #include "utils/log_adapter.h"
 
@@ -30,6 +32,25 @@ std::shared_ptr<Model> Model::Import(const char *model_buf, size_t size) {
   return model;
 }
 
+std::shared_ptr<Model> Model::ImportFromFile(const char *model_path) {
+  MS_EXCEPTION_IF_NULL(model_path);
+  auto model = std::make_shared<Model>();
+#ifdef SUPPORT_TRAIN
+  std::ifstream ifs(model_path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+  if (!ifs.good()) {
+    MS_LOG(ERROR) << "Open model file " << model_path << " failed.";
+    return model;
+  }
+  std::string model_buf(static_cast<size_t>(ifs.tellg()), '\0');
+  ifs.seekg(0, std::ios::beg);
+  ifs.read(&model_buf[0], model_buf.size());
+  model->model_impl_ = ModelImpl::Import(model_buf.data(), model_buf.size());
+#else
+  model->model_impl_ = ModelImpl::ImportFromFile(model_path);
+#endif
+  return model;
+}
+
 lite::Primitive *Model::GetOp(const std::string &name) const {
   MS_EXCEPTION_IF_NULL(model_impl_);
   return const_cast<Primitive *>(model_impl_->GetOp(name));
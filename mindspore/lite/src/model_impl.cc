@@ -14,9 +14,14 @@
  * limitations under the License.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <memory>
 #include <string>
 #include "src/model_impl.h"
+#include "src/runtime/weight_cache.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore::lite {
@@ -46,6 +51,43 @@ std::shared_ptr<ModelImpl> ModelImpl::Import(const char *model_buf, size_t size)
   return model;
 }
 
+std::shared_ptr<ModelImpl> ModelImpl::ImportFromFile(const char *model_path) {
+  MS_EXCEPTION_IF_NULL(model_path);
+  int fd = open(model_path, O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open model file " << model_path << " failed.";
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Get size of model file " << model_path << " failed.";
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // writable so that kernels may still transform weights in place, the written pages are copied on write
+  auto model_buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (model_buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map model file " << model_path << " failed.";
+    return nullptr;
+  }
+  flatbuffers::Verifier verify(reinterpret_cast<const uint8_t *>(model_buf), size);
+  if (!schema::VerifyMetaGraphBuffer(verify)) {
+    MS_LOG(ERROR) << "The model file " << model_path << " is invalid and fail to create graph.";
+    munmap(model_buf, size);
+    return nullptr;
+  }
+  auto model = std::make_shared<ModelImpl>(reinterpret_cast<const char *>(model_buf), size);
+  model->buf_mapped_ = true;
+  auto ret = model->BuildOps();
+  if (0 != ret) {
+    MS_LOG(ERROR) << "BuildOps failed";
+    return nullptr;
+  }
+  return model;
+}
+
 lite::Primitive *ModelImpl::GetOp(const std::string &name) const {
   auto iter = ops.find(name);
   if (iter == ops.end()) {
@@ -56,15 +98,26 @@ lite::Primitive *ModelImpl::GetOp(const std::string &name) const {
 }
 
 ModelImpl::~ModelImpl() {
-  delete[](this->model_buf_);
+  FreeModelBuf();
   for (auto iter : ops) {
     delete (iter.second);
   }
   ops.clear();
 }
 
-void ModelImpl::FreeMetaGraph() {
-  delete[](this->model_buf_);
+void ModelImpl::FreeMetaGraph() { FreeModelBuf(); }
+
+void ModelImpl::FreeModelBuf() {
+  if (model_buf_ == nullptr) {
+    return;
+  }
+  // the address may be reused by another model
+  WeightCache::GetInstance()->Invalidate(model_buf_, buf_size_);
+  if (buf_mapped_) {
+    munmap(const_cast<char *>(model_buf_), buf_size_);
+  } else {
+    delete[](this->model_buf_);
+  }
   model_buf_ = nullptr;
 }
 
@@ -218,6 +271,8 @@ lite::Primitive *ModelImpl::CopyPrimitive(const schema::Primitive *srcPrim) {
       return new lite::QuantDTypeCast(const_cast<schema::Primitive *>(srcPrim));
     case schema::PrimitiveType_EmbeddingLookup:
       return new lite::EmbeddingLookup(const_cast<schema::Primitive *>(srcPrim));
+    case schema::PrimitiveType_LayerNorm:
+      return new lite::LayerNorm(const_cast<schema::Primitive *>(srcPrim));
     default:
       break;
   }
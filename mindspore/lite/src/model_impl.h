@@ -28,6 +28,9 @@ namespace lite {
 class ModelImpl {
  public:
   static std::shared_ptr<ModelImpl> Import(const char *model_buf, size_t size);
+  // Map the model file privately instead of reading it, the pages are loaded on first access and stay shared with the
+  // page cache until they are written.
+  static std::shared_ptr<ModelImpl> ImportFromFile(const char *model_path);
   ModelImpl() = default;
   explicit ModelImpl(const char *model_buf, size_t size) : model_buf_(model_buf), buf_size_(size) {
     meta_graph = schema::GetMetaGraph(model_buf);
@@ -40,10 +43,12 @@ class ModelImpl {
 
  protected:
   lite::Primitive *CopyPrimitive(const schema::Primitive *srcPrim);
+  void FreeModelBuf();
 
  protected:
-  const char *model_buf_;
-  size_t buf_size_;
+  const char *model_buf_ = nullptr;
+  size_t buf_size_ = 0;
+  bool buf_mapped_ = false;
   const schema::MetaGraph *meta_graph = nullptr;
   std::map<std::string, lite::Primitive *> ops;
 };
@@ -785,6 +785,12 @@ class EmbeddingLookup : public Primitive {
   const schema::EmbeddingLookup *GetAttribute() const { return this->primitive->value_as_EmbeddingLookup(); }
   int InferShape(std::vector<tensor::Tensor *> inputs_, std::vector<tensor::Tensor *> outputs_) override;
 };
+
+class LayerNorm : public Primitive {
+ public:
+  explicit LayerNorm(schema::Primitive *primitive) : Primitive(primitive) {}
+  const schema::LayerNorm *GetAttribute() const { return this->primitive->value_as_LayerNorm(); }
+};
 }  // namespace lite
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_OPS_OPS_H_
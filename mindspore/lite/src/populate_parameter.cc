@@ -70,6 +70,7 @@
 #include "src/runtime/kernel/arm/nnacl/int8/quant_dtype_cast.h"
 #include "src/runtime/kernel/arm/nnacl/fp32/lstm.h"
 #include "src/runtime/kernel/arm/nnacl/fp32/embedding_lookup.h"
+#include "src/runtime/kernel/arm/nnacl/fp32/layer_norm.h"
 
 namespace mindspore::kernel {
 OpParameter *PopulateBatchNorm(const lite::Primitive *primitive) {
@@ -1227,6 +1228,20 @@ OpParameter *PopulateEmbeddingLookupParameter(const lite::Primitive *primitive)
   return reinterpret_cast<OpParameter *>(embedding_lookup_parameter);
 }
 
+OpParameter *PopulateLayerNormParameter(const lite::Primitive *primitive) {
+  LayerNormParameter *layer_norm_param = new (std::nothrow) LayerNormParameter();
+  if (layer_norm_param == nullptr) {
+    MS_LOG(ERROR) << "new LayerNormParameter failed.";
+    return nullptr;
+  }
+  layer_norm_param->op_parameter_.type_ = primitive->Type();
+  auto layer_norm_attr = primitive->Value()->value_as_LayerNorm();
+  layer_norm_param->begin_norm_axis_ = layer_norm_attr->beginNormAxis();
+  layer_norm_param->epsilon_ = layer_norm_attr->epsilon();
+  layer_norm_param->elementwise_affine_ = layer_norm_attr->elementwiseAffine();
+  return reinterpret_cast<OpParameter *>(layer_norm_param);
+}
+
 PopulateParameterRegistry::PopulateParameterRegistry() {
   populate_parameter_funcs_[schema::PrimitiveType_SoftMax] = PopulateSoftmaxParameter;
   populate_parameter_funcs_[schema::PrimitiveType_Activation] = PopulateActivationParameter;
@@ -1305,6 +1320,7 @@ PopulateParameterRegistry::PopulateParameterRegistry() {
   populate_parameter_funcs_[schema::PrimitiveType_QuantDTypeCast] = PopulateQuantDTypeCastParameter;
   populate_parameter_funcs_[schema::PrimitiveType_Lstm] = PopulateLstmParameter;
   populate_parameter_funcs_[schema::PrimitiveType_EmbeddingLookup] = PopulateEmbeddingLookupParameter;
+  populate_parameter_funcs_[schema::PrimitiveType_LayerNorm] = PopulateLayerNormParameter;
 }
 
 PopulateParameterRegistry *PopulateParameterRegistry::GetInstance() {
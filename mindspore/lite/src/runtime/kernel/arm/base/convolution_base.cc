@@ -103,6 +103,22 @@ int ConvolutionBaseCPUKernel::CheckLayout(lite::tensor::Tensor *input_tensor) {
   return RET_OK;
 }
 
+bool ConvolutionBaseCPUKernel::IsNhwc4Input() {
+  auto input_format = inputs_.at(kInputIndex)->GetFormat();
+  return input_format == schema::Format_NHWC4 ||
+         (input_format == schema::Format_NHWC && conv_param_->input_channel_ % C4NUM == 0);
+}
+
+void *ConvolutionBaseCPUKernel::Nhwc4Input() {
+  auto ori_input_data = inputs_.at(kInputIndex)->Data();
+  if (IsNhwc4Input()) {
+    return ori_input_data;
+  }
+  convert_func_(ori_input_data, nhwc4_input_, conv_param_->input_batch_,
+                conv_param_->input_h_ * conv_param_->input_w_, conv_param_->input_channel_);
+  return nhwc4_input_;
+}
+
 int ConvolutionBaseCPUKernel::SetQuantParam() {
   ConvQuantArg *conv_quant_arg_ = &conv_param_->conv_quant_arg_;
   conv_quant_arg_->quant_args_ = reinterpret_cast<QuantArg **>(malloc(3 * sizeof(QuantArg *)));
@@ -48,6 +48,10 @@ class ConvolutionBaseCPUKernel : public LiteKernel {
   int ReSize() override { return 0; }
   int Run() override { return 0; }
   virtual int CheckLayout(lite::tensor::Tensor *input_tensor);
+  // true if the input can be read as NHWC4 as it is: it is in NHWC4 or its NHWC channel is aligned to C4NUM
+  bool IsNhwc4Input();
+  // the input data if IsNhwc4Input, otherwise the input converted into nhwc4_input_ by convert_func_
+  void *Nhwc4Input();
   int SetQuantParam();
   void FreeQuantParam();
 
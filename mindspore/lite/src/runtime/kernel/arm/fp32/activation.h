@@ -34,6 +34,7 @@ class ActivationCPUKernel : public LiteKernel {
 
   int Init() override;
   int ReSize() override;
+  bool SupportResize() const override { return true; }
   int Run() override;
   int DoActivation(int task_id);
 
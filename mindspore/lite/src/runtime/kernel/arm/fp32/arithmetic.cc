@@ -49,7 +49,37 @@ int ArithmeticCPUKernel::Init() {
   return RET_OK;
 }
 
-int ArithmeticCPUKernel::ReSize() { return RET_OK; }
+int ArithmeticCPUKernel::ReSize() {
+  // the broadcast shapes were populated from the primitive for the old input shapes
+  auto in_shape0 = inputs_[0]->shape();
+  auto in_shape1 = inputs_[1]->shape();
+  auto out_shape = outputs_[0]->shape();
+  size_t ndim = out_shape.size();
+  if (ndim > sizeof(arithmeticParameter_->out_shape_) / sizeof(int) || in_shape0.size() > ndim ||
+      in_shape1.size() > ndim) {
+    MS_LOG(ERROR) << "Arithmetic does not support output rank " << ndim << " with input ranks " << in_shape0.size()
+                  << " and " << in_shape1.size();
+    return RET_ERROR;
+  }
+  arithmeticParameter_->ndim_ = ndim;
+  arithmeticParameter_->broadcasting_ = false;
+  for (size_t i = 0; i < ndim; i++) {
+    // the input of a lower rank is filled with leading ones
+    auto fill0 = ndim - in_shape0.size();
+    auto fill1 = ndim - in_shape1.size();
+    arithmeticParameter_->in_shape0_[i] = i < fill0 ? 1 : in_shape0[i - fill0];
+    arithmeticParameter_->in_shape1_[i] = i < fill1 ? 1 : in_shape1[i - fill1];
+    arithmeticParameter_->out_shape_[i] = out_shape[i];
+    if (arithmeticParameter_->in_shape0_[i] != arithmeticParameter_->in_shape1_[i]) {
+      arithmeticParameter_->broadcasting_ = true;
+    }
+  }
+  delete[](tile_data0_);
+  delete[](tile_data1_);
+  tile_data0_ = nullptr;
+  tile_data1_ = nullptr;
+  return Init();
+}
 
 int ArithmeticCPUKernel::DoArithmetic(int task_id) {
   auto input0_data = reinterpret_cast<float *>(inputs_[0]->Data());
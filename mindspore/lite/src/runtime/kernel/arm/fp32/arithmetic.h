@@ -168,6 +168,7 @@ class ArithmeticCPUKernel : public LiteKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportResize() const override { return true; }
   int DoArithmetic(int task_id);
 
  private:
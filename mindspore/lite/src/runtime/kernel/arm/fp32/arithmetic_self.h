@@ -89,6 +89,7 @@ class ArithmeticSelfCPUKernel : public LiteKernel {
 
   int Init() override;
   int ReSize() override;
+  bool SupportResize() const override { return true; }
   int Run() override;
   int DoArithmeticSelf(int task_id);
 
@@ -24,6 +24,7 @@
 #include "src/kernel_factory.h"
 #include "include/errorcode.h"
 #include "src/runtime/runtime_api.h"
+#include "src/runtime/weight_cache.h"
 
 using mindspore::kernel::KERNEL_ARCH::kCPU;
 using mindspore::lite::KernelRegistrar;
@@ -49,15 +50,25 @@ int ConvolutionCPUKernel::InitWeightBias() {
 #endif
   int pack_weight_size = oc_block_num * oc_block * ic4 * C4NUM * kernel_plane;
 
-  // init weight
-  auto origin_weight = reinterpret_cast<float *>(inputs_.at(kWeightIndex)->Data());
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed weight failed.";
-    return RET_ERROR;
+  // init weight, adopt the weight packed by the converter in the model buffer if the layout matches
+  auto weight_tensor = inputs_.at(kWeightIndex);
+  if (oc_block == C8NUM && weight_tensor->PackedLayout() == schema::PackedWeightLayout_CONV_FP32_OC8_IC4 &&
+      weight_tensor->PackedSize() == pack_weight_size * sizeof(float)) {
+    packed_weight_ = reinterpret_cast<float *>(weight_tensor->PackedData());
+    own_packed_weight_ = false;
+  } else {
+    auto origin_weight = reinterpret_cast<float *>(weight_tensor->Data());
+    auto conv_param = conv_param_;
+    packed_weight_ = reinterpret_cast<float *>(lite::WeightCache::GetInstance()->Acquire(
+      weight_tensor, "conv_fp32_oc" + std::to_string(oc_block), pack_weight_size * sizeof(float),
+      [origin_weight, conv_param, oc_block, oc_block_num](void *dst) {
+        PackWeightFp32(origin_weight, conv_param, reinterpret_cast<float *>(dst), oc_block, oc_block_num);
+      }));
+    if (packed_weight_ == nullptr) {
+      MS_LOG(ERROR) << "malloc packed weight failed.";
+      return RET_ERROR;
+    }
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
-  PackWeightFp32(origin_weight, conv_param_, packed_weight_, oc_block, oc_block_num);
 
   // init bias
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * oc_block * sizeof(float)));
@@ -98,14 +109,17 @@ int ConvolutionCPUKernel::InitTmpBuffer() {
   memset(packed_input_, 0, in_batch * packed_input_size * sizeof(float));
 
   /*=============================nhwc4_input_============================*/
-  size_t nhwc4_input_size =
-    ic4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
-  nhwc4_input_ = malloc(nhwc4_input_size);
-  if (nhwc4_input_ == nullptr) {
-    MS_LOG(ERROR) << "malloc nhwc4 input failed.";
-    return RET_ERROR;
+  // an input readable as NHWC4 is not converted
+  if (!IsNhwc4Input()) {
+    size_t nhwc4_input_size =
+      ic4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
+    nhwc4_input_ = malloc(nhwc4_input_size);
+    if (nhwc4_input_ == nullptr) {
+      MS_LOG(ERROR) << "malloc nhwc4 input failed.";
+      return RET_ERROR;
+    }
+    memset(nhwc4_input_, 0, nhwc4_input_size);
   }
-  memset(nhwc4_input_, 0, nhwc4_input_size);
 
   /*=============================tmp_output_block_============================*/
   tmp_output_block_ = reinterpret_cast<float *>(malloc(TILE_NUM * out_channel * sizeof(float)));
@@ -160,12 +174,15 @@ int ConvolutionCPUKernel::Init() {
 int ConvolutionCPUKernel::ReSize() {
   if (packed_input_ != nullptr) {
     free(packed_input_);
+    packed_input_ = nullptr;
   }
   if (tmp_output_block_ != nullptr) {
     free(tmp_output_block_);
+    tmp_output_block_ = nullptr;
   }
   if (nhwc4_input_ != nullptr) {
     free(nhwc4_input_);
+    nhwc4_input_ = nullptr;
   }
 
   auto ret = ConvolutionBaseCPUKernel::Init();
@@ -188,8 +205,8 @@ int ConvolutionCPUKernel::RunImpl(int task_id) {
     return RET_ERROR;
   }
   auto output_addr = reinterpret_cast<float *>(outputs_.at(kOutputIndex)->Data());
-  ConvFp32(reinterpret_cast<float *>(nhwc4_input_), packed_input_, packed_weight_,
-           reinterpret_cast<float *>(bias_data_), tmp_output_block_, output_addr, task_id, conv_param_, gemm_func_);
+  ConvFp32(execute_input_, packed_input_, packed_weight_, reinterpret_cast<float *>(bias_data_), tmp_output_block_,
+           output_addr, task_id, conv_param_, gemm_func_);
   return RET_OK;
 }
 
@@ -204,13 +221,7 @@ int ConvolutionImpl(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
 }
 
 int ConvolutionCPUKernel::Run() {
-  auto input_tensor = inputs_.at(kInputIndex);
-  auto ori_input_data = input_tensor->Data();
-  int in_batch = conv_param_->input_batch_;
-  int in_h = conv_param_->input_h_;
-  int in_w = conv_param_->input_w_;
-  int in_channel = conv_param_->input_channel_;
-  convert_func_(ori_input_data, nhwc4_input_, in_batch, in_h * in_w, in_channel);
+  execute_input_ = reinterpret_cast<float *>(Nhwc4Input());
 
   int error_code = LiteBackendParallelLaunch(ConvolutionImpl, this, thread_count_);
   if (error_code != RET_OK) {
@@ -22,6 +22,7 @@
 #include "src/runtime/kernel/arm/nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "src/runtime/kernel/arm/nnacl/fp32/conv.h"
+#include "src/runtime/weight_cache.h"
 
 namespace mindspore::kernel {
 class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
@@ -33,8 +34,8 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
     if (packed_input_ != nullptr) {
       free(packed_input_);
     }
-    if (packed_weight_ != nullptr) {
-      free(packed_weight_);
+    if (packed_weight_ != nullptr && own_packed_weight_) {
+      lite::WeightCache::GetInstance()->Release(packed_weight_);
     }
     if (tmp_output_block_ != nullptr) {
       free(tmp_output_block_);
@@ -44,15 +45,23 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportResize() const override { return true; }
+  bool SupportInputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || format == schema::Format_NHWC4;
+  }
   int RunImpl(int task_id);
   int InitWeightBias();
   int InitTmpBuffer();
   void ConfigInputOutput();
 
  private:
-  float *packed_input_;
-  float *packed_weight_;
-  float *tmp_output_block_;
+  // the NHWC4 input of the run, the input data or nhwc4_input_
+  float *execute_input_ = nullptr;
+  float *packed_input_ = nullptr;
+  float *packed_weight_ = nullptr;
+  // false if packed_weight_ is adopted from the model buffer
+  bool own_packed_weight_ = true;
+  float *tmp_output_block_ = nullptr;
   GEMM_FUNC_FP32 gemm_func_ = nullptr;
 };
 }  // namespace mindspore::kernel
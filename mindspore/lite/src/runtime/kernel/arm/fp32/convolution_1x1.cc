@@ -16,6 +16,7 @@
 
 #include "src/runtime/kernel/arm/fp32/convolution_1x1.h"
 #include "src/runtime/runtime_api.h"
+#include "src/runtime/weight_cache.h"
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -24,7 +25,7 @@ using mindspore::lite::RET_OK;
 namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   if (weight_ptr_ != nullptr) {
-    free(weight_ptr_);
+    lite::WeightCache::GetInstance()->Release(weight_ptr_);
     weight_ptr_ = nullptr;
   }
   if (pack_input_ != nullptr) {
@@ -47,13 +48,18 @@ int Convolution1x1CPUKernel::ReSize() {
     free(pack_input_);
     pack_input_ = nullptr;
   }
+  if (pack_output_ != nullptr) {
+    free(pack_output_);
+    pack_output_ = nullptr;
+  }
   if (pre_trans_input_ && input_ptr_ != nullptr) {
     free(input_ptr_);
     input_ptr_ = nullptr;
   }
+  // the tensor shapes were inferred again, the packed weight and bias only depend on the channels
+  ConvolutionBaseCPUKernel::Init();
   InitConv1x1MatmulParam();
-  InitConv1x1Param();
-  return RET_OK;
+  return InitConv1x1Param();
 }
 
 void Convolution1x1CPUKernel::InitConv1x1MatmulParam() {
@@ -80,14 +86,18 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
     bias_data_ = nullptr;
   }
 
-  weight_ptr_ = reinterpret_cast<float *>(malloc(matmul_param_->deep_ * matmul_param_->col_8_ * sizeof(float)));
+  auto origin_weight = reinterpret_cast<float *>(inputs_[1]->Data());
+  int col = matmul_param_->col_;
+  int deep = matmul_param_->deep_;
+  weight_ptr_ = reinterpret_cast<float *>(lite::WeightCache::GetInstance()->Acquire(
+    inputs_[1], "conv1x1_fp32_col8", matmul_param_->deep_ * matmul_param_->col_8_ * sizeof(float),
+    [origin_weight, col, deep](void *dst) {
+      RowMajor2Col8Major(origin_weight, reinterpret_cast<float *>(dst), col, deep);
+    }));
   if (weight_ptr_ == nullptr) {
     MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
     return RET_ERROR;
   }
-  memset(weight_ptr_, 0, matmul_param_->deep_ * matmul_param_->col_8_ * sizeof(float));
-  RowMajor2Col8Major(reinterpret_cast<float *>(inputs_[1]->Data()), weight_ptr_, matmul_param_->col_,
-                     matmul_param_->deep_);
   return RET_OK;
 }
 
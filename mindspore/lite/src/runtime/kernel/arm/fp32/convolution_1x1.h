@@ -42,6 +42,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   int Init() override;
   int Run() override;
   int ReSize() override;
+  bool SupportResize() const override { return true; }
 
  public:
   int DoConv1x1(int task_id);
@@ -21,6 +21,7 @@
 #include "src/kernel_registry.h"
 #include "include/errorcode.h"
 #include "src/runtime/runtime_api.h"
+#include "src/runtime/weight_cache.h"
 
 using mindspore::kernel::KERNEL_ARCH::kCPU;
 using mindspore::lite::KernelRegistrar;
@@ -64,14 +65,18 @@ int Convolution3x3CPUKernel::InitWeightBias() {
   int k_plane = 16;
   // init weight
   size_t transformed_size = iC4 * C4NUM * oc_block_num * oc_block * k_plane * sizeof(float);
-  transformed_filter_addr_ = reinterpret_cast<float *>(malloc(transformed_size));
+  auto weight_tensor = inputs_.at(kWeightIndex);
+  auto weight_data = reinterpret_cast<float *>(weight_tensor->Data());
+  auto conv_param = conv_param_;
+  transformed_filter_addr_ = reinterpret_cast<float *>(lite::WeightCache::GetInstance()->Acquire(
+    weight_tensor, "conv3x3_fp32_oc" + std::to_string(oc_block), transformed_size,
+    [weight_data, conv_param, oc_block, oc_block_num](void *dst) {
+      ProcessFilter(weight_data, reinterpret_cast<float *>(dst), conv_param, oc_block, oc_block_num);
+    }));
   if (transformed_filter_addr_ == nullptr) {
     MS_LOG(ERROR) << "malloc transformed filter addr failed.";
     return RET_ERROR;
   }
-  memset(transformed_filter_addr_, 0, transformed_size);
-  auto weight_data = reinterpret_cast<float *>(inputs_.at(kWeightIndex)->Data());
-  ProcessFilter(weight_data, transformed_filter_addr_, conv_param_, oc_block, oc_block_num);
 
   // init bias
   size_t new_bias_size = oC4 * C4NUM * sizeof(float);
@@ -123,14 +128,17 @@ int Convolution3x3CPUKernel::InitTmpBuffer() {
   memset(tmp_dst_buffer_, 0, tmp_dst_buffer_size);
 
   /*=============================nhwc4_input_============================*/
-  size_t nhwc4_input_size =
-    iC4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
-  nhwc4_input_ = malloc(nhwc4_input_size);
-  if (nhwc4_input_ == nullptr) {
-    MS_LOG(ERROR) << "malloc nhwc4_input_ failed.";
-    return RET_ERROR;
+  // an input readable as NHWC4 is not converted
+  if (!IsNhwc4Input()) {
+    size_t nhwc4_input_size =
+      iC4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
+    nhwc4_input_ = malloc(nhwc4_input_size);
+    if (nhwc4_input_ == nullptr) {
+      MS_LOG(ERROR) << "malloc nhwc4_input_ failed.";
+      return RET_ERROR;
+    }
+    memset(nhwc4_input_, 0, nhwc4_input_size);
   }
-  memset(nhwc4_input_, 0, nhwc4_input_size);
 
   /*=============================nc4hw4_out_============================*/
   size_t nc4hw4_out_size =
@@ -197,6 +205,7 @@ int Convolution3x3CPUKernel::ReSize() {
   }
   if (nhwc4_input_ != nullptr) {
     free(nhwc4_input_);
+    nhwc4_input_ = nullptr;
   }
   if (nc4hw4_out_ != nullptr) {
     free(nc4hw4_out_);
@@ -221,8 +230,8 @@ int Convolution3x3CPUKernel::RunImpl(int task_id) {
     return RET_ERROR;
   }
   auto output_addr = reinterpret_cast<float *>(outputs_.at(kOutputIndex)->Data());
-  Conv3x3Fp32(reinterpret_cast<float *>(nhwc4_input_), transformed_filter_addr_, reinterpret_cast<float *>(bias_data_),
-              output_addr, tmp_buffer_address_list_, task_id, conv_param_, gemm_func_);
+  Conv3x3Fp32(execute_input_, transformed_filter_addr_, reinterpret_cast<float *>(bias_data_), output_addr,
+              tmp_buffer_address_list_, task_id, conv_param_, gemm_func_);
   return RET_OK;
 }
 
@@ -237,13 +246,7 @@ int Convolution3x3Impl(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
 }
 
 int Convolution3x3CPUKernel::Run() {
-  auto input_tensor = inputs_.at(kInputIndex);
-  auto ori_input_data = input_tensor->Data();
-  int in_batch = conv_param_->input_batch_;
-  int in_h = conv_param_->input_h_;
-  int in_w = conv_param_->input_w_;
-  int in_channel = conv_param_->input_channel_;
-  convert_func_(ori_input_data, nhwc4_input_, in_batch, in_h * in_w, in_channel);
+  execute_input_ = reinterpret_cast<float *>(Nhwc4Input());
 
   int error_code = LiteBackendParallelLaunch(Convolution3x3Impl, this, thread_count_);
   if (error_code != RET_OK) {
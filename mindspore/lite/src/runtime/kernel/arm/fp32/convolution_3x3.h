@@ -21,6 +21,7 @@
 #include "src/lite_kernel.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "src/runtime/kernel/arm/nnacl/winograd_transform.h"
+#include "src/runtime/weight_cache.h"
 
 namespace mindspore::kernel {
 class Convolution3x3CPUKernel : public ConvolutionBaseCPUKernel {
@@ -30,7 +31,7 @@ class Convolution3x3CPUKernel : public ConvolutionBaseCPUKernel {
       : ConvolutionBaseCPUKernel(parameter, inputs, outputs, ctx) {}
   ~Convolution3x3CPUKernel() override {
     if (transformed_filter_addr_ != nullptr) {
-      free(transformed_filter_addr_);
+      lite::WeightCache::GetInstance()->Release(transformed_filter_addr_);
     }
     if (tile_buffer_ != nullptr) {
       free(tile_buffer_);
@@ -49,12 +50,17 @@ class Convolution3x3CPUKernel : public ConvolutionBaseCPUKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportInputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || format == schema::Format_NHWC4;
+  }
   int RunImpl(int task_id);
   int InitWeightBias();
   int InitTmpBuffer();
   void ConfigInputOutput();
 
  private:
+  // the NHWC4 input of the run, the input data or nhwc4_input_
+  float *execute_input_ = nullptr;
   float *transformed_filter_addr_;
   float *tile_buffer_;
   float *block_unit_buffer_;
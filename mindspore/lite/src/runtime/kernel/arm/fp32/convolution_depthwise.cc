@@ -20,6 +20,7 @@
 #include "src/kernel_registry.h"
 #include "include/errorcode.h"
 #include "src/runtime/runtime_api.h"
+#include "src/runtime/weight_cache.h"
 
 using mindspore::kernel::KERNEL_ARCH::kCPU;
 using mindspore::lite::KernelRegistrar;
@@ -35,14 +36,17 @@ int ConvolutionDepthwiseCPUKernel::InitWeightBias() {
   int OC4 = UP_DIV(conv_param_->output_channel_, C4NUM);
   int pack_weight_size = C4NUM * OC4 * conv_param_->kernel_h_ * conv_param_->kernel_w_;
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  int kernel_plane = conv_param_->kernel_h_ * conv_param_->kernel_w_;
+  int channel = conv_param_->output_channel_;
+  packed_weight_ = reinterpret_cast<float *>(lite::WeightCache::GetInstance()->Acquire(
+    weight_tensor, "conv_dw_fp32_c4", pack_weight_size * sizeof(float),
+    [origin_weight, kernel_plane, channel](void *dst) {
+      PackNCHWToNC4HW4Fp32(origin_weight, dst, 1, kernel_plane, channel);
+    }));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "Malloc buffer failed.";
     return RET_ERROR;
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
-  PackNCHWToNC4HW4Fp32(origin_weight, packed_weight_, 1, conv_param_->kernel_h_ * conv_param_->kernel_w_,
-                       conv_param_->output_channel_);
 
   // init bias
   bias_data_ = reinterpret_cast<float *>(malloc(C4NUM * OC4 * sizeof(float)));
@@ -63,8 +67,8 @@ int ConvolutionDepthwiseCPUKernel::InitWeightBias() {
 
 int ConvolutionDepthwiseCPUKernel::InitBuffer() {
   // malloc pack input and output buffer
-  if (conv_param_->input_channel_ % C4NUM != 0) {
-    need_align_ = true;
+  need_align_ = conv_param_->input_channel_ % C4NUM != 0;
+  if (need_align_) {
     int IC4 = UP_DIV(conv_param_->input_channel_, C4NUM);
     int pack_input_size = conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * C4NUM * IC4;
     packed_input_ = reinterpret_cast<float *>(malloc(pack_input_size * sizeof(float)));
@@ -108,14 +112,19 @@ int ConvolutionDepthwiseCPUKernel::Init() {
 }
 
 int ConvolutionDepthwiseCPUKernel::ReSize() {
-  if (need_align_) {
+  if (packed_input_ != nullptr) {
     free(packed_input_);
+    packed_input_ = nullptr;
+  }
+  if (packed_output_ != nullptr) {
     free(packed_output_);
+    packed_output_ = nullptr;
   }
   // conv base init
   ConvolutionBaseCPUKernel::Init();
 
   // init sliding window param
+  delete sliding_;
   sliding_ = new SlidingWindowParam;
   InitSlidingParam(sliding_, conv_param_, C4NUM);
 
@@ -128,7 +137,7 @@ int ConvolutionDepthwiseCPUKernel::ReSize() {
 }
 
 int ConvolutionDepthwiseCPUKernel::Execute(int task_id) {
-  ConvDwC4Fp32(packed_output_, packed_input_, packed_weight_, reinterpret_cast<float *>(bias_data_), conv_param_,
+  ConvDwC4Fp32(execute_output_, execute_input_, packed_weight_, reinterpret_cast<float *>(bias_data_), conv_param_,
                sliding_, task_id);
   return RET_OK;
 }
@@ -151,18 +160,19 @@ int ConvolutionDepthwiseCPUKernel::Run() {
   auto input_tensor = inputs_.at(kInputIndex);
   auto input_addr = reinterpret_cast<float *>(input_tensor->Data());
 
-  // pack input: to nhwc4
-  if (need_align_) {
+  // pack input: to nhwc4, unless the scheduler keeps it in nhwc4
+  if (need_align_ && input_tensor->GetFormat() != schema::Format_NHWC4) {
     PackNHWCToNHWC4Fp32(input_addr, packed_input_, conv_param_->input_batch_,
                         conv_param_->input_h_ * conv_param_->input_w_, conv_param_->input_channel_);
+    execute_input_ = packed_input_;
   } else {
-    packed_input_ = input_addr;
+    execute_input_ = input_addr;
   }
 
-  auto output_addr = reinterpret_cast<float *>(outputs_.at(kOutputIndex)->Data());
-  if (!need_align_) {
-    packed_output_ = output_addr;
-  }
+  auto output_tensor = outputs_.at(kOutputIndex);
+  auto output_addr = reinterpret_cast<float *>(output_tensor->Data());
+  bool unpack_output = need_align_ && output_tensor->GetFormat() != schema::Format_NHWC4;
+  execute_output_ = unpack_output ? packed_output_ : output_addr;
 
   auto ret = LiteBackendParallelLaunch(ConvDwRun, this, conv_param_->thread_num_);
   if (ret != RET_OK) {
@@ -170,7 +180,7 @@ int ConvolutionDepthwiseCPUKernel::Run() {
     return RET_ERROR;
   }
 
-  if (need_align_) {
+  if (unpack_output) {
     PackNHWC4ToNHWCFp32(packed_output_, output_addr, conv_param_->output_batch_,
                         conv_param_->output_h_ * conv_param_->output_w_, conv_param_->output_channel_);
   }
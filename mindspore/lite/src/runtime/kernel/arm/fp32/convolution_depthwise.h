@@ -21,6 +21,7 @@
 #include "src/lite_kernel.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
 #include "src/runtime/kernel/arm/nnacl/fp32/conv_depthwise.h"
+#include "src/runtime/weight_cache.h"
 
 namespace mindspore::kernel {
 class ConvolutionDepthwiseCPUKernel : public ConvolutionBaseCPUKernel {
@@ -30,9 +31,11 @@ class ConvolutionDepthwiseCPUKernel : public ConvolutionBaseCPUKernel {
       : ConvolutionBaseCPUKernel(parameter, inputs, outputs, ctx) {}
   ~ConvolutionDepthwiseCPUKernel() override {
     delete sliding_;
-    free(packed_weight_);
-    if (need_align_) {
+    lite::WeightCache::GetInstance()->Release(packed_weight_);
+    if (packed_input_ != nullptr) {
       free(packed_input_);
+    }
+    if (packed_output_ != nullptr) {
       free(packed_output_);
     }
   };
@@ -40,16 +43,25 @@ class ConvolutionDepthwiseCPUKernel : public ConvolutionBaseCPUKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportInputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || format == schema::Format_NHWC4;
+  }
+  bool SupportOutputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || format == schema::Format_NHWC4;
+  }
 
   int InitBuffer();
   int InitWeightBias();
   int Execute(int task_id);
 
  private:
-  SlidingWindowParam *sliding_;
+  SlidingWindowParam *sliding_ = nullptr;
   float *packed_weight_;
-  float *packed_input_;
-  float *packed_output_;
+  float *packed_input_ = nullptr;
+  float *packed_output_ = nullptr;
+  // the NHWC4 input and output of the run, the tensor data or the packed buffers
+  float *execute_input_ = nullptr;
+  float *execute_output_ = nullptr;
   bool need_align_ = false;
 };
 }  // namespace mindspore::kernel
@@ -206,14 +206,17 @@ int ConvolutionWinogradCPUKernel::InitTmpBuffer() {
   tmp_buffer_address_list_[3] = tmp_data_;
 
   /*=============================nhwc4_input_============================*/
-  size_t nhwc4_input_size =
-    ic4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
-  nhwc4_input_ = malloc(nhwc4_input_size);
-  if (nhwc4_input_ == nullptr) {
-    MS_LOG(ERROR) << "malloc nhwc4_input_ failed.";
-    return RET_ERROR;
+  // an input readable as NHWC4 is not converted
+  if (!IsNhwc4Input()) {
+    size_t nhwc4_input_size =
+      ic4 * C4NUM * conv_param_->input_batch_ * conv_param_->input_h_ * conv_param_->input_w_ * sizeof(float);
+    nhwc4_input_ = malloc(nhwc4_input_size);
+    if (nhwc4_input_ == nullptr) {
+      MS_LOG(ERROR) << "malloc nhwc4_input_ failed.";
+      return RET_ERROR;
+    }
+    memset(nhwc4_input_, 0, nhwc4_input_size);
   }
-  memset(nhwc4_input_, 0, nhwc4_input_size);
   return RET_OK;
 }
 
@@ -291,6 +294,7 @@ int ConvolutionWinogradCPUKernel::ReSize() {
   }
   if (nhwc4_input_ != nullptr) {
     free(nhwc4_input_);
+    nhwc4_input_ = nullptr;
   }
 
   auto ret = ConvolutionBaseCPUKernel::Init();
@@ -322,7 +326,7 @@ int ConvolutionWinogradCPUKernel::RunImpl(int task_id) {
     return RET_ERROR;
   }
   auto output_addr = reinterpret_cast<float *>(outputs_.at(kOutputIndex)->Data());
-  ConvWinogardFp32(reinterpret_cast<float *>(nhwc4_input_), reinterpret_cast<float *>(trans_weight_->GetData()),
+  ConvWinogardFp32(execute_input_, reinterpret_cast<float *>(trans_weight_->GetData()),
                    reinterpret_cast<const float *>(bias_data_), output_addr, tmp_buffer_address_list_, task_id,
                    conv_param_, input_trans_func_, output_trans_func_, gemm_func_);
   return RET_OK;
@@ -339,13 +343,7 @@ int ConvolutionWinogradImpl(int task_id, LiteParallelGroupEnv *penv, void *cdata
 }
 
 int ConvolutionWinogradCPUKernel::Run() {
-  auto input_tensor = inputs_.at(kInputIndex);
-  auto ori_input_data = input_tensor->Data();
-  int in_batch = conv_param_->input_batch_;
-  int in_h = conv_param_->input_h_;
-  int in_w = conv_param_->input_w_;
-  int in_channel = conv_param_->input_channel_;
-  convert_func_(ori_input_data, nhwc4_input_, in_batch, in_h * in_w, in_channel);
+  execute_input_ = reinterpret_cast<float *>(Nhwc4Input());
 
   int error_code = LiteBackendParallelLaunch(ConvolutionWinogradImpl, this, thread_count_);
   if (error_code != RET_OK) {
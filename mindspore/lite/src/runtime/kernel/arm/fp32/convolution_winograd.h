@@ -48,6 +48,9 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportInputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || format == schema::Format_NHWC4;
+  }
   int RunImpl(int task_id);
   int InitWeightBias();
   int MallocFilterMatrix(int oc_block, int oc_block_num);
@@ -55,6 +58,8 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
   int ConfigInputOutput();
 
  private:
+  // the NHWC4 input of the run, the input data or nhwc4_input_
+  float *execute_input_ = nullptr;
   int kernel_unit_;
   int input_unit_;
   int output_unit_;
@@ -41,14 +41,41 @@ FullconnectionCPUKernel::~FullconnectionCPUKernel() {
   }
 }
 
-int FullconnectionCPUKernel::ReSize() { return RET_OK; }
+int FullconnectionCPUKernel::ReSize() {
+  // only the rows follow the input shape, the packed weight and bias are kept
+  if (a_c8_ptr_ != nullptr) {
+    free(a_c8_ptr_);
+    a_c8_ptr_ = nullptr;
+  }
+  if (c_r8x8_ptr_ != nullptr) {
+    free(c_r8x8_ptr_);
+    c_r8x8_ptr_ = nullptr;
+  }
+  return InitRowBuffer();
+}
 
-int FullconnectionCPUKernel::Init() {
+int FullconnectionCPUKernel::InitRowBuffer() {
   fc_param_->row_ = (inputs_[0]->shape())[0];
+  fc_param_->row_8_ = UP_ROUND(fc_param_->row_, 8);
+
+  a_c8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->row_8_ * fc_param_->deep_ * sizeof(float)));
+  if (a_c8_ptr_ == nullptr) {
+    return RET_MEMORY_FAILED;
+  }
+  memset(a_c8_ptr_, 0, fc_param_->row_8_ * fc_param_->deep_ * sizeof(float));
+
+  c_r8x8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->row_8_ * fc_param_->col_8_ * sizeof(float)));
+  if (c_r8x8_ptr_ == nullptr) {
+    return RET_MEMORY_FAILED;
+  }
+  memset(c_r8x8_ptr_, 0, fc_param_->row_8_ * fc_param_->col_8_ * sizeof(float));
+  return RET_OK;
+}
+
+int FullconnectionCPUKernel::Init() {
   fc_param_->col_ = (inputs_[1]->shape())[0];
   fc_param_->deep_ = (inputs_[1]->shape())[1];
 
-  fc_param_->row_8_ = UP_ROUND(fc_param_->row_, 8);
   fc_param_->col_8_ = UP_ROUND(fc_param_->col_, 8);
 
   thread_count_ = MSMIN(thread_count_, UP_DIV(fc_param_->col_8_, 8));
@@ -60,25 +87,13 @@ int FullconnectionCPUKernel::Init() {
     memcpy(bias_ptr_, inputs_[2]->Data(), fc_param_->col_ * sizeof(float));
   }
 
-  a_c8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->row_8_ * fc_param_->deep_ * sizeof(float)));
-  if (a_c8_ptr_ == nullptr) {
-    return RET_MEMORY_FAILED;
-  }
-  memset(a_c8_ptr_, 0, fc_param_->row_8_ * fc_param_->deep_ * sizeof(float));
-
   b_r8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->col_8_ * fc_param_->deep_ * sizeof(float)));
   if (b_r8_ptr_ == nullptr) {
     return RET_MEMORY_FAILED;
   }
   memset(b_r8_ptr_, 0, fc_param_->col_8_ * fc_param_->deep_ * sizeof(float));
   RowMajor2Col8Major(reinterpret_cast<float *>(inputs_[1]->Data()), b_r8_ptr_, fc_param_->col_, fc_param_->deep_);
-
-  c_r8x8_ptr_ = reinterpret_cast<float *>(malloc(fc_param_->row_8_ * fc_param_->col_8_ * sizeof(float)));
-  if (c_r8x8_ptr_ == nullptr) {
-    return RET_MEMORY_FAILED;
-  }
-  memset(c_r8x8_ptr_, 0, fc_param_->row_8_ * fc_param_->col_8_ * sizeof(float));
-  return RET_OK;
+  return InitRowBuffer();
 }
 
 int FcFp32MatmulRun(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
@@ -36,15 +36,19 @@ class FullconnectionCPUKernel : public FullconnectionBaseCPUKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  bool SupportResize() const override { return true; }
 
  public:
   int DoMatmul(int task_id);
 
  private:
-  float *a_c8_ptr_;
-  float *b_r8_ptr_;
-  float *c_r8x8_ptr_;
-  float *bias_ptr_;
+  int InitRowBuffer();
+
+ private:
+  float *a_c8_ptr_ = nullptr;
+  float *b_r8_ptr_ = nullptr;
+  float *c_r8x8_ptr_ = nullptr;
+  float *bias_ptr_ = nullptr;
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_FULLCONNECTION_H_
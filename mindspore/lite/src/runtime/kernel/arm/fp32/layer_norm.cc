@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/fp32/layer_norm.h"
+#include <vector>
+#include "schema/model_generated.h"
+#include "src/kernel_registry.h"
+#include "src/runtime/runtime_api.h"
+#include "include/errorcode.h"
+
+using mindspore::kernel::KERNEL_ARCH::kCPU;
+using mindspore::lite::KernelRegistrar;
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+using mindspore::schema::PrimitiveType_LayerNorm;
+
+namespace mindspore::kernel {
+int LayerNormCPUKernel::Init() { return ReSize(); }
+
+int LayerNormCPUKernel::ReSize() {
+  auto shape = inputs_.front()->shape();
+  int rank = static_cast<int>(shape.size());
+  int begin_norm_axis = layer_norm_param_->begin_norm_axis_;
+  if (begin_norm_axis < 0) {
+    begin_norm_axis += rank;
+  }
+  if (begin_norm_axis < 0 || begin_norm_axis >= rank) {
+    MS_LOG(ERROR) << "LayerNorm begin_norm_axis " << layer_norm_param_->begin_norm_axis_ << " is out of the rank "
+                  << rank;
+    return RET_ERROR;
+  }
+  outer_size_ = 1;
+  for (int i = 0; i < begin_norm_axis; i++) {
+    outer_size_ *= shape[i];
+  }
+  inner_size_ = 1;
+  for (int i = begin_norm_axis; i < rank; i++) {
+    inner_size_ *= shape[i];
+  }
+  if (layer_norm_param_->elementwise_affine_) {
+    if (inputs_.size() != 3 || inputs_[1]->ElementsNum() != inner_size_ || inputs_[2]->ElementsNum() != inner_size_) {
+      MS_LOG(ERROR) << "LayerNorm gamma and beta should have " << inner_size_ << " elements";
+      return RET_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+int LayerNormCPUKernel::DoLayerNorm(int task_id) {
+  auto input_data = reinterpret_cast<float *>(inputs_.front()->Data());
+  auto output_data = reinterpret_cast<float *>(outputs_.front()->Data());
+  float *gamma_data = nullptr;
+  float *beta_data = nullptr;
+  if (layer_norm_param_->elementwise_affine_) {
+    gamma_data = reinterpret_cast<float *>(inputs_[1]->Data());
+    beta_data = reinterpret_cast<float *>(inputs_[2]->Data());
+  }
+  auto error_code = LayerNorm(outer_size_, inner_size_, input_data, gamma_data, beta_data, layer_norm_param_->epsilon_,
+                              output_data, task_id, thread_count_);
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "DoLayerNorm error task_id[" << task_id << "] error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int LayerNormRun(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
+  auto layer_norm = reinterpret_cast<LayerNormCPUKernel *>(cdata);
+  auto error_code = layer_norm->DoLayerNorm(task_id);
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "LayerNormRun error task_id[" << task_id << "] error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int LayerNormCPUKernel::Run() {
+  int error_code = LiteBackendParallelLaunch(LayerNormRun, this, MSMAX(1, MSMIN(thread_count_, outer_size_)));
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "LayerNorm function error error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+kernel::LiteKernel *CpuLayerNormFp32KernelCreator(const std::vector<lite::tensor::Tensor *> &inputs,
+                                                  const std::vector<lite::tensor::Tensor *> &outputs,
+                                                  OpParameter *opParameter, const lite::Context *ctx,
+                                                  const kernel::KernelKey &desc) {
+  MS_ASSERT(opParameter != nullptr);
+  MS_ASSERT(desc.type == schema::PrimitiveType_LayerNorm);
+  auto *kernel = new (std::nothrow) LayerNormCPUKernel(opParameter, inputs, outputs, ctx);
+  if (kernel == nullptr) {
+    MS_LOG(ERROR) << "new LayerNormCPUKernel fail!";
+    return nullptr;
+  }
+  auto ret = kernel->Init();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init kernel failed, name: " << opParameter->name_ << ", type: "
+                  << schema::EnumNamePrimitiveType(static_cast<schema::PrimitiveType>(opParameter->type_));
+    delete kernel;
+    return nullptr;
+  }
+  return kernel;
+}
+
+REG_KERNEL(kCPU, kNumberTypeFloat32, PrimitiveType_LayerNorm, CpuLayerNormFp32KernelCreator)
+}  // namespace mindspore::kernel
@@ -35,6 +35,7 @@ class ReshapeCPUKernel : public ReshapeBaseCPUKernel {
 
   int Init() override;
   int ReSize() override;
+  bool SupportResize() const override { return true; }
   int Run() override;
 
  private:
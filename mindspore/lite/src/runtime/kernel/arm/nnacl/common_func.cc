@@ -16,6 +16,10 @@
 
 #include "src/runtime/kernel/arm/nnacl/common_func.h"
 #include "src/runtime/kernel/arm/nnacl/quantization/fixed_point.h"
+#ifdef ENABLE_X86_64
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include "src/runtime/kernel/arm/nnacl/x86_64/gemm_avx.h"
+#endif
 
 #ifndef ENABLE_ARM64
 void IndirectGemmFp32(float *output, const float *input, const float *weight, const float *bias, size_t step, int ic4,
@@ -63,6 +67,13 @@ void IndirectGemmFp32(float *output, const float *input, const float *weight, co
 void IndirectGemmFp32_8x8(float *output, const float *input, const float *weight, const float *bias, size_t step,
                           size_t ic4, size_t output_channel, size_t offset, size_t mode, size_t writeC4, size_t relu,
                           size_t relu6) {
+#ifdef ENABLE_X86_64
+  if (X86GetSimdLevel() >= X86SimdLevel_Avx2 && IndirectGemmFp32_8x8Avx2(output, input, weight, bias, step, ic4,
+                                                                          output_channel, offset, mode, writeC4, relu,
+                                                                          relu6)) {
+    return;
+  }
+#endif
   int oc4 = UP_DIV(output_channel, C4NUM);
   if (mode && writeC4) {
     for (int i = 0; i < TILE_NUM; i++) {
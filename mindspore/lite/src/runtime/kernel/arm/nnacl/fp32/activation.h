@@ -75,4 +75,14 @@ inline int HSwish(const float *src, int length, float *dst) {
   return NNACL_OK;
 }
 
+// the tanh approximation, 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+inline int Gelu(const float *src, int length, float *dst) {
+  for (int i = 0; i < length; ++i) {
+    float in = src[i];
+    float inner = 0.7978845608f * (in + 0.044715f * in * in * in);
+    dst[i] = 0.5f * in * (1.0f + tanhf(inner));
+  }
+  return NNACL_OK;
+}
+
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_ACTIVATION_H_
@@ -20,6 +20,10 @@
 #ifdef ENABLE_ARM64
 #include <arm_neon.h>
 #endif
+#ifdef ENABLE_X86_64
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include "src/runtime/kernel/arm/nnacl/x86_64/gemm_avx.h"
+#endif
 
 void InitSlidingParam(SlidingWindowParam *sliding, const ConvParameter *conv_param, int block) {
   int left = 0;
@@ -128,6 +132,13 @@ void DepthwiseBorder(float *dst, const float *src, const float *weight, const fl
 void DepthwiseCenter(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
                      int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
                      int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6) {
+#ifdef ENABLE_X86_64
+  if (X86GetSimdLevel() >= X86SimdLevel_Avx2) {
+    DepthwiseCenterAvx2(dst, src, weight, bias, height, width, kernel_h, kernel_w, out_h_step, block_channel,
+                        in_sh_step, in_sw_step, in_kh_step, in_kw_step, is_relu, is_relu6);
+    return;
+  }
+#endif
   float *dst_h = dst;
   const float *src_h = src;
   for (int oh = 0; oh < height; oh++) {
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/nnacl/fp32/layer_norm.h"
+#include <math.h>
+#include "src/runtime/kernel/arm/nnacl/errorcode.h"
+
+int LayerNorm(const int outer_size, const int inner_size, const float *src_data, const float *gamma_data,
+              const float *beta_data, const float epsilon, float *dst_data, const int tid, const int thread_num) {
+  if (src_data == NULL || dst_data == NULL) {
+    return NNACL_NULL_PTR;
+  }
+  if (inner_size <= 0) {
+    return NNACL_ERR;
+  }
+  for (int i = tid; i < outer_size; i += thread_num) {
+    const float *src = src_data + i * inner_size;
+    float *dst = dst_data + i * inner_size;
+    // the row is in cache after the first pass, a second pass for the variance avoids the cancellation of
+    // E(x^2) - E(x)^2
+    double sum = 0.0;
+    for (int j = 0; j < inner_size; j++) {
+      sum += src[j];
+    }
+    double mean = sum / inner_size;
+    double square_sum = 0.0;
+    for (int j = 0; j < inner_size; j++) {
+      double diff = src[j] - mean;
+      square_sum += diff * diff;
+    }
+    double variance = square_sum / inner_size;
+    float mean_f = (float)mean;
+    float inv_std = (float)(1.0 / sqrt(variance + epsilon));
+    if (gamma_data != NULL && beta_data != NULL) {
+      for (int j = 0; j < inner_size; j++) {
+        dst[j] = (src[j] - mean_f) * inv_std * gamma_data[j] + beta_data[j];
+      }
+    } else {
+      for (int j = 0; j < inner_size; j++) {
+        dst[j] = (src[j] - mean_f) * inv_std;
+      }
+    }
+  }
+  return NNACL_OK;
+}
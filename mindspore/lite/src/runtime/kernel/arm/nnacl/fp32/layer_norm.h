@@ -0,0 +1,34 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_FP32_LAYER_NORM_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_FP32_LAYER_NORM_H_
+
+#include "src/runtime/kernel/arm/nnacl/op_base.h"
+
+struct LayerNormParameter {
+  OpParameter op_parameter_;
+  int begin_norm_axis_;
+  float epsilon_;
+  bool elementwise_affine_;
+};
+
+// Normalize each of the outer_size rows of inner_size elements, then scale by gamma and shift by beta if they are not
+// NULL. The rows are split among thread_num threads.
+int LayerNorm(const int outer_size, const int inner_size, const float *src_data, const float *gamma_data,
+              const float *beta_data, const float epsilon, float *dst_data, const int tid, const int thread_num);
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_FP32_LAYER_NORM_H_
@@ -15,6 +15,10 @@
  */
 
 #include "src/runtime/kernel/arm/nnacl/fp32/matmul.h"
+#ifdef ENABLE_X86_64
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include "src/runtime/kernel/arm/nnacl/x86_64/gemm_avx.h"
+#endif
 
 void RowMajor2Row8Major(float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
@@ -156,6 +160,12 @@ void MatMul8x8(const float *a, const float *b, float *c, const float *bias, ActT
 
 void MatMul(const float *a, const float *b, float *c, const float *bias, ActType act_type, int deep, int row_8_,
             int col_8_) {
+#ifdef ENABLE_X86_64
+  if (X86GetSimdLevel() >= X86SimdLevel_Avx2 && row_8_ % C8NUM == 0 && col_8_ % C8NUM == 0) {
+    MatMul8x8Avx2(a, b, c, bias, act_type, deep, row_8_, col_8_);
+    return;
+  }
+#endif
   MatMul8x8(a, b, c, bias, act_type, deep, row_8_, col_8_);
   return;
 }
@@ -17,6 +17,10 @@
 #include "src/runtime/kernel/arm/nnacl/int8/matmul.h"
 #include <limits.h>
 #include "src/runtime/kernel/arm/nnacl/quantization/fixed_point.h"
+#ifdef ENABLE_X86_64
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include "src/runtime/kernel/arm/nnacl/x86_64/matmul_int8_avx.h"
+#endif
 
 void RowMajor2Row8MajorInt8(int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
@@ -41,6 +45,17 @@ void RowMajor2Col8MajorInt8(int8_t *src_ptr, int8_t *dst_ptr, int row, int col)
 
 void MatMulInt8(const int8_t *a, const int8_t *b, int32_t *c, const int row8, const int col8, const int deep,
                 const int32_t a_zp, const int32_t b_zp) {
+#ifdef ENABLE_X86_64
+  X86SimdLevel simd_level = X86GetSimdLevel();
+  if (simd_level >= X86SimdLevel_Avx2 && row8 % C8NUM == 0 && col8 % C8NUM == 0) {
+    if (simd_level >= X86SimdLevel_Avx512Vnni) {
+      MatMulInt8Avx512Vnni(a, b, c, row8, col8, deep, a_zp, b_zp);
+    } else {
+      MatMulInt8Avx2(a, b, c, row8, col8, deep, a_zp, b_zp);
+    }
+    return;
+  }
+#endif
   /*  col8-major * row8-major => row8x8-major  */
   for (int row = 0; row < row8; row++) {
     for (int col = 0; col < col8; col++) {
@@ -105,7 +105,7 @@ void WinogradOutputTransform(const float *gemm_out, float *tmp_out_data, const f
 
 // fp32 conv3x3
 void Conv3x3Fp32InputUnit(const float *tmp_data, float *trans_input_data, size_t step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t d00 = vld1q_f32(tmp_data);
   float32x4_t d01 = vld1q_f32(tmp_data + 4);
   float32x4_t d02 = vld1q_f32(tmp_data + 2 * 4);
@@ -338,7 +338,7 @@ void Conv3x3Fp32FilterTransform(float *weight_data, float *trans_weight, int iC4
     for (int i = 0; i < iC4; i++) {
       float *src_ic4_ptr = weight_data + src_oc_offset + i * kernel_plane * C4NUM;
       float *dst_ic4_ptr = trans_weight + dst_oc_offset + i * oc_block * C4NUM;
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
       float32x4_t g00 = vld1q_f32(src_ic4_ptr);
       float32x4_t g01 = vld1q_f32(src_ic4_ptr + 4);
       float32x4_t g02 = vld1q_f32(src_ic4_ptr + 2 * 4);
@@ -544,7 +544,7 @@ void Conv3x3Fp32FilterTransform(float *weight_data, float *trans_weight, int iC4
 
 void Conv3x3Fp32OutputUnit(const float *gemm_out, const float *bias_data, float *output_data, bool h_not_bound,
                            bool w_not_bound, int output_w) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t bias_ptr = vld1q_f32(bias_data);
 
   float32x4_t s00 = vld1q_f32(gemm_out);
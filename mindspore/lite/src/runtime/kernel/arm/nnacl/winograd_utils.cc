@@ -32,7 +32,7 @@ static OutputTransformUnitFunc outputTransformUnit[] = {
 };
 
 void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -189,7 +189,7 @@ void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step,
 }
 
 void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -1295,7 +1295,7 @@ void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step,
 
 void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t bias_ptr = vld1q_f32(bias_data);
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
@@ -1319,10 +1319,10 @@ void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float
   float32x4_t t02 = vaddq_f32(src_data_02, vaddq_f32(src_data_12, src_data_22));
   float32x4_t t03 = vaddq_f32(src_data_03, vaddq_f32(src_data_13, src_data_23));
 
-  float32x4_t t10 = vsubq_f32(src_data_30, vmulq_n_f32(vsubq_f32(src_data_10, src_data_20), 0.5));
-  float32x4_t t11 = vsubq_f32(src_data_31, vmulq_n_f32(vsubq_f32(src_data_11, src_data_21), 0.5));
-  float32x4_t t12 = vsubq_f32(src_data_32, vmulq_n_f32(vsubq_f32(src_data_12, src_data_22), 0.5));
-  float32x4_t t13 = vsubq_f32(src_data_33, vmulq_n_f32(vsubq_f32(src_data_13, src_data_23), 0.5));
+  float32x4_t t10 = vaddq_f32(src_data_30, vmulq_n_f32(vsubq_f32(src_data_10, src_data_20), 0.5));
+  float32x4_t t11 = vaddq_f32(src_data_31, vmulq_n_f32(vsubq_f32(src_data_11, src_data_21), 0.5));
+  float32x4_t t12 = vaddq_f32(src_data_32, vmulq_n_f32(vsubq_f32(src_data_12, src_data_22), 0.5));
+  float32x4_t t13 = vaddq_f32(src_data_33, vmulq_n_f32(vsubq_f32(src_data_13, src_data_23), 0.5));
 
   float32x4_t m00 = vaddq_f32(vaddq_f32(t00, vaddq_f32(t01, t02)), bias_ptr);
   float32x4_t m01 = vaddq_f32(vaddq_f32(t03, vmulq_n_f32(vsubq_f32(t01, t02), 0.5)), bias_ptr);
@@ -1377,7 +1377,7 @@ void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t bias_ptr = vld1q_f32(bias_data);
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
@@ -1493,7 +1493,7 @@ void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -1791,7 +1791,7 @@ void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -2219,7 +2219,7 @@ void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -2709,7 +2709,7 @@ void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -3277,7 +3277,7 @@ void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -3918,7 +3918,7 @@ void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_X86_64)
   float32x4_t src_data_00 = vld1q_f32(src_data + 0 * src_step);
   float32x4_t src_data_01 = vld1q_f32(src_data + 1 * src_step);
   float32x4_t src_data_02 = vld1q_f32(src_data + 2 * src_step);
@@ -4501,7 +4501,7 @@ void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float
     float s34 = t35 - t36;
     float s35 = t45 - t46;
     float s36 = t55 - t56;
-    float s37 = t56 - t66;
+    float s37 = t65 - t66;
 
     float s41 = t01 + t02;
     float s42 = t11 + t12;
@@ -19,6 +19,8 @@
 
 #ifdef ENABLE_ARM
 #include <arm_neon.h>
+#elif defined(ENABLE_X86_64)
+#include "src/runtime/kernel/arm/nnacl/x86_64/neon_sse.h"
 #endif
 #include "src/runtime/kernel/arm/nnacl/matrix_table.h"
 #include "src/runtime/kernel/arm/nnacl/conv_parameter.h"
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include <cpuid.h>
+#include <stdint.h>
+
+namespace {
+constexpr uint32_t kLeafFeature = 1;
+constexpr uint32_t kLeafExtendedFeature = 7;
+// leaf 1 ecx
+constexpr uint32_t kFmaBit = 1u << 12;
+constexpr uint32_t kOsXsaveBit = 1u << 27;
+constexpr uint32_t kAvxBit = 1u << 28;
+// leaf 7 ebx
+constexpr uint32_t kAvx2Bit = 1u << 5;
+constexpr uint32_t kAvx512FBit = 1u << 16;
+constexpr uint32_t kAvx512BwBit = 1u << 30;
+constexpr uint32_t kAvx512VlBit = 1u << 31;
+// leaf 7 ecx
+constexpr uint32_t kAvx512VnniBit = 1u << 11;
+// xcr0: sse and avx state, then opmask and the upper zmm states
+constexpr uint64_t kYmmState = 0x6;
+constexpr uint64_t kZmmState = 0xe6;
+
+uint64_t ReadXcr0() {
+  uint32_t eax = 0;
+  uint32_t edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+X86SimdLevel DetectSimdLevel() {
+  uint32_t eax = 0;
+  uint32_t ebx = 0;
+  uint32_t ecx = 0;
+  uint32_t edx = 0;
+  if (__get_cpuid_max(0, nullptr) < kLeafExtendedFeature) {
+    return X86SimdLevel_None;
+  }
+  __cpuid_count(kLeafFeature, 0, eax, ebx, ecx, edx);
+  uint32_t feature_ecx = ecx;
+  if ((feature_ecx & kOsXsaveBit) == 0 || (feature_ecx & kAvxBit) == 0 || (feature_ecx & kFmaBit) == 0) {
+    return X86SimdLevel_None;
+  }
+  uint64_t xcr0 = ReadXcr0();
+  if ((xcr0 & kYmmState) != kYmmState) {
+    return X86SimdLevel_None;
+  }
+  __cpuid_count(kLeafExtendedFeature, 0, eax, ebx, ecx, edx);
+  if ((ebx & kAvx2Bit) == 0) {
+    return X86SimdLevel_None;
+  }
+  uint32_t avx512_bits = kAvx512FBit | kAvx512BwBit | kAvx512VlBit;
+  if ((ebx & avx512_bits) == avx512_bits && (ecx & kAvx512VnniBit) != 0 && (xcr0 & kZmmState) == kZmmState) {
+    return X86SimdLevel_Avx512Vnni;
+  }
+  return X86SimdLevel_Avx2;
+}
+
+X86SimdLevel g_simd_level = X86CpuSimdLevel();
+}  // namespace
+
+X86SimdLevel X86CpuSimdLevel() {
+  static X86SimdLevel cpu_level = DetectSimdLevel();
+  return cpu_level;
+}
+
+X86SimdLevel X86GetSimdLevel() { return g_simd_level; }
+
+void X86SetSimdLevel(X86SimdLevel level) {
+  X86SimdLevel cpu_level = X86CpuSimdLevel();
+  g_simd_level = level < cpu_level ? level : cpu_level;
+}
+
+const char *X86SimdLevelName(X86SimdLevel level) {
+  switch (level) {
+    case X86SimdLevel_Avx2:
+      return "AVX2";
+    case X86SimdLevel_Avx512Vnni:
+      return "AVX512_VNNI";
+    default:
+      return "NONE";
+  }
+}
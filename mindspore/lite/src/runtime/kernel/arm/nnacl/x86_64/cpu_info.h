@@ -0,0 +1,39 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_CPU_INFO_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_CPU_INFO_H_
+
+// SIMD levels of the x86-64 kernels, the kernels of a level also need the levels below it.
+typedef enum X86SimdLevel {
+  X86SimdLevel_None = 0,
+  // avx2 and fma for the fp32 kernels and the int8 kernels without vnni
+  X86SimdLevel_Avx2 = 1,
+  // avx512f, avx512bw, avx512vl and avx512 vnni for the int8 kernels
+  X86SimdLevel_Avx512Vnni = 2,
+} X86SimdLevel;
+
+// The highest level supported by both the cpu and the os, which saves the ymm and zmm registers.
+X86SimdLevel X86CpuSimdLevel();
+
+// The level used by the kernels, which is the cpu level unless it is lowered by X86SetSimdLevel, for example to
+// compare the kernels with the scalar ones.
+X86SimdLevel X86GetSimdLevel();
+void X86SetSimdLevel(X86SimdLevel level);
+
+const char *X86SimdLevelName(X86SimdLevel level);
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_CPU_INFO_H_
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/nnacl/x86_64/gemm_avx.h"
+#include <immintrin.h>
+#include <string.h>
+
+// The kernels are compiled for avx2 by the target attribute so the rest of the library still runs on any x86-64 cpu.
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+namespace {
+AVX2_TARGET inline __m256 ActivateAvx2(__m256 value, bool relu, bool relu6) {
+  if (relu || relu6) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  if (relu6) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  return value;
+}
+
+// acc[i] += sum over the blocks of input[block][i][0..3] * weight[block][0..3][0..7], blocks of the input hold 8 tiles
+// of 4 channels and blocks of the weight hold 4 channels of 8 output channels.
+AVX2_TARGET inline void GemmTile8x8Avx2(const float *input, const float *weight, size_t block_num, __m256 acc[C8NUM]) {
+  for (size_t blk = 0; blk < block_num; ++blk) {
+    const float *in = input + blk * TILE_NUM * C4NUM;
+    const float *w = weight + blk * C4NUM * C8NUM;
+    for (int m = 0; m < C4NUM; ++m) {
+      __m256 w_vec = _mm256_loadu_ps(w + m * C8NUM);
+      for (int i = 0; i < TILE_NUM; ++i) {
+        acc[i] = _mm256_fmadd_ps(_mm256_broadcast_ss(in + i * C4NUM + m), w_vec, acc[i]);
+      }
+    }
+  }
+}
+}  // namespace
+
+AVX2_TARGET void MatMul8x8Avx2(const float *a, const float *b, float *c, const float *bias, ActType act_type, int deep,
+                               int row_8_, int col_8_) {
+  /*  col8-major * row8-major => col8x8-major  */
+  bool relu = act_type != ActType_No;
+  bool relu6 = act_type == ActType_Relu6;
+  for (int c8 = 0; c8 < col_8_ / C8NUM; ++c8) {
+    const float *b_block = b + c8 * deep * C8NUM;
+    __m256 bias_vec = bias != nullptr ? _mm256_loadu_ps(bias + c8 * C8NUM) : _mm256_setzero_ps();
+    for (int r8 = 0; r8 < row_8_ / C8NUM; ++r8) {
+      const float *a_block = a + r8 * deep * C8NUM;
+      __m256 acc[C8NUM];
+      for (int r = 0; r < C8NUM; ++r) {
+        acc[r] = bias_vec;
+      }
+      for (int d = 0; d < deep; ++d) {
+        __m256 b_vec = _mm256_loadu_ps(b_block + d * C8NUM);
+        const float *a_d = a_block + d * C8NUM;
+        for (int r = 0; r < C8NUM; ++r) {
+          acc[r] = _mm256_fmadd_ps(_mm256_broadcast_ss(a_d + r), b_vec, acc[r]);
+        }
+      }
+      float *c_block = c + c8 * row_8_ * C8NUM + r8 * C8NUM * C8NUM;
+      for (int r = 0; r < C8NUM; ++r) {
+        _mm256_storeu_ps(c_block + r * C8NUM, ActivateAvx2(acc[r], relu, relu6));
+      }
+    }
+  }
+}
+
+AVX2_TARGET bool IndirectGemmFp32_8x8Avx2(float *output, const float *input, const float *weight, const float *bias,
+                                          size_t step, size_t ic4, size_t output_channel, size_t offset, size_t mode,
+                                          size_t writeC4, size_t relu, size_t relu6) {
+  size_t oc8 = UP_DIV(output_channel, C8NUM);
+  size_t block_step = ic4 * C4NUM * C8NUM;
+  if (mode == 0) {
+    // accumulate every kernel step, write the tiles row by row with bias and activation
+    for (size_t oc8_block = 0; oc8_block < oc8; ++oc8_block) {
+      size_t oc_start = oc8_block * C8NUM;
+      size_t oc_num = MSMIN(output_channel - oc_start, static_cast<size_t>(C8NUM));
+      float bias_buf[C8NUM] = {0};
+      if (bias != nullptr) {
+        memcpy(bias_buf, bias + oc_start, oc_num * sizeof(float));
+      }
+      __m256 bias_vec = _mm256_loadu_ps(bias_buf);
+      __m256 acc[TILE_NUM];
+      for (int i = 0; i < TILE_NUM; ++i) {
+        acc[i] = bias_vec;
+      }
+      GemmTile8x8Avx2(input, weight + oc8_block * step * block_step, step * ic4, acc);
+      for (int i = 0; i < TILE_NUM; ++i) {
+        __m256 value = ActivateAvx2(acc[i], relu != 0, relu6 != 0 && relu == 0);
+        float *dst = output + i * output_channel + oc_start;
+        if (oc_num == C8NUM) {
+          _mm256_storeu_ps(dst, value);
+        } else {
+          float out_buf[C8NUM];
+          _mm256_storeu_ps(out_buf, value);
+          memcpy(dst, out_buf, oc_num * sizeof(float));
+        }
+      }
+    }
+    return true;
+  }
+  if (writeC4 == 0) {
+    return false;
+  }
+  // winograd: every kernel step is a separate gemm, write them as C4 blocks without bias and activation
+  size_t oc4 = UP_DIV(output_channel, C4NUM);
+  size_t tile_step = oc4 * C4NUM * step;
+  for (size_t n = 0; n < step; ++n) {
+    const float *in = input + n * ic4 * C4NUM * TILE_NUM;
+    for (size_t oc8_block = 0; oc8_block < oc8; ++oc8_block) {
+      __m256 acc[TILE_NUM];
+      for (int i = 0; i < TILE_NUM; ++i) {
+        acc[i] = _mm256_setzero_ps();
+      }
+      GemmTile8x8Avx2(in, weight + oc8_block * step * block_step + n * block_step, ic4, acc);
+      size_t oc4_block = oc8_block * 2;
+      float *dst = output + oc4_block * step * C4NUM + n * C4NUM;
+      for (int i = 0; i < TILE_NUM; ++i) {
+        _mm_storeu_ps(dst + i * tile_step, _mm256_castps256_ps128(acc[i]));
+        if (oc4_block + 1 < oc4) {
+          _mm_storeu_ps(dst + i * tile_step + step * C4NUM, _mm256_extractf128_ps(acc[i], 1));
+        }
+      }
+    }
+  }
+  return true;
+}
+
+AVX2_TARGET void DepthwiseCenterAvx2(float *dst, const float *src, const float *weight, const float *bias, int height,
+                                     int width, int kernel_h, int kernel_w, int out_h_step, int block_channel,
+                                     int in_sh_step, int in_sw_step, int in_kh_step, int in_kw_step, bool is_relu,
+                                     bool is_relu6) {
+  __m128 bias_vec = _mm_loadu_ps(bias);
+  __m128 zero = _mm_setzero_ps();
+  __m128 six = _mm_set1_ps(6.0f);
+  for (int oh = 0; oh < height; oh++) {
+    float *dst_w = dst + oh * out_h_step;
+    const float *src_w = src + oh * in_sh_step;
+    int ow = 0;
+    // two output pixels at a time share the weight loads
+    for (; ow + 1 < width; ow += 2) {
+      __m128 acc0 = bias_vec;
+      __m128 acc1 = bias_vec;
+      for (int kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_w + kh * in_kh_step;
+        const float *weight_kw = weight + kh * kernel_w * C4NUM;
+        for (int kw = 0; kw < kernel_w; kw++) {
+          __m128 w = _mm_loadu_ps(weight_kw + kw * C4NUM);
+          acc0 = _mm_fmadd_ps(_mm_loadu_ps(src_kw), w, acc0);
+          acc1 = _mm_fmadd_ps(_mm_loadu_ps(src_kw + in_sw_step), w, acc1);
+          src_kw += in_kw_step;
+        }
+      }
+      if (is_relu || is_relu6) {
+        acc0 = _mm_max_ps(acc0, zero);
+        acc1 = _mm_max_ps(acc1, zero);
+      }
+      if (is_relu6) {
+        acc0 = _mm_min_ps(acc0, six);
+        acc1 = _mm_min_ps(acc1, six);
+      }
+      _mm_storeu_ps(dst_w, acc0);
+      _mm_storeu_ps(dst_w + block_channel, acc1);
+      dst_w += 2 * block_channel;
+      src_w += 2 * in_sw_step;
+    }
+    for (; ow < width; ow++) {
+      __m128 acc = bias_vec;
+      for (int kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_w + kh * in_kh_step;
+        const float *weight_kw = weight + kh * kernel_w * C4NUM;
+        for (int kw = 0; kw < kernel_w; kw++) {
+          acc = _mm_fmadd_ps(_mm_loadu_ps(src_kw), _mm_loadu_ps(weight_kw + kw * C4NUM), acc);
+          src_kw += in_kw_step;
+        }
+      }
+      if (is_relu || is_relu6) {
+        acc = _mm_max_ps(acc, zero);
+      }
+      if (is_relu6) {
+        acc = _mm_min_ps(acc, six);
+      }
+      _mm_storeu_ps(dst_w, acc);
+      dst_w += block_channel;
+      src_w += in_sw_step;
+    }
+  }
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_AVX_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_AVX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "src/runtime/kernel/arm/nnacl/op_base.h"
+#include "src/runtime/kernel/arm/nnacl/matmul.h"
+
+// AVX2 and FMA versions of the fp32 kernels, they take the same arguments and packed layouts as the C kernels and
+// must only be called when X86GetSimdLevel() >= X86SimdLevel_Avx2.
+
+// row_8_ and col_8_ must be multiples of 8.
+void MatMul8x8Avx2(const float *a, const float *b, float *c, const float *bias, ActType act_type, int deep, int row_8_,
+                   int col_8_);
+
+// Supports mode 0, and mode 1 with writeC4 as winograd uses it, returns false for the other modes.
+bool IndirectGemmFp32_8x8Avx2(float *output, const float *input, const float *weight, const float *bias, size_t step,
+                              size_t ic4, size_t output_channel, size_t offset, size_t mode, size_t writeC4,
+                              size_t relu, size_t relu6);
+
+void DepthwiseCenterAvx2(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
+                         int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
+                         int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6);
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_AVX_H_
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel/arm/nnacl/x86_64/matmul_int8_avx.h"
+#include <immintrin.h>
+#include "src/runtime/kernel/arm/nnacl/op_base.h"
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_VNNI_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512vl,avx512vnni")))
+
+namespace {
+AVX2_TARGET inline __m256i Combine(__m128i low, __m128i high) {
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+// The 8 bytes of row d of a packed 8 column block, zero out of the depth.
+AVX2_TARGET inline __m128i LoadRow8(const int8_t *block, int d, int deep) {
+  if (d >= deep) {
+    return _mm_setzero_si128();
+  }
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(block + d * C8NUM));
+}
+
+// Lane j holds (block[d][j] - zp, block[d + 1][j] - zp) as int16, zero out of the depth.
+AVX2_TARGET inline __m256i LoadPairs(const int8_t *block, int d, int deep, __m128i zp) {
+  __m128i row0 = _mm_sub_epi16(_mm_cvtepi8_epi16(LoadRow8(block, d, deep)), zp);
+  __m128i row1 = d + 1 < deep ? _mm_sub_epi16(_mm_cvtepi8_epi16(LoadRow8(block, d + 1, deep)), zp)
+                              : _mm_setzero_si128();
+  return Combine(_mm_unpacklo_epi16(row0, row1), _mm_unpackhi_epi16(row0, row1));
+}
+
+// Lane j holds the bytes block[d..d + 3][j], zero out of the depth.
+AVX2_TARGET inline __m256i LoadQuads(const int8_t *block, int d, int deep) {
+  __m128i row01 = _mm_unpacklo_epi8(LoadRow8(block, d, deep), LoadRow8(block, d + 1, deep));
+  __m128i row23 = _mm_unpacklo_epi8(LoadRow8(block, d + 2, deep), LoadRow8(block, d + 3, deep));
+  return Combine(_mm_unpacklo_epi16(row01, row23), _mm_unpackhi_epi16(row01, row23));
+}
+}  // namespace
+
+AVX2_TARGET void MatMulInt8Avx2(const int8_t *a, const int8_t *b, int32_t *c, int row8, int col8, int deep,
+                                int32_t a_zp, int32_t b_zp) {
+  /*  col8-major * row8-major => row8x8-major  */
+  __m128i a_zp_vec = _mm_set1_epi16(static_cast<int16_t>(a_zp));
+  __m128i b_zp_vec = _mm_set1_epi16(static_cast<int16_t>(b_zp));
+  for (int c8 = 0; c8 < col8 / C8NUM; ++c8) {
+    const int8_t *b_block = b + c8 * deep * C8NUM;
+    for (int r8 = 0; r8 < row8 / C8NUM; ++r8) {
+      const int8_t *a_block = a + r8 * deep * C8NUM;
+      __m256i acc[C8NUM];
+      for (int r = 0; r < C8NUM; ++r) {
+        acc[r] = _mm256_setzero_si256();
+      }
+      for (int d = 0; d < deep; d += 2) {
+        __m256i b_pairs = LoadPairs(b_block, d, deep, b_zp_vec);
+        alignas(32) int32_t a_pairs[C8NUM];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(a_pairs), LoadPairs(a_block, d, deep, a_zp_vec));
+        for (int r = 0; r < C8NUM; ++r) {
+          acc[r] = _mm256_add_epi32(acc[r], _mm256_madd_epi16(_mm256_set1_epi32(a_pairs[r]), b_pairs));
+        }
+      }
+      int32_t *c_block = c + c8 * row8 * C8NUM + r8 * C8NUM * C8NUM;
+      for (int r = 0; r < C8NUM; ++r) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c_block + r * C8NUM), acc[r]);
+      }
+    }
+  }
+}
+
+AVX512_VNNI_TARGET void MatMulInt8Avx512Vnni(const int8_t *a, const int8_t *b, int32_t *c, int row8, int col8,
+                                             int deep, int32_t a_zp, int32_t b_zp) {
+  /*  col8-major * row8-major => row8x8-major  */
+  // vpdpbusd multiplies unsigned by signed bytes, so a is offset by 128 to unsigned and the zero points are applied
+  // after the dot products: sum((a - a_zp) * (b - b_zp)) = sum((a + 128) * b) - (128 + a_zp) * sum(b)
+  //                                                        - b_zp * sum(a) + deep * a_zp * b_zp
+  __m256i ones = _mm256_set1_epi8(1);
+  __m256i sign = _mm256_set1_epi8(static_cast<char>(0x80));
+  int32_t zp_product = deep * a_zp * b_zp;
+  for (int c8 = 0; c8 < col8 / C8NUM; ++c8) {
+    const int8_t *b_block = b + c8 * deep * C8NUM;
+    __m256i b_sum = _mm256_setzero_si256();
+    for (int d = 0; d < deep; d += C4NUM) {
+      b_sum = _mm256_dpbusd_epi32(b_sum, ones, LoadQuads(b_block, d, deep));
+    }
+    __m256i col_offset =
+      _mm256_sub_epi32(_mm256_set1_epi32(zp_product), _mm256_mullo_epi32(b_sum, _mm256_set1_epi32(128 + a_zp)));
+    for (int r8 = 0; r8 < row8 / C8NUM; ++r8) {
+      const int8_t *a_block = a + r8 * deep * C8NUM;
+      __m256i acc[C8NUM];
+      for (int r = 0; r < C8NUM; ++r) {
+        acc[r] = col_offset;
+      }
+      __m256i a_sum = _mm256_setzero_si256();
+      for (int d = 0; d < deep; d += C4NUM) {
+        __m256i b_quads = LoadQuads(b_block, d, deep);
+        __m256i a_quads = LoadQuads(a_block, d, deep);
+        a_sum = _mm256_dpbusd_epi32(a_sum, ones, a_quads);
+        alignas(32) int32_t a_unsigned[C8NUM];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(a_unsigned), _mm256_xor_si256(a_quads, sign));
+        for (int r = 0; r < C8NUM; ++r) {
+          acc[r] = _mm256_dpbusd_epi32(acc[r], _mm256_set1_epi32(a_unsigned[r]), b_quads);
+        }
+      }
+      alignas(32) int32_t row_offset[C8NUM];
+      _mm256_store_si256(reinterpret_cast<__m256i *>(row_offset), _mm256_mullo_epi32(a_sum, _mm256_set1_epi32(b_zp)));
+      int32_t *c_block = c + c8 * row8 * C8NUM + r8 * C8NUM * C8NUM;
+      for (int r = 0; r < C8NUM; ++r) {
+        __m256i value = _mm256_sub_epi32(acc[r], _mm256_set1_epi32(row_offset[r]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(c_block + r * C8NUM), value);
+      }
+    }
+  }
+}
@@ -0,0 +1,30 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_MATMUL_INT8_AVX_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_MATMUL_INT8_AVX_H_
+
+#include <stdint.h>
+
+// x86-64 versions of MatMulInt8 with the same packed layouts, row8 and col8 must be multiples of 8.
+// Needs X86GetSimdLevel() >= X86SimdLevel_Avx2, multiplies pairs of int16 values.
+void MatMulInt8Avx2(const int8_t *a, const int8_t *b, int32_t *c, int row8, int col8, int deep, int32_t a_zp,
+                    int32_t b_zp);
+// Needs X86GetSimdLevel() >= X86SimdLevel_Avx512Vnni, multiplies quads of int8 values by vpdpbusd.
+void MatMulInt8Avx512Vnni(const int8_t *a, const int8_t *b, int32_t *c, int row8, int col8, int deep, int32_t a_zp,
+                          int32_t b_zp);
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_MATMUL_INT8_AVX_H_
@@ -0,0 +1,42 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_NEON_SSE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_NEON_SSE_H_
+
+// The float32x4 subset of the NEON intrinsics used by the C4 transforms, implemented by SSE which every x86-64 cpu
+// supports, so these transforms share one source for ARM and x86-64.
+#include <xmmintrin.h>
+
+typedef __m128 float32x4_t;
+
+static inline float32x4_t vld1q_f32(const float *ptr) { return _mm_loadu_ps(ptr); }
+static inline void vst1q_f32(float *ptr, float32x4_t v) { _mm_storeu_ps(ptr, v); }
+static inline float32x4_t vdupq_n_f32(float value) { return _mm_set1_ps(value); }
+static inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) { return _mm_add_ps(a, b); }
+static inline float32x4_t vsubq_f32(float32x4_t a, float32x4_t b) { return _mm_sub_ps(a, b); }
+static inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) { return _mm_mul_ps(a, b); }
+static inline float32x4_t vmulq_n_f32(float32x4_t a, float b) { return _mm_mul_ps(a, _mm_set1_ps(b)); }
+static inline float32x4_t vmlaq_f32(float32x4_t a, float32x4_t b, float32x4_t c) {
+  return _mm_add_ps(a, _mm_mul_ps(b, c));
+}
+static inline float32x4_t vmlaq_n_f32(float32x4_t a, float32x4_t b, float c) {
+  return _mm_add_ps(a, _mm_mul_ps(b, _mm_set1_ps(c)));
+}
+static inline float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b) { return _mm_max_ps(a, b); }
+static inline float32x4_t vminq_f32(float32x4_t a, float32x4_t b) { return _mm_min_ps(a, b); }
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_NEON_SSE_H_
@@ -1,51 +1,59 @@
+#ifdef RELU
+#define ACTIVATION(x) max(x, 0.0f)
+#elif defined(RELU6)
+#define ACTIVATION(x) clamp(x, 0.0f, 6.0f)
+#else
+#define ACTIVATION(x) (x)
+#endif
+
 __kernel void ElementAdd(__global float *input_a, __global float *input_b, __global float *output,
                          const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] + input_b[idx];
+  output[idx] = ACTIVATION(input_a[idx] + input_b[idx]);
 }
 
 __kernel void ElementSub(__global float *input_a, __global float *input_b, __global float *output,
                          const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] - input_b[idx];
+  output[idx] = ACTIVATION(input_a[idx] - input_b[idx]);
 }
 
 __kernel void ElementMul(__global float *input_a, __global float *input_b, __global float *output,
                          const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] * input_b[idx];
+  output[idx] = ACTIVATION(input_a[idx] * input_b[idx]);
 }
 
 __kernel void ElementDiv(__global float *input_a, __global float *input_b, __global float *output,
                          const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] * input_b[idx];
+  output[idx] = ACTIVATION(input_a[idx] * input_b[idx]);
 }
 
 __kernel void BoardcastAdd(__global float *input_a, float input_b, __global float *output, const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] + input_b;
+  output[idx] = ACTIVATION(input_a[idx] + input_b);
 }
 
 __kernel void BoardcastSub(__global float *input_a, float input_b, __global float *output, const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] - input_b;
+  output[idx] = ACTIVATION(input_a[idx] - input_b);
 }
 
 __kernel void BoardcastMul(__global float *input_a, float input_b, __global float *output, const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] * input_b;
+  output[idx] = ACTIVATION(input_a[idx] * input_b);
 }
 
 __kernel void BoardcastDiv(__global float *input_a, float input_b, __global float *output, const unsigned int n) {
   int idx = get_global_id(0);
   if (idx >= n) return;
-  output[idx] = input_a[idx] * input_b;
+  output[idx] = ACTIVATION(input_a[idx] * input_b);
 }
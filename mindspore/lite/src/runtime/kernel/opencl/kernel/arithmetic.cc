@@ -83,11 +83,22 @@ int ArithmeticOpenCLKernel::Init() {
       break;
   }
 
+  // the activation a fusion folded into the op runs on its result in the same kernel
+  std::set<std::string> build_options;
+  auto activation_type = reinterpret_cast<ArithmeticParameter *>(opParameter)->activation_type_;
+  if (activation_type == schema::ActivationType_RELU) {
+    build_options.emplace("-DRELU");
+  } else if (activation_type == schema::ActivationType_RELU6) {
+    build_options.emplace("-DRELU6");
+  } else if (activation_type != schema::ActivationType_NO_ACTIVATION) {
+    MS_LOG(ERROR) << "Unsupported activation type " << activation_type;
+    return 1;
+  }
+
 #ifdef PROGRAM_WITH_IL
   runtime_->CreateKernelFromIL(kernel_(), kernel_name);
 #else
   std::string program_name = "Arithmetic";
-  std::set<std::string> build_options;
   std::string source = arithmetic_buffer_source_fp32;
   runtime_->LoadSource(program_name, source);
 
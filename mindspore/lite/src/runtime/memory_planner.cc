@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/memory_planner.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+// tensors start at cache line boundaries, so simd loads of a tensor do not depend on its neighbours
+constexpr size_t kPlanAlignment = 64;
+// enough for a few batch sizes or sequence lengths, a graph resized to every length does not keep every plan
+constexpr size_t kMaxCachedPlans = 16;
+
+size_t AlignSize(size_t size) { return (size + kPlanAlignment - 1) / kPlanAlignment * kPlanAlignment; }
+}  // namespace
+
+MemoryPlanner::~MemoryPlanner() { Release(); }
+
+int MemoryPlanner::AnalyseLifetime(const std::vector<kernel::LiteKernel *> &kernels,
+                                   const std::vector<tensor::Tensor *> &graph_outputs, std::vector<TensorLife> *lives) {
+  MS_ASSERT(lives != nullptr);
+  std::unordered_map<tensor::Tensor *, size_t> life_index;
+  for (size_t i = 0; i < kernels.size(); i++) {
+    auto *kernel = kernels[i];
+    MS_ASSERT(kernel != nullptr);
+    if (kernel->Desc().arch != kernel::KERNEL_ARCH::kCPU) {
+      MS_LOG(DEBUG) << "Kernel " << kernel->Name() << " does not run on cpu, the graph is not planned.";
+      return RET_NO_CHANGE;
+    }
+    for (auto *tensor : kernel->GetInputs()) {
+      auto iter = life_index.find(tensor);
+      if (iter != life_index.end()) {
+        lives->at(iter->second).last = i;
+      }
+    }
+    for (auto *tensor : kernel->GetOutputs()) {
+      MS_ASSERT(tensor != nullptr);
+      if (tensor->Data() != nullptr) {
+        continue;
+      }
+      if (life_index.find(tensor) != life_index.end()) {
+        MS_LOG(DEBUG) << "Tensor of kernel " << kernel->Name() << " is written by two kernels, the graph is not planned.";
+        return RET_NO_CHANGE;
+      }
+      auto shape = tensor->shape();
+      auto size = tensor->Size();
+      if (size == 0 || std::any_of(shape.begin(), shape.end(), [](int dim) { return dim < 0; })) {
+        MS_LOG(DEBUG) << "Shape of an output of kernel " << kernel->Name() << " is unknown, the graph is not planned.";
+        return RET_NO_CHANGE;
+      }
+      life_index[tensor] = lives->size();
+      lives->push_back({tensor, AlignSize(size), i, i});
+    }
+  }
+  for (auto *tensor : graph_outputs) {
+    auto iter = life_index.find(tensor);
+    if (iter != life_index.end()) {
+      lives->at(iter->second).last = kernels.size();
+    }
+  }
+  return RET_OK;
+}
+
+MemoryPlanner::CachedPlan MemoryPlanner::AssignOffsets(const std::vector<TensorLife> &lives) {
+  // greedy by size: the large tensors are placed first, each tensor takes the lowest gap which is free during its
+  // lifetime
+  std::vector<size_t> order(lives.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&lives](size_t a, size_t b) { return lives[a].size > lives[b].size; });
+  CachedPlan plan{std::vector<size_t>(lives.size()), 0};
+  std::vector<size_t> placed;
+  for (auto index : order) {
+    auto &life = lives[index];
+    std::vector<std::pair<size_t, size_t>> used;
+    for (auto placed_index : placed) {
+      auto &placed_life = lives[placed_index];
+      if (placed_life.first <= life.last && life.first <= placed_life.last) {
+        used.emplace_back(plan.offsets[placed_index], plan.offsets[placed_index] + placed_life.size);
+      }
+    }
+    std::sort(used.begin(), used.end());
+    size_t offset = 0;
+    for (auto &range : used) {
+      if (range.first >= offset + life.size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    placed.emplace_back(index);
+    plan.offsets[index] = offset;
+    plan.planned_size = std::max(plan.planned_size, offset + life.size);
+  }
+  return plan;
+}
+
+int MemoryPlanner::ReserveArena(size_t size) {
+  if (size <= arena_size_) {
+    return RET_OK;
+  }
+  free(arena_);
+  arena_ = malloc(size + kPlanAlignment);
+  if (arena_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc memory arena failed, size=" << size;
+    arena_size_ = 0;
+    return RET_MEMORY_FAILED;
+  }
+  arena_size_ = size;
+  return RET_OK;
+}
+
+int MemoryPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels,
+                        const std::vector<tensor::Tensor *> &graph_outputs) {
+  Unbind();
+  std::vector<TensorLife> lives;
+  auto ret = AnalyseLifetime(kernels, graph_outputs, &lives);
+  if (ret != RET_OK || lives.empty()) {
+    return RET_NO_CHANGE;
+  }
+  std::vector<size_t> key;
+  for (auto &life : lives) {
+    key.emplace_back(life.size);
+  }
+  auto iter = cached_plans_.find(key);
+  if (iter == cached_plans_.end()) {
+    if (cached_order_.size() >= kMaxCachedPlans) {
+      cached_plans_.erase(cached_order_.front());
+      cached_order_.pop_front();
+    }
+    iter = cached_plans_.emplace(key, AssignOffsets(lives)).first;
+    cached_order_.emplace_back(key);
+  }
+  auto &plan = iter->second;
+  ret = ReserveArena(plan.planned_size);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  auto base = AlignSize(reinterpret_cast<uintptr_t>(arena_));
+  for (size_t i = 0; i < lives.size(); i++) {
+    lives[i].tensor->SetData(reinterpret_cast<void *>(base + plan.offsets[i]));
+    offsets_[lives[i].tensor] = plan.offsets[i];
+    total_tensor_size_ += lives[i].size;
+  }
+  planned_size_ = plan.planned_size;
+  MS_LOG(INFO) << "Plan " << offsets_.size() << " tensors into a memory arena of " << planned_size_ << " bytes, "
+               << total_tensor_size_ << " bytes without reuse.";
+  return RET_OK;
+}
+
+void MemoryPlanner::Unbind() {
+  for (auto &item : offsets_) {
+    item.first->SetData(nullptr);
+  }
+  offsets_.clear();
+  planned_size_ = 0;
+  total_tensor_size_ = 0;
+}
+
+void MemoryPlanner::Release() {
+  Unbind();
+  cached_plans_.clear();
+  cached_order_.clear();
+  free(arena_);
+  arena_ = nullptr;
+  arena_size_ = 0;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "src/lite_kernel.h"
+#include "src/ir/tensor.h"
+
+namespace mindspore::lite {
+// Plans the data of the intermediate tensors of a graph into one arena when the graph is compiled. The lifetime of a
+// tensor runs from the kernel writing it to the last kernel reading it, tensors whose lifetimes do not overlap share
+// memory, so running the graph allocates nothing. The offsets are cached by the sizes of the tensors and the arena only
+// grows, so switching between shapes which have been planned allocates nothing either.
+class MemoryPlanner {
+ public:
+  MemoryPlanner() = default;
+  ~MemoryPlanner();
+  MemoryPlanner(const MemoryPlanner &) = delete;
+  MemoryPlanner &operator=(const MemoryPlanner &) = delete;
+
+  // Plan the output tensors of kernels, which are sorted in the order they run. Graph outputs live until the end of the
+  // graph. Returns RET_NO_CHANGE if the graph can not be planned, for example a shape is unknown, then the tensors
+  // are left to the allocator.
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<tensor::Tensor *> &graph_outputs);
+  // Detach the planned tensors from the arena, the arena and the cached plans are kept for the next Plan.
+  void Unbind();
+  // Detach the planned tensors, free the arena and drop the cached plans.
+  void Release();
+
+  bool planned() const { return !offsets_.empty(); }
+  // bytes used by the current plan
+  size_t planned_size() const { return planned_size_; }
+  // bytes needed if every planned tensor had its own memory
+  size_t total_tensor_size() const { return total_tensor_size_; }
+  // bytes of the arena, the largest plan so far
+  size_t arena_size() const { return arena_size_; }
+  size_t cached_plan_num() const { return cached_plans_.size(); }
+  const std::unordered_map<tensor::Tensor *, size_t> &offsets() const { return offsets_; }
+
+ private:
+  struct TensorLife {
+    tensor::Tensor *tensor;
+    size_t size;
+    size_t first;
+    size_t last;
+  };
+
+  struct CachedPlan {
+    // offsets of the tensors in the order of the lifetimes
+    std::vector<size_t> offsets;
+    size_t planned_size;
+  };
+
+  int AnalyseLifetime(const std::vector<kernel::LiteKernel *> &kernels,
+                      const std::vector<tensor::Tensor *> &graph_outputs, std::vector<TensorLife> *lives);
+  CachedPlan AssignOffsets(const std::vector<TensorLife> &lives);
+  int ReserveArena(size_t size);
+
+  void *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  size_t planned_size_ = 0;
+  size_t total_tensor_size_ = 0;
+  std::unordered_map<tensor::Tensor *, size_t> offsets_;
+  // plans keyed by the sizes of the tensors in the order of the lifetimes, the oldest is dropped first
+  std::map<std::vector<size_t>, CachedPlan> cached_plans_;
+  std::deque<std::vector<size_t>> cached_order_;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
@@ -66,6 +66,19 @@ void SetMaxWokerNum(int num) {
   p->ConfigMaxThreadNum(num);
 }
 
+void SetThreadPoolSpinCount(int count) {
+  auto p = mindspore::predict::ThreadPool::GetInstance();
+  if (p == nullptr) {
+    MS_LOG(ERROR) << "Get thread pool instance failed";
+    return;
+  }
+  if (count < 0) {
+    LiteAPISetLastError("The spin count of thread pool is less than 0");
+    return;
+  }
+  p->ConfigSpinCount(count);
+}
+
 void ConfigThreadPool(int mode, int nthreads) {
   auto p = mindspore::predict::ThreadPool::GetInstance();
   if (p == nullptr) {
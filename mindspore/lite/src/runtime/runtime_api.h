@@ -44,6 +44,7 @@ INTERNAL_API_DLL void *LiteBackendAllocWorkspace(int deviceType, int deviceId, u
                                                  int dtypeBits);
 INTERNAL_API_DLL int LiteBackendFreeWorkspace(int deviceType, int deviceId, void *ptr);
 INTERNAL_API_DLL void SetMaxWokerNum(int num);
+INTERNAL_API_DLL void SetThreadPoolSpinCount(int count);
 INTERNAL_API_DLL void ConfigThreadPool(int mode, int nthreads);
 INTERNAL_API_DLL inline void CfgThreadPool(int nthread) { ConfigThreadPool(-1, nthread); }
 INTERNAL_API_DLL int LiteBackendParallelLaunch(FTVMParallelLambda flambda, void *cdata, int num_task);
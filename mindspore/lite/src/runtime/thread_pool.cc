@@ -16,12 +16,26 @@
 
 #include "src/runtime/thread_pool.h"
 #include <algorithm>
+#include <climits>
 #include "utils/log_adapter.h"
 #ifdef MS_COMPILE_IOS
 #include <sys/types.h>
 #include <sys/sysctl.h>
 #include <mach/machine.h>
 #endif  // MS_COMPILE_IOS
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <dirent.h>
+#include <sched.h>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <tuple>
+#endif
 
 namespace mindspore {
 namespace predict {
@@ -29,35 +43,108 @@ constexpr int kDefaultBigCount = 2;
 constexpr int kDefaultMidCount = 2;
 constexpr int kSmallCpuNum = 4;
 constexpr int kBigMidCpuNum = 4;
-constexpr int kDefaultThreadNum = 1;
-static unsigned int kDefaultMaxThreadNums = 8;
-static unsigned int localMaxThreadNums = 1;
-
-bool LiteQueue::Enqueue(ThreadPoolTask *task) {
-  const int tailIndex = tail.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tailIndex + 1) % kSingleThreadMaxTask;
-  if (next == head.load(std::memory_order_acquire)) {
-    return false;
+constexpr unsigned int kDefaultMaxThreadNums = 8;
+constexpr uint64_t kLaunchWorkerMask = 0xffffffffULL;
+constexpr int kLaunchSeqShift = 32;
+static std::atomic_uint localMaxThreadNums = {1};
+// whether the calling thread is running a task of the pool
+static thread_local bool inLaunch = false;
+
+namespace {
+unsigned int MaxThreadNums() {
+#if defined(__linux__) && !defined(__ANDROID__)
+  static unsigned int maxNums = std::max(kDefaultMaxThreadNums, std::thread::hardware_concurrency());
+  return maxNums;
+#else
+  return kDefaultMaxThreadNums;
+#endif
+}
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+#if defined(__linux__)
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+
+void FutexWait(std::atomic<uint32_t> *addr, uint32_t value) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t> *addr) {
+  (void)syscall(SYS_futex, reinterpret_cast<uint32_t *>(addr), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+#if defined(__linux__) && !defined(__ANDROID__)
+int ReadCpuTopology(unsigned int cpu, const std::string &name) {
+  std::ifstream ifs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+  int value = -1;
+  if (!(ifs >> value)) {
+    return -1;
+  }
+  return value;
+}
+
+int ReadCpuNode(unsigned int cpu) {
+  auto dir = opendir(("/sys/devices/system/cpu/cpu" + std::to_string(cpu)).c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+  int node = 0;
+  for (auto entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    if (strncmp(entry->d_name, "node", 4) == 0 && isdigit(entry->d_name[4])) {
+      node = atoi(entry->d_name + 4);
+      break;
+    }
   }
-  buffer[tailIndex] = task;
-  tail.store(next, std::memory_order_release);
-  ++taskSize;
-  return true;
+  (void)closedir(dir);
+  return node;
 }
+#endif
+}  // namespace
 
-bool LiteQueue::Dequeue(ThreadPoolTask **out) {
-  if (taskSize == 0) {
-    return false;
+void TaskRange::Reset(uint32_t begin, uint32_t end) {
+  range.store((static_cast<uint64_t>(end) << 32) | begin, std::memory_order_release);
+}
+
+bool TaskRange::PopFront(int *taskId) {
+  auto cur = range.load(std::memory_order_acquire);
+  while (true) {
+    auto begin = static_cast<uint32_t>(cur);
+    auto end = static_cast<uint32_t>(cur >> 32);
+    if (begin >= end) {
+      return false;
+    }
+    uint64_t next = (static_cast<uint64_t>(end) << 32) | (begin + 1);
+    if (range.compare_exchange_weak(cur, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      *taskId = static_cast<int>(begin);
+      return true;
+    }
   }
-  // queue empty
-  const int headIndex = head.load(std::memory_order_relaxed);
-  if (headIndex == tail.load(std::memory_order_acquire)) {
-    return false;
+}
+
+bool TaskRange::StealBack(uint32_t *begin, uint32_t *end) {
+  auto cur = range.load(std::memory_order_acquire);
+  while (true) {
+    auto curBegin = static_cast<uint32_t>(cur);
+    auto curEnd = static_cast<uint32_t>(cur >> 32);
+    if (curBegin >= curEnd) {
+      return false;
+    }
+    // take the back half, the owner keeps taking from the front
+    auto mid = curEnd - (curEnd - curBegin + 1) / 2;
+    uint64_t next = (static_cast<uint64_t>(mid) << 32) | curBegin;
+    if (range.compare_exchange_weak(cur, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+      *begin = mid;
+      *end = curEnd;
+      return true;
+    }
   }
-  *out = buffer[headIndex];
-  head.store((headIndex + 1) % kSingleThreadMaxTask, std::memory_order_release);
-  return true;
 }
 
 bool LiteThreadBind::Bind(bool ifBind, int numThreads, bool master) {
@@ -86,6 +173,9 @@ void LiteThreadBind::InitSortedCpuId() {
   // mate10(970)|p20(970): 4big, 4small
   // mate20(980)|p30(980)|mate30(990): 2big, 2mid, 4small
   // note: p30's core 7 not allowed to be bind
+  if (InitServerCpuId()) {
+    return;
+  }
   int numCores = 0;
 #ifdef MS_COMPILE_IOS
   size_t len = sizeof(numCores);
@@ -110,11 +200,61 @@ void LiteThreadBind::InitSortedCpuId() {
   }
 }
 
+bool LiteThreadBind::InitServerCpuId() {
+#if defined(__linux__) && !defined(__ANDROID__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return false;
+  }
+  struct CpuInfo {
+    unsigned int id;
+    int node;
+    int package;
+    int core;
+    // 0 for the first hardware thread of a physical core, 1 for its first smt sibling and so on
+    int smtRank;
+  };
+  std::vector<CpuInfo> cpus;
+  std::map<std::pair<int, int>, int> coreThreads;
+  for (unsigned int i = 0; i < CPU_SETSIZE; ++i) {
+    if (!CPU_ISSET(i, &allowed)) {
+      continue;
+    }
+    CpuInfo info{i, ReadCpuNode(i), ReadCpuTopology(i, "physical_package_id"), ReadCpuTopology(i, "core_id"), 0};
+    if (info.core < 0) {
+      MS_LOG(DEBUG) << "no cpu topology in sysfs, sort cpus by big and little cores";
+      return false;
+    }
+    info.smtRank = coreThreads[std::make_pair(info.package, info.core)]++;
+    cpus.emplace_back(info);
+  }
+  if (cpus.empty()) {
+    return false;
+  }
+  int masterCpu = sched_getcpu();
+  int masterNode = masterCpu >= 0 ? ReadCpuNode(static_cast<unsigned int>(masterCpu)) : cpus.front().node;
+  std::sort(cpus.begin(), cpus.end(), [masterNode](const CpuInfo &a, const CpuInfo &b) {
+    return std::make_tuple(a.smtRank, a.node != masterNode, a.node, a.package, a.core, a.id) <
+           std::make_tuple(b.smtRank, b.node != masterNode, b.node, b.package, b.core, b.id);
+  });
+  sortedCpuIds.clear();
+  for (const auto &cpu : cpus) {
+    sortedCpuIds.emplace_back(cpu.id);
+  }
+  serverTopology = true;
+  MS_LOG(DEBUG) << "sort " << sortedCpuIds.size() << " cpus by topology, master thread on numa node " << masterNode;
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool LiteThreadBind::BindMasterThread(bool bindFlag, int mode) {
   std::vector<int> cpu;
   if (bindFlag) {
     size_t cpuIndex;
-    if (mode == MID_CORE) {
+    if (mode == MID_CORE && !serverTopology) {
       cpuIndex = sortedCpuIds.size() - 1;
     } else {
       cpuIndex = 0;
@@ -146,7 +286,8 @@ bool LiteThreadBind::BindMasterThread(bool bindFlag, int mode) {
 
 bool LiteThreadBind::BindThreads(bool bindFlag) {
   if (bindFlag && bindModel != NO_BIND) {
-    size_t bindNums = std::min(sortedCpuIds.size(), threadIdList.size());
+    // the first cpu is left to the master thread on servers
+    size_t bindNums = std::min(sortedCpuIds.size() - (serverTopology ? 1 : 0), threadIdList.size());
     cpu_set_t cpuSet;
     size_t coreIndex;
     for (size_t i = 0; i < bindNums; ++i) {
@@ -155,7 +296,7 @@ bool LiteThreadBind::BindThreads(bool bindFlag) {
 #else
       CPU_ZERO(&cpuSet);
 #endif
-      if (bindModel == MID_CORE) {
+      if (bindModel == MID_CORE && !serverTopology) {
         coreIndex = sortedCpuIds.size() - 2 - i;
       } else {
         coreIndex = i + 1;
@@ -209,7 +350,7 @@ bool LiteThreadBind::SetCPUBind(pthread_t threadId, cpu_set_t *cpuSet) {
   MS_LOG(ERROR) << "not bind thread to apple's cpu.";
   return false;
 #else
-  int ret = pthread_setaffinity_np(threadId, sizeof(cpuSet), cpuSet);
+  int ret = pthread_setaffinity_np(threadId, sizeof(cpu_set_t), cpuSet);
   if (ret != 0) {
     MS_LOG(ERROR) << "bind thread " << threadId << " to cpu failed.ERROR " << ret;
     return false;
@@ -225,57 +366,38 @@ bool ThreadPool::SetThreadPool() {
     MS_LOG(WARNING) << "numThreads " << configThreadNums << ", must be greater than 0";
     configThreadNums = curThreadRunNums;
   }
-  if (localMaxThreadNums == 0) {
-    localMaxThreadNums = 1;
-  } else if (localMaxThreadNums > kDefaultMaxThreadNums) {
-    localMaxThreadNums = kDefaultMaxThreadNums;
+  unsigned int runNums = localMaxThreadNums;
+  if (runNums == 0) {
+    runNums = 1;
+  } else if (runNums > MaxThreadNums()) {
+    runNums = MaxThreadNums();
   }
-  if (configThreadNums > kDefaultMaxThreadNums) {
-    configThreadNums = kDefaultMaxThreadNums;
+  if (taskRanges == nullptr) {
+    taskRanges = std::unique_ptr<TaskRange[]>(new (std::nothrow) TaskRange[MaxThreadNums()]);
+    if (taskRanges == nullptr) {
+      MS_LOG(ERROR) << "malloc task ranges failed";
+      return false;
+    }
   }
-  int addNum = 0;
-  if (configThreadNums > kDefaultMaxThreadNums) {
-    addNum = configThreadNums - curThreadRunNums;
-  } else if (localMaxThreadNums > curThreadNums) {
-    addNum = localMaxThreadNums - curThreadNums;
-  }
-  AddNewThread(addNum);
-  if (curThreadRunNums > localMaxThreadNums) {
-    SubRunThread(localMaxThreadNums);
-  } else {
-    AddRunThread(localMaxThreadNums);
+  if (static_cast<int>(runNums) > curThreadNums) {
+    AddNewThread(static_cast<int>(runNums) - curThreadNums);
   }
+  // the workers beyond the run number are not given tasks and sleep after spinning
+  curThreadRunNums = static_cast<int>(runNums);
+  // spinning threads would take the cores from the running ones when there are more threads than cores
+  oversubscribed = runNums > std::thread::hardware_concurrency();
   MS_LOG(DEBUG) << "configThreadNums=" << configThreadNums << ", curThreadNums=" << curThreadNums
-                << ", curThreadRunNums=" << curThreadRunNums << ", localMaxThreadNums=" << localMaxThreadNums;
+                << ", curThreadRunNums=" << curThreadRunNums;
   return true;
 }
 
 void ThreadPool::AddNewThread(int newNums) {
+  // a new worker starts from the current launch, it is not published until the worker has been added
+  auto seen = launchState.load(std::memory_order_acquire);
   for (int i = curThreadNums - 1, j = 0; j < newNums; ++i, ++j) {
-    auto active = new std::atomic_bool{true};
-    auto queue = std::make_shared<LiteQueue>();
-    threadList.emplace_back([this, i, active, queue]() {
-      ThreadPoolTask *task = nullptr;
-      while (!exitRun) {
-        while (*active) {
-          if (queue->Dequeue(&task)) {
-            auto ret = task->first(i + 1, task->second.tvmParam, task->second.cdata);
-            if (ret != 0) {
-              errorInfo.emplace_back(std::make_pair(i + 1, std::make_pair(false, ret)));
-            }
-            queue->taskSize--;
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queueLock(tMutex);
-        queueReady.wait(queueLock, [active, this] { return exitRun || *active; });
-      }
-    });
-    activateList.emplace_back(active);
-    queueList.emplace_back(queue);
+    threadList.emplace_back(&ThreadPool::WorkerLoop, this, i, seen);
   }
   curThreadNums += newNums;
-  curThreadRunNums += newNums;
   MS_LOG(DEBUG) << "add " << newNums << " thread";
 }
 
@@ -290,7 +412,7 @@ bool ThreadPool::SetThreadCpuBind(bool ifBind, int mode, bool master) {
       MS_LOG(ERROR) << "create threadBind failed";
       return false;
     }
-    threadBind->threadIdList.resize(kDefaultMaxThreadNums);
+    threadBind->threadIdList.resize(MaxThreadNums());
     threadBind->InitSortedCpuId();
   }
   threadBind->threadIdList.clear();
@@ -305,120 +427,167 @@ bool ThreadPool::SetThreadCpuBind(bool ifBind, int mode, bool master) {
   return true;
 }
 
-bool ThreadPool::AddTask(WorkFun &&worker, void *cdata, int numTask) {
-  if (numTask <= 0) {
-    numTask = curThreadRunNums;
+void ThreadPool::RunTask(int taskId) {
+  int ret = launchWorker(taskId, &launchEnv, launchData);
+  if (ret != 0) {
+    MS_LOG(ERROR) << "task " << taskId << " failed, error code is " << ret;
+    int expected = 0;
+    (void)launchError.compare_exchange_strong(expected, ret);
   }
-  TvmEnv env{};
-  env.num_task = numTask;
-  errorInfo.clear();
-  // single task, run master thread
-  if (curThreadRunNums <= 1) {
-    for (int i = 0; i < numTask; ++i) {
-      int ret = worker(i, &env, cdata);
-      if (ret != 0) {
-        errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
+}
+
+void ThreadPool::RunTasks(int index) {
+  inLaunch = true;
+  auto own = &taskRanges[index];
+  int taskId = 0;
+  bool stolen = true;
+  while (stolen) {
+    while (own->PopFront(&taskId)) {
+      RunTask(taskId);
+    }
+    stolen = false;
+    for (int i = 1; i < launchThreads && !stolen; ++i) {
+      uint32_t begin = 0;
+      uint32_t end = 0;
+      if (taskRanges[(index + i) % launchThreads].StealBack(&begin, &end)) {
+        // the tasks stolen become the own range, so they can be stolen again
+        own->Reset(begin + 1, end);
+        RunTask(static_cast<int>(begin));
+        stolen = true;
       }
     }
-    return CheckResult();
   }
-  ThreadPoolTask task;
-  task.first = std::move(worker);
-  task.second.cdata = cdata;
-  task.second.tvmParam = &env;
-  return DistributeTask(&task, numTask);
+  inLaunch = false;
 }
 
-bool ThreadPool::DistributeTask(ThreadPoolTask *task, int numTask) {
-  MS_LOG(DEBUG) << "numTask = " << numTask << ", curThreadRunNums = " << curThreadRunNums;
-  auto taskOri = *task;
-  if (numTask > curThreadRunNums) {
-    task->first = [taskOri, numTask, this](int task_id, TvmEnv *penv, void *cdata) -> int {
-      for (int i = task_id; i < numTask; i += curThreadRunNums) {
-        int ret = taskOri.first(i, penv, cdata);
-        if (ret != 0) {
-          errorInfo.emplace_back(std::make_pair(i + 1, std::make_pair(false, ret)));
-        }
-      }
-      return 0;
-    };
-  }
-  bool kSuccFlag;
-  auto size = std::min(curThreadRunNums, numTask);
-  for (int i = 0; i < size - 1; ++i) {
-    do {
-      kSuccFlag = true;
-      if (!queueList[i]->Enqueue(task)) {
-        std::this_thread::yield();
-        kSuccFlag = false;
-      }
-    } while (!kSuccFlag);
-  }
-  // master thread
-  int ret = task->first(0, task->second.tvmParam, task->second.cdata);
-  if (ret != 0) {
-    errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
-  }
-  kSuccFlag = false;
-  while (!kSuccFlag) {
-    std::this_thread::yield();
-    kSuccFlag = true;
-    for (int i = 0; i < curThreadRunNums - 1; ++i) {
-      if (queueList[i]->taskSize != 0) {
-        kSuccFlag = false;
-        break;
-      }
+void ThreadPool::WorkerLoop(int index, uint64_t seen) {
+  while (true) {
+    seen = WaitLaunch(seen);
+    if (exitRun) {
+      return;
+    }
+    // the state of the launch stays untouched until every worker it needs has finished
+    if (index < static_cast<int>(seen & kLaunchWorkerMask)) {
+      RunTasks(index + 1);
+      pendingNums.fetch_sub(1, std::memory_order_release);
     }
   }
-  MS_LOG(DEBUG) << "finish " << numTask << " task successful";
-  return CheckResult();
 }
 
-void ThreadPool::AddRunThread(int num) {
-  MS_LOG(DEBUG) << "num=" << num << ", curThreadRunNums=" << curThreadRunNums;
-  int activeNums = num - curThreadRunNums;
-  if (activeNums <= 0 || activateList.size() < activeNums) {
-    return;
-  }
-  for (int i = curThreadRunNums - 1, j = 0; j < activeNums; ++i, ++j) {
-    *activateList[i] = true;
+uint64_t ThreadPool::WaitLaunch(uint64_t seen) {
+  int spins = oversubscribed ? 0 : spinCount.load(std::memory_order_relaxed);
+  for (int i = 0; i < spins; ++i) {
+    auto state = launchState.load(std::memory_order_acquire);
+    if (state != seen || exitRun) {
+      return state;
+    }
+    CpuRelax();
+  }
+  while (true) {
+    // a launcher which does not see the sleeper has bumped the sequence before it is read here, so the wait below
+    // returns at once
+    sleepingNums.fetch_add(1);
+    auto seq = wakeSeq.load();
+    auto state = launchState.load(std::memory_order_acquire);
+    if (state != seen || exitRun) {
+      sleepingNums.fetch_sub(1);
+      return state;
+    }
+#if defined(__linux__)
+    FutexWait(&wakeSeq, seq);
+#else
+    {
+      std::unique_lock<std::mutex> wakeLock(wakeMutex);
+      wakeCond.wait(wakeLock, [this, seq] { return wakeSeq.load() != seq; });
+    }
+#endif
+    sleepingNums.fetch_sub(1);
   }
-  std::lock_guard<std::mutex> queueLock(tMutex);
-  queueReady.notify_all();
-  curThreadRunNums = num;
 }
 
-void ThreadPool::SubRunThread(int num) {
-  MS_LOG(DEBUG) << "num=" << num << ", curThreadRunNums=" << curThreadRunNums;
-  int deactiveNums = curThreadRunNums - num;
-  if (deactiveNums <= 0) {
+void ThreadPool::NotifyLaunch() {
+  wakeSeq.fetch_add(1);
+  if (sleepingNums.load() == 0 && !exitRun) {
     return;
   }
-  for (int i = num - 1, j = 0; j < deactiveNums; ++i, ++j) {
-    *activateList[i] = false;
-  }
-  curThreadRunNums = num;
+#if defined(__linux__)
+  FutexWakeAll(&wakeSeq);
+#else
+  std::lock_guard<std::mutex> wakeLock(wakeMutex);
+  wakeCond.notify_all();
+#endif
 }
 
-bool ThreadPool::CheckResult() {
-  bool kSuccFlag = true;
-  for (auto result : errorInfo) {
-    if (result.second.first) {
-      MS_LOG(ERROR) << "task " << result.first << " failed, error code is " << result.second.second;
-      kSuccFlag = false;
+bool ThreadPool::DistributeTask(WorkFun &&worker, void *cdata, int numTask) {
+  MS_LOG(DEBUG) << "numTask = " << numTask << ", curThreadRunNums = " << curThreadRunNums;
+  launchWorker = std::move(worker);
+  launchData = cdata;
+  launchEnv = TvmEnv{};
+  launchEnv.num_task = numTask;
+  launchThreads = std::min(curThreadRunNums, numTask);
+  launchError = 0;
+  // contiguous ranges keep the neighbouring tasks of a kernel on one thread
+  for (int i = 0; i < launchThreads; ++i) {
+    auto begin = static_cast<int64_t>(numTask) * i / launchThreads;
+    auto end = static_cast<int64_t>(numTask) * (i + 1) / launchThreads;
+    taskRanges[i].Reset(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+  }
+  int workerNums = launchThreads - 1;
+  if (workerNums > 0) {
+    pendingNums.store(workerNums, std::memory_order_relaxed);
+    uint64_t seq = (launchState.load(std::memory_order_relaxed) >> kLaunchSeqShift) + 1;
+    launchState.store((seq << kLaunchSeqShift) | static_cast<uint64_t>(workerNums), std::memory_order_release);
+    NotifyLaunch();
+  }
+  // master thread
+  RunTasks(0);
+  int spins = oversubscribed ? 0 : spinCount.load(std::memory_order_relaxed);
+  for (int i = 0; pendingNums.load(std::memory_order_acquire) != 0;) {
+    if (i < spins) {
+      CpuRelax();
+      ++i;
+    } else {
+      std::this_thread::yield();
     }
   }
-  return kSuccFlag;
+  launchWorker = nullptr;
+  if (launchError != 0) {
+    return false;
+  }
+  MS_LOG(DEBUG) << "finish " << numTask << " task successful";
+  return true;
 }
 
 bool ThreadPool::LaunchWork(WorkFun worker, void *cdata, int numTask) {
+  // a single task runs on the calling thread without touching the pool, so sessions running single threaded on
+  // threads of their own do not contend for it, and so does a launch from inside a task, which would wait for the
+  // launch running it otherwise
+  if (numTask == 1 || inLaunch) {
+    TvmEnv env{};
+    env.num_task = std::max(numTask, 1);
+    bool succ = true;
+    for (int i = 0; i < env.num_task; ++i) {
+      int ret = worker(i, &env, cdata);
+      if (ret != 0) {
+        MS_LOG(ERROR) << "task " << i << " failed, error code is " << ret;
+        succ = false;
+      }
+    }
+    return succ;
+  }
+  // the workers and their task ranges serve one launch at a time
+  std::lock_guard<std::mutex> launchLock(launchMutex);
   if (!SetThreadPool()) {
     return false;
   }
-  return AddTask(std::move(worker), cdata, numTask);
+  if (numTask <= 0) {
+    numTask = curThreadRunNums;
+  }
+  return DistributeTask(std::move(worker), cdata, numTask);
 }
 
 bool ThreadPool::BindAllThreads(bool ifBind, int mode, bool master) {
+  std::lock_guard<std::mutex> launchLock(launchMutex);
   if (!SetThreadPool()) {
     return false;
   }
@@ -432,25 +601,21 @@ void ThreadPool::ConfigThreadPool(int mode, int numThreads) {
 
 void ThreadPool::ConfigMaxThreadNum(unsigned int num) { localMaxThreadNums = num; }
 
+void ThreadPool::ConfigSpinCount(int count) { spinCount = std::max(count, 0); }
+
 ThreadPool *ThreadPool::GetInstance() {
   static ThreadPool instance;
   return &instance;
 }
 
 ThreadPool::~ThreadPool() {
-  curThreadRunNums = static_cast<int>(threadList.size() + 1);
   exitRun = true;
-  SubRunThread(kDefaultThreadNum);
-  queueReady.notify_all();
+  NotifyLaunch();
   for (auto &it : threadList) {
     if (it.joinable()) {
       it.join();
     }
   }
-  for (const auto &it : activateList) {
-    delete it;
-  }
 }
 }  // namespace predict
 }  // namespace mindspore
-
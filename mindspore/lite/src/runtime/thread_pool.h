@@ -23,10 +23,10 @@
 #include <vector>
 #include <string>
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <functional>
-#include <iostream>
 #include "src/runtime/runtime_api.h"
 
 namespace mindspore {
@@ -41,28 +41,18 @@ typedef struct {
 #define CPU_SET_LOCAL(cpu, cpusetp) ((cpusetp)->__bits[(cpu) / __NCPUBITS] |= (1UL << ((cpu) % __NCPUBITS)))
 #endif
 
-constexpr int kSingleThreadMaxTask = 2;
+constexpr int kDefaultSpinCount = 2000;
 using TvmEnv = LiteParallelGroupEnv;
 using WorkFun = std::function<int(int, TvmEnv *, void *)>;
-using TaskParam = struct Param {
-  void *cdata;
-  TvmEnv *tvmParam;
-};
-using ThreadPoolTask = std::pair<WorkFun, TaskParam>;
 enum AffinityMode : int { BIG_CORE = 1, MID_CORE = -1, NO_BIND = 0 };
 
-class LiteQueue {
- public:
-  LiteQueue() = default;
-  ~LiteQueue() = default;
-  bool Enqueue(ThreadPoolTask *task);
-  bool Dequeue(ThreadPoolTask **out);
-  std::atomic_int taskSize = {0};
-
- private:
-  std::atomic_int head = {0};
-  std::atomic_int tail = {0};
-  ThreadPoolTask *buffer[kSingleThreadMaxTask]{};
+// The task ids of a launch not taken yet by a thread, packed as [begin, end) in one word so that the owner taking
+// from the front and the thieves stealing from the back agree by a single compare and swap.
+struct alignas(64) TaskRange {
+  std::atomic<uint64_t> range = {0};
+  void Reset(uint32_t begin, uint32_t end);
+  bool PopFront(int *taskId);
+  bool StealBack(uint32_t *begin, uint32_t *end);
 };
 
 class LiteThreadBind {
@@ -75,14 +65,24 @@ class LiteThreadBind {
   std::vector<pthread_t> threadIdList;
 
  private:
+  bool InitServerCpuId();
   bool BindMasterThread(bool bindFlag, int mode);
   bool BindThreads(bool bindFlag);
   bool SetCPUBind(pthread_t threadId, cpu_set_t *cpuSet);
   int bigCore = 0;
   int midCore = 0;
+  // on linux servers the cpus are sorted by topology instead of by big and little cores: a hardware thread of each
+  // physical core first, those on the numa node of the master thread ahead, then their smt siblings
+  bool serverTopology = false;
   std::vector<unsigned int> sortedCpuIds{};
 };
 
+// Runs the tasks of a launch on the calling thread and the workers. The task ids are split into contiguous ranges, one
+// per thread, a thread done with its own range steals half of the range of another one, so uneven tasks do not leave
+// stragglers. Idle workers spin for a while and then sleep on a futex, which keeps the wakeup of back to back kernels
+// cheap without burning the cores between inferences.
+//
+// The pool serves one launch at a time. A launch from inside a task runs its tasks on the calling thread.
 class ThreadPool {
  public:
   ThreadPool() = default;
@@ -91,6 +91,8 @@ class ThreadPool {
   bool LaunchWork(WorkFun worker, void *cdata, int numTask);
   void ConfigThreadPool(int mode, int numThreads);
   void ConfigMaxThreadNum(unsigned int num);
+  // the number of polls an idle worker spins before it sleeps, 0 to sleep at once
+  void ConfigSpinCount(int count);
   bool BindAllThreads(bool ifBind, int mode, bool master = true);
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
@@ -99,25 +101,42 @@ class ThreadPool {
   bool SetThreadPool();
   void AddNewThread(int newNums);
   bool SetThreadCpuBind(bool ifBind, int mode, bool master);
-  bool AddTask(WorkFun &&worker, void *cdata, int numTask);
-  bool DistributeTask(ThreadPoolTask *task, int numTask);
-  void AddRunThread(int num);
-  void SubRunThread(int num);
-  bool CheckResult();
+  bool DistributeTask(WorkFun &&worker, void *cdata, int numTask);
+  void RunTasks(int index);
+  void RunTask(int taskId);
+  void WorkerLoop(int index, uint64_t seen);
+  uint64_t WaitLaunch(uint64_t seen);
+  void NotifyLaunch();
 
   std::mutex poolMutex;
-  std::mutex tMutex;
-  std::condition_variable queueReady;
+  std::mutex launchMutex;
   std::atomic_bool exitRun = {false};
-  std::vector<std::atomic_bool *> activateList{};
   int curThreadNums = 1;
   int curThreadRunNums = 1;
   int configThreadNums = 1;
   int configBindMode = -1;
+  std::atomic_int spinCount = {kDefaultSpinCount};
+  std::atomic_bool oversubscribed = {false};
   std::vector<std::thread> threadList{};
-  std::vector<std::shared_ptr<LiteQueue>> queueList{};
   std::unique_ptr<LiteThreadBind> threadBind{nullptr};
-  std::vector<std::pair<int, std::pair<bool, int>>> errorInfo{};
+
+  // the launch being run, written by the master thread before the launch is published
+  WorkFun launchWorker;
+  void *launchData = nullptr;
+  TvmEnv launchEnv{};
+  int launchThreads = 1;
+  std::unique_ptr<TaskRange[]> taskRanges{nullptr};
+  // the sequence number of the launch in the high half and the number of workers it needs in the low half, the workers
+  // read both in one load
+  std::atomic<uint64_t> launchState = {0};
+  std::atomic<uint32_t> wakeSeq = {0};
+  std::atomic_int sleepingNums = {0};
+  std::atomic_int pendingNums = {0};
+  std::atomic_int launchError = {0};
+#if !defined(__linux__)
+  std::mutex wakeMutex;
+  std::condition_variable wakeCond;
+#endif
 };
 }  // namespace predict
 }  // namespace mindspore
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/weight_cache.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+WeightCache *WeightCache::GetInstance() {
+  static WeightCache instance;
+  return &instance;
+}
+
+WeightCache::~WeightCache() {
+  for (auto &iter : shared_) {
+    free(iter.first);
+  }
+  shared_.clear();
+  published_.clear();
+}
+
+void *WeightCache::Pack(size_t size, const std::function<void(void *)> &pack_func) {
+  auto packed = malloc(size);
+  if (packed == nullptr) {
+    MS_LOG(ERROR) << "Malloc packed weight of " << size << " bytes failed.";
+    return nullptr;
+  }
+  memset(packed, 0, size);
+  pack_func(packed);
+  return packed;
+}
+
+void *WeightCache::Acquire(tensor::Tensor *weight, const std::string &key, size_t size,
+                           const std::function<void(void *)> &pack_func) {
+  if (size == 0 || pack_func == nullptr) {
+    MS_LOG(ERROR) << "Invalid packed weight of " << key;
+    return nullptr;
+  }
+  if (weight == nullptr || !weight->IsModelWeight() || weight->Data() == nullptr) {
+    return Pack(size, pack_func);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Key weight_key(weight->Data(), key);
+  auto iter = published_.find(weight_key);
+  if (iter != published_.end()) {
+    auto &packed_weight = shared_.at(iter->second);
+    if (packed_weight.size == size) {
+      packed_weight.ref_count++;
+      return iter->second;
+    }
+    // the key misses a parameter of the packing, do not share it
+    MS_LOG(WARNING) << "Packed weight of " << key << " has " << packed_weight.size << " bytes, " << size
+                    << " bytes are expected, it is packed again.";
+    return Pack(size, pack_func);
+  }
+  // packing under the lock keeps two sessions compiling at the same time from packing a weight twice
+  auto packed = Pack(size, pack_func);
+  if (packed == nullptr) {
+    return nullptr;
+  }
+  published_[weight_key] = packed;
+  shared_[packed] = PackedWeight{weight_key, size, 1, true};
+  return packed;
+}
+
+void WeightCache::Release(void *packed) {
+  if (packed == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = shared_.find(packed);
+  if (iter == shared_.end()) {
+    free(packed);
+    return;
+  }
+  if (--iter->second.ref_count > 0) {
+    return;
+  }
+  if (iter->second.published) {
+    published_.erase(iter->second.key);
+  }
+  free(packed);
+  shared_.erase(iter);
+}
+
+void WeightCache::Invalidate(const void *buf, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto begin = reinterpret_cast<uintptr_t>(buf);
+  for (auto iter = published_.begin(); iter != published_.end();) {
+    auto origin = reinterpret_cast<uintptr_t>(iter->first.first);
+    if (origin >= begin && origin < begin + size) {
+      shared_.at(iter->second).published = false;
+      iter = published_.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+}
+
+size_t WeightCache::shared_size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = 0;
+  for (auto &iter : shared_) {
+    size += iter.second.size;
+  }
+  return size;
+}
+
+size_t WeightCache::shared_num() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return shared_.size();
+}
+}  // namespace mindspore::lite
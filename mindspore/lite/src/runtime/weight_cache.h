@@ -0,0 +1,73 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_CACHE_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "src/ir/tensor.h"
+
+namespace mindspore::lite {
+// Weights packed by kernels, shared by the kernels of every session compiled from the same model. A weight in a model
+// buffer does not change while the model is alive, so the first kernel packing it publishes the packed weight and the
+// kernels of the other sessions take it, which makes a session cost its activations only. Packed weights are immutable
+// once published, kernels may read them from any thread.
+class WeightCache {
+ public:
+  static WeightCache *GetInstance();
+  ~WeightCache();
+  WeightCache(const WeightCache &) = delete;
+  WeightCache &operator=(const WeightCache &) = delete;
+
+  // Get the weight packed by pack_func into size bytes, which are zeroed before packing. key identifies the packing
+  // of the kernel, including every parameter it depends on besides the weight. The packed weight is shared if weight
+  // is in a model buffer, otherwise it is private to the caller. Returns nullptr if the memory can not be allocated.
+  void *Acquire(tensor::Tensor *weight, const std::string &key, size_t size,
+                const std::function<void(void *)> &pack_func);
+  // Release a packed weight got from Acquire, it is freed when no kernel holds it.
+  void Release(void *packed);
+  // Stop sharing the weights packed from [buf, buf + size) because the model buffer is freed, the kernels holding
+  // them still keep them.
+  void Invalidate(const void *buf, size_t size);
+
+  // bytes of the shared packed weights
+  size_t shared_size();
+  size_t shared_num();
+
+ private:
+  using Key = std::pair<const void *, std::string>;
+  struct PackedWeight {
+    Key key;
+    size_t size;
+    size_t ref_count;
+    bool published;
+  };
+
+  WeightCache() = default;
+  static void *Pack(size_t size, const std::function<void(void *)> &pack_func);
+
+  std::mutex mutex_;
+  std::map<Key, void *> published_;
+  std::unordered_map<void *, PackedWeight> shared_;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_CACHE_H_
@@ -19,11 +19,33 @@
 #include <vector>
 #include "include/errorcode.h"
 #include "src/kernel_factory.h"
+#include "src/common/utils.h"
 #if SUPPORT_GPU
 #include "src/runtime/kernel/opencl/subgraph_opencl_kernel.h"
 #endif
 
 namespace mindspore::lite {
+namespace {
+// true if the tensor is read by some kernels, all of them on cpu and reading it as their first input in format
+bool ConsumersSupportFormat(const std::vector<kernel::LiteKernel *> &kernels, const tensor::Tensor *tensor,
+                            schema::Format format) {
+  bool consumed = false;
+  for (auto *kernel : kernels) {
+    auto &inputs = kernel->GetInputs();
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (inputs[i] != tensor) {
+        continue;
+      }
+      if (i != 0 || kernel->Desc().arch != kernel::KERNEL_ARCH::kCPU || !kernel->SupportInputFormat(format)) {
+        return false;
+      }
+      consumed = true;
+    }
+  }
+  return consumed;
+}
+}  // namespace
+
 int Scheduler::Schedule(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
                         std::vector<kernel::LiteKernel *> *kernels) {
   // 1. op ---> kernel
@@ -37,6 +59,13 @@ int Scheduler::Schedule(const lite::Model *model, std::vector<tensor::Tensor *>
 
   kernel::LiteKernelUtil::TopologicalSortKernels(*kernels);
 
+  std::vector<tensor::Tensor *> graph_outputs;
+  auto out_indexes = model->GetMetaGraph()->outputIndex();
+  for (size_t i = 0; i < out_indexes->size(); i++) {
+    graph_outputs.emplace_back(tensors->at(size_t(out_indexes->GetAs<uint32_t>(i))));
+  }
+  PropagateLayout(*kernels, graph_outputs);
+
   ConstructSubgraphs(kernels);
 
   MS_LOG(DEBUG) << "schedule kernels success.";
@@ -88,6 +117,39 @@ int Scheduler::InitOp2Kernel(const lite::Model *model, std::vector<tensor::Tenso
   return RET_OK;
 }
 
+void Scheduler::PropagateLayout(const std::vector<kernel::LiteKernel *> &kernels,
+                                const std::vector<tensor::Tensor *> &graph_outputs) {
+  for (auto *kernel : kernels) {
+    if (kernel->Desc().arch != kernel::KERNEL_ARCH::kCPU || kernel->GetOutputs().empty() ||
+        !kernel->SupportOutputFormat(schema::Format_NHWC4)) {
+      continue;
+    }
+    auto *output = kernel->GetOutputs().front();
+    // NHWC4 is the same as NHWC if the channel is aligned already
+    if (output->GetFormat() != schema::Format_NHWC || output->data_type() != kNumberTypeFloat32 ||
+        output->shape().size() != 4 || output->Channel() % C4NUM == 0 || IsContain(graph_outputs, output)) {
+      continue;
+    }
+    if (ConsumersSupportFormat(kernels, output, schema::Format_NHWC4)) {
+      MS_LOG(DEBUG) << "Keep the output of kernel " << kernel->Name() << " in NHWC4.";
+      output->SetFormat(schema::Format_NHWC4);
+    }
+  }
+}
+
+void Scheduler::ResetLayout(const std::vector<kernel::LiteKernel *> &kernels) {
+  for (auto *kernel : kernels) {
+    if (kernel->Desc().arch != kernel::KERNEL_ARCH::kCPU) {
+      continue;
+    }
+    for (auto *output : kernel->GetOutputs()) {
+      if (output->GetFormat() == schema::Format_NHWC4) {
+        output->SetFormat(schema::Format_NHWC);
+      }
+    }
+  }
+}
+
 void Scheduler::ConstructSubgraphs(std::vector<kernel::LiteKernel *> *kernels) {
   uint32_t kernel_count = kernels->size();
   std::vector<kernel::LiteKernel *> sub_kernels;
@@ -28,6 +28,12 @@ class Scheduler {
   explicit Scheduler(const Context *ctx) : context_(ctx) {}
   int Schedule(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
                std::vector<kernel::LiteKernel *> *kernels);
+  // Keep the first output of a cpu kernel in NHWC4 when the kernel writes it so and all its consumers read it so, which
+  // saves the NHWC4 packing and unpacking of the kernels on both sides. Graph outputs stay in NHWC.
+  static void PropagateLayout(const std::vector<kernel::LiteKernel *> &kernels,
+                              const std::vector<tensor::Tensor *> &graph_outputs);
+  // Set the tensors back to NHWC before their shapes are inferred again.
+  static void ResetLayout(const std::vector<kernel::LiteKernel *> &kernels);
 
  protected:
   kernel::LiteKernel *ScheduleNode(const std::vector<tensor::Tensor *> &inputs,
@@ -14,8 +14,14 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 #include "mindspore/lite/schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -23,6 +29,7 @@
 #include "include/context.h"
 #include "include/errorcode.h"
 #include "mindspore/core/utils/log_adapter.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/pack.h"
 
 namespace mindspore {
 class InferTest : public mindspore::Common {
@@ -241,6 +248,648 @@ TEST_F(InferTest, TestAddNode) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestResizeAddNode) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+
+  for (int i = 0; i < 2; i++) {
+    auto input = std::make_unique<schema::TensorT>();
+    input->nodeType = schema::NodeType::NodeType_ValueNode;
+    input->format = schema::Format_NHWC;
+    input->dataType = TypeId::kNumberTypeFloat32;
+    input->dims = {1, 4, 4, 3};
+    input->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(input));
+  }
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model.get());
+  ASSERT_EQ(lite::RET_OK, ret);
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 2);
+
+  // switch between batch sizes, the second switch to a batch uses the cached memory plan
+  for (int batch : {3, 1, 3}) {
+    ret = session->Resize(inputs, {{batch, 4, 4, 3}, {batch, 4, 4, 3}});
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto element_num = batch * 4 * 4 * 3;
+    for (auto *in_tensor : inputs) {
+      ASSERT_EQ(element_num, in_tensor->ElementsNum());
+      auto *in_data = reinterpret_cast<float *>(in_tensor->MutableData());
+      ASSERT_NE(nullptr, in_data);
+      for (int i = 0; i < element_num; i++) {
+        in_data[i] = static_cast<float>(i);
+      }
+    }
+    ret = session->RunGraph();
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_EQ(element_num, outputs.front()->ElementsNum());
+    auto *out_data = reinterpret_cast<float *>(outputs.front()->MutableData());
+    for (int i = 0; i < element_num; i++) {
+      ASSERT_EQ(static_cast<float>(2 * i), out_data[i]);
+    }
+  }
+  // the inputs must be inputs of the graph, and one shape is needed for each of them
+  ASSERT_NE(lite::RET_OK, session->Resize(inputs, {{1, 4, 4, 3}}));
+  delete session;
+  delete context;
+}
+
+static std::unique_ptr<schema::TensorT> NewFloatTensor(const std::vector<int> &dims, schema::NodeType node_type,
+                                                       const std::vector<float> &data = {}) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = node_type;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = TypeId::kNumberTypeFloat32;
+  tensor->dims = dims;
+  tensor->offset = -1;
+  if (!data.empty()) {
+    tensor->data.resize(data.size() * sizeof(float));
+    memcpy(tensor->data.data(), data.data(), tensor->data.size());
+  }
+  return tensor;
+}
+
+static std::shared_ptr<lite::Model> ImportMetaGraph(schema::MetaGraphT *meta_graph) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph);
+  builder.Finish(offset);
+  return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+TEST_F(InferTest, TestResizeFullConnection) {
+  const int deep = 6;
+  const int col = 4;
+  std::vector<float> weight(col * deep);
+  std::vector<float> bias(col);
+  for (int i = 0; i < col * deep; i++) {
+    weight[i] = static_cast<float>(i % 5) - 2;
+  }
+  for (int i = 0; i < col; i++) {
+    bias[i] = static_cast<float>(i);
+  }
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1, 2};
+  node->outputIndex = {3};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_FullConnection;
+  auto primitive = new schema::FullConnectionT;
+  primitive->hasBias = true;
+  primitive->axis = 1;
+  node->primitive->value.value = primitive;
+  node->name = "FullConnection";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {3};
+  meta_graph->allTensors.emplace_back(NewFloatTensor({2, deep}, schema::NodeType::NodeType_ValueNode));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({col, deep}, schema::NodeType::NodeType_ValueNode, weight));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({col}, schema::NodeType::NodeType_ValueNode, bias));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  auto model = ImportMetaGraph(meta_graph.get());
+  ASSERT_NE(nullptr, model);
+
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model.get()));
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+
+  // the packed rows grow past one block of 8 and shrink back
+  for (int row : {9, 2, 17}) {
+    ASSERT_EQ(lite::RET_OK, session->Resize(inputs, {{row, deep}}));
+    auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+    ASSERT_NE(nullptr, in_data);
+    for (int i = 0; i < row * deep; i++) {
+      in_data[i] = static_cast<float>(i % 7) * 0.5f;
+    }
+    ASSERT_EQ(lite::RET_OK, session->RunGraph());
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_EQ(row * col, outputs.front()->ElementsNum());
+    auto *out_data = reinterpret_cast<float *>(outputs.front()->MutableData());
+    for (int r = 0; r < row; r++) {
+      for (int c = 0; c < col; c++) {
+        float expect = bias[c];
+        for (int k = 0; k < deep; k++) {
+          expect += in_data[r * deep + k] * weight[c * deep + k];
+        }
+        ASSERT_NEAR(expect, out_data[r * col + c], 1e-4);
+      }
+    }
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestResizeConv1x1) {
+  const int channel_in = 3;
+  const int channel_out = 5;
+  std::vector<float> weight(channel_out * channel_in);
+  for (int i = 0; i < channel_out * channel_in; i++) {
+    weight[i] = static_cast<float>(i % 4) - 1.5f;
+  }
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto primitive = new schema::Conv2DT;
+  primitive->padMode = schema::PadMode_SAME;
+  primitive->channelIn = channel_in;
+  primitive->channelOut = channel_out;
+  primitive->format = schema::Format_NHWC;
+  primitive->strideH = 1;
+  primitive->strideW = 1;
+  primitive->kernelH = 1;
+  primitive->kernelW = 1;
+  primitive->dilateH = 1;
+  primitive->dilateW = 1;
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+  meta_graph->allTensors.emplace_back(NewFloatTensor({1, 2, 2, channel_in}, schema::NodeType::NodeType_ValueNode));
+  auto weight_tensor =
+    NewFloatTensor({channel_out, 1, 1, channel_in}, schema::NodeType::NodeType_ValueNode, weight);
+  weight_tensor->format = schema::Format_KHWC;
+  meta_graph->allTensors.emplace_back(std::move(weight_tensor));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  auto model = ImportMetaGraph(meta_graph.get());
+  ASSERT_NE(nullptr, model);
+
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model.get()));
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+
+  // the height and width change the rows of the matmul, not only the batch
+  std::vector<std::vector<int>> shapes = {{2, 3, 5, channel_in}, {1, 2, 2, channel_in}, {1, 7, 3, channel_in}};
+  for (const auto &shape : shapes) {
+    ASSERT_EQ(lite::RET_OK, session->Resize(inputs, {shape}));
+    int pixels = shape[0] * shape[1] * shape[2];
+    auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+    ASSERT_NE(nullptr, in_data);
+    for (int i = 0; i < pixels * channel_in; i++) {
+      in_data[i] = static_cast<float>(i % 9) * 0.25f;
+    }
+    ASSERT_EQ(lite::RET_OK, session->RunGraph());
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_EQ(pixels * channel_out, outputs.front()->ElementsNum());
+    auto *out_data = reinterpret_cast<float *>(outputs.front()->MutableData());
+    for (int p = 0; p < pixels; p++) {
+      for (int o = 0; o < channel_out; o++) {
+        float expect = 0;
+        for (int c = 0; c < channel_in; c++) {
+          expect += in_data[p * channel_in + c] * weight[o * channel_in + c];
+        }
+        ASSERT_NEAR(expect, out_data[p * channel_out + o], 1e-4);
+      }
+    }
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestResizeConv3x3) {
+  const int channel_in = 3;
+  const int channel_out = 5;
+  const int kernel = 3;
+  const int stride = 2;
+  const int pad = 1;
+  std::vector<float> weight(channel_out * kernel * kernel * channel_in);
+  for (size_t i = 0; i < weight.size(); i++) {
+    weight[i] = static_cast<float>(i % 7) * 0.25f - 0.75f;
+  }
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto primitive = new schema::Conv2DT;
+  // explicit pads keep the conv parameter of the kernel valid for any input size
+  primitive->padMode = schema::PadMode_CAFFE;
+  primitive->padUp = pad;
+  primitive->padDown = pad;
+  primitive->padLeft = pad;
+  primitive->padRight = pad;
+  primitive->channelIn = channel_in;
+  primitive->channelOut = channel_out;
+  primitive->format = schema::Format_NHWC;
+  // stride 2 runs the common conv kernel instead of the 3x3 or winograd ones
+  primitive->strideH = stride;
+  primitive->strideW = stride;
+  primitive->kernelH = kernel;
+  primitive->kernelW = kernel;
+  primitive->dilateH = 1;
+  primitive->dilateW = 1;
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+  meta_graph->allTensors.emplace_back(NewFloatTensor({1, 4, 4, channel_in}, schema::NodeType::NodeType_ValueNode));
+  auto weight_tensor =
+    NewFloatTensor({channel_out, kernel, kernel, channel_in}, schema::NodeType::NodeType_ValueNode, weight);
+  weight_tensor->format = schema::Format_KHWC;
+  meta_graph->allTensors.emplace_back(std::move(weight_tensor));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  auto model = ImportMetaGraph(meta_graph.get());
+  ASSERT_NE(nullptr, model);
+
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model.get()));
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+
+  // growing and shrinking the input reallocates the packed input of the kernel
+  std::vector<std::vector<int>> shapes = {{2, 9, 7, channel_in}, {1, 4, 4, channel_in}, {1, 5, 11, channel_in}};
+  for (const auto &shape : shapes) {
+    ASSERT_EQ(lite::RET_OK, session->Resize(inputs, {shape}));
+    int batch = shape[0];
+    int in_h = shape[1];
+    int in_w = shape[2];
+    int out_h = (in_h + 2 * pad - kernel) / stride + 1;
+    int out_w = (in_w + 2 * pad - kernel) / stride + 1;
+    auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+    ASSERT_NE(nullptr, in_data);
+    for (int i = 0; i < batch * in_h * in_w * channel_in; i++) {
+      in_data[i] = static_cast<float>(i % 9) * 0.25f;
+    }
+    ASSERT_EQ(lite::RET_OK, session->RunGraph());
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_EQ(batch * out_h * out_w * channel_out, outputs.front()->ElementsNum());
+    auto *out_data = reinterpret_cast<float *>(outputs.front()->MutableData());
+    for (int b = 0; b < batch; b++) {
+      for (int oh = 0; oh < out_h; oh++) {
+        for (int ow = 0; ow < out_w; ow++) {
+          for (int o = 0; o < channel_out; o++) {
+            float expect = 0;
+            for (int kh = 0; kh < kernel; kh++) {
+              for (int kw = 0; kw < kernel; kw++) {
+                int ih = oh * stride - pad + kh;
+                int iw = ow * stride - pad + kw;
+                if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+                  continue;
+                }
+                for (int c = 0; c < channel_in; c++) {
+                  expect += in_data[((b * in_h + ih) * in_w + iw) * channel_in + c] *
+                            weight[((o * kernel + kh) * kernel + kw) * channel_in + c];
+                }
+              }
+            }
+            ASSERT_NEAR(expect, out_data[((b * out_h + oh) * out_w + ow) * channel_out + o], 1e-4);
+          }
+        }
+      }
+    }
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestCallbackSeesNhwcTensors) {
+  const int height = 5;
+  const int width = 5;
+  const int channel = 3;
+  const int channel_out = 5;
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  // the depthwise conv writes its output in NHWC4 and the conv reads it so
+  auto dw_node = std::make_unique<schema::CNodeT>();
+  dw_node->inputIndex = {0, 1};
+  dw_node->outputIndex = {2};
+  dw_node->primitive = std::make_unique<schema::PrimitiveT>();
+  dw_node->primitive->value.type = schema::PrimitiveType_DepthwiseConv2D;
+  auto dw_primitive = new schema::DepthwiseConv2DT;
+  dw_primitive->format = schema::Format_NHWC;
+  dw_primitive->channelIn = channel;
+  dw_primitive->channelMultiplier = 1;
+  dw_primitive->kernelH = 3;
+  dw_primitive->kernelW = 3;
+  dw_primitive->strideH = 1;
+  dw_primitive->strideW = 1;
+  dw_primitive->padMode = schema::PadMode_CAFFE;
+  dw_primitive->padUp = 1;
+  dw_primitive->padDown = 1;
+  dw_primitive->padLeft = 1;
+  dw_primitive->padRight = 1;
+  dw_primitive->dilateH = 1;
+  dw_primitive->dilateW = 1;
+  dw_node->primitive->value.value = dw_primitive;
+  dw_node->name = "DepthwiseConv2D";
+  meta_graph->nodes.emplace_back(std::move(dw_node));
+  auto conv_node = std::make_unique<schema::CNodeT>();
+  conv_node->inputIndex = {2, 3};
+  conv_node->outputIndex = {4};
+  conv_node->primitive = std::make_unique<schema::PrimitiveT>();
+  conv_node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto conv_primitive = new schema::Conv2DT;
+  conv_primitive->padMode = schema::PadMode_CAFFE;
+  conv_primitive->padUp = 1;
+  conv_primitive->padDown = 1;
+  conv_primitive->padLeft = 1;
+  conv_primitive->padRight = 1;
+  conv_primitive->channelIn = channel;
+  conv_primitive->channelOut = channel_out;
+  conv_primitive->format = schema::Format_NHWC;
+  conv_primitive->strideH = 2;
+  conv_primitive->strideW = 2;
+  conv_primitive->kernelH = 3;
+  conv_primitive->kernelW = 3;
+  conv_primitive->dilateH = 1;
+  conv_primitive->dilateW = 1;
+  conv_node->primitive->value.value = conv_primitive;
+  conv_node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(conv_node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {4};
+  meta_graph->allTensors.emplace_back(
+    NewFloatTensor({1, height, width, channel}, schema::NodeType::NodeType_ValueNode));
+  // the same value everywhere, the layout of the depthwise weight does not matter
+  meta_graph->allTensors.emplace_back(NewFloatTensor({1, 3, 3, channel}, schema::NodeType::NodeType_ValueNode,
+                                                     std::vector<float>(3 * 3 * channel, 0.5f)));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  std::vector<float> weight(channel_out * 3 * 3 * channel);
+  for (size_t i = 0; i < weight.size(); i++) {
+    weight[i] = static_cast<float>(i % 7) * 0.25f - 0.75f;
+  }
+  auto weight_tensor =
+    NewFloatTensor({channel_out, 3, 3, channel}, schema::NodeType::NodeType_ValueNode, weight);
+  weight_tensor->format = schema::Format_KHWC;
+  meta_graph->allTensors.emplace_back(std::move(weight_tensor));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  auto model = ImportMetaGraph(meta_graph.get());
+  ASSERT_NE(nullptr, model);
+
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model.get()));
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  for (int i = 0; i < height * width * channel; i++) {
+    in_data[i] = static_cast<float>(i % 9) * 0.25f;
+  }
+  ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  auto *out_tensor = session->GetOutputs().front();
+  auto *out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+  std::vector<float> expect_output(out_data, out_data + out_tensor->ElementsNum());
+
+  std::vector<float> dw_output;
+  std::vector<float> conv_input;
+  session::KernelCallBack before = [&](std::vector<tensor::MSTensor *> before_inputs,
+                                       std::vector<tensor::MSTensor *> before_outputs,
+                                       const session::CallBackParam &param) {
+    if (param.type_callback_param == "Conv2D") {
+      auto *data = reinterpret_cast<float *>(before_inputs.front()->MutableData());
+      conv_input.assign(data, data + before_inputs.front()->ElementsNum());
+    }
+    return true;
+  };
+  session::KernelCallBack after = [&](std::vector<tensor::MSTensor *> after_inputs,
+                                      std::vector<tensor::MSTensor *> after_outputs,
+                                      const session::CallBackParam &param) {
+    if (param.type_callback_param == "DepthwiseConv2D") {
+      auto *data = reinterpret_cast<float *>(after_outputs.front()->MutableData());
+      dw_output.assign(data, data + after_outputs.front()->ElementsNum());
+    }
+    return true;
+  };
+  ASSERT_EQ(lite::RET_OK, session->RunGraph(before, after));
+  // the kernels run in the same layout as without callbacks
+  out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+  for (size_t i = 0; i < expect_output.size(); i++) {
+    ASSERT_EQ(expect_output[i], out_data[i]);
+  }
+  ASSERT_EQ(dw_output.size(), static_cast<size_t>(height * width * channel));
+  ASSERT_EQ(conv_input, dw_output);
+  for (int h = 0; h < height; h++) {
+    for (int w = 0; w < width; w++) {
+      for (int c = 0; c < channel; c++) {
+        float expect = 0;
+        for (int ih = std::max(h - 1, 0); ih <= std::min(h + 1, height - 1); ih++) {
+          for (int iw = std::max(w - 1, 0); iw <= std::min(w + 1, width - 1); iw++) {
+            expect += 0.5f * in_data[(ih * width + iw) * channel + c];
+          }
+        }
+        ASSERT_NEAR(expect, dw_output[(h * width + w) * channel + c], 1e-4);
+      }
+    }
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestResizeUnsupportedKernel) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0};
+  node->outputIndex = {1};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_SoftMax;
+  auto primitive = new schema::SoftMaxT;
+  primitive->axis = 1;
+  node->primitive->value.value = primitive;
+  node->name = "SoftMax";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {1};
+  meta_graph->allTensors.emplace_back(NewFloatTensor({2, 8}, schema::NodeType::NodeType_ValueNode));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  auto model = ImportMetaGraph(meta_graph.get());
+  ASSERT_NE(nullptr, model);
+
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model.get()));
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  // softmax sizes its buffer in Init only, the graph keeps its shapes
+  ASSERT_NE(lite::RET_OK, session->Resize(inputs, {{4, 8}}));
+  ASSERT_EQ(16, inputs.front()->ElementsNum());
+  ASSERT_EQ(16, session->GetOutputs().front()->ElementsNum());
+  delete session;
+  delete context;
+}
+
+// a conv graph run by the common conv kernel, its weight is the one to prepack
+static std::unique_ptr<schema::MetaGraphT> NewConv5x5Graph(const std::vector<float> &weight) {
+  auto meta_graph = std::make_unique<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto primitive = new schema::Conv2DT;
+  primitive->padMode = schema::PadMode_CAFFE;
+  primitive->padUp = 2;
+  primitive->padDown = 2;
+  primitive->padLeft = 2;
+  primitive->padRight = 2;
+  primitive->channelIn = 6;
+  primitive->channelOut = 10;
+  primitive->format = schema::Format_NHWC;
+  primitive->strideH = 2;
+  primitive->strideW = 2;
+  primitive->kernelH = 5;
+  primitive->kernelW = 5;
+  primitive->dilateH = 1;
+  primitive->dilateW = 1;
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+  meta_graph->allTensors.emplace_back(NewFloatTensor({1, 9, 9, 6}, schema::NodeType::NodeType_ValueNode));
+  auto weight_tensor = NewFloatTensor({10, 5, 5, 6}, schema::NodeType::NodeType_ValueNode, weight);
+  weight_tensor->format = schema::Format_KHWC;
+  meta_graph->allTensors.emplace_back(std::move(weight_tensor));
+  meta_graph->allTensors.emplace_back(NewFloatTensor({}, schema::NodeType::NodeType_Parameter));
+  return meta_graph;
+}
+
+static std::vector<float> RunConv5x5Model(lite::Model *model) {
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  EXPECT_NE(nullptr, session);
+  std::vector<float> output;
+  if (session != nullptr && session->CompileGraph(model) == lite::RET_OK) {
+    auto *in_data = reinterpret_cast<float *>(session->GetInputs().front()->MutableData());
+    for (int i = 0; i < 9 * 9 * 6; i++) {
+      in_data[i] = static_cast<float>(i % 13) * 0.1f - 0.5f;
+    }
+    EXPECT_EQ(lite::RET_OK, session->RunGraph());
+    auto out_tensor = session->GetOutputs().front();
+    auto *out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+    output.assign(out_data, out_data + out_tensor->ElementsNum());
+  }
+  delete session;
+  delete context;
+  return output;
+}
+
+TEST_F(InferTest, TestImportMappedModelFile) {
+  std::vector<float> weight(10 * 5 * 5 * 6);
+  for (size_t i = 0; i < weight.size(); i++) {
+    weight[i] = static_cast<float>(i % 7) * 0.05f - 0.15f;
+  }
+  auto origin_graph = NewConv5x5Graph(weight);
+  auto origin_model = ImportMetaGraph(origin_graph.get());
+  ASSERT_NE(nullptr, origin_model);
+  auto expect = RunConv5x5Model(origin_model.get());
+  ASSERT_EQ(expect.size(), 5 * 5 * 10U);
+
+  // the packed weight is read from the mapped file, the original one must not be read any more
+  auto meta_graph = NewConv5x5Graph(weight);
+  auto &weight_tensor = meta_graph->allTensors.at(1);
+  ConvParameter conv_param{};
+  conv_param.output_channel_ = 10;
+  conv_param.kernel_h_ = 5;
+  conv_param.kernel_w_ = 5;
+  conv_param.input_channel_ = 6;
+  int oc_block_num = UP_DIV(conv_param.output_channel_, C8NUM);
+  std::vector<float> packed_weight(oc_block_num * C8NUM * UP_DIV(conv_param.input_channel_, C4NUM) * C4NUM * 5 * 5);
+  PackWeightFp32(weight.data(), &conv_param, packed_weight.data(), C8NUM, oc_block_num);
+  weight_tensor->packedLayout = schema::PackedWeightLayout_CONV_FP32_OC8_IC4;
+  weight_tensor->packedData.resize(packed_weight.size() * sizeof(float));
+  memcpy(weight_tensor->packedData.data(), packed_weight.data(), weight_tensor->packedData.size());
+  memset(weight_tensor->data.data(), 0, weight_tensor->data.size());
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  char model_path[] = "/tmp/infer_test_model_XXXXXX";
+  int fd = mkstemp(model_path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  {
+    std::ofstream ofs(model_path, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+    ASSERT_TRUE(ofs.good());
+  }
+  auto model = lite::Model::ImportFromFile(model_path);
+  unlink(model_path);
+  ASSERT_NE(nullptr, model);
+  ASSERT_NE(nullptr, model->GetMetaGraph());
+  auto output = RunConv5x5Model(model.get());
+  ASSERT_EQ(output.size(), expect.size());
+#ifndef ENABLE_ARM32
+  CompareOutputData(output.data(), expect.data(), expect.size(), 0.0001);
+#endif
+}
+
 TEST_F(InferTest, TestModel) {
   auto buf = new char *[1];
   size_t model_size;
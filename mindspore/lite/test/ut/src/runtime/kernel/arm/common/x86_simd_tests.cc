@@ -0,0 +1,263 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_X86_64
+#include <chrono>
+#include <functional>
+#include <random>
+#include <vector>
+#include "mindspore/core/utils/log_adapter.h"
+#include "common/common_test.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/common_func.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/fp32/conv_depthwise.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/fp32/matmul.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/int8/matmul.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/winograd_utils.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+
+namespace mindspore {
+class TestX86Simd : public mindspore::Common {
+ public:
+  TestX86Simd() {}
+  void TearDown() override { X86SetSimdLevel(X86CpuSimdLevel()); }
+
+  // Run the kernel with the scalar code and with the simd level, log the cost of both.
+  static void RunBoth(const std::string &name, X86SimdLevel level, const std::function<void()> &scalar_run,
+                      const std::function<void()> &simd_run) {
+    const int loop_count = 20;
+    X86SetSimdLevel(X86SimdLevel_None);
+    auto scalar_cost = Cost(scalar_run, loop_count);
+    X86SetSimdLevel(level);
+    auto simd_cost = Cost(simd_run, loop_count);
+    MS_LOG(INFO) << name << " scalar cost " << scalar_cost << " us, " << X86SimdLevelName(X86GetSimdLevel())
+                 << " cost " << simd_cost << " us per loop.";
+  }
+
+  static double Cost(const std::function<void()> &run, int loop_count) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loop_count; i++) {
+      run();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / loop_count;
+  }
+
+  template <typename T>
+  static std::vector<T> RandomData(size_t size, int low, int high) {
+    static std::mt19937 gen(1);
+    std::uniform_int_distribution<int> dist(low, high);
+    std::vector<T> data(size);
+    for (auto &value : data) {
+      value = static_cast<T>(dist(gen));
+    }
+    return data;
+  }
+
+  // Runs one C4 tile through the winograd input transform, the product with the transformed kernel and the output
+  // transform, and compares it with the scalar direct correlation of the tile with the kernel. matrix_g is the
+  // input_unit x kernel_unit kernel transform.
+  static void CheckWinogradTile(int input_unit, int output_unit, const std::vector<float> &matrix_g) {
+    int kernel_unit = input_unit - output_unit + 1;
+    int tile_size = input_unit * input_unit;
+    auto input = RandomData<float>(tile_size * C4NUM, -5, 5);
+    auto kernel = RandomData<float>(kernel_unit * kernel_unit * C4NUM, -3, 3);
+    auto bias = RandomData<float>(C4NUM, -3, 3);
+    std::vector<float> trans_input(tile_size * C4NUM);
+    GetInputTransFunc(input_unit)(input.data(), trans_input.data(), C4NUM, C4NUM);
+    for (int i = 0; i < input_unit; i++) {
+      for (int j = 0; j < input_unit; j++) {
+        for (int c = 0; c < C4NUM; c++) {
+          float trans_kernel = 0;
+          for (int a = 0; a < kernel_unit; a++) {
+            for (int b = 0; b < kernel_unit; b++) {
+              trans_kernel += matrix_g[i * kernel_unit + a] * kernel[(a * kernel_unit + b) * C4NUM + c] *
+                              matrix_g[j * kernel_unit + b];
+            }
+          }
+          trans_input[(i * input_unit + j) * C4NUM + c] *= trans_kernel;
+        }
+      }
+    }
+    std::vector<float> output(output_unit * output_unit * C4NUM);
+    GetOutputTransFunc(input_unit, output_unit)(trans_input.data(), output.data(), bias.data(), C4NUM, output_unit);
+
+    std::vector<float> expect(output.size());
+    for (int y = 0; y < output_unit; y++) {
+      for (int x = 0; x < output_unit; x++) {
+        for (int c = 0; c < C4NUM; c++) {
+          float sum = bias[c];
+          for (int a = 0; a < kernel_unit; a++) {
+            for (int b = 0; b < kernel_unit; b++) {
+              sum += input[((y + a) * input_unit + x + b) * C4NUM + c] * kernel[(a * kernel_unit + b) * C4NUM + c];
+            }
+          }
+          expect[(y * output_unit + x) * C4NUM + c] = sum;
+        }
+      }
+    }
+    CompareOutputData(output.data(), expect.data(), output.size(), 0.01);
+  }
+};
+
+TEST_F(TestX86Simd, MatMulFp32) {
+  if (X86CpuSimdLevel() < X86SimdLevel_Avx2) {
+    return;
+  }
+  int row8 = 64;
+  int col8 = 96;
+  int deep = 77;
+  auto a = RandomData<float>(row8 * deep, -100, 100);
+  auto b = RandomData<float>(col8 * deep, -100, 100);
+  auto bias = RandomData<float>(col8, -100, 100);
+  std::vector<float> expect(row8 * col8);
+  std::vector<float> output(row8 * col8);
+  for (auto act_type : {ActType_No, ActType_Relu, ActType_Relu6}) {
+    RunBoth(
+      "MatMul", X86SimdLevel_Avx2,
+      [&]() { MatMul(a.data(), b.data(), expect.data(), bias.data(), act_type, deep, row8, col8); },
+      [&]() { MatMul(a.data(), b.data(), output.data(), bias.data(), act_type, deep, row8, col8); });
+    CompareOutputData(output.data(), expect.data(), output.size(), 0.01);
+  }
+}
+
+TEST_F(TestX86Simd, IndirectGemmFp32) {
+  if (X86CpuSimdLevel() < X86SimdLevel_Avx2) {
+    return;
+  }
+  size_t step = 9;
+  size_t ic4 = 5;
+  size_t oc = 21;
+  size_t oc8 = UP_DIV(oc, C8NUM);
+  auto input = RandomData<float>(step * ic4 * C4NUM * TILE_NUM, -10, 10);
+  auto weight = RandomData<float>(oc8 * step * ic4 * C4NUM * C8NUM, -10, 10);
+  auto bias = RandomData<float>(oc, -10, 10);
+  std::vector<float> expect(TILE_NUM * oc);
+  std::vector<float> output(TILE_NUM * oc);
+  // conv: mode 0 with the activations
+  for (size_t relu = 0; relu < 2; relu++) {
+    for (size_t relu6 = 0; relu6 < 2; relu6++) {
+      RunBoth(
+        "IndirectGemmFp32_8x8", X86SimdLevel_Avx2,
+        [&]() {
+          IndirectGemmFp32_8x8(expect.data(), input.data(), weight.data(), bias.data(), step, ic4, oc,
+                               oc * sizeof(float), 0, 0, relu, relu6);
+        },
+        [&]() {
+          IndirectGemmFp32_8x8(output.data(), input.data(), weight.data(), bias.data(), step, ic4, oc,
+                               oc * sizeof(float), 0, 0, relu, relu6);
+        });
+      CompareOutputData(output.data(), expect.data(), output.size(), 0.01);
+    }
+  }
+  // winograd: mode 1 writing C4 blocks, the output channels are a multiple of 4
+  size_t oc4 = UP_DIV(oc, C4NUM);
+  std::vector<float> expect_c4(TILE_NUM * oc4 * C4NUM * step);
+  std::vector<float> output_c4(TILE_NUM * oc4 * C4NUM * step);
+  RunBoth(
+    "IndirectGemmFp32_8x8 winograd", X86SimdLevel_Avx2,
+    [&]() {
+      IndirectGemmFp32_8x8(expect_c4.data(), input.data(), weight.data(), nullptr, step, ic4, oc4 * C4NUM, 0, 1, 1, 0,
+                           0);
+    },
+    [&]() {
+      IndirectGemmFp32_8x8(output_c4.data(), input.data(), weight.data(), nullptr, step, ic4, oc4 * C4NUM, 0, 1, 1, 0,
+                           0);
+    });
+  CompareOutputData(output_c4.data(), expect_c4.data(), output_c4.size(), 0.01);
+}
+
+TEST_F(TestX86Simd, ConvDwFp32) {
+  if (X86CpuSimdLevel() < X86SimdLevel_Avx2) {
+    return;
+  }
+  ConvParameter conv_param = {};
+  conv_param.input_batch_ = 1;
+  conv_param.input_h_ = 28;
+  conv_param.input_w_ = 28;
+  conv_param.input_channel_ = 24;
+  conv_param.output_batch_ = 1;
+  conv_param.output_h_ = 28;
+  conv_param.output_w_ = 28;
+  conv_param.output_channel_ = 24;
+  conv_param.kernel_h_ = 3;
+  conv_param.kernel_w_ = 3;
+  conv_param.stride_h_ = 1;
+  conv_param.stride_w_ = 1;
+  conv_param.dilation_h_ = 1;
+  conv_param.dilation_w_ = 1;
+  conv_param.pad_h_ = 1;
+  conv_param.pad_w_ = 1;
+  conv_param.thread_num_ = 1;
+  conv_param.is_relu6_ = true;
+  SlidingWindowParam sliding;
+  InitSlidingParam(&sliding, &conv_param, C4NUM);
+  sliding.kernel_step_ = conv_param.kernel_h_ * conv_param.kernel_w_ * C4NUM;
+
+  auto input = RandomData<float>(sliding.in_step_, -5, 5);
+  auto weight = RandomData<float>(sliding.c_block_ * sliding.kernel_step_, -2, 2);
+  auto bias = RandomData<float>(sliding.block_channel_, -2, 2);
+  std::vector<float> expect(sliding.out_step_);
+  std::vector<float> output(sliding.out_step_);
+  RunBoth(
+    "ConvDwC4Fp32", X86SimdLevel_Avx2,
+    [&]() { ConvDwC4Fp32(expect.data(), input.data(), weight.data(), bias.data(), &conv_param, &sliding, 0); },
+    [&]() { ConvDwC4Fp32(output.data(), input.data(), weight.data(), bias.data(), &conv_param, &sliding, 0); });
+  CompareOutputData(output.data(), expect.data(), output.size(), 0.0001);
+}
+
+// The winograd transforms run the NEON code through the SSE shim on x86-64.
+TEST_F(TestX86Simd, WinogradTransform4x4) {
+  // F(2, 3), the kernel transform of the points 0, 1/2, -1/2 and infinity the 4x4 input transform uses
+  CheckWinogradTile(4, 2, {1, 0, 0, 1, 0.5f, 0.25f, 1, -0.5f, 0.25f, 0, 0, 1});
+  std::vector<float> matrix_g(4 * 2);
+  MatrixG4x2(matrix_g.data());
+  CheckWinogradTile(4, 3, matrix_g);
+}
+
+TEST_F(TestX86Simd, WinogradTransform8x8) {
+  using MatrixFunc = void (*)(float *);
+  MatrixFunc matrix_g_funcs[] = {MatrixG8x7, MatrixG8x6, MatrixG8x5, MatrixG8x4, MatrixG8x3, MatrixG8x2};
+  for (int output_unit = 2; output_unit <= 7; output_unit++) {
+    int kernel_unit = 8 - output_unit + 1;
+    std::vector<float> matrix_g(8 * kernel_unit);
+    matrix_g_funcs[output_unit - 2](matrix_g.data());
+    CheckWinogradTile(8, output_unit, matrix_g);
+  }
+}
+
+TEST_F(TestX86Simd, MatMulInt8) {
+  int row8 = 32;
+  int col8 = 48;
+  int32_t a_zp = 3;
+  int32_t b_zp = -7;
+  auto a = RandomData<int8_t>(row8 * 131, -128, 127);
+  auto b = RandomData<int8_t>(col8 * 131, -128, 127);
+  // odd depths and depths which are not a multiple of 4 take the padded tails
+  for (int deep : {131, 130, 64}) {
+    for (auto level : {X86SimdLevel_Avx2, X86SimdLevel_Avx512Vnni}) {
+      if (X86CpuSimdLevel() < level) {
+        continue;
+      }
+      std::vector<int32_t> expect(row8 * col8);
+      std::vector<int32_t> output(row8 * col8);
+      RunBoth(
+        "MatMulInt8", level, [&]() { MatMulInt8(a.data(), b.data(), expect.data(), row8, col8, deep, a_zp, b_zp); },
+        [&]() { MatMulInt8(a.data(), b.data(), output.data(), row8, col8, deep, a_zp, b_zp); });
+      ASSERT_EQ(output, expect);
+    }
+  }
+}
+}  // namespace mindspore
+#endif
@@ -84,6 +84,17 @@ TEST_F(TestActivationFp32, TanhFp32) {
   MS_LOG(INFO) << "TanhFp32 passed";
 }
 
+TEST_F(TestActivationFp32, GeluFp32) {
+  float input[7] = {-3, -2, -1, 0, 1, 2, 3};
+  float output[7] = {0};
+  Gelu(input, 7, output);
+  float expect[7] = {-0.003637, -0.045402, -0.158808, 0.000000, 0.841192, 1.954598, 2.996363};
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_NEAR(output[i], expect[i], 0.00001);
+  }
+  MS_LOG(INFO) << "GeluFp32 passed";
+}
+
 TEST_F(TestActivationFp32, HSwishFp32) {
   std::vector<lite::tensor::Tensor *> inputs_tensor;
   std::vector<lite::tensor::Tensor *> outputs_tensor;
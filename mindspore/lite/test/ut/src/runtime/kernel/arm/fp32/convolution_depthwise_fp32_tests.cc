@@ -15,10 +15,12 @@
  */
 #include <iostream>
 #include <memory>
+#include <vector>
 #include "utils/log_adapter.h"
 #include "common/common_test.h"
 #include "src/common/file_utils.h"
 #include "mindspore/lite/src/runtime/kernel/arm/base/convolution_base.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/pack.h"
 #include "mindspore/lite/src/kernel_registry.h"
 #include "mindspore/lite/src/ops/ops.h"
 
@@ -148,6 +150,67 @@ TEST_F(TestConvolutionDwFp32, ConvDwFp32Accuracy) {
   MS_LOG(INFO) << "TestConvolutionDwFp32 accuracy passed";
 }
 
+// The scheduler keeps the input and output in NHWC4 between depthwise and conv kernels, the kernel reads and writes
+// them without packing.
+TEST_F(TestConvolutionDwFp32, ConvDwFp32Nhwc4) {
+  auto conv_param = new ConvParameter();
+  InitConvDwParam(conv_param);
+  auto ctx = new Context();
+  ctx->thread_num_ = 4;
+
+  std::vector<lite::tensor::Tensor *> inputs;
+  std::vector<lite::tensor::Tensor *> outputs;
+  InitConvDwCreator(&inputs, &outputs, conv_param);
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_DepthwiseConv2D};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  kernel::LiteKernel *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(conv_param), ctx, desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_TRUE(kernel->SupportInputFormat(schema::Format_NHWC4));
+  ASSERT_TRUE(kernel->SupportOutputFormat(schema::Format_NHWC4));
+
+  int plane = conv_param->input_h_ * conv_param->input_w_;
+  int channel = conv_param->input_channel_;
+  std::vector<float> nhwc_input(reinterpret_cast<float *>(inputs[0]->Data()),
+                                reinterpret_cast<float *>(inputs[0]->Data()) + inputs[0]->ElementsNum());
+  inputs[0]->FreeData();
+  inputs[0]->SetFormat(schema::Format_NHWC4);
+  inputs[0]->MallocData();
+  PackNHWCToNHWC4Fp32(nhwc_input.data(), inputs[0]->Data(), 1, plane, channel);
+  outputs[0]->FreeData();
+  outputs[0]->SetFormat(schema::Format_NHWC4);
+  outputs[0]->MallocData();
+  kernel->Run();
+
+  // the aligned channels are zero
+  auto output_ptr = reinterpret_cast<float *>(outputs[0]->Data());
+  int c4 = UP_DIV(channel, C4NUM) * C4NUM;
+  for (int i = 0; i < plane; i++) {
+    for (int c = channel; c < c4; c++) {
+      ASSERT_EQ(output_ptr[i * c4 + c], 0);
+    }
+  }
+  std::vector<float> nhwc_output(outputs[0]->ElementsNum());
+  PackNHWC4ToNHWCFp32(output_ptr, nhwc_output.data(), 1, plane, channel);
+
+  size_t output_size;
+  std::string output_path = "./test_data/convDw/convDwfp32_output.bin";
+  auto correct_data = reinterpret_cast<float *>(mindspore::lite::ReadFile(output_path.c_str(), &output_size));
+  CompareOutputData(nhwc_output.data(), correct_data, nhwc_output.size(), 0.0001);
+
+  // the kernel owns conv_param
+  delete kernel;
+  for (int i = 0; i < inputs.size(); i++) {
+    delete inputs[i];
+  }
+  for (int i = 0; i < outputs.size(); i++) {
+    delete outputs[i];
+  }
+  delete ctx;
+  delete[] reinterpret_cast<char *>(correct_data);
+}
+
 TEST_F(TestConvolutionDwFp32, ConvDwFp32Performance) {
   // prepare stage
   auto conv_param = new ConvParameter();
@@ -0,0 +1,300 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/convolution.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/convolution_3x3.h"
+#include "mindspore/lite/src/runtime/kernel/arm/fp32/convolution_winograd.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/pack.h"
+#include "mindspore/lite/src/kernel_registry.h"
+
+namespace mindspore {
+class TestConvolutionFp32 : public mindspore::Common {
+ public:
+  TestConvolutionFp32() {}
+};
+
+void InitConvParam(ConvParameter *conv_param) {
+  conv_param->input_batch_ = 1;
+  conv_param->input_h_ = 9;
+  conv_param->input_w_ = 9;
+  conv_param->input_channel_ = 6;
+
+  conv_param->output_batch_ = 1;
+  conv_param->output_h_ = 5;
+  conv_param->output_w_ = 5;
+  conv_param->output_channel_ = 10;
+
+  conv_param->kernel_h_ = 5;
+  conv_param->kernel_w_ = 5;
+
+  // stride 2 for the common conv kernel instead of winograd
+  conv_param->stride_h_ = 2;
+  conv_param->stride_w_ = 2;
+
+  conv_param->dilation_h_ = 1;
+  conv_param->dilation_w_ = 1;
+
+  conv_param->pad_h_ = 2;
+  conv_param->pad_w_ = 2;
+}
+
+void InitConvTensors(std::vector<lite::tensor::Tensor *> *inputs, std::vector<lite::tensor::Tensor *> *outputs,
+                     const ConvParameter *conv_param) {
+  auto *input = new lite::tensor::Tensor;
+  input->set_data_type(kNumberTypeFloat32);
+  input->SetFormat(schema::Format_NHWC);
+  input->set_shape({conv_param->input_batch_, conv_param->input_h_, conv_param->input_w_, conv_param->input_channel_});
+  input->MallocData();
+  auto input_data = reinterpret_cast<float *>(input->Data());
+  for (int i = 0; i < input->ElementsNum(); i++) {
+    input_data[i] = static_cast<float>(i % 13) * 0.1f - 0.5f;
+  }
+
+  // weight format co kh kw ci
+  auto *weight = new lite::tensor::Tensor;
+  weight->set_data_type(kNumberTypeFloat32);
+  weight->SetFormat(schema::Format_KHWC);
+  weight->set_shape(
+    {conv_param->output_channel_, conv_param->kernel_h_, conv_param->kernel_w_, conv_param->input_channel_});
+  weight->MallocData();
+  auto weight_data = reinterpret_cast<float *>(weight->Data());
+  for (int i = 0; i < weight->ElementsNum(); i++) {
+    weight_data[i] = static_cast<float>(i % 7) * 0.05f - 0.15f;
+  }
+
+  auto *bias = new lite::tensor::Tensor;
+  bias->set_data_type(kNumberTypeFloat32);
+  bias->set_shape({conv_param->output_channel_});
+  bias->MallocData();
+  auto bias_data = reinterpret_cast<float *>(bias->Data());
+  for (int i = 0; i < bias->ElementsNum(); i++) {
+    bias_data[i] = static_cast<float>(i) * 0.01f;
+  }
+
+  inputs->push_back(input);
+  inputs->push_back(weight);
+  inputs->push_back(bias);
+
+  auto *output = new lite::tensor::Tensor;
+  output->set_data_type(kNumberTypeFloat32);
+  output->SetFormat(schema::Format_NHWC);
+  output->set_shape(
+    {conv_param->output_batch_, conv_param->output_h_, conv_param->output_w_, conv_param->output_channel_});
+  output->MallocData();
+  outputs->push_back(output);
+}
+
+std::vector<float> RunConv(std::vector<float> *packed_weight) {
+  auto conv_param = new ConvParameter();
+  InitConvParam(conv_param);
+  auto ctx = new Context();
+  ctx->thread_num_ = 2;
+
+  std::vector<lite::tensor::Tensor *> inputs;
+  std::vector<lite::tensor::Tensor *> outputs;
+  InitConvTensors(&inputs, &outputs, conv_param);
+  if (packed_weight != nullptr) {
+    // pack the weight as the converter does, the kernel adopts it instead of packing the original one
+    int oc_block_num = UP_DIV(conv_param->output_channel_, C8NUM);
+    int ic4 = UP_DIV(conv_param->input_channel_, C4NUM);
+    packed_weight->assign(oc_block_num * C8NUM * ic4 * C4NUM * conv_param->kernel_h_ * conv_param->kernel_w_, 0);
+    PackWeightFp32(reinterpret_cast<float *>(inputs[1]->Data()), conv_param, packed_weight->data(), C8NUM,
+                   oc_block_num);
+    inputs[1]->SetPackedData(schema::PackedWeightLayout_CONV_FP32_OC8_IC4, packed_weight->data(),
+                             packed_weight->size() * sizeof(float));
+    // the original weight must not be read any more
+    memset(inputs[1]->Data(), 0, inputs[1]->Size());
+  }
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Conv2D};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  EXPECT_NE(creator, nullptr);
+  kernel::LiteKernel *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(conv_param), ctx, desc);
+  EXPECT_NE(kernel, nullptr);
+  EXPECT_NE(dynamic_cast<kernel::ConvolutionCPUKernel *>(kernel), nullptr);
+  kernel->Run();
+
+  auto output_ptr = reinterpret_cast<float *>(outputs[0]->Data());
+  std::vector<float> output(output_ptr, output_ptr + outputs[0]->ElementsNum());
+  // the kernel owns conv_param
+  delete kernel;
+  for (auto input : inputs) {
+    delete input;
+  }
+  for (auto out : outputs) {
+    delete out;
+  }
+  delete ctx;
+  return output;
+}
+
+TEST_F(TestConvolutionFp32, ConvFp32PrepackedWeight) {
+  auto expect = RunConv(nullptr);
+  std::vector<float> packed_weight;
+  auto output = RunConv(&packed_weight);
+  ASSERT_EQ(output.size(), expect.size());
+#ifndef ENABLE_ARM32
+  CompareOutputData(output.data(), expect.data(), expect.size(), 0.0001);
+#endif
+  MS_LOG(INFO) << "TestConvolutionFp32 prepacked weight passed";
+}
+
+using ConvKernelCreator =
+  std::function<kernel::LiteKernel *(ConvParameter *, const std::vector<lite::tensor::Tensor *> &,
+                                     const std::vector<lite::tensor::Tensor *> &, Context *)>;
+
+void InitNhwc4ConvParam(ConvParameter *conv_param, int kernel, int stride, int in_channel) {
+  conv_param->input_batch_ = 1;
+  conv_param->input_h_ = 6;
+  conv_param->input_w_ = 6;
+  conv_param->input_channel_ = in_channel;
+  conv_param->kernel_h_ = kernel;
+  conv_param->kernel_w_ = kernel;
+  conv_param->stride_h_ = stride;
+  conv_param->stride_w_ = stride;
+  conv_param->dilation_h_ = 1;
+  conv_param->dilation_w_ = 1;
+  conv_param->pad_h_ = kernel / 2;
+  conv_param->pad_w_ = kernel / 2;
+  conv_param->output_batch_ = 1;
+  conv_param->output_h_ = (conv_param->input_h_ + 2 * conv_param->pad_h_ - kernel) / stride + 1;
+  conv_param->output_w_ = (conv_param->input_w_ + 2 * conv_param->pad_w_ - kernel) / stride + 1;
+  conv_param->output_channel_ = 10;
+}
+
+// the convolution of the NHWC input, KHWC weight and bias the tensors are initialized with
+std::vector<float> RefConv(const std::vector<lite::tensor::Tensor *> &inputs, const ConvParameter *conv_param) {
+  auto input = reinterpret_cast<float *>(inputs[0]->Data());
+  auto weight = reinterpret_cast<float *>(inputs[1]->Data());
+  auto bias = reinterpret_cast<float *>(inputs[2]->Data());
+  int in_h = conv_param->input_h_;
+  int in_w = conv_param->input_w_;
+  int in_c = conv_param->input_channel_;
+  int kernel_h = conv_param->kernel_h_;
+  int kernel_w = conv_param->kernel_w_;
+  int out_w = conv_param->output_w_;
+  int out_c = conv_param->output_channel_;
+  std::vector<float> output(conv_param->output_h_ * out_w * out_c);
+  for (int oh = 0; oh < conv_param->output_h_; oh++) {
+    for (int ow = 0; ow < out_w; ow++) {
+      for (int o = 0; o < out_c; o++) {
+        float sum = bias[o];
+        for (int kh = 0; kh < kernel_h; kh++) {
+          for (int kw = 0; kw < kernel_w; kw++) {
+            int ih = oh * conv_param->stride_h_ - conv_param->pad_h_ + kh;
+            int iw = ow * conv_param->stride_w_ - conv_param->pad_w_ + kw;
+            if (ih < 0 || ih >= in_h || iw < 0 || iw >= in_w) {
+              continue;
+            }
+            for (int c = 0; c < in_c; c++) {
+              sum += input[(ih * in_w + iw) * in_c + c] * weight[((o * kernel_h + kh) * kernel_w + kw) * in_c + c];
+            }
+          }
+        }
+        output[(oh * out_w + ow) * out_c + o] = sum;
+      }
+    }
+  }
+  return output;
+}
+
+// Runs the conv kernel on an input in the given format, NHWC4 as the scheduler keeps it after a depthwise conv, and
+// compares its output with the reference. An input readable as NHWC4 must be read in place.
+void CheckConvInputFormat(const ConvKernelCreator &creator, int kernel_size, int stride, int in_channel,
+                          schema::Format format) {
+  auto conv_param = new ConvParameter();
+  InitNhwc4ConvParam(conv_param, kernel_size, stride, in_channel);
+  auto ctx = new Context();
+  ctx->thread_num_ = 2;
+  std::vector<lite::tensor::Tensor *> inputs;
+  std::vector<lite::tensor::Tensor *> outputs;
+  InitConvTensors(&inputs, &outputs, conv_param);
+  auto expect = RefConv(inputs, conv_param);
+
+  // the kernel is initialized with the NHWC input, the scheduler changes the format afterwards
+  auto kernel = creator(conv_param, inputs, outputs, ctx);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->Init(), lite::RET_OK);
+  ASSERT_TRUE(kernel->SupportInputFormat(schema::Format_NHWC4));
+  if (format == schema::Format_NHWC4) {
+    int plane = conv_param->input_h_ * conv_param->input_w_;
+    std::vector<float> nhwc_input(reinterpret_cast<float *>(inputs[0]->Data()),
+                                  reinterpret_cast<float *>(inputs[0]->Data()) + inputs[0]->ElementsNum());
+    inputs[0]->FreeData();
+    inputs[0]->SetFormat(schema::Format_NHWC4);
+    inputs[0]->MallocData();
+    PackNHWCToNHWC4Fp32(nhwc_input.data(), inputs[0]->Data(), 1, plane, in_channel);
+  }
+  auto conv = static_cast<kernel::ConvolutionBaseCPUKernel *>(kernel);
+  if (format == schema::Format_NHWC4 || in_channel % C4NUM == 0) {
+    ASSERT_TRUE(conv->IsNhwc4Input());
+    ASSERT_EQ(conv->Nhwc4Input(), inputs[0]->Data());
+  } else {
+    ASSERT_NE(conv->Nhwc4Input(), inputs[0]->Data());
+  }
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  auto output = reinterpret_cast<float *>(outputs[0]->Data());
+  CompareOutputData(output, expect.data(), expect.size(), 0.0005);
+
+  // the kernel owns conv_param
+  delete kernel;
+  for (auto input : inputs) {
+    delete input;
+  }
+  for (auto out : outputs) {
+    delete out;
+  }
+  delete ctx;
+}
+
+TEST_F(TestConvolutionFp32, ConvFp32ReadNhwc4Input) {
+  ConvKernelCreator creator = [](ConvParameter *conv_param, const std::vector<lite::tensor::Tensor *> &inputs,
+                                 const std::vector<lite::tensor::Tensor *> &outputs, Context *ctx) {
+    return new kernel::ConvolutionCPUKernel(reinterpret_cast<OpParameter *>(conv_param), inputs, outputs, ctx);
+  };
+  CheckConvInputFormat(creator, 5, 2, 6, schema::Format_NHWC);
+  CheckConvInputFormat(creator, 5, 2, 6, schema::Format_NHWC4);
+  CheckConvInputFormat(creator, 5, 2, 8, schema::Format_NHWC);
+}
+
+TEST_F(TestConvolutionFp32, Conv3x3Fp32ReadNhwc4Input) {
+  ConvKernelCreator creator = [](ConvParameter *conv_param, const std::vector<lite::tensor::Tensor *> &inputs,
+                                 const std::vector<lite::tensor::Tensor *> &outputs, Context *ctx) {
+    return new kernel::Convolution3x3CPUKernel(reinterpret_cast<OpParameter *>(conv_param), inputs, outputs, ctx);
+  };
+  CheckConvInputFormat(creator, 3, 1, 6, schema::Format_NHWC);
+  CheckConvInputFormat(creator, 3, 1, 6, schema::Format_NHWC4);
+  CheckConvInputFormat(creator, 3, 1, 8, schema::Format_NHWC);
+}
+
+TEST_F(TestConvolutionFp32, ConvWinogradFp32ReadNhwc4Input) {
+  // output unit 2 for a 3x3 kernel, the input unit is 4
+  ConvKernelCreator creator = [](ConvParameter *conv_param, const std::vector<lite::tensor::Tensor *> &inputs,
+                                 const std::vector<lite::tensor::Tensor *> &outputs, Context *ctx) {
+    return new kernel::ConvolutionWinogradCPUKernel(reinterpret_cast<OpParameter *>(conv_param), inputs, outputs, ctx,
+                                                    2);
+  };
+  CheckConvInputFormat(creator, 3, 1, 6, schema::Format_NHWC);
+  CheckConvInputFormat(creator, 3, 1, 6, schema::Format_NHWC4);
+  CheckConvInputFormat(creator, 3, 1, 8, schema::Format_NHWC);
+}
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "mindspore/core/utils/log_adapter.h"
+#include "common/common_test.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/fp32/layer_norm.h"
+#include "mindspore/lite/src/kernel_registry.h"
+#include "mindspore/lite/src/lite_kernel.h"
+
+namespace mindspore {
+class TestLayerNormFp32 : public mindspore::Common {
+ public:
+  TestLayerNormFp32() {}
+};
+
+TEST_F(TestLayerNormFp32, LayerNormFp32) {
+  float input[8] = {1, 2, 3, 4, -1, 0, 0, 1};
+  float gamma[4] = {1, 2, 1, 1};
+  float beta[4] = {0, 0, 1, -1};
+  float output[8] = {0};
+  ASSERT_EQ(LayerNorm(2, 4, input, gamma, beta, 1e-5, output, 0, 1), NNACL_OK);
+  float expect[8] = {-1.341635, -0.894424, 1.447212, 0.341635, -1.414199, 0.000000, 1.000000, 0.414199};
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_NEAR(output[i], expect[i], 0.00001);
+  }
+  MS_LOG(INFO) << "LayerNormFp32 passed";
+}
+
+TEST_F(TestLayerNormFp32, LayerNormKernelFp32) {
+  std::vector<lite::tensor::Tensor *> inputs_tensor;
+  std::vector<lite::tensor::Tensor *> outputs_tensor;
+
+  LayerNormParameter op_param;
+  op_param.op_parameter_.type_ = schema::PrimitiveType_LayerNorm;
+  op_param.begin_norm_axis_ = -1;
+  op_param.epsilon_ = 1e-5;
+  op_param.elementwise_affine_ = true;
+
+  std::vector<float> input = {1, 2, 3, 4, -1, 0, 0, 1, 2, 2, 2, 2};
+  std::vector<float> gamma = {1, 2, 1, 1};
+  std::vector<float> beta = {0, 0, 1, -1};
+  lite::tensor::Tensor input0_tensor(kNumberTypeFloat32, {3, 4});
+  lite::tensor::Tensor input1_tensor(kNumberTypeFloat32, {4});
+  lite::tensor::Tensor input2_tensor(kNumberTypeFloat32, {4});
+  input0_tensor.SetData(input.data());
+  input1_tensor.SetData(gamma.data());
+  input2_tensor.SetData(beta.data());
+  inputs_tensor = {&input0_tensor, &input1_tensor, &input2_tensor};
+
+  std::vector<float> output(12);
+  lite::tensor::Tensor output0_tensor(kNumberTypeFloat32, {3, 4});
+  output0_tensor.SetData(output.data());
+  outputs_tensor.push_back(&output0_tensor);
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_LayerNorm};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  lite::Context ctx;
+  ctx.thread_num_ = 2;
+  kernel::LiteKernel *kernel =
+    creator(inputs_tensor, outputs_tensor, reinterpret_cast<OpParameter *>(&op_param), &ctx, desc);
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->Run(), 0);
+
+  // a constant row is normalized to zeros
+  std::vector<float> expect_output = {-1.341635, -0.894424, 1.447212, 0.341635, -1.414199, 0.000000,
+                                      1.000000,  0.414199,  0.000000, 0.000000, 1.000000,  -1.000000};
+  CompareOutputData(output.data(), expect_output.data(), 12, 0.00001);
+
+  for (auto tensor : inputs_tensor) {
+    tensor->SetData(nullptr);
+  }
+  output0_tensor.SetData(nullptr);
+  delete kernel;
+}
+}  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include "common/common_test.h"
 #include "mindspore/lite/src/runtime/kernel/opencl/subgraph_opencl_kernel.h"
 #include "mindspore/lite/src/runtime/kernel/opencl/kernel/arithmetic.h"
@@ -60,7 +61,14 @@ void LogData(void *data, const int size, const std::string prefix) {
   std::cout << std::endl;
 }
 
-void TestCase(const std::vector<int> &shape_a, const std::vector<int> &shape_b) {
+void Relu6(float *data, const int size) {
+  for (int i = 0; i < size; i++) {
+    data[i] = std::min(std::max(data[i], 0.0f), 6.0f);
+  }
+}
+
+void TestCase(const std::vector<int> &shape_a, const std::vector<int> &shape_b,
+              int activation_type = schema::ActivationType_NO_ACTIVATION) {
   std::cout << "TestCase" << std::endl;
   auto ocl_runtime = lite::opencl::OpenCLRuntime::GetInstance();
 
@@ -93,6 +101,9 @@ void TestCase(const std::vector<int> &shape_a, const std::vector<int> &shape_b)
   } else {
     ElementAdd(data_a, data_b, data_c_cpu, element_num);
   }
+  if (activation_type == schema::ActivationType_RELU6) {
+    Relu6(data_c_cpu, element_num);
+  }
 
   std::cout << "TestCase set data" << std::endl;
   std::vector<lite::tensor::Tensor *> inputs = {tensor_a};
@@ -107,6 +118,7 @@ void TestCase(const std::vector<int> &shape_a, const std::vector<int> &shape_b)
   ArithmeticParameter *param = new ArithmeticParameter();
   param->ndim_ = 4;
   param->op_parameter_.type_ = PrimitiveType_Add;
+  param->activation_type_ = activation_type;
 
   std::vector<lite::tensor::Tensor *> arithmetic_inputs = {tensor_a, tensor_b};
   lite::Context ctx;
@@ -167,6 +179,12 @@ TEST_F(TestArithmeticOpenCL, AddElementwiseTest) {
   TestCase(shape_a, shape_b);
 }
 
+TEST_F(TestArithmeticOpenCL, AddElementwiseRelu6Test) {
+  const std::vector<int> &shape_a = {1, 32, 32, 4};
+  const std::vector<int> &shape_b = {1, 32, 32, 4};
+  TestCase(shape_a, shape_b, schema::ActivationType_RELU6);
+}
+
 // TEST_F(TestOpenCLKernel, AddBoardcaseTest) {
 //  const std::vector<int> &shape_a = {1, 4, 128, 128};
 //  const std::vector<int> &shape_b = {};
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "mindspore/core/utils/log_adapter.h"
+#include "mindspore/lite/src/runtime/memory_planner.h"
+
+namespace mindspore {
+class TestMemoryPlanner : public mindspore::Common {
+ public:
+  TestMemoryPlanner() {}
+  void TearDown() override {
+    for (auto *kernel : kernels_) {
+      delete kernel;
+    }
+    for (auto *tensor : tensors_) {
+      delete tensor;
+    }
+  }
+
+  lite::tensor::Tensor *NewTensor(const std::vector<int> &shape) {
+    auto *tensor = new lite::tensor::Tensor(kNumberTypeFloat32, shape);
+    tensors_.emplace_back(tensor);
+    return tensor;
+  }
+
+  void NewKernel(const std::vector<lite::tensor::Tensor *> &inputs,
+                 const std::vector<lite::tensor::Tensor *> &outputs) {
+    auto *kernel = new kernel::LiteKernel(nullptr, inputs, outputs);
+    kernel->set_desc({kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Activation});
+    kernels_.emplace_back(kernel);
+  }
+
+  bool Overlap(lite::MemoryPlanner *planner, lite::tensor::Tensor *a, lite::tensor::Tensor *b) {
+    auto a_begin = planner->offsets().at(a);
+    auto b_begin = planner->offsets().at(b);
+    return a_begin < b_begin + b->Size() && b_begin < a_begin + a->Size();
+  }
+
+  std::vector<lite::tensor::Tensor *> tensors_;
+  std::vector<kernel::LiteKernel *> kernels_;
+};
+
+TEST_F(TestMemoryPlanner, ChainReuse) {
+  // input -> t1 -> t2 -> t3 -> output, t1 is dead when t3 is written
+  auto *input = NewTensor({1, 16, 16, 4});
+  auto *t1 = NewTensor({1, 16, 16, 4});
+  auto *t2 = NewTensor({1, 16, 16, 4});
+  auto *t3 = NewTensor({1, 16, 16, 4});
+  auto *output = NewTensor({1, 16, 16, 4});
+  NewKernel({input}, {t1});
+  NewKernel({t1}, {t2});
+  NewKernel({t2}, {t3});
+  NewKernel({t3}, {output});
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels_, {output}), lite::RET_OK);
+  ASSERT_TRUE(planner.planned());
+  ASSERT_EQ(planner.offsets().size(), 4);
+  ASSERT_EQ(planner.offsets().count(input), 0);
+  ASSERT_EQ(planner.total_tensor_size(), 4 * t1->Size());
+  ASSERT_EQ(planner.planned_size(), 2 * t1->Size());
+  ASSERT_FALSE(Overlap(&planner, t1, t2));
+  ASSERT_FALSE(Overlap(&planner, t2, t3));
+  ASSERT_FALSE(Overlap(&planner, t3, output));
+  ASSERT_NE(t1->Data(), nullptr);
+  ASSERT_EQ(input->Data(), nullptr);
+
+  planner.Release();
+  ASSERT_EQ(t1->Data(), nullptr);
+  ASSERT_EQ(output->Data(), nullptr);
+}
+
+TEST_F(TestMemoryPlanner, BranchAndGraphOutput) {
+  // t1 is read by the last kernel and is a graph output, so it is never shared
+  auto *input = NewTensor({1, 8, 8, 8});
+  auto *t1 = NewTensor({1, 8, 8, 8});
+  auto *t2 = NewTensor({1, 8, 8, 16});
+  auto *t3 = NewTensor({1, 8, 8, 3});
+  auto *t4 = NewTensor({1, 8, 8, 8});
+  NewKernel({input}, {t1});
+  NewKernel({t1}, {t2});
+  NewKernel({t2}, {t3});
+  NewKernel({t3, t1}, {t4});
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels_, {t1, t4}), lite::RET_OK);
+  std::vector<lite::tensor::Tensor *> planned = {t1, t2, t3, t4};
+  for (auto *tensor : planned) {
+    ASSERT_FALSE(Overlap(&planner, t1, tensor) && tensor != t1);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(tensor->Data()) % 64, 0);
+  }
+  ASSERT_FALSE(Overlap(&planner, t2, t3));
+  ASSERT_FALSE(Overlap(&planner, t3, t4));
+  ASSERT_LT(planner.planned_size(), planner.total_tensor_size());
+}
+
+TEST_F(TestMemoryPlanner, CachedPlans) {
+  auto *input = NewTensor({1, 8, 8, 8});
+  auto *t1 = NewTensor({1, 8, 8, 8});
+  auto *t2 = NewTensor({1, 8, 8, 8});
+  NewKernel({input}, {t1});
+  NewKernel({t1}, {t2});
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels_, {t2}), lite::RET_OK);
+  auto small_size = planner.planned_size();
+  for (auto *tensor : tensors_) {
+    tensor->set_shape({4, 8, 8, 8});
+  }
+  ASSERT_EQ(planner.Plan(kernels_, {t2}), lite::RET_OK);
+  ASSERT_EQ(planner.planned_size(), 4 * small_size);
+  ASSERT_EQ(planner.arena_size(), 4 * small_size);
+
+  // back to the first shape: the plan is cached and the larger arena is reused
+  for (auto *tensor : tensors_) {
+    tensor->set_shape({1, 8, 8, 8});
+  }
+  ASSERT_EQ(planner.Plan(kernels_, {t2}), lite::RET_OK);
+  ASSERT_EQ(planner.cached_plan_num(), 2);
+  ASSERT_EQ(planner.planned_size(), small_size);
+  ASSERT_EQ(planner.arena_size(), 4 * small_size);
+  ASSERT_FALSE(Overlap(&planner, t1, t2));
+
+  planner.Unbind();
+  ASSERT_FALSE(planner.planned());
+  ASSERT_EQ(t1->Data(), nullptr);
+  ASSERT_EQ(planner.arena_size(), 4 * small_size);
+}
+
+TEST_F(TestMemoryPlanner, UnknownShape) {
+  auto *input = NewTensor({1, 8, 8, 8});
+  auto *t1 = NewTensor({1, -1, 8, 8});
+  NewKernel({input}, {t1});
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels_, {t1}), lite::RET_NO_CHANGE);
+  ASSERT_FALSE(planner.planned());
+  ASSERT_EQ(t1->Data(), nullptr);
+}
+}  // namespace mindspore
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/core/utils/log_adapter.h"
+#include "mindspore/lite/src/common/utils.h"
+#include "mindspore/lite/src/runtime/thread_pool.h"
+
+namespace mindspore {
+constexpr int kPoolThreadNum = 4;
+
+class TestThreadPool : public mindspore::Common {
+ public:
+  TestThreadPool() {}
+  void SetUp() override { pool_.ConfigMaxThreadNum(kPoolThreadNum); }
+
+  predict::ThreadPool pool_;
+};
+
+TEST_F(TestThreadPool, RunEveryTaskOnce) {
+  for (int num_task : {2, 3, kPoolThreadNum, 17, 1000}) {
+    std::vector<std::atomic_int> counts(num_task);
+    auto ret = pool_.LaunchWork(
+      [&counts](int task_id, predict::TvmEnv *env, void *cdata) {
+        counts[task_id]++;
+        return 0;
+      },
+      nullptr, num_task);
+    ASSERT_TRUE(ret);
+    for (int i = 0; i < num_task; i++) {
+      ASSERT_EQ(counts[i], 1);
+    }
+  }
+}
+
+TEST_F(TestThreadPool, StealFromStraggler) {
+  // the tasks of the master thread are slow, the workers steal them
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  const int num_task = 64;
+  std::vector<std::atomic_int> counts(num_task);
+  auto ret = pool_.LaunchWork(
+    [&](int task_id, predict::TvmEnv *env, void *cdata) {
+      if (task_id < num_task / kPoolThreadNum) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+      counts[task_id]++;
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.insert(std::this_thread::get_id());
+      return 0;
+    },
+    nullptr, num_task);
+  ASSERT_TRUE(ret);
+  for (int i = 0; i < num_task; i++) {
+    ASSERT_EQ(counts[i], 1);
+  }
+  ASSERT_GT(threads.size(), 1);
+}
+
+TEST_F(TestThreadPool, NestedLaunch) {
+  std::atomic_int count = {0};
+  auto ret = pool_.LaunchWork(
+    [this, &count](int task_id, predict::TvmEnv *env, void *cdata) {
+      auto thread_id = std::this_thread::get_id();
+      bool same_thread = true;
+      bool nested_ret = pool_.LaunchWork(
+        [&](int nested_id, predict::TvmEnv *nested_env, void *nested_data) {
+          same_thread = same_thread && thread_id == std::this_thread::get_id();
+          count++;
+          return 0;
+        },
+        nullptr, 3);
+      return nested_ret && same_thread ? 0 : 1;
+    },
+    nullptr, kPoolThreadNum);
+  ASSERT_TRUE(ret);
+  ASSERT_EQ(count, 3 * kPoolThreadNum);
+}
+
+TEST_F(TestThreadPool, TaskFailed) {
+  auto ret = pool_.LaunchWork(
+    [](int task_id, predict::TvmEnv *env, void *cdata) { return task_id == 5 ? -1 : 0; }, nullptr, 8);
+  ASSERT_FALSE(ret);
+  ret = pool_.LaunchWork([](int task_id, predict::TvmEnv *env, void *cdata) { return 0; }, nullptr, 8);
+  ASSERT_TRUE(ret);
+}
+
+TEST_F(TestThreadPool, ConcurrentLaunch) {
+  std::atomic_int count = {0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 3; i++) {
+    callers.emplace_back([this, &count]() {
+      for (int j = 0; j < 100; j++) {
+        (void)pool_.LaunchWork(
+          [&count](int task_id, predict::TvmEnv *env, void *cdata) {
+            count++;
+            return 0;
+          },
+          nullptr, kPoolThreadNum);
+      }
+    });
+  }
+  for (auto &caller : callers) {
+    caller.join();
+  }
+  ASSERT_EQ(count, 3 * 100 * kPoolThreadNum);
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+TEST_F(TestThreadPool, BindMasterThread) {
+  cpu_set_t origin;
+  CPU_ZERO(&origin);
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &origin), 0);
+  ASSERT_TRUE(pool_.BindAllThreads(true, predict::BIG_CORE, true));
+  // the whole cpu_set_t is passed, cpus above 63 are bound as well
+  cpu_set_t bound;
+  CPU_ZERO(&bound);
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &bound), 0);
+  EXPECT_EQ(CPU_COUNT(&bound), 1);
+  CPU_AND(&bound, &bound, &origin);
+  EXPECT_EQ(CPU_COUNT(&bound), 1);
+  ASSERT_TRUE(pool_.BindAllThreads(false, predict::BIG_CORE, true));
+  ASSERT_EQ(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &origin), 0);
+}
+#endif
+
+// The latency of launching empty tasks, with the workers spinning between launches and with them sleeping at once.
+TEST_F(TestThreadPool, LaunchLatency) {
+  const int loop_count = 2000;
+  auto empty_task = [](int task_id, predict::TvmEnv *env, void *cdata) { return 0; };
+  for (int spin_count : {predict::kDefaultSpinCount, 0}) {
+    pool_.ConfigSpinCount(spin_count);
+    for (int i = 0; i < 10; i++) {
+      ASSERT_TRUE(pool_.LaunchWork(empty_task, nullptr, kPoolThreadNum));
+    }
+    auto time_start = mindspore::lite::GetTimeUs();
+    for (int i = 0; i < loop_count; i++) {
+      ASSERT_TRUE(pool_.LaunchWork(empty_task, nullptr, kPoolThreadNum));
+    }
+    auto time_end = mindspore::lite::GetTimeUs();
+    printf("spin count %d, launch latency : %f us\n", spin_count,
+           static_cast<float>(time_end - time_start) / loop_count);
+  }
+}
+}  // namespace mindspore
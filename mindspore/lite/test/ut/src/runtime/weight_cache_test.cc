@@ -0,0 +1,126 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/core/utils/log_adapter.h"
+#include "mindspore/lite/src/runtime/weight_cache.h"
+
+namespace mindspore {
+class TestWeightCache : public mindspore::Common {
+ public:
+  TestWeightCache() {}
+
+  void SetUp() override {
+    weight_ = new lite::tensor::Tensor(kNumberTypeFloat32, {4, 2});
+    weight_->MallocData();
+    model_buf_ = weight_->Data();
+    auto data = reinterpret_cast<float *>(model_buf_);
+    for (int i = 0; i < weight_->ElementsNum(); i++) {
+      data[i] = static_cast<float>(i);
+    }
+    // a weight in a model buffer
+    weight_->SetModelWeight(true);
+  }
+
+  void TearDown() override { delete weight_; }
+
+  void *Acquire(const std::string &key, size_t size) {
+    return lite::WeightCache::GetInstance()->Acquire(weight_, key, size, [this](void *dst) {
+      pack_num_++;
+      memcpy(dst, weight_->Data(), weight_->Size());
+    });
+  }
+
+  lite::tensor::Tensor *weight_ = nullptr;
+  void *model_buf_ = nullptr;
+  int pack_num_ = 0;
+};
+
+TEST_F(TestWeightCache, SharedByKernels) {
+  auto cache = lite::WeightCache::GetInstance();
+  auto size = weight_->Size() + 16;
+  auto a = Acquire("test_fp32", size);
+  auto b = Acquire("test_fp32", size);
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(pack_num_, 1);
+  ASSERT_EQ(cache->shared_num(), 1);
+  ASSERT_EQ(cache->shared_size(), size);
+  ASSERT_EQ(reinterpret_cast<float *>(a)[7], 7.0f);
+  // the padding is zeroed
+  ASSERT_EQ(reinterpret_cast<float *>(a)[8], 0.0f);
+
+  // another packing of the same weight
+  auto c = Acquire("test_fp32_other", size);
+  ASSERT_NE(c, a);
+  ASSERT_EQ(pack_num_, 2);
+
+  cache->Release(a);
+  cache->Release(c);
+  ASSERT_EQ(cache->shared_num(), 1);
+  cache->Release(b);
+  ASSERT_EQ(cache->shared_num(), 0);
+}
+
+TEST_F(TestWeightCache, PrivateWeight) {
+  auto cache = lite::WeightCache::GetInstance();
+  weight_->SetModelWeight(false);
+  auto a = Acquire("test_fp32", weight_->Size());
+  auto b = Acquire("test_fp32", weight_->Size());
+  ASSERT_NE(a, b);
+  ASSERT_EQ(pack_num_, 2);
+  ASSERT_EQ(cache->shared_num(), 0);
+  cache->Release(a);
+  cache->Release(b);
+}
+
+TEST_F(TestWeightCache, InvalidatedByFreedModel) {
+  auto cache = lite::WeightCache::GetInstance();
+  auto a = Acquire("test_fp32", weight_->Size());
+  cache->Invalidate(model_buf_, weight_->Size());
+  // the kernel holding it keeps it, a new kernel packs again
+  ASSERT_EQ(reinterpret_cast<float *>(a)[1], 1.0f);
+  auto b = Acquire("test_fp32", weight_->Size());
+  ASSERT_NE(a, b);
+  ASSERT_EQ(pack_num_, 2);
+  cache->Release(a);
+  cache->Release(b);
+  ASSERT_EQ(cache->shared_num(), 0);
+}
+
+TEST_F(TestWeightCache, ConcurrentAcquire) {
+  auto cache = lite::WeightCache::GetInstance();
+  constexpr int kThreadNum = 8;
+  std::vector<void *> packed(kThreadNum, nullptr);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; i++) {
+    threads.emplace_back([this, &packed, i]() { packed[i] = Acquire("test_fp32", weight_->Size()); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(pack_num_, 1);
+  for (int i = 0; i < kThreadNum; i++) {
+    ASSERT_EQ(packed[i], packed[0]);
+    cache->Release(packed[i]);
+  }
+  ASSERT_EQ(cache->shared_num(), 0);
+}
+}  // namespace mindspore
@@ -0,0 +1,151 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/core/utils/log_adapter.h"
+#include "mindspore/lite/src/scheduler.h"
+
+namespace mindspore {
+namespace {
+// a kernel reading its first input and writing its first output in NHWC4 if it supports it
+class FormatKernel : public kernel::LiteKernel {
+ public:
+  FormatKernel(const std::vector<lite::tensor::Tensor *> &inputs, const std::vector<lite::tensor::Tensor *> &outputs,
+               bool nhwc4_input, bool nhwc4_output)
+      : LiteKernel(nullptr, inputs, outputs), nhwc4_input_(nhwc4_input), nhwc4_output_(nhwc4_output) {
+    set_desc({kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_DepthwiseConv2D});
+  }
+
+  bool SupportInputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || (nhwc4_input_ && format == schema::Format_NHWC4);
+  }
+  bool SupportOutputFormat(schema::Format format) const override {
+    return format == schema::Format_NHWC || (nhwc4_output_ && format == schema::Format_NHWC4);
+  }
+
+ private:
+  bool nhwc4_input_;
+  bool nhwc4_output_;
+};
+}  // namespace
+
+class TestScheduler : public mindspore::Common {
+ public:
+  TestScheduler() {}
+  void TearDown() override {
+    for (auto *kernel : kernels_) {
+      delete kernel;
+    }
+    for (auto *tensor : tensors_) {
+      delete tensor;
+    }
+  }
+
+  lite::tensor::Tensor *NewTensor(const std::vector<int> &shape) {
+    auto *tensor = new lite::tensor::Tensor(kNumberTypeFloat32, shape);
+    tensors_.emplace_back(tensor);
+    return tensor;
+  }
+
+  void NewKernel(const std::vector<lite::tensor::Tensor *> &inputs,
+                 const std::vector<lite::tensor::Tensor *> &outputs, bool nhwc4_input, bool nhwc4_output) {
+    kernels_.emplace_back(new FormatKernel(inputs, outputs, nhwc4_input, nhwc4_output));
+  }
+
+  std::vector<lite::tensor::Tensor *> tensors_;
+  std::vector<kernel::LiteKernel *> kernels_;
+};
+
+TEST_F(TestScheduler, KeepNhwc4BetweenSupportingKernels) {
+  // input -> dw -> t1 -> dw -> t2 -> conv -> output
+  auto *input = NewTensor({1, 8, 8, 5});
+  auto *t1 = NewTensor({1, 8, 8, 5});
+  auto *t2 = NewTensor({1, 8, 8, 5});
+  auto *output = NewTensor({1, 8, 8, 5});
+  NewKernel({input}, {t1}, true, true);
+  NewKernel({t1}, {t2}, true, true);
+  NewKernel({t2}, {output}, true, false);
+
+  lite::Scheduler::PropagateLayout(kernels_, {output});
+  ASSERT_EQ(input->GetFormat(), schema::Format_NHWC);
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC4);
+  ASSERT_EQ(t2->GetFormat(), schema::Format_NHWC4);
+  ASSERT_EQ(output->GetFormat(), schema::Format_NHWC);
+  // the aligned channels are allocated
+  ASSERT_EQ(t1->Size(), 1 * 8 * 8 * 8 * sizeof(float));
+}
+
+TEST_F(TestScheduler, KeepNhwcForNonSupportingConsumer) {
+  // t1 is read by a NHWC4 kernel and a NHWC kernel, t2 is the second input of a NHWC4 kernel
+  auto *input = NewTensor({1, 8, 8, 5});
+  auto *t1 = NewTensor({1, 8, 8, 5});
+  auto *t2 = NewTensor({1, 8, 8, 5});
+  auto *t3 = NewTensor({1, 8, 8, 5});
+  auto *out1 = NewTensor({1, 8, 8, 5});
+  auto *out2 = NewTensor({1, 8, 8, 5});
+  NewKernel({input}, {t1}, true, true);
+  NewKernel({t1}, {t2}, true, true);
+  NewKernel({t1}, {t3}, false, false);
+  NewKernel({t3, t2}, {out1}, true, true);
+  NewKernel({t3}, {out2}, false, false);
+
+  lite::Scheduler::PropagateLayout(kernels_, {out1, out2});
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC);
+  ASSERT_EQ(t2->GetFormat(), schema::Format_NHWC);
+  ASSERT_EQ(t3->GetFormat(), schema::Format_NHWC);
+}
+
+TEST_F(TestScheduler, KeepNhwcForGraphOutput) {
+  // t1 is a graph output read by a NHWC4 kernel as well, the aligned t2 is the same in both formats
+  auto *input = NewTensor({1, 8, 8, 5});
+  auto *t1 = NewTensor({1, 8, 8, 5});
+  auto *t2 = NewTensor({1, 8, 8, 8});
+  auto *output = NewTensor({1, 8, 8, 8});
+  NewKernel({input}, {t1}, true, true);
+  NewKernel({t1}, {t2}, true, true);
+  NewKernel({t2}, {output}, true, true);
+
+  lite::Scheduler::PropagateLayout(kernels_, {t1, output});
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC);
+  ASSERT_EQ(t2->GetFormat(), schema::Format_NHWC);
+  ASSERT_EQ(output->GetFormat(), schema::Format_NHWC);
+}
+
+TEST_F(TestScheduler, ResetAndPropagateLayoutOnResize) {
+  auto *input = NewTensor({1, 8, 8, 5});
+  auto *t1 = NewTensor({1, 8, 8, 5});
+  auto *output = NewTensor({1, 8, 8, 5});
+  NewKernel({input}, {t1}, true, true);
+  NewKernel({t1}, {output}, true, true);
+  lite::Scheduler::PropagateLayout(kernels_, {output});
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC4);
+
+  // the shapes are inferred in NHWC, an aligned channel needs no NHWC4
+  lite::Scheduler::ResetLayout(kernels_);
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC);
+  t1->set_shape({2, 4, 4, 8});
+  lite::Scheduler::PropagateLayout(kernels_, {output});
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC);
+
+  lite::Scheduler::ResetLayout(kernels_);
+  t1->set_shape({1, 3, 3, 7});
+  lite::Scheduler::PropagateLayout(kernels_, {output});
+  ASSERT_EQ(t1->GetFormat(), schema::Format_NHWC4);
+  ASSERT_EQ(t1->Size(), 1 * 3 * 3 * 8 * sizeof(float));
+  ASSERT_EQ(output->GetFormat(), schema::Format_NHWC);
+}
+}  // namespace mindspore
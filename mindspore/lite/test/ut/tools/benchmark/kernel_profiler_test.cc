@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/lite/src/ir/tensor.h"
+#include "mindspore/lite/tools/benchmark/kernel_profiler.h"
+
+namespace mindspore {
+namespace lite {
+class TestKernelProfiler : public mindspore::Common {
+ public:
+  TestKernelProfiler() {}
+};
+
+TEST_F(TestKernelProfiler, EstimateCost) {
+  tensor::LiteTensor input(kNumberTypeFloat32, {1, 8, 8, 4});
+  tensor::LiteTensor weight(kNumberTypeFloat32, {16, 3, 3, 4});
+  tensor::LiteTensor output(kNumberTypeFloat32, {1, 8, 8, 16});
+  auto cost = EstimateKernelCost("Conv2D", {&input, &weight}, {&output});
+  ASSERT_EQ(cost.flops, 2 * 64 * 16 * 3 * 3 * 4);
+  ASSERT_EQ(cost.bytes, (256 + 576 + 1024) * sizeof(float));
+
+  tensor::LiteTensor left(kNumberTypeFloat32, {2, 3, 5});
+  tensor::LiteTensor right(kNumberTypeFloat32, {2, 5, 7});
+  tensor::LiteTensor product(kNumberTypeFloat32, {2, 3, 7});
+  cost = EstimateKernelCost("MatMul", {&left, &right}, {&product});
+  ASSERT_EQ(cost.flops, 2 * 2 * 3 * 7 * 5);
+
+  cost = EstimateKernelCost("Activation", {&product}, {&product});
+  ASSERT_EQ(cost.flops, 42);
+}
+
+TEST_F(TestKernelProfiler, RecordRuns) {
+  auto allocator = std::make_shared<ProfileAllocator>();
+  KernelProfiler profiler(2, allocator);
+  ASSERT_EQ(profiler.Init(), RET_OK);
+  tensor::LiteTensor input(kNumberTypeFloat32, {1, 4});
+  tensor::LiteTensor output(kNumberTypeFloat32, {1, 4});
+  std::vector<tensor::MSTensor *> inputs = {&input};
+  std::vector<tensor::MSTensor *> outputs = {&output};
+  session::CallBackParam add = {"add,\"1\"", "Add"};
+  session::CallBackParam relu = {"relu", "Activation"};
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(profiler.before_call_back()(inputs, outputs, add));
+    // a buffer taken while the kernel runs
+    allocator->Free(allocator->Malloc(64));
+    ASSERT_TRUE(profiler.after_call_back()(inputs, outputs, add));
+    ASSERT_TRUE(profiler.before_call_back()(inputs, outputs, relu));
+    ASSERT_TRUE(profiler.after_call_back()(inputs, outputs, relu));
+  }
+  const auto &records = profiler.records();
+  ASSERT_EQ(records.size(), 2);
+  ASSERT_EQ(records[0].name, add.name_callback_param);
+  ASSERT_EQ(records[0].times.size(), 3);
+  ASSERT_EQ(records[0].malloc_count, 3);
+  ASSERT_EQ(records[0].malloc_bytes, 3 * 64);
+  ASSERT_EQ(records[1].malloc_count, 0);
+  ASSERT_EQ(allocator->free_count(), 3);
+
+  RooflinePeak peak;
+  peak.gflops = 100;
+  peak.bandwidth = 10;
+  auto csv = profiler.Csv(peak);
+  ASSERT_EQ(csv.find("name,type,runs,"), 0);
+  ASSERT_NE(csv.find("\"add,\"\"1\"\"\",Add,3,"), std::string::npos);
+  ASSERT_NE(csv.find(",memory,"), std::string::npos);
+
+  auto trace = profiler.ChromeTrace();
+  ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  ASSERT_NE(trace.find("{\"name\": \"add,\\\"1\\\"\", \"cat\": \"Add\", \"ph\": \"X\""), std::string::npos);
+
+  profiler.Clear();
+  ASSERT_TRUE(profiler.records().empty());
+}
+}  // namespace lite
+}  // namespace mindspore
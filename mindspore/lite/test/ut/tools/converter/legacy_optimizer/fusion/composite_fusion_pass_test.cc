@@ -0,0 +1,399 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "tools/converter/legacy_optimizer/fusion/composite_fusion_pass.h"
+
+namespace mindspore {
+namespace lite {
+class CompositeFusionPassTest : public mindspore::Common {
+ public:
+  CompositeFusionPassTest() = default;
+};
+
+namespace {
+constexpr float kEpsilon = 1e-5f;
+
+// builds a small graph node by node, every node has one output tensor
+class GraphBuilder {
+ public:
+  GraphBuilder() : graph_(std::make_unique<schema::MetaGraphT>()) { graph_->name = "graph"; }
+
+  uint32_t AddInput(const std::vector<int32_t> &dims) {
+    auto idx = AddTensor(schema::NodeType_Parameter, dims, {});
+    graph_->inputIndex.emplace_back(idx);
+    return idx;
+  }
+
+  uint32_t AddConst(const std::vector<int32_t> &dims, const std::vector<float> &data) {
+    return AddTensor(schema::NodeType_ValueNode, dims, data);
+  }
+
+  uint32_t AddNode(const std::string &name, schema::PrimitiveType type, void *attr,
+                   const std::vector<uint32_t> &inputs, const std::vector<int32_t> &outputDims) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->name = name;
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = type;
+    node->primitive->value.value = attr;
+    node->inputIndex = inputs;
+    auto output = AddTensor(schema::NodeType_Parameter, outputDims, {});
+    node->outputIndex = {output};
+    graph_->nodes.emplace_back(std::move(node));
+    return output;
+  }
+
+  void AddOutput(uint32_t idx) { graph_->outputIndex.emplace_back(idx); }
+
+  std::unique_ptr<schema::MetaGraphT> Build() { return std::move(graph_); }
+
+ private:
+  uint32_t AddTensor(schema::NodeType nodeType, const std::vector<int32_t> &dims, const std::vector<float> &data) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = nodeType;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = dims;
+    tensor->data.resize(data.size() * sizeof(float));
+    if (!data.empty()) {
+      memcpy(tensor->data.data(), data.data(), tensor->data.size());
+    }
+    graph_->allTensors.emplace_back(std::move(tensor));
+    return graph_->allTensors.size() - 1;
+  }
+
+  std::unique_ptr<schema::MetaGraphT> graph_;
+};
+
+schema::CNodeT *FindNode(const schema::MetaGraphT &graph, const std::string &name) {
+  for (auto &node : graph.nodes) {
+    if (node->name == name) {
+      return node.get();
+    }
+  }
+  return nullptr;
+}
+
+// a fused node is isolated, it has neither inputs nor outputs any more
+bool IsRemoved(const schema::MetaGraphT &graph, const std::string &name) {
+  auto node = FindNode(graph, name);
+  return node != nullptr && node->inputIndex.empty() && node->outputIndex.empty();
+}
+
+uint32_t AddConv(GraphBuilder *builder, const std::string &name, uint32_t input, const std::vector<int32_t> &dims) {
+  auto weight = builder->AddConst({dims.back(), 1, 1, dims.back()}, std::vector<float>(dims.back() * dims.back(), 1));
+  return builder->AddNode(name, schema::PrimitiveType_Conv2D, new schema::Conv2DT, {input, weight}, dims);
+}
+
+schema::MeanT *NewMean(int32_t axis) {
+  auto attr = new schema::MeanT;
+  attr->axis = {axis};
+  attr->keepDims = true;
+  return attr;
+}
+
+schema::AddT *NewAdd(schema::ActivationType activationType = schema::ActivationType_NO_ACTIVATION) {
+  auto attr = new schema::AddT;
+  attr->activationType = activationType;
+  return attr;
+}
+
+schema::ActivationT *NewActivation(schema::ActivationType type) {
+  auto attr = new schema::ActivationT;
+  attr->type = type;
+  return attr;
+}
+
+struct LayerNormGraphOptions {
+  std::vector<float> gamma = std::vector<float>(8, 2.0f);
+  std::vector<float> beta = std::vector<float>(8, 1.0f);
+  schema::ActivationType betaActivation = schema::ActivationType_NO_ACTIVATION;
+  bool subIsOutput = false;
+  // a conv in front of the LayerNorm, otherwise it reads the graph input
+  bool withConv = true;
+};
+
+// gamma * (x - mean(x)) / sqrt(mean((x - mean(x))^2) + epsilon) + beta over the last axis of x
+std::unique_ptr<schema::MetaGraphT> BuildLayerNormGraph(const LayerNormGraphOptions &options) {
+  const std::vector<int32_t> dims = {1, 4, 8};
+  const std::vector<int32_t> reducedDims = {1, 4, 1};
+  GraphBuilder builder;
+  auto input = builder.AddInput(dims);
+  auto x = options.withConv ? AddConv(&builder, "conv", input, dims) : input;
+  auto mean = builder.AddNode("mean", schema::PrimitiveType_Mean, NewMean(-1), {x}, reducedDims);
+  auto sub = builder.AddNode("sub", schema::PrimitiveType_Sub, new schema::SubT, {x, mean}, dims);
+  auto square = builder.AddNode("square", schema::PrimitiveType_Mul, new schema::MulT, {sub, sub}, dims);
+  auto variance = builder.AddNode("variance", schema::PrimitiveType_Mean, NewMean(-1), {square}, reducedDims);
+  auto epsilon = builder.AddConst({1}, {kEpsilon});
+  auto addEpsilon =
+    builder.AddNode("add_epsilon", schema::PrimitiveType_Add, NewAdd(), {variance, epsilon}, reducedDims);
+  auto stdDev = builder.AddNode("sqrt", schema::PrimitiveType_Sqrt, new schema::SqrtT, {addEpsilon}, reducedDims);
+  auto div = builder.AddNode("div", schema::PrimitiveType_RealDiv, new schema::RealDivT, {sub, stdDev}, dims);
+  auto gammaConst = builder.AddConst({static_cast<int32_t>(options.gamma.size())}, options.gamma);
+  auto gamma = builder.AddNode("gamma", schema::PrimitiveType_Mul, new schema::MulT, {div, gammaConst}, dims);
+  auto betaConst = builder.AddConst({static_cast<int32_t>(options.beta.size())}, options.beta);
+  auto beta =
+    builder.AddNode("beta", schema::PrimitiveType_Add, NewAdd(options.betaActivation), {gamma, betaConst}, dims);
+  builder.AddOutput(beta);
+  if (options.subIsOutput) {
+    builder.AddOutput(sub);
+  }
+  return builder.Build();
+}
+
+// x * (0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))) of the graph input x, followed by an add of a constant
+std::unique_ptr<schema::MetaGraphT> BuildGeluGraph() {
+  const std::vector<int32_t> dims = {1, 4, 8};
+  GraphBuilder builder;
+  auto x = builder.AddInput(dims);
+  auto powAttr = new schema::PowerT;
+  powAttr->power = 3.0f;
+  powAttr->scale = 1.0f;
+  powAttr->shift = 0.0f;
+  auto cube = builder.AddNode("pow", schema::PrimitiveType_Power, powAttr, {x}, dims);
+  auto coeff = builder.AddConst({1}, {0.044715f});
+  auto mulCoeff = builder.AddNode("mul_coeff", schema::PrimitiveType_Mul, new schema::MulT, {cube, coeff}, dims);
+  auto addInput = builder.AddNode("add_input", schema::PrimitiveType_Add, NewAdd(), {x, mulCoeff}, dims);
+  auto sqrtTwoOverPi = builder.AddConst({1}, {0.7978845608f});
+  auto mulSqrt =
+    builder.AddNode("mul_sqrt", schema::PrimitiveType_Mul, new schema::MulT, {addInput, sqrtTwoOverPi}, dims);
+  auto tanhOutput = builder.AddNode("tanh", schema::PrimitiveType_Activation,
+                                    NewActivation(schema::ActivationType_TANH), {mulSqrt}, dims);
+  auto one = builder.AddConst({1}, {1.0f});
+  auto addOne = builder.AddNode("add_one", schema::PrimitiveType_Add, NewAdd(), {tanhOutput, one}, dims);
+  auto half = builder.AddConst({1}, {0.5f});
+  auto mulHalf = builder.AddNode("mul_half", schema::PrimitiveType_Mul, new schema::MulT, {addOne, half}, dims);
+  auto gelu = builder.AddNode("gelu", schema::PrimitiveType_Mul, new schema::MulT, {mulHalf, x}, dims);
+  // the add is tried as the output of the LayerNorm pattern first, which takes the last mul of the gelu before it
+  // fails
+  auto bias = builder.AddConst({8}, std::vector<float>(8, 1.0f));
+  auto output = builder.AddNode("bias", schema::PrimitiveType_Add, NewAdd(), {gelu, bias}, dims);
+  builder.AddOutput(output);
+  return builder.Build();
+}
+
+struct ConvAddGraphOptions {
+  bool withBiasAdd = true;
+  // the residual is the first input of the add and its node comes before the conv, so the add is first tried with the
+  // residual as the conv branch
+  bool residualFirst = false;
+  bool biasAddIsOutput = false;
+  // the residual is x itself instead of pool(x)
+  bool residualIsGraphInput = false;
+};
+
+// relu(add(biasadd(conv(x)), pool(x)))
+std::unique_ptr<schema::MetaGraphT> BuildConvAddGraph(const ConvAddGraphOptions &options) {
+  const std::vector<int32_t> dims = {1, 4, 4, 8};
+  GraphBuilder builder;
+  auto input = builder.AddInput(dims);
+  auto addResidual = [&builder, input, &dims, &options]() {
+    if (options.residualIsGraphInput) {
+      return input;
+    }
+    return builder.AddNode("residual", schema::PrimitiveType_Pooling, new schema::PoolingT, {input}, dims);
+  };
+  uint32_t residual = 0;
+  if (options.residualFirst) {
+    residual = addResidual();
+  }
+  auto conv = AddConv(&builder, "conv", input, dims);
+  auto biasAdd = conv;
+  if (options.withBiasAdd) {
+    auto bias = builder.AddConst({8}, std::vector<float>(8, 1.0f));
+    biasAdd = builder.AddNode("biasadd", schema::PrimitiveType_BiasAdd, new schema::BiasAddT, {conv, bias}, dims);
+  }
+  if (!options.residualFirst) {
+    residual = addResidual();
+  }
+  std::vector<uint32_t> addInputs = {biasAdd, residual};
+  if (options.residualFirst) {
+    addInputs = {residual, biasAdd};
+  }
+  auto add = builder.AddNode("add", schema::PrimitiveType_Add, NewAdd(), addInputs, dims);
+  auto relu = builder.AddNode("relu", schema::PrimitiveType_Activation, NewActivation(schema::ActivationType_RELU),
+                              {add}, dims);
+  builder.AddOutput(relu);
+  if (options.biasAddIsOutput) {
+    builder.AddOutput(biasAdd);
+  }
+  return builder.Build();
+}
+
+void CheckConvAddReluFused(const schema::MetaGraphT &graph) {
+  auto add = FindNode(graph, "add");
+  ASSERT_NE(add, nullptr);
+  ASSERT_NE(add->primitive->value.AsAdd(), nullptr);
+  EXPECT_EQ(add->primitive->value.AsAdd()->activationType, schema::ActivationType_RELU);
+  EXPECT_TRUE(IsRemoved(graph, "relu"));
+  ASSERT_EQ(graph.outputIndex.size(), 1);
+  EXPECT_EQ(graph.outputIndex.front(), add->outputIndex.front());
+}
+}  // namespace
+
+TEST_F(CompositeFusionPassTest, TestLayerNormFusion) {
+  auto graph = BuildLayerNormGraph(LayerNormGraphOptions());
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+
+  auto layerNorm = FindNode(*graph, "beta");
+  ASSERT_NE(layerNorm, nullptr);
+  ASSERT_EQ(layerNorm->primitive->value.type, schema::PrimitiveType_LayerNorm);
+  auto attr = layerNorm->primitive->value.AsLayerNorm();
+  EXPECT_EQ(attr->beginNormAxis, -1);
+  EXPECT_FLOAT_EQ(attr->epsilon, kEpsilon);
+  ASSERT_EQ(layerNorm->inputIndex.size(), 3);
+  EXPECT_EQ(layerNorm->inputIndex[0], FindNode(*graph, "conv")->outputIndex.front());
+  for (const auto &name : {"mean", "sub", "square", "variance", "add_epsilon", "sqrt", "div", "gamma"}) {
+    EXPECT_TRUE(IsRemoved(*graph, name)) << name;
+  }
+}
+
+TEST_F(CompositeFusionPassTest, TestLayerNormFusionOnGraphInput) {
+  LayerNormGraphOptions options;
+  options.withConv = false;
+  auto graph = BuildLayerNormGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+
+  auto layerNorm = FindNode(*graph, "beta");
+  ASSERT_NE(layerNorm, nullptr);
+  ASSERT_EQ(layerNorm->primitive->value.type, schema::PrimitiveType_LayerNorm);
+  ASSERT_EQ(layerNorm->inputIndex.size(), 3);
+  EXPECT_EQ(layerNorm->inputIndex[0], graph->inputIndex.front());
+  for (const auto &name : {"mean", "sub", "square", "variance", "add_epsilon", "sqrt", "div", "gamma"}) {
+    EXPECT_TRUE(IsRemoved(*graph, name)) << name;
+  }
+}
+
+TEST_F(CompositeFusionPassTest, TestLayerNormBroadcastScalarGamma) {
+  LayerNormGraphOptions options;
+  options.gamma = {2.0f};
+  auto graph = BuildLayerNormGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+
+  auto layerNorm = FindNode(*graph, "beta");
+  ASSERT_EQ(layerNorm->primitive->value.type, schema::PrimitiveType_LayerNorm);
+  auto &gamma = graph->allTensors.at(layerNorm->inputIndex[1]);
+  ASSERT_EQ(gamma->dims, std::vector<int32_t>({8}));
+  ASSERT_EQ(gamma->data.size(), 8 * sizeof(float));
+  auto gammaData = reinterpret_cast<const float *>(gamma->data.data());
+  EXPECT_EQ(std::vector<float>(gammaData, gammaData + 8), std::vector<float>(8, 2.0f));
+}
+
+TEST_F(CompositeFusionPassTest, TestLayerNormNotFuseMismatchedGamma) {
+  LayerNormGraphOptions options;
+  options.gamma = std::vector<float>(4, 2.0f);
+  auto graph = BuildLayerNormGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+  EXPECT_EQ(FindNode(*graph, "beta")->primitive->value.type, schema::PrimitiveType_Add);
+}
+
+TEST_F(CompositeFusionPassTest, TestLayerNormNotFuseAddWithActivation) {
+  LayerNormGraphOptions options;
+  options.betaActivation = schema::ActivationType_RELU;
+  auto graph = BuildLayerNormGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+  EXPECT_EQ(FindNode(*graph, "beta")->primitive->value.type, schema::PrimitiveType_Add);
+}
+
+TEST_F(CompositeFusionPassTest, TestInnerOutputUsedOutsideBlocksFusion) {
+  LayerNormGraphOptions options;
+  options.subIsOutput = true;
+  auto graph = BuildLayerNormGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+  EXPECT_EQ(FindNode(*graph, "beta")->primitive->value.type, schema::PrimitiveType_Add);
+  EXPECT_FALSE(IsRemoved(*graph, "sub"));
+}
+
+TEST_F(CompositeFusionPassTest, TestGeluFusionAfterRollBack) {
+  auto graph = BuildGeluGraph();
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+
+  auto gelu = FindNode(*graph, "gelu");
+  ASSERT_NE(gelu, nullptr);
+  ASSERT_EQ(gelu->primitive->value.type, schema::PrimitiveType_Activation);
+  EXPECT_EQ(gelu->primitive->value.AsActivation()->type, schema::ActivationType_GELU);
+  ASSERT_EQ(gelu->inputIndex.size(), 1);
+  EXPECT_EQ(gelu->inputIndex.front(), graph->inputIndex.front());
+  for (const auto &name : {"pow", "mul_coeff", "add_input", "mul_sqrt", "tanh", "add_one", "mul_half"}) {
+    EXPECT_TRUE(IsRemoved(*graph, name)) << name;
+  }
+  // the add the LayerNorm pattern failed at is left as it is
+  auto bias = FindNode(*graph, "bias");
+  EXPECT_EQ(bias->primitive->value.type, schema::PrimitiveType_Add);
+  EXPECT_EQ(bias->inputIndex.front(), gelu->outputIndex.front());
+}
+
+TEST_F(CompositeFusionPassTest, TestConvBiasAddAddReluFusion) {
+  auto graph = BuildConvAddGraph(ConvAddGraphOptions());
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+  CheckConvAddReluFused(*graph);
+  EXPECT_FALSE(IsRemoved(*graph, "biasadd"));
+}
+
+TEST_F(CompositeFusionPassTest, TestConvAddReluFusionSkipOptionalBiasAdd) {
+  ConvAddGraphOptions options;
+  options.withBiasAdd = false;
+  auto graph = BuildConvAddGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+  CheckConvAddReluFused(*graph);
+}
+
+TEST_F(CompositeFusionPassTest, TestConvAddReluFusionSwappedInputs) {
+  ConvAddGraphOptions options;
+  options.residualFirst = true;
+  auto graph = BuildConvAddGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+  CheckConvAddReluFused(*graph);
+}
+
+TEST_F(CompositeFusionPassTest, TestConvAddReluFusionGraphInputResidual) {
+  ConvAddGraphOptions options;
+  options.residualIsGraphInput = true;
+  auto graph = BuildConvAddGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+  CheckConvAddReluFused(*graph);
+  EXPECT_EQ(FindNode(*graph, "add")->inputIndex.back(), graph->inputIndex.front());
+}
+
+TEST_F(CompositeFusionPassTest, TestConvAddReluNotFuseInnerOutput) {
+  ConvAddGraphOptions options;
+  options.biasAddIsOutput = true;
+  auto graph = BuildConvAddGraph(options);
+  CompositeFusionPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+  auto add = FindNode(*graph, "add");
+  EXPECT_EQ(add->primitive->value.AsAdd()->activationType, schema::ActivationType_NO_ACTIVATION);
+  EXPECT_FALSE(IsRemoved(*graph, "relu"));
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/lite_session.h"
+#include "include/model.h"
+#include "src/runtime/kernel/arm/nnacl/op_base.h"
+#include "tools/converter/legacy_optimizer/graph/weight_prepack_pass.h"
+
+namespace mindspore {
+namespace lite {
+class WeightPrepackPassTest : public mindspore::Common {
+ public:
+  WeightPrepackPassTest() = default;
+};
+
+namespace {
+constexpr int kInH = 9;
+constexpr int kInW = 9;
+constexpr int kInC = 6;
+constexpr int kOutC = 10;
+constexpr int kPad = 2;
+
+std::unique_ptr<schema::TensorT> NewTensor(schema::NodeType nodeType, const std::vector<int32_t> &dims,
+                                           const std::vector<float> &data) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = nodeType;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = TypeId::kNumberTypeFloat32;
+  tensor->dims = dims;
+  tensor->offset = -1;
+  tensor->data.resize(data.size() * sizeof(float));
+  if (!data.empty()) {
+    memcpy(tensor->data.data(), data.data(), tensor->data.size());
+  }
+  return tensor;
+}
+
+// a graph of one conv of the given kernel and stride with a KHWC weight, as WeightFormatPass leaves it
+std::unique_ptr<schema::MetaGraphT> NewConvGraph(int kernel, int stride, const std::vector<float> &weight) {
+  auto graph = std::make_unique<schema::MetaGraphT>();
+  graph->name = "graph";
+  auto conv = new schema::Conv2DT;
+  conv->padMode = schema::PadMode_CAFFE;
+  conv->padUp = kPad;
+  conv->padDown = kPad;
+  conv->padLeft = kPad;
+  conv->padRight = kPad;
+  conv->channelIn = kInC;
+  conv->channelOut = kOutC;
+  conv->format = schema::Format_NHWC;
+  conv->kernelH = kernel;
+  conv->kernelW = kernel;
+  conv->strideH = stride;
+  conv->strideW = stride;
+  conv->dilateH = 1;
+  conv->dilateW = 1;
+  auto node = std::make_unique<schema::CNodeT>();
+  node->name = "Conv2D";
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  node->primitive->value.value = conv;
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  graph->nodes.emplace_back(std::move(node));
+  graph->allTensors.emplace_back(NewTensor(schema::NodeType_ValueNode, {1, kInH, kInW, kInC}, {}));
+  auto weight_tensor = NewTensor(schema::NodeType_ValueNode, {kOutC, kernel, kernel, kInC}, weight);
+  weight_tensor->format = schema::Format_KHWC;
+  graph->allTensors.emplace_back(std::move(weight_tensor));
+  graph->allTensors.emplace_back(NewTensor(schema::NodeType_Parameter, {}, {}));
+  graph->inputIndex = {0};
+  graph->outputIndex = {2};
+  return graph;
+}
+
+std::vector<float> NewWeight(int kernel) {
+  std::vector<float> weight(kOutC * kernel * kernel * kInC);
+  for (size_t i = 0; i < weight.size(); i++) {
+    weight[i] = static_cast<float>(i % 7) * 0.05f - 0.15f;
+  }
+  return weight;
+}
+}  // namespace
+
+TEST_F(WeightPrepackPassTest, KernelAdoptsPackedWeight) {
+  const int kernel = 5;
+  const int stride = 2;
+  auto weight = NewWeight(kernel);
+  auto graph = NewConvGraph(kernel, stride, weight);
+  WeightPrepackPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_OK);
+  auto &weight_tensor = graph->allTensors.at(1);
+  ASSERT_EQ(weight_tensor->packedLayout, schema::PackedWeightLayout_CONV_FP32_OC8_IC4);
+  // the size the common conv kernel packs at Init
+  size_t pack_weight_num = UP_DIV(kOutC, C8NUM) * C8NUM * UP_DIV(kInC, C4NUM) * C4NUM * kernel * kernel;
+  ASSERT_EQ(weight_tensor->packedData.size(), pack_weight_num * sizeof(float));
+  ASSERT_EQ(weight_tensor->data.size(), weight.size() * sizeof(float));
+  // a second run finds the weight packed
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+
+  // the kernel computes the conv from the packed weight only
+  memset(weight_tensor->data.data(), 0, weight_tensor->data.size());
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, graph.get());
+  builder.Finish(offset);
+  auto model = Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ASSERT_NE(model, nullptr);
+  auto context = new Context;
+  context->cpu_bind_mode_ = NO_BIND;
+  context->device_ctx_.type = DT_CPU;
+  context->thread_num_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(session->CompileGraph(model.get()), RET_OK);
+  auto *in_data = reinterpret_cast<float *>(session->GetInputs().front()->MutableData());
+  for (int i = 0; i < kInH * kInW * kInC; i++) {
+    in_data[i] = static_cast<float>(i % 13) * 0.1f - 0.5f;
+  }
+  ASSERT_EQ(session->RunGraph(), RET_OK);
+  auto output = session->GetOutputs().front();
+  int out_h = (kInH + 2 * kPad - kernel) / stride + 1;
+  int out_w = (kInW + 2 * kPad - kernel) / stride + 1;
+  ASSERT_EQ(output->ElementsNum(), out_h * out_w * kOutC);
+  auto *out_data = reinterpret_cast<float *>(output->MutableData());
+  std::vector<float> expect(out_h * out_w * kOutC, 0);
+  for (int oh = 0; oh < out_h; oh++) {
+    for (int ow = 0; ow < out_w; ow++) {
+      for (int o = 0; o < kOutC; o++) {
+        float sum = 0;
+        for (int kh = 0; kh < kernel; kh++) {
+          for (int kw = 0; kw < kernel; kw++) {
+            int ih = oh * stride - kPad + kh;
+            int iw = ow * stride - kPad + kw;
+            if (ih < 0 || ih >= kInH || iw < 0 || iw >= kInW) {
+              continue;
+            }
+            for (int c = 0; c < kInC; c++) {
+              sum += in_data[(ih * kInW + iw) * kInC + c] * weight[((o * kernel + kh) * kernel + kw) * kInC + c];
+            }
+          }
+        }
+        expect[(oh * out_w + ow) * kOutC + o] = sum;
+      }
+    }
+  }
+#ifndef ENABLE_ARM32
+  CompareOutputData(out_data, expect.data(), expect.size(), 0.0001);
+#endif
+  delete session;
+  delete context;
+}
+
+TEST_F(WeightPrepackPassTest, SkipWeightPackedByOtherKernels) {
+  // 3x3 convs of stride 1 run the 3x3 or winograd kernel
+  auto graph = NewConvGraph(3, 1, NewWeight(3));
+  WeightPrepackPass pass;
+  ASSERT_EQ(pass.Run(graph.get()), RET_NO_CHANGE);
+  ASSERT_EQ(graph->allTensors.at(1)->packedLayout, schema::PackedWeightLayout_NONE);
+  ASSERT_TRUE(graph->allTensors.at(1)->packedData.empty());
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,277 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "include/errorcode.h"
+#include "tools/converter/quantizer/post_training.h"
+
+namespace mindspore {
+namespace lite {
+namespace quant {
+class PostTrainingTest : public mindspore::Common {
+ public:
+  PostTrainingTest() = default;
+};
+
+namespace {
+constexpr int kBinNum = 2048;
+constexpr int kQuantMax = 127;
+constexpr int kQuantMin = -128;
+const char kOpName[] = "conv";
+
+CNodePtr BuildCNode(const FuncGraphPtr &graph) {
+  auto cnode = graph->NewCNode({NewValueNode(std::make_shared<Primitive>("Conv2D")), graph->add_parameter()});
+  cnode->set_fullname_with_scope(kOpName);
+  return cnode;
+}
+
+// Data with count[k] values in the middle of bin k, the value kBinNum makes the bin interval 1 and falls in the last
+// bin.
+std::vector<float> BuildData(const std::vector<int> &counts) {
+  std::vector<float> data;
+  for (int k = 0; k < kBinNum; ++k) {
+    data.insert(data.end(), counts[k], static_cast<float>(k) + 0.5f);
+  }
+  data.emplace_back(static_cast<float>(kBinNum));
+  return data;
+}
+
+std::vector<float> BuildHistogram(const std::vector<int> &counts) {
+  std::vector<float> histogram(kBinNum, 1.0e-7);
+  for (int k = 0; k < kBinNum; ++k) {
+    for (int i = 0; i < counts[k]; ++i) {
+      histogram[k]++;
+    }
+  }
+  histogram[kBinNum - 1]++;
+  return histogram;
+}
+
+// The threshold search as it was before it worked on prefix sums, it merges the first i bins to 128 bins, expands them
+// back and sums up the divergence bin by bin. It runs in double, in float the two differ on near ties.
+int ReferenceThreshold(const std::vector<float> &histogram) {
+  constexpr int quant_bint_nums = 128;
+  const int bin_num = histogram.size();
+  int threshold = quant_bint_nums;
+  double min_kl = DBL_MAX;
+  double after_threshold_sum = std::accumulate(histogram.begin() + quant_bint_nums, histogram.end(), 0.0);
+  for (int i = quant_bint_nums; i < bin_num; ++i) {
+    std::vector<double> quantized_histogram(quant_bint_nums, 0);
+    std::vector<double> reference_histogram(histogram.begin(), histogram.begin() + i);
+    std::vector<double> expanded_histogram(i, 0);
+    reference_histogram[i - 1] += after_threshold_sum;
+    after_threshold_sum -= histogram[i];
+    const double bin_interval = static_cast<double>(i) / quant_bint_nums;
+    for (int j = 0; j < quant_bint_nums; ++j) {
+      const double start = j * bin_interval;
+      const double end = start + bin_interval;
+      const int left_upper = static_cast<int>(std::ceil(start));
+      const int right_lower = static_cast<int>(std::floor(end));
+      double left_scale = 0;
+      double right_scale = 0;
+      double count = 0;
+      if (left_upper > start) {
+        left_scale = left_upper - start;
+        quantized_histogram[j] += left_scale * histogram[left_upper - 1];
+        count += histogram[left_upper - 1] != 0 ? left_scale : 0;
+      }
+      if (right_lower < end) {
+        right_scale = end - right_lower;
+        quantized_histogram[j] += right_scale * histogram[right_lower];
+        count += histogram[right_lower] != 0 ? right_scale : 0;
+      }
+      for (int k = left_upper; k < right_lower; ++k) {
+        quantized_histogram[j] += histogram[k];
+        count += histogram[k] != 0 ? 1 : 0;
+      }
+      if (count == 0) {
+        continue;
+      }
+      const double average_num = quantized_histogram[j] / count;
+      if (left_upper > start && histogram[left_upper - 1] != 0) {
+        expanded_histogram[left_upper - 1] += average_num * left_scale;
+      }
+      if (right_lower < end && histogram[right_lower] != 0) {
+        expanded_histogram[right_lower] += average_num * right_scale;
+      }
+      for (int k = left_upper; k < right_lower; ++k) {
+        if (histogram[k] != 0) {
+          expanded_histogram[k] += average_num;
+        }
+      }
+    }
+    const double p_sum = std::accumulate(reference_histogram.begin(), reference_histogram.end(), 0.0);
+    const double q_sum = std::accumulate(expanded_histogram.begin(), expanded_histogram.end(), 0.0);
+    double kl = 0;
+    for (int k = 0; k < i; ++k) {
+      const double p = reference_histogram[k] / p_sum;
+      const double q = expanded_histogram[k] / q_sum;
+      if (p != 0) {
+        kl += q == 0 ? 1.0 : p * std::log(p / q);
+      }
+    }
+    if (kl < min_kl) {
+      min_kl = kl;
+      threshold = i;
+    }
+  }
+  return threshold;
+}
+
+float GetScale(Calibrator *calibrator, const CNodePtr &cnode) {
+  auto result = calibrator->GetResult(calibrator->GetOutputDivergInfo());
+  return result.at(cnode);
+}
+}  // namespace
+
+TEST_F(PostTrainingTest, TestThresholdOfFixedHistograms) {
+  std::vector<int> gaussian(kBinNum);
+  std::vector<int> long_tail(kBinNum);
+  std::vector<int> truncated(kBinNum);
+  std::vector<int> shifted(kBinNum);
+  for (int k = 0; k < kBinNum; ++k) {
+    gaussian[k] = static_cast<int>(std::round(1000 * std::exp(-static_cast<double>(k * k) / (2 * 300.0 * 300.0))));
+    long_tail[k] = static_cast<int>(std::round(2000 * std::exp(-k / 150.0))) + (k % 97 == 0 ? 5 : 0);
+    truncated[k] = k < 700 ? 50 + (k * 37) % 11 : (k % 301 == 0 ? 3 : 0);
+    shifted[k] = static_cast<int>(std::round(800 * std::exp(-static_cast<double>((k - 400) * (k - 400)) / 12800.0) +
+                                             100 * std::exp(-k / 50.0)));
+  }
+  for (const auto &counts : {gaussian, long_tail, truncated, shifted}) {
+    auto graph = std::make_shared<FuncGraph>();
+    auto cnode = BuildCNode(graph);
+    Calibrator calibrator("", 8, kQuantMax, kQuantMin);
+    ASSERT_EQ(calibrator.AddQuantizedOp(cnode), RET_OK);
+    auto data = BuildData(counts);
+    auto diverg_info = calibrator.GetOutputDivergInfo();
+    calibrator.RecordMaxValue(kOpName, data.data(), data.size(), diverg_info);
+    calibrator.UpdateDivergInverval(diverg_info);
+    calibrator.UpdateDataFrequency(kOpName, data.data(), data.size(), diverg_info);
+    ASSERT_EQ(calibrator.ComputeThreshold(), RET_OK);
+
+    const int threshold = ReferenceThreshold(BuildHistogram(counts));
+    const float best_t = static_cast<float>(threshold) + 0.5f;
+    EXPECT_FLOAT_EQ(GetScale(&calibrator, cnode), 2 * best_t / (kQuantMax - kQuantMin));
+  }
+}
+
+TEST_F(PostTrainingTest, TestMergedSessionsEqualOneSession) {
+  std::vector<int> counts(kBinNum);
+  for (int k = 0; k < kBinNum; ++k) {
+    counts[k] = static_cast<int>(std::round(2000 * std::exp(-k / 150.0))) + (k % 97 == 0 ? 5 : 0);
+  }
+  auto data = BuildData(counts);
+  // the batches of the data, spread over the sessions like the calibration does
+  constexpr size_t kBatchNum = 7;
+  constexpr size_t kSessionNum = 3;
+  const size_t batch_size = (data.size() + kBatchNum - 1) / kBatchNum;
+  auto for_each_batch = [&](const std::function<void(size_t, const float *, size_t)> &func) {
+    for (size_t i = 0; i < kBatchNum; ++i) {
+      size_t begin = std::min(i * batch_size, data.size());
+      size_t end = std::min(begin + batch_size, data.size());
+      func(i, data.data() + begin, end - begin);
+    }
+  };
+
+  auto graph = std::make_shared<FuncGraph>();
+  auto cnode = BuildCNode(graph);
+  Calibrator single("", 8, kQuantMax, kQuantMin);
+  ASSERT_EQ(single.AddQuantizedOp(cnode), RET_OK);
+  auto single_info = single.GetOutputDivergInfo();
+  for_each_batch([&](size_t, const float *batch, size_t size) {
+    single.RecordMaxValue(kOpName, batch, size, single_info);
+  });
+  single.UpdateDivergInverval(single_info);
+  for_each_batch([&](size_t, const float *batch, size_t size) {
+    single.UpdateDataFrequency(kOpName, batch, size, single_info);
+  });
+  ASSERT_EQ(single.ComputeThreshold(), RET_OK);
+
+  Calibrator merged("", 8, kQuantMax, kQuantMin);
+  ASSERT_EQ(merged.AddQuantizedOp(cnode), RET_OK);
+  auto run_sessions = [&](bool update_histogram) {
+    std::vector<DivergInfoMap> input_infos(kSessionNum);
+    std::vector<DivergInfoMap> output_infos(kSessionNum);
+    for (size_t i = 0; i < kSessionNum; ++i) {
+      merged.NewLocalDivergInfo(&input_infos[i], &output_infos[i]);
+    }
+    for_each_batch([&](size_t index, const float *batch, size_t size) {
+      auto info = &output_infos[index % kSessionNum];
+      if (update_histogram) {
+        merged.UpdateDataFrequency(kOpName, batch, size, info);
+      } else {
+        merged.RecordMaxValue(kOpName, batch, size, info);
+      }
+    });
+    for (size_t i = 0; i < kSessionNum; ++i) {
+      merged.MergeDivergInfo(input_infos[i], output_infos[i]);
+    }
+  };
+  run_sessions(false);
+  merged.UpdateDivergInverval(merged.GetOutputDivergInfo());
+  run_sessions(true);
+  ASSERT_EQ(merged.ComputeThreshold(), RET_OK);
+
+  auto single_min_max = single.GetMinMax(single_info).at(cnode);
+  auto merged_min_max = merged.GetMinMax(merged.GetOutputDivergInfo()).at(cnode);
+  EXPECT_EQ(merged_min_max.min, single_min_max.min);
+  EXPECT_EQ(merged_min_max.max, single_min_max.max);
+  EXPECT_FLOAT_EQ(GetScale(&merged, cnode), GetScale(&single, cnode));
+}
+
+TEST_F(PostTrainingTest, TestReadPerChannelConfig) {
+  const std::string config_path = "./post_training_test.cfg";
+  auto read_config = [&config_path](const std::string &content, Calibrator *calibrator) {
+    std::ofstream fs(config_path);
+    fs << content;
+    fs.close();
+    auto status = calibrator->ReadConfig();
+    std::remove(config_path.c_str());
+    return status;
+  };
+
+  Calibrator by_default(config_path, 8, kQuantMax, kQuantMin);
+  ASSERT_EQ(read_config("image_path=./images\nbatch_count=2\nthread_num=4\n", &by_default), RET_OK);
+  EXPECT_FALSE(by_default.GetPerChannel());
+  EXPECT_EQ(by_default.GetThreadNum(), 4u);
+
+  // the int8 kernels do not support per channel quant params yet
+  Calibrator per_channel(config_path, 8, kQuantMax, kQuantMin);
+  EXPECT_EQ(read_config("image_path=./images\nper_channel=true\n", &per_channel), RET_PARAM_INVALID);
+
+  Calibrator per_channel_num(config_path, 8, kQuantMax, kQuantMin);
+  EXPECT_EQ(read_config("per_channel=1\n", &per_channel_num), RET_PARAM_INVALID);
+
+  Calibrator per_layer(config_path, 8, kQuantMax, kQuantMin);
+  ASSERT_EQ(read_config("per_channel=false\n", &per_layer), RET_OK);
+  EXPECT_FALSE(per_layer.GetPerChannel());
+
+  Calibrator invalid(config_path, 8, kQuantMax, kQuantMin);
+  EXPECT_EQ(read_config("per_channel\n", &invalid), RET_PARAM_INVALID);
+}
+}  // namespace quant
+}  // namespace lite
+}  // namespace mindspore
@@ -22,9 +22,15 @@
 #include <algorithm>
 #include <utility>
 #include <cfloat>
+#include <atomic>
+#include <thread>
 #include "src/common/common.h"
 #include "include/ms_tensor.h"
 #include "include/context.h"
+#include "src/runtime/weight_cache.h"
+#ifdef ENABLE_X86_64
+#include "src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#endif
 
 namespace mindspore {
 namespace lite {
@@ -320,6 +326,159 @@ int Benchmark::MarkPerformance() {
   return RET_OK;
 }
 
+session::LiteSession *Benchmark::CreateWorkerSession(Model *model) {
+  lite::Context context;
+  context.device_ctx_.type = lite::DT_CPU;
+  context.cpu_bind_mode_ = NO_BIND;
+  // requests run in parallel across sessions instead of inside one
+  context.thread_num_ = 1;
+  auto *worker = session::LiteSession::CreateSession(&context);
+  if (worker == nullptr) {
+    MS_LOG(ERROR) << "CreateSession failed";
+    return nullptr;
+  }
+  auto ret = worker->CompileGraph(model);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "CompileGraph failed: " << ret;
+    delete worker;
+    return nullptr;
+  }
+  auto inputs = worker->GetInputs();
+  if (!_flags->resizeDims.empty()) {
+    std::vector<std::vector<int>> dims;
+    for (auto &shape : _flags->resizeDims) {
+      dims.emplace_back(shape.begin(), shape.end());
+    }
+    ret = worker->Resize(inputs, dims);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Resize inputs failed: " << ret;
+      delete worker;
+      return nullptr;
+    }
+  }
+  // the same inputs as the benchmark session
+  for (size_t i = 0; i < inputs.size() && i < msInputs.size(); i++) {
+    if (inputs[i]->Size() != msInputs[i]->Size()) {
+      MS_LOG(ERROR) << "Size of input " << i << " is " << inputs[i]->Size() << ", " << msInputs[i]->Size()
+                    << " is expected";
+      delete worker;
+      return nullptr;
+    }
+    memcpy(inputs[i]->MutableData(), msInputs[i]->MutableData(), inputs[i]->Size());
+  }
+  return worker;
+}
+
+int Benchmark::MarkConcurrency(Model *model) {
+  MS_ASSERT(model != nullptr);
+  std::string modelName = _flags->modelPath.substr(_flags->modelPath.find_last_of(DELIM_SLASH) + 1);
+  for (auto concurrency : _flags->concurrencyList) {
+    auto startPrepareTime = GetTimeUs();
+    std::vector<session::LiteSession *> workers;
+    for (int i = 0; i < concurrency; i++) {
+      auto *worker = CreateWorkerSession(model);
+      if (worker == nullptr) {
+        MS_LOG(ERROR) << "Create session " << i << " of " << concurrency << " failed";
+        break;
+      }
+      workers.emplace_back(worker);
+    }
+    auto endPrepareTime = GetTimeUs();
+    if (workers.size() != static_cast<size_t>(concurrency)) {
+      for (auto *worker : workers) {
+        delete worker;
+      }
+      return RET_ERROR;
+    }
+
+    std::atomic_int failed(0);
+    auto run = [&failed](session::LiteSession *worker, int loopCount) {
+      for (int i = 0; i < loopCount; i++) {
+        if (worker->RunGraph() != RET_OK) {
+          failed++;
+          return;
+        }
+      }
+    };
+    for (auto *worker : workers) {
+      run(worker, _flags->warmUpLoopCount);
+    }
+    auto start = GetTimeUs();
+    std::vector<std::thread> threads;
+    for (auto *worker : workers) {
+      threads.emplace_back(run, worker, _flags->loopCount);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto end = GetTimeUs();
+    auto sharedWeightSize = WeightCache::GetInstance()->shared_size();
+    for (auto *worker : workers) {
+      delete worker;
+    }
+    if (failed > 0) {
+      MS_LOG(ERROR) << failed << " of " << concurrency << " sessions failed to run";
+      return RET_ERROR;
+    }
+
+    auto inferences = static_cast<double>(concurrency) * _flags->loopCount;
+    auto throughput = end > start ? inferences * 1000000 / (end - start) : 0;
+    MS_LOG(INFO) << "Model = " << modelName << ", Concurrency = " << concurrency
+                 << ", PrepareTimePerSession = " << (endPrepareTime - startPrepareTime) / 1000.0f / concurrency
+                 << " ms, Throughput = " << throughput << " inferences/s, SharedWeightSize = "
+                 << sharedWeightSize / 1024 << " KB";
+    printf("Model = %s, Concurrency = %d, PrepareTimePerSession = %f ms, Throughput = %f inferences/s, "
+           "SharedWeightSize = %zu KB\n",
+           modelName.c_str(), concurrency, (endPrepareTime - startPrepareTime) / 1000.0f / concurrency, throughput,
+           sharedWeightSize / 1024);
+  }
+  return RET_OK;
+}
+
+int Benchmark::MarkProfile() {
+  KernelProfiler profiler(_flags->numThreads, profileAllocator);
+  auto status = profiler.Init();
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "Init kernel profiler failed: " << status;
+    return status;
+  }
+  for (int i = 0; i < _flags->warmUpLoopCount; i++) {
+    status = session->RunGraph(profiler.before_call_back(), profiler.after_call_back());
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Inference error " << status;
+      return status;
+    }
+  }
+  profiler.Clear();
+  for (int i = 0; i < _flags->loopCount; i++) {
+    session->BindThread(true);
+    status = session->RunGraph(profiler.before_call_back(), profiler.after_call_back());
+    session->BindThread(false);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Inference error " << status;
+      return status;
+    }
+  }
+
+  RooflinePeak peak;
+  peak.gflops = _flags->peakGflops;
+  peak.bandwidth = _flags->peakBandwidth;
+  profiler.PrintReport(peak);
+  const std::vector<std::pair<std::string, std::string>> files = {
+    {_flags->profilePath + ".csv", profiler.Csv(peak)}, {_flags->profilePath + ".trace.json", profiler.ChromeTrace()}};
+  for (const auto &file : files) {
+    std::ofstream ofs(file.first, std::ios::trunc | std::ios::out);
+    if (!ofs.is_open()) {
+      MS_LOG(ERROR) << "Open file " << file.first << " failed";
+      return RET_ERROR;
+    }
+    ofs << file.second;
+    ofs.close();
+    MS_LOG(INFO) << "Save the kernel profile to " << file.first;
+  }
+  return RET_OK;
+}
+
 int Benchmark::MarkAccuracy() {
   MS_LOG(INFO) << "MarkAccuracy";
   for (size_t i = 0; i < msInputs.size(); i++) {
@@ -357,20 +516,12 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
   // Load graph
   std::string modelName = _flags->modelPath.substr(_flags->modelPath.find_last_of(DELIM_SLASH) + 1);
 
-  MS_LOG(INFO) << "start reading model file";
-  size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOG(ERROR) << "Read model file failed while running %s", modelName.c_str();
-    return RET_ERROR;
-  }
-  auto model = lite::Model::Import(graphBuf, size);
+  MS_LOG(INFO) << "start mapping model file";
+  auto model = lite::Model::ImportFromFile(_flags->modelPath.c_str());
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model file failed while running %s", modelName.c_str();
-    delete[](graphBuf);
     return RET_ERROR;
   }
-  delete[](graphBuf);
   auto context = new(std::nothrow) lite::Context;
   if (context == nullptr) {
     MS_LOG(ERROR) << "New context failed while running %s", modelName.c_str();
@@ -392,6 +543,11 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
     context->cpu_bind_mode_ = NO_BIND;
   }
   context->thread_num_ = _flags->numThreads;
+  if (!_flags->profilePath.empty()) {
+    profileAllocator = std::make_shared<ProfileAllocator>();
+    context->allocator = profileAllocator;
+  }
+  auto contextType = context->device_ctx_.type;
   session = session::LiteSession::CreateSession(context);
   delete(context);
   if (session == nullptr) {
@@ -405,6 +561,18 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
     return ret;
   }
   msInputs = session->GetInputs();
+  if (!_flags->resizeDims.empty()) {
+    std::vector<std::vector<int>> dims;
+    for (auto &shape : _flags->resizeDims) {
+      dims.emplace_back(shape.begin(), shape.end());
+    }
+    ret = session->Resize(msInputs, dims);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Resize inputs failed while running " << modelName.c_str();
+      delete(session);
+      return ret;
+    }
+  }
   auto endPrepareTime = GetTimeUs();
 #if defined(__arm__)
   MS_LOG(INFO) << "PrepareTime = " << (endPrepareTime - startPrepareTime) / 1000 << " ms";
@@ -437,6 +605,30 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
       return status;
     }
   }
+  if (!_flags->profilePath.empty()) {
+    if (contextType != lite::DT_CPU) {
+      MS_LOG(WARNING) << "Kernels are only profiled on CPU";
+    } else {
+      status = MarkProfile();
+      if (status != 0) {
+        MS_LOG(ERROR) << "Run MarkProfile error: " << status;
+        delete(session);
+        return status;
+      }
+    }
+  }
+  if (!_flags->concurrencyList.empty()) {
+    if (contextType != lite::DT_CPU) {
+      MS_LOG(WARNING) << "Concurrency is only measured on CPU";
+    } else {
+      status = MarkConcurrency(model.get());
+      if (status != 0) {
+        MS_LOG(ERROR) << "Run MarkConcurrency error: " << status;
+        delete(session);
+        return status;
+      }
+    }
+  }
 
   if (cleanData) {
     for (auto &data : calibData) {
@@ -482,6 +674,12 @@ void BenchmarkFlags::InitResizeDimsList() {
   }
 }
 
+void BenchmarkFlags::InitConcurrencyList() {
+  for (const auto &concurrencyStr : StringSplit(this->concurrencyIn, std::string(DELIM_COMMA))) {
+    this->concurrencyList.emplace_back(std::stoi(concurrencyStr));
+  }
+}
+
 int Benchmark::Init() {
   if (this->_flags == nullptr) {
     return 1;
@@ -495,6 +693,7 @@ int Benchmark::Init() {
   MS_LOG(INFO) << "WarmUpLoopCount = " << this->_flags->warmUpLoopCount;
   MS_LOG(INFO) << "NumThreads = " << this->_flags->numThreads;
   MS_LOG(INFO) << "calibDataPath = " << this->_flags->calibDataPath;
+  MS_LOG(INFO) << "profilePath = " << this->_flags->profilePath;
   if (this->_flags->cpuBindMode == -1) {
     MS_LOG(INFO) << "cpuBindMode = MID_CPU";
   } else if (this->_flags->cpuBindMode == 1) {
@@ -502,6 +701,19 @@ int Benchmark::Init() {
   } else {
     MS_LOG(INFO) << "cpuBindMode = NO_BIND";
   }
+#ifdef ENABLE_X86_64
+  if (this->_flags->simdLevel == "NONE") {
+    X86SetSimdLevel(X86SimdLevel_None);
+  } else if (this->_flags->simdLevel == "AVX2") {
+    X86SetSimdLevel(X86SimdLevel_Avx2);
+  } else if (this->_flags->simdLevel == "AVX512_VNNI") {
+    X86SetSimdLevel(X86SimdLevel_Avx512Vnni);
+  } else {
+    MS_LOG(ERROR) << "simdLevel should be NONE, AVX2 or AVX512_VNNI, but got " << this->_flags->simdLevel;
+    return RET_ERROR;
+  }
+  MS_LOG(INFO) << "simdLevel = " << X86SimdLevelName(X86GetSimdLevel());
+#endif
 
   this->_flags->inDataType = this->_flags->inDataTypeIn == "img" ? kImage : kBinary;
 
@@ -515,6 +727,17 @@ int Benchmark::Init() {
     MS_LOG(ERROR) << "Size of input resizeDims should be equal to size of input inDataPath";
     return RET_ERROR;
   }
+  _flags->InitConcurrencyList();
+  for (auto concurrency : _flags->concurrencyList) {
+    if (concurrency <= 0) {
+      MS_LOG(ERROR) << "concurrency should be positive, but got " << concurrency;
+      return RET_ERROR;
+    }
+  }
+  if (_flags->peakGflops < 0 || _flags->peakBandwidth < 0) {
+    MS_LOG(ERROR) << "peakGflops and peakBandwidth should not be negative";
+    return RET_ERROR;
+  }
 
   return RET_OK;
 }
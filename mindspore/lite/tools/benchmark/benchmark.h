@@ -33,6 +33,7 @@
 #include "include/model.h"
 #include "include/lite_session.h"
 #include "include/inference.h"
+#include "tools/benchmark/kernel_profiler.h"
 
 namespace mindspore::lite {
 enum MS_API InDataType { kImage = 0, kBinary = 1 };
@@ -64,11 +65,24 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loopCount, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::warmUpLoopCount, "warmUpLoopCount", "Run warm up loop", 3);
+    AddFlag(&BenchmarkFlags::simdLevel, "simdLevel",
+            "SIMD kernels on x86-64, capped by the cpu. NONE | AVX2 | AVX512_VNNI", "AVX512_VNNI");
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::calibDataPath, "calibDataPath", "Calibration data file path", "");
     AddFlag(&BenchmarkFlags::accuracyThreshold, "accuracyThreshold", "Threshold of accuracy", 0.5);
     // Resize
     AddFlag(&BenchmarkFlags::resizeDimsIn, "resizeDims", "Dims to resize to", "");
+    // MarkConcurrency
+    AddFlag(&BenchmarkFlags::concurrencyIn, "concurrency",
+            "Numbers of single threaded sessions running the model at the same time to measure throughput, e.g. 1,2,4",
+            "");
+    // MarkProfile
+    AddFlag(&BenchmarkFlags::profilePath, "profilePath",
+            "Path prefix of the per kernel profile, <profilePath>.csv and <profilePath>.trace.json are written if set",
+            "");
+    AddFlag(&BenchmarkFlags::peakGflops, "peakGflops", "Peak GFLOP/s of the cpu for the roofline of the profile", 0.0);
+    AddFlag(&BenchmarkFlags::peakBandwidth, "peakBandwidth", "Peak GB/s of the memory for the roofline of the profile",
+            0.0);
   }
 
   ~BenchmarkFlags() override = default;
@@ -77,6 +91,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
 
   void InitResizeDimsList();
 
+  void InitConcurrencyList();
+
  public:
   // common
   std::string modelPath;
@@ -89,12 +105,20 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loopCount;
   int numThreads;
   int warmUpLoopCount;
+  std::string simdLevel;
   // MarkAccuracy
   std::string calibDataPath;
   float accuracyThreshold;
   // Resize
   std::string resizeDimsIn;
   std::vector<std::vector<int64_t>> resizeDims;
+  // MarkConcurrency
+  std::string concurrencyIn;
+  std::vector<int> concurrencyList;
+  // MarkProfile
+  std::string profilePath;
+  double peakGflops;
+  double peakBandwidth;
 
   std::string omModelPath;
   std::string device;
@@ -131,6 +155,15 @@ class MS_API Benchmark {
 
   int MarkAccuracy();
 
+  // Throughput of sessions sharing the weights of model, each runs loopCount times on a thread of its own.
+  int MarkConcurrency(Model *model);
+
+  session::LiteSession *CreateWorkerSession(Model *model);
+
+  // Per kernel time percentiles, estimated flops and bytes against the roofline, and allocator activity of loopCount
+  // runs.
+  int MarkProfile();
+
  private:
   BenchmarkFlags *_flags;
   session::LiteSession *session;
@@ -138,6 +171,7 @@ class MS_API Benchmark {
   std::unordered_map<std::string, std::vector<mindspore::tensor::MSTensor *>> msOutputs;
   std::unordered_map<std::string, CheckTensor *> calibData;
   bool cleanData = true;
+  std::shared_ptr<ProfileAllocator> profileAllocator;
 };
 
 int MS_API RunBenchmark(int argc, const char **argv);
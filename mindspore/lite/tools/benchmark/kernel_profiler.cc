@@ -0,0 +1,313 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/benchmark/kernel_profiler.h"
+#define __STDC_FORMAT_MACROS
+#include <cinttypes>
+#undef __STDC_FORMAT_MACROS
+#include <time.h>
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr double kBytesPerGB = 1e9;
+constexpr double kFlopsPerGFlop = 1e9;
+
+double GetCpuTimeUs() {
+  struct timespec ts {};
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+    return 0;
+  }
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+double ElementsNum(const std::vector<tensor::MSTensor *> &tensors, size_t index) {
+  if (index >= tensors.size() || tensors[index] == nullptr) {
+    return 0;
+  }
+  return tensors[index]->ElementsNum();
+}
+
+// the channel of the NHWC shape
+double Channel(const std::vector<tensor::MSTensor *> &tensors, size_t index) {
+  if (index >= tensors.size() || tensors[index] == nullptr || tensors[index]->shape().empty()) {
+    return 0;
+  }
+  return tensors[index]->shape().back();
+}
+
+// nearest rank of the sorted times
+double Percentile(const std::vector<double> &sorted_times, int percent) {
+  if (sorted_times.empty()) {
+    return 0;
+  }
+  auto rank = (sorted_times.size() * percent + 99) / 100;
+  return sorted_times.at(std::max<size_t>(rank, 1) - 1);
+}
+
+double Mean(const std::vector<double> &times) {
+  if (times.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (auto time : times) {
+    sum += time;
+  }
+  return sum / times.size();
+}
+
+std::string CsvString(const std::string &str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string quoted = "\"";
+  for (auto c : str) {
+    quoted += c == '"' ? "\"\"" : std::string(1, c);
+  }
+  return quoted + "\"";
+}
+
+std::string JsonString(const std::string &str) {
+  std::ostringstream oss;
+  oss << '"';
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      oss << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      oss << c;
+    }
+  }
+  oss << '"';
+  return oss.str();
+}
+
+struct KernelSummary {
+  double mean = 0;
+  double min = 0;
+  double max = 0;
+  double p50 = 0;
+  double p90 = 0;
+  double p99 = 0;
+  double gflops = 0;
+  double bandwidth = 0;
+  double intensity = 0;
+  double thread_util = 0;
+  // achieved over the attainable gflops of the roofline, 0 if there is no peak
+  double efficiency = 0;
+  std::string bound;
+};
+
+KernelSummary Summarize(const KernelRecord &record, int thread_num, const RooflinePeak &peak) {
+  KernelSummary summary;
+  auto times = record.times;
+  std::sort(times.begin(), times.end());
+  summary.mean = Mean(times);
+  summary.min = times.empty() ? 0 : times.front();
+  summary.max = times.empty() ? 0 : times.back();
+  summary.p50 = Percentile(times, 50);
+  summary.p90 = Percentile(times, 90);
+  summary.p99 = Percentile(times, 99);
+  if (summary.mean > 0) {
+    summary.gflops = record.cost.flops / (summary.mean * 1e-6) / kFlopsPerGFlop;
+    summary.bandwidth = record.cost.bytes / (summary.mean * 1e-6) / kBytesPerGB;
+    summary.thread_util = record.cpu_time / (summary.mean * times.size() * std::max(thread_num, 1));
+  }
+  summary.intensity = record.cost.bytes > 0 ? record.cost.flops / record.cost.bytes : 0;
+  if (peak.gflops > 0 && peak.bandwidth > 0) {
+    auto memory_roof = summary.intensity * peak.bandwidth;
+    summary.bound = memory_roof < peak.gflops ? "memory" : "compute";
+    auto attainable = std::min(memory_roof, peak.gflops);
+    summary.efficiency = attainable > 0 ? summary.gflops / attainable : 0;
+  }
+  return summary;
+}
+}  // namespace
+
+void *ProfileAllocator::Malloc(size_t size) {
+  malloc_count_++;
+  malloc_bytes_ += size;
+  return allocator_->Malloc(size);
+}
+
+void ProfileAllocator::Free(void *ptr) {
+  if (ptr != nullptr) {
+    free_count_++;
+  }
+  allocator_->Free(ptr);
+}
+
+KernelCost EstimateKernelCost(const std::string &type, const std::vector<tensor::MSTensor *> &inputs,
+                              const std::vector<tensor::MSTensor *> &outputs) {
+  KernelCost cost;
+  for (auto tensor : inputs) {
+    cost.bytes += tensor == nullptr ? 0 : tensor->Size();
+  }
+  for (auto tensor : outputs) {
+    cost.bytes += tensor == nullptr ? 0 : tensor->Size();
+  }
+  auto input_num = ElementsNum(inputs, 0);
+  auto output_num = ElementsNum(outputs, 0);
+  if (type == "Conv2D" || type == "DepthwiseConv2D" || type == "FullConnection") {
+    // each output element is a dot product of the weight elements of its channel
+    auto channel = Channel(outputs, 0);
+    cost.flops = channel > 0 ? 2 * output_num * ElementsNum(inputs, 1) / channel : 0;
+  } else if (type == "DeConv2D" || type == "DeDepthwiseConv2D") {
+    // each input element is scattered by the weight elements of its channel
+    auto channel = Channel(inputs, 0);
+    cost.flops = channel > 0 ? 2 * input_num * ElementsNum(inputs, 1) / channel : 0;
+  } else if (type == "MatMul") {
+    // the depth is the elements of a row of the first input, which has as many rows as the output
+    auto channel = Channel(outputs, 0);
+    auto depth = output_num > 0 ? input_num * channel / output_num : 0;
+    cost.flops = 2 * output_num * depth;
+  } else if (type == "Pooling" || type == "Reduce" || type == "Mean" || type == "ArgMax" || type == "ArgMin") {
+    cost.flops = input_num;
+  } else if (type == "SoftMax" || type == "LayerNorm") {
+    // max or mean, sub, exp or square, sum and div, with the scale and shift of layer norm
+    cost.flops = 5 * input_num;
+  } else if (type == "BatchNorm" || type == "FusedBatchNorm" || type == "Scale") {
+    cost.flops = 2 * output_num;
+  } else {
+    cost.flops = output_num;
+  }
+  return cost;
+}
+
+int KernelProfiler::Init() {
+  if (allocator_ == nullptr) {
+    MS_LOG(ERROR) << "allocator of the kernel profiler is nullptr";
+    return RET_NULL_PTR;
+  }
+  before_call_back_ = [&](const std::vector<mindspore::tensor::MSTensor *> &before_inputs,
+                          const std::vector<mindspore::tensor::MSTensor *> &before_outputs,
+                          const session::CallBackParam &call_param) {
+    op_malloc_count_ = allocator_->malloc_count();
+    op_malloc_bytes_ = allocator_->malloc_bytes();
+    op_cpu_begin_ = GetCpuTimeUs();
+    op_begin_ = std::chrono::steady_clock::now();
+    return true;
+  };
+  after_call_back_ = [&](const std::vector<mindspore::tensor::MSTensor *> &after_inputs,
+                         const std::vector<mindspore::tensor::MSTensor *> &after_outputs,
+                         const session::CallBackParam &call_param) {
+    auto op_end = std::chrono::steady_clock::now();
+    auto cpu_time = GetCpuTimeUs() - op_cpu_begin_;
+    auto record = GetRecord(call_param, after_inputs, after_outputs);
+    auto duration = std::chrono::duration<double, std::micro>(op_end - op_begin_).count();
+    record->times.emplace_back(duration);
+    record->cpu_time += cpu_time;
+    record->malloc_count += allocator_->malloc_count() - op_malloc_count_;
+    record->malloc_bytes += allocator_->malloc_bytes() - op_malloc_bytes_;
+    auto start = std::chrono::duration<double, std::micro>(op_begin_ - begin_time_).count();
+    events_.push_back({static_cast<size_t>(record - records_.data()), start, duration});
+    return true;
+  };
+  return RET_OK;
+}
+
+void KernelProfiler::Clear() {
+  records_.clear();
+  record_index_.clear();
+  events_.clear();
+  begin_time_ = std::chrono::steady_clock::now();
+}
+
+KernelRecord *KernelProfiler::GetRecord(const session::CallBackParam &op_info,
+                                        const std::vector<tensor::MSTensor *> &inputs,
+                                        const std::vector<tensor::MSTensor *> &outputs) {
+  auto iter = record_index_.find(op_info.name_callback_param);
+  if (iter != record_index_.end()) {
+    return &records_.at(iter->second);
+  }
+  KernelRecord record;
+  record.name = op_info.name_callback_param;
+  record.type = op_info.type_callback_param;
+  // the shapes do not change between runs, the cost is estimated once
+  record.cost = EstimateKernelCost(record.type, inputs, outputs);
+  record_index_[record.name] = records_.size();
+  records_.emplace_back(record);
+  return &records_.back();
+}
+
+std::string KernelProfiler::Csv(const RooflinePeak &peak) const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3);
+  oss << "name,type,runs,mean_us,min_us,max_us,p50_us,p90_us,p99_us,mflops,kbytes,flops_per_byte,gflops,gbps,"
+         "thread_util,mallocs_per_run,malloc_kbytes_per_run,bound,roofline_efficiency\n";
+  for (const auto &record : records_) {
+    auto summary = Summarize(record, thread_num_, peak);
+    auto runs = std::max<size_t>(record.times.size(), 1);
+    oss << CsvString(record.name) << "," << CsvString(record.type) << "," << record.times.size() << "," << summary.mean
+        << "," << summary.min << "," << summary.max << "," << summary.p50 << "," << summary.p90 << "," << summary.p99
+        << "," << record.cost.flops / 1e6 << "," << record.cost.bytes / 1024 << "," << summary.intensity << ","
+        << summary.gflops << "," << summary.bandwidth << "," << summary.thread_util << ","
+        << static_cast<double>(record.malloc_count) / runs << ","
+        << static_cast<double>(record.malloc_bytes) / 1024 / runs << "," << summary.bound << ","
+        << summary.efficiency << "\n";
+  }
+  return oss.str();
+}
+
+std::string KernelProfiler::ChromeTrace() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3);
+  oss << "{\"traceEvents\": [\n";
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const auto &event = events_[i];
+    const auto &record = records_.at(event.record);
+    oss << "  {\"name\": " << JsonString(record.name) << ", \"cat\": " << JsonString(record.type)
+        << ", \"ph\": \"X\", \"ts\": " << event.start << ", \"dur\": " << event.duration
+        << ", \"pid\": 1, \"tid\": 1, \"args\": {\"mflops\": " << record.cost.flops / 1e6
+        << ", \"kbytes\": " << record.cost.bytes / 1024 << "}}" << (i + 1 < events_.size() ? ",\n" : "\n");
+  }
+  oss << "], \"displayTimeUnit\": \"ms\"}\n";
+  return oss.str();
+}
+
+void KernelProfiler::PrintReport(const RooflinePeak &peak) const {
+  std::vector<std::pair<const KernelRecord *, KernelSummary>> summaries;
+  double total_time = 0;
+  for (const auto &record : records_) {
+    summaries.emplace_back(&record, Summarize(record, thread_num_, peak));
+    total_time += summaries.back().second.mean;
+  }
+  std::sort(summaries.begin(), summaries.end(),
+            [](const std::pair<const KernelRecord *, KernelSummary> &a,
+               const std::pair<const KernelRecord *, KernelSummary> &b) { return a.second.mean > b.second.mean; });
+  printf("-------------------------------------------------------------------------\n");
+  printf("%-40s %-18s %10s %10s %10s %8s %10s %8s %8s %8s\n", "opName", "opType", "p50(us)", "p99(us)", "percent",
+         "GFLOP/s", "GB/s", "util", "mallocs", "roofline");
+  for (const auto &item : summaries) {
+    const auto &record = *item.first;
+    const auto &summary = item.second;
+    auto runs = std::max<size_t>(record.times.size(), 1);
+    printf("%-40s %-18s %10.3f %10.3f %10.4f %8.3f %10.3f %8.3f %8.1f %8.3f\n", record.name.c_str(),
+           record.type.c_str(), summary.p50, summary.p99, total_time > 0 ? summary.mean / total_time : 0,
+           summary.gflops, summary.bandwidth, summary.thread_util, static_cast<double>(record.malloc_count) / runs,
+           summary.efficiency);
+  }
+  printf("\n kernel cost: %5.5f ms, allocator: %" PRIu64 " mallocs of %" PRIu64 " KB, %" PRIu64 " frees in total\n",
+         total_time / 1000, allocator_->malloc_count(), allocator_->malloc_bytes() / 1024, allocator_->free_count());
+  printf("-------------------------------------------------------------------------\n");
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINNIE_BENCHMARK_KERNEL_PROFILER_H_
+#define MINNIE_BENCHMARK_KERNEL_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "include/lite_session.h"
+#include "include/ms_tensor.h"
+#include "src/runtime/allocator.h"
+
+namespace mindspore::lite {
+// Counts the buffers a session takes from its allocator, the allocations made while a kernel runs are on its hot path.
+class ProfileAllocator : public Allocator {
+ public:
+  ProfileAllocator() : allocator_(Allocator::Create()) { name = "profile"; }
+  ~ProfileAllocator() override = default;
+
+  void *Malloc(size_t size) override;
+  void Free(void *ptr) override;
+  void SetContext(const AllocatorContext &ctx) override { allocator_->SetContext(ctx); }
+  size_t GetTotalSize() override { return allocator_->GetTotalSize(); }
+  void Clear() override { allocator_->Clear(); }
+
+  uint64_t malloc_count() const { return malloc_count_; }
+  uint64_t malloc_bytes() const { return malloc_bytes_; }
+  uint64_t free_count() const { return free_count_; }
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+  std::atomic<uint64_t> malloc_count_{0};
+  std::atomic<uint64_t> malloc_bytes_{0};
+  std::atomic<uint64_t> free_count_{0};
+};
+
+struct KernelCost {
+  double flops = 0;
+  // bytes of the input, weight and output tensors, each read or written once
+  double bytes = 0;
+};
+
+// The work of a kernel estimated from the shapes of its tensors, the weights carry the kernel sizes of convolutions and
+// matmuls. Ops with no arithmetic to speak of count one flop per output element.
+KernelCost EstimateKernelCost(const std::string &type, const std::vector<tensor::MSTensor *> &inputs,
+                              const std::vector<tensor::MSTensor *> &outputs);
+
+struct KernelRecord {
+  std::string name;
+  std::string type;
+  KernelCost cost;
+  // microseconds of each run
+  std::vector<double> times;
+  // microseconds of cpu time of the process, summed over the runs
+  double cpu_time = 0;
+  uint64_t malloc_count = 0;
+  uint64_t malloc_bytes = 0;
+};
+
+// Peaks of the target cpu for the roofline, the efficiency of kernels is not reported if they are 0.
+struct RooflinePeak {
+  double gflops = 0;
+  double bandwidth = 0;
+};
+
+// Records the wall time, cpu time and allocator activity of each kernel through the callbacks of RunGraph, runs of a
+// kernel are kept apart so their percentiles can be reported.
+class KernelProfiler {
+ public:
+  KernelProfiler(int thread_num, std::shared_ptr<ProfileAllocator> allocator)
+      : thread_num_(thread_num), allocator_(std::move(allocator)) {}
+  ~KernelProfiler() = default;
+
+  const session::KernelCallBack &before_call_back() const { return before_call_back_; }
+  const session::KernelCallBack &after_call_back() const { return after_call_back_; }
+  int Init();
+  void Clear();
+
+  // kernels in the order they ran first
+  const std::vector<KernelRecord> &records() const { return records_; }
+  std::string Csv(const RooflinePeak &peak) const;
+  // The runs in the Chrome trace event format, which can be loaded by chrome://tracing.
+  std::string ChromeTrace() const;
+  void PrintReport(const RooflinePeak &peak) const;
+
+ private:
+  struct TraceEvent {
+    size_t record;
+    double start;
+    double duration;
+  };
+
+  KernelRecord *GetRecord(const session::CallBackParam &op_info, const std::vector<tensor::MSTensor *> &inputs,
+                          const std::vector<tensor::MSTensor *> &outputs);
+
+  int thread_num_;
+  std::shared_ptr<ProfileAllocator> allocator_;
+  std::vector<KernelRecord> records_;
+  std::unordered_map<std::string, size_t> record_index_;
+  std::vector<TraceEvent> events_;
+  std::chrono::steady_clock::time_point begin_time_ = std::chrono::steady_clock::now();
+
+  // state of the kernel running
+  std::chrono::steady_clock::time_point op_begin_;
+  double op_cpu_begin_ = 0;
+  uint64_t op_malloc_count_ = 0;
+  uint64_t op_malloc_bytes_ = 0;
+
+  session::KernelCallBack before_call_back_;
+  session::KernelCallBack after_call_back_;
+};
+}  // namespace mindspore::lite
+#endif  // MINNIE_BENCHMARK_KERNEL_PROFILER_H_
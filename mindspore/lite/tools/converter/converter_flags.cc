@@ -38,6 +38,8 @@ Flags::Flags() {
   AddFlag(&Flags::quantSize, "quantSize", "Weight quantization size threshold", "0");
   AddFlag(&Flags::configFile, "config_file", "Configuration for post-training.", "");
   AddFlag(&Flags::formatTrans, "formatTrans", "whether transform format. true | false", "true");
+  AddFlag(&Flags::prepackWeight, "prepackWeight",
+          "whether store conv weights packed for the cpu kernels besides the original ones. true | false", "false");
 }
 
 int Flags::Init(int argc, const char **argv) {
@@ -26,6 +26,7 @@
 #include "tools/converter/legacy_optimizer/fusion/conv_relu_fusion_pass.h"
 #include "tools/converter/legacy_optimizer/fusion/conv_relu6_fusion_pass.h"
 #include "tools/converter/legacy_optimizer/fusion/conv_biasadd_fusion_pass.h"
+#include "tools/converter/legacy_optimizer/fusion/composite_fusion_pass.h"
 // #include "tools/converter/legacy_optimizer/fusion/matmul_biasadd_fusion_pass.h"
 #include "tools/converter/legacy_optimizer/fusion/format_trans_fusion_pass.h"
 // #include "tools/converter/legacy_optimizer/fusion/quant_cast_fusion_pass.h"
@@ -52,6 +53,7 @@
 #include "tools/converter/legacy_optimizer/graph/isolated_node_remove_pass.h"
 #include "tools/converter/legacy_optimizer/graph/unused_node_remove_pass.h"
 #include "tools/converter/legacy_optimizer/graph/topological_sort_pass.h"
+#include "tools/converter/legacy_optimizer/graph/weight_prepack_pass.h"
 
 #include "tools/converter/converter.h"
 
@@ -107,6 +109,7 @@ int GraphDefTransform::Transform(const converter::Flags &ctx) {
     fusionOptimizer.AddPass(new (std::nothrow) ConvScaleFusionPass());
     fusionOptimizer.AddPass(new (std::nothrow) ConvReluFusionPass());
     fusionOptimizer.AddPass(new (std::nothrow) ConvRelu6FusionPass());
+    fusionOptimizer.AddPass(new (std::nothrow) CompositeFusionPass());
     fusionOptimizer.AddPass(new (std::nothrow) IsolatedNodeRemovePass());
     status = fusionOptimizer.Run(graphDefT);
     if (status != RET_OK && status != RET_NO_CHANGE) {
@@ -166,6 +169,21 @@ int GraphDefTransform::Transform(const converter::Flags &ctx) {
       return status;
     }
   }
+
+  // weight prepack, after the weight format trans
+  if (ctx.prepackWeight) {
+    if (!ctx.formatTrans) {
+      MS_LOG(WARNING) << "prepackWeight needs formatTrans, weights are not prepacked";
+    } else {
+      Optimizer weightPrepackOptimizer;
+      weightPrepackOptimizer.AddPass(new (std::nothrow) WeightPrepackPass());
+      status = weightPrepackOptimizer.Run(graphDefT);
+      if (status != RET_OK && status != RET_NO_CHANGE) {
+        MS_LOG(ERROR) << "Run weightPrepackOptimizer graphPasses Failed";
+        return status;
+      }
+    }
+  }
   // topological sorting
   {
     Optimizer topologicalOptimizer;
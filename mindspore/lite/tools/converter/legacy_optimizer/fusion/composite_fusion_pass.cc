@@ -0,0 +1,542 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/fusion/composite_fusion_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/utils.h"
+#include "tools/common/graph_util.h"
+#include "tools/common/tensor_util.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr float kGeluCoeff = 0.044715f;
+constexpr float kGeluSqrtTwoOverPi = 0.7978845608f;
+
+bool IsConstFloat(const schema::TensorT &tensor) {
+  return tensor.nodeType == schema::NodeType_ValueNode && tensor.dataType == kNumberTypeFloat32 &&
+         tensor.data.size() >= sizeof(float);
+}
+
+// the index in inputIndex of the only constant input of a node with two inputs, -1 if there is not
+int GetConstInputIdx(const schema::MetaGraphT &graph, const schema::CNodeT &node) {
+  if (node.inputIndex.size() != 2) {
+    return -1;
+  }
+  bool firstConst = IsConstFloat(*graph.allTensors.at(node.inputIndex[0]));
+  bool secondConst = IsConstFloat(*graph.allTensors.at(node.inputIndex[1]));
+  if (firstConst == secondConst) {
+    return -1;
+  }
+  return firstConst ? 0 : 1;
+}
+
+bool ValuesEqual(const schema::TensorT &tensor, float value) {
+  auto data = reinterpret_cast<const float *>(tensor.data.data());
+  size_t num = tensor.data.size() / sizeof(float);
+  return std::all_of(data, data + num, [value](float elem) {
+    return std::fabs(elem - value) <= 1e-4f * std::max(1.0f, std::fabs(value));
+  });
+}
+
+// whether all the elements of the constant input of node are value
+bool ConstInputEqual(const schema::MetaGraphT &graph, const schema::CNodeT &node, float value) {
+  auto constIdx = GetConstInputIdx(graph, node);
+  return constIdx >= 0 && ValuesEqual(*graph.allTensors.at(node.inputIndex[constIdx]), value);
+}
+
+bool PowerExponentEqual(const schema::MetaGraphT &graph, const schema::CNodeT &node, float exponent) {
+  auto attr = node.primitive->value.AsPower();
+  // pow(scale * x + shift, power)
+  if (attr != nullptr && (attr->scale != 1.0f || attr->shift != 0.0f)) {
+    return false;
+  }
+  if (node.inputIndex.size() == 2) {
+    auto &expTensor = graph.allTensors.at(node.inputIndex[1]);
+    return IsConstFloat(*expTensor) && ValuesEqual(*expTensor, exponent);
+  }
+  return attr != nullptr && node.inputIndex.size() == 1 && attr->power == exponent;
+}
+
+// the axes reduced by a mean which keeps the dims
+bool GetMeanAxes(const schema::CNodeT &node, std::vector<int32_t> *axes) {
+  auto &value = node.primitive->value;
+  if (value.type == schema::PrimitiveType_Mean && value.AsMean() != nullptr && value.AsMean()->keepDims) {
+    *axes = value.AsMean()->axis;
+  } else if (value.type == schema::PrimitiveType_Reduce && value.AsReduce() != nullptr &&
+             value.AsReduce()->mode == schema::ReduceMode_ReduceMean && value.AsReduce()->keepDims) {
+    *axes = value.AsReduce()->axes;
+  } else {
+    return false;
+  }
+  return !axes->empty();
+}
+
+// the normalized axes should be the last ones of input, returns the first of them as a negative axis, 0 if they are not
+int32_t GetBeginNormAxis(std::vector<int32_t> axes, size_t rank) {
+  for (auto &axis : axes) {
+    if (axis >= 0) {
+      if (rank == 0) {
+        return 0;
+      }
+      axis -= static_cast<int32_t>(rank);
+    }
+  }
+  std::sort(axes.begin(), axes.end());
+  for (size_t i = 0; i < axes.size(); i++) {
+    if (axes[i] != static_cast<int32_t>(i) - static_cast<int32_t>(axes.size())) {
+      return 0;
+    }
+  }
+  return axes.front();
+}
+
+// the Add, Sub, Mul and Div parsers may fold an activation into the op, such a node is not just the arithmetic the
+// patterns replace
+bool HasActivation(const schema::CNodeT &node) {
+  auto &value = node.primitive->value;
+  int activationType = schema::ActivationType_NO_ACTIVATION;
+  if (value.AsAdd() != nullptr) {
+    activationType = value.AsAdd()->activationType;
+  } else if (value.AsSub() != nullptr) {
+    activationType = value.AsSub()->activationType;
+  } else if (value.AsMul() != nullptr) {
+    activationType = value.AsMul()->activationType;
+  } else if (value.AsDiv() != nullptr) {
+    activationType = value.AsDiv()->activationType;
+  }
+  return activationType != schema::ActivationType_NO_ACTIVATION;
+}
+
+bool AnyHasActivation(const schema::MetaGraphT &graph,
+                      std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath,
+                      const std::vector<std::string> &patternOpNames) {
+  return std::any_of(patternOpNames.begin(), patternOpNames.end(), [&graph, &matchedPath](const std::string &name) {
+    return HasActivation(*graph.nodes.at(matchedPath[name]->nodeIdx));
+  });
+}
+
+// the LayerNorm kernel scales and shifts each element of the normalized dims by an element of gamma and beta, a scalar
+// is broadcast to them. Returns whether the constant fits, with the dims to broadcast it to, if it has to be.
+bool AffineTensorFits(const schema::TensorT &tensor, const std::vector<int32_t> &inputDims, int32_t beginNormAxis,
+                      std::vector<int32_t> *broadcastDims) {
+  size_t elemNum = tensor.data.size() / sizeof(float);
+  auto normAxisNum = static_cast<size_t>(-beginNormAxis);
+  std::vector<int32_t> normDims;
+  if (inputDims.size() >= normAxisNum) {
+    normDims.assign(inputDims.end() - normAxisNum, inputDims.end());
+  }
+  if (normDims.empty() || std::any_of(normDims.begin(), normDims.end(), [](int32_t dim) { return dim <= 0; })) {
+    // the shape of the input is not known, only constants shaped like the normalized dims are taken
+    return elemNum > 1 && tensor.dims.size() == normAxisNum;
+  }
+  if (elemNum == GetShapeSize(normDims)) {
+    return true;
+  }
+  if (elemNum != 1) {
+    return false;
+  }
+  *broadcastDims = normDims;
+  return true;
+}
+
+// broadcast a scalar constant to dims, into a copy if other nodes use it too, returns the index of the broadcast one
+STATUS BroadcastTensor(schema::MetaGraphT *graph, const std::vector<int32_t> &dims, uint32_t *tensorIdx) {
+  auto &tensor = graph->allTensors.at(*tensorIdx);
+  auto value = *reinterpret_cast<const float *>(tensor->data.data());
+  std::vector<float> broadcast(GetShapeSize(dims), value);
+  std::unique_ptr<schema::TensorT> copied;
+  auto *target = tensor.get();
+  if (GetRefCount(graph, *tensorIdx) > 1) {
+    copied = CopyTensorDefT(tensor);
+    if (copied == nullptr) {
+      MS_LOG(ERROR) << "copy tensor " << *tensorIdx << " failed";
+      return RET_ERROR;
+    }
+    target = copied.get();
+  }
+  target->dims = dims;
+  target->data.resize(broadcast.size() * sizeof(float));
+  memcpy(target->data.data(), broadcast.data(), target->data.size());
+  if (copied != nullptr) {
+    graph->allTensors.emplace_back(std::move(copied));
+    *tensorIdx = graph->allTensors.size() - 1;
+  }
+  return RET_OK;
+}
+}  // namespace
+
+STATUS CompositeFusionPass::DefinePattern() {
+  auto ret = DefineLayerNormPattern();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = DefineGeluPattern();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  return DefineConvAddActivationPattern();
+}
+
+// mul gamma(add beta) of (x - mean(x)) / sqrt(mean((x - mean(x))^2) + epsilon)
+STATUS CompositeFusionPass::DefineLayerNormPattern() {
+  auto inputOp = std::make_shared<PatternOp>(kInputName);
+  inputOp->isPlaceHold = true;
+  auto meanOp = std::make_shared<PatternOp>(kLayerNormMeanName);
+  meanOp->types = {schema::PrimitiveType_Mean, schema::PrimitiveType_Reduce};
+  meanOp->left = inputOp;
+  auto subOp = std::make_shared<PatternOp>(kLayerNormSubName);
+  subOp->types = {schema::PrimitiveType_Sub};
+  subOp->isCommutative = false;
+  subOp->left = inputOp;
+  subOp->right = meanOp;
+  auto squareOp = std::make_shared<PatternOp>(kLayerNormSquareName);
+  squareOp->types = {schema::PrimitiveType_Power, schema::PrimitiveType_Mul, schema::PrimitiveType_Square};
+  squareOp->left = subOp;
+  auto varianceOp = std::make_shared<PatternOp>(kLayerNormVarianceName);
+  varianceOp->types = {schema::PrimitiveType_Mean, schema::PrimitiveType_Reduce};
+  varianceOp->left = squareOp;
+  auto addEpsilonOp = std::make_shared<PatternOp>(kLayerNormAddEpsilonName);
+  addEpsilonOp->types = {schema::PrimitiveType_Add};
+  addEpsilonOp->left = varianceOp;
+  auto sqrtOp = std::make_shared<PatternOp>(kLayerNormSqrtName);
+  sqrtOp->types = {schema::PrimitiveType_Sqrt};
+  sqrtOp->left = addEpsilonOp;
+  auto divOp = std::make_shared<PatternOp>(kLayerNormDivName);
+  divOp->types = {schema::PrimitiveType_RealDiv, schema::PrimitiveType_Div};
+  divOp->isCommutative = false;
+  divOp->left = subOp;
+  divOp->right = sqrtOp;
+  auto gammaOp = std::make_shared<PatternOp>(kLayerNormGammaName);
+  gammaOp->types = {schema::PrimitiveType_Mul};
+  gammaOp->left = divOp;
+  auto betaOp = std::make_shared<PatternOp>(kLayerNormBetaName);
+  betaOp->types = {schema::PrimitiveType_Add};
+  betaOp->left = gammaOp;
+
+  std::unique_ptr<FusionPattern> fusionPattern(new (std::nothrow) FusionPattern(kLayerNormFusionPattern));
+  if (fusionPattern == nullptr) {
+    MS_LOG(ERROR) << "new fusionPattern failed";
+    return RET_ERROR;
+  }
+  for (const auto &op : {inputOp, meanOp, subOp, squareOp, varianceOp, addEpsilonOp, sqrtOp, divOp, gammaOp, betaOp}) {
+    fusionPattern->AddPatternOp(op);
+  }
+  fusionPattern->Finish();
+  this->patterns.emplace_back(fusionPattern.release());
+  return RET_OK;
+}
+
+// x * (0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))))
+STATUS CompositeFusionPass::DefineGeluPattern() {
+  auto inputOp = std::make_shared<PatternOp>(kInputName);
+  inputOp->isPlaceHold = true;
+  auto powOp = std::make_shared<PatternOp>(kGeluPowName);
+  powOp->types = {schema::PrimitiveType_Power};
+  powOp->left = inputOp;
+  auto mulCoeffOp = std::make_shared<PatternOp>(kGeluMulCoeffName);
+  mulCoeffOp->types = {schema::PrimitiveType_Mul};
+  mulCoeffOp->left = powOp;
+  auto addInputOp = std::make_shared<PatternOp>(kGeluAddInputName);
+  addInputOp->types = {schema::PrimitiveType_Add};
+  addInputOp->left = inputOp;
+  addInputOp->right = mulCoeffOp;
+  auto mulSqrtOp = std::make_shared<PatternOp>(kGeluMulSqrtName);
+  mulSqrtOp->types = {schema::PrimitiveType_Mul};
+  mulSqrtOp->left = addInputOp;
+  auto tanhOp = std::make_shared<PatternOp>(kGeluTanhName);
+  tanhOp->types = {schema::PrimitiveType_Activation};
+  tanhOp->left = mulSqrtOp;
+  auto addOneOp = std::make_shared<PatternOp>(kGeluAddOneName);
+  addOneOp->types = {schema::PrimitiveType_Add};
+  addOneOp->left = tanhOp;
+  auto mulHalfOp = std::make_shared<PatternOp>(kGeluMulHalfName);
+  mulHalfOp->types = {schema::PrimitiveType_Mul};
+  mulHalfOp->left = addOneOp;
+  auto mulInputOp = std::make_shared<PatternOp>(kGeluMulInputName);
+  mulInputOp->types = {schema::PrimitiveType_Mul};
+  mulInputOp->left = inputOp;
+  mulInputOp->right = mulHalfOp;
+
+  std::unique_ptr<FusionPattern> fusionPattern(new (std::nothrow) FusionPattern(kGeluFusionPattern));
+  if (fusionPattern == nullptr) {
+    MS_LOG(ERROR) << "new fusionPattern failed";
+    return RET_ERROR;
+  }
+  for (const auto &op : {inputOp, powOp, mulCoeffOp, addInputOp, mulSqrtOp, tanhOp, addOneOp, mulHalfOp, mulInputOp}) {
+    fusionPattern->AddPatternOp(op);
+  }
+  fusionPattern->Finish();
+  this->patterns.emplace_back(fusionPattern.release());
+  return RET_OK;
+}
+
+// activation(add(biasadd(conv), residual)), the biasadd is optional
+STATUS CompositeFusionPass::DefineConvAddActivationPattern() {
+  auto convOp = std::make_shared<PatternOp>(kConvName);
+  convOp->types = {schema::PrimitiveType_Conv2D, schema::PrimitiveType_DepthwiseConv2D};
+  auto biasAddOp = std::make_shared<PatternOp>(BIASADD_NAME);
+  biasAddOp->types = {schema::PrimitiveType_BiasAdd};
+  biasAddOp->isOptional = true;
+  biasAddOp->left = convOp;
+  auto residualOp = std::make_shared<PatternOp>(kResidualName);
+  residualOp->isPlaceHold = true;
+  auto addOp = std::make_shared<PatternOp>(kAddName);
+  addOp->types = {schema::PrimitiveType_Add};
+  addOp->left = biasAddOp;
+  addOp->right = residualOp;
+  auto actOp = std::make_shared<PatternOp>(ACTIVATION_NAME);
+  actOp->types = {schema::PrimitiveType_Activation};
+  actOp->left = addOp;
+
+  std::unique_ptr<FusionPattern> fusionPattern(new (std::nothrow) FusionPattern(kConvAddActivationFusionPattern));
+  if (fusionPattern == nullptr) {
+    MS_LOG(ERROR) << "new fusionPattern failed";
+    return RET_ERROR;
+  }
+  for (const auto &op : {convOp, biasAddOp, residualOp, addOp, actOp}) {
+    fusionPattern->AddPatternOp(op);
+  }
+  fusionPattern->Finish();
+  this->patterns.emplace_back(fusionPattern.release());
+  return RET_OK;
+}
+
+STATUS CompositeFusionPass::DoFusion(schema::MetaGraphT *graph, const std::string &patternName,
+                                     std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) {
+  MS_ASSERT(graph != nullptr);
+  if (patternName == kLayerNormFusionPattern) {
+    return DoLayerNormFusion(graph, matchedPath);
+  }
+  if (patternName == kGeluFusionPattern) {
+    return DoGeluFusion(graph, matchedPath);
+  }
+  if (patternName == kConvAddActivationFusionPattern) {
+    return DoConvAddActivationFusion(graph, matchedPath);
+  }
+  MS_LOG(ERROR) << "Unsupported pattern " << patternName;
+  return RET_PARAM_INVALID;
+}
+
+STATUS CompositeFusionPass::DoLayerNormFusion(schema::MetaGraphT *graph,
+                                              std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) {
+  auto &meanNode = graph->nodes.at(matchedPath[kLayerNormMeanName]->nodeIdx);
+  auto &subNode = graph->nodes.at(matchedPath[kLayerNormSubName]->nodeIdx);
+  auto &squareNode = graph->nodes.at(matchedPath[kLayerNormSquareName]->nodeIdx);
+  auto &varianceNode = graph->nodes.at(matchedPath[kLayerNormVarianceName]->nodeIdx);
+  auto &addEpsilonNode = graph->nodes.at(matchedPath[kLayerNormAddEpsilonName]->nodeIdx);
+  auto &gammaNode = graph->nodes.at(matchedPath[kLayerNormGammaName]->nodeIdx);
+  auto &betaNode = graph->nodes.at(matchedPath[kLayerNormBetaName]->nodeIdx);
+  if (AnyHasActivation(*graph, matchedPath,
+                       {kLayerNormSubName, kLayerNormSquareName, kLayerNormAddEpsilonName, kLayerNormDivName,
+                        kLayerNormGammaName, kLayerNormBetaName})) {
+    return RET_NO_CHANGE;
+  }
+  if (meanNode->inputIndex.empty() || subNode->inputIndex.size() != 2 ||
+      meanNode->inputIndex.front() != subNode->inputIndex.front()) {
+    return RET_NO_CHANGE;
+  }
+  auto inputIdx = subNode->inputIndex.front();
+
+  std::vector<int32_t> meanAxes;
+  std::vector<int32_t> varianceAxes;
+  if (!GetMeanAxes(*meanNode, &meanAxes) || !GetMeanAxes(*varianceNode, &varianceAxes) || meanAxes != varianceAxes) {
+    return RET_NO_CHANGE;
+  }
+  auto inputDims = graph->allTensors.at(inputIdx)->dims;
+  auto beginNormAxis = GetBeginNormAxis(meanAxes, inputDims.size());
+  if (beginNormAxis == 0) {
+    return RET_NO_CHANGE;
+  }
+  auto squareType = squareNode->primitive->value.type;
+  if ((squareType == schema::PrimitiveType_Power && !PowerExponentEqual(*graph, *squareNode, 2.0f)) ||
+      (squareType == schema::PrimitiveType_Mul &&
+       (squareNode->inputIndex.size() != 2 || squareNode->inputIndex[0] != squareNode->inputIndex[1]))) {
+    return RET_NO_CHANGE;
+  }
+  auto epsilonIdx = GetConstInputIdx(*graph, *addEpsilonNode);
+  auto gammaIdx = GetConstInputIdx(*graph, *gammaNode);
+  auto betaIdx = GetConstInputIdx(*graph, *betaNode);
+  if (epsilonIdx < 0 || gammaIdx < 0 || betaIdx < 0) {
+    return RET_NO_CHANGE;
+  }
+  auto &epsilonTensor = graph->allTensors.at(addEpsilonNode->inputIndex[epsilonIdx]);
+  auto gammaTensorIdx = gammaNode->inputIndex[gammaIdx];
+  auto betaTensorIdx = betaNode->inputIndex[betaIdx];
+  auto &gammaTensor = graph->allTensors.at(gammaTensorIdx);
+  auto &betaTensor = graph->allTensors.at(betaTensorIdx);
+  std::vector<int32_t> gammaBroadcastDims;
+  std::vector<int32_t> betaBroadcastDims;
+  if (epsilonTensor->data.size() != sizeof(float) ||
+      !AffineTensorFits(*gammaTensor, inputDims, beginNormAxis, &gammaBroadcastDims) ||
+      !AffineTensorFits(*betaTensor, inputDims, beginNormAxis, &betaBroadcastDims)) {
+    return RET_NO_CHANGE;
+  }
+  // with the shape of the input not known neither of them is broadcast
+  if (gammaBroadcastDims.empty() && betaBroadcastDims.empty() &&
+      gammaTensor->data.size() != betaTensor->data.size()) {
+    return RET_NO_CHANGE;
+  }
+  auto epsilon = *reinterpret_cast<const float *>(epsilonTensor->data.data());
+  if (!gammaBroadcastDims.empty() && BroadcastTensor(graph, gammaBroadcastDims, &gammaTensorIdx) != RET_OK) {
+    return RET_ERROR;
+  }
+  if (!betaBroadcastDims.empty() && BroadcastTensor(graph, betaBroadcastDims, &betaTensorIdx) != RET_OK) {
+    return RET_ERROR;
+  }
+
+  std::unique_ptr<schema::LayerNormT> attr(new (std::nothrow) schema::LayerNormT());
+  if (attr == nullptr) {
+    MS_LOG(ERROR) << "new LayerNormT failed";
+    return RET_ERROR;
+  }
+  attr->beginNormAxis = beginNormAxis;
+  attr->epsilon = epsilon;
+  attr->elementwiseAffine = true;
+  // the output node of the pattern becomes the LayerNorm
+  betaNode->primitive = std::make_unique<schema::PrimitiveT>();
+  betaNode->primitive->value.type = schema::PrimitiveType_LayerNorm;
+  betaNode->primitive->value.value = attr.release();
+  betaNode->inputIndex = {inputIdx, gammaTensorIdx, betaTensorIdx};
+  return RemoveFusedNodes(graph, {matchedPath[kLayerNormMeanName]->nodeIdx, matchedPath[kLayerNormSubName]->nodeIdx,
+                                  matchedPath[kLayerNormSquareName]->nodeIdx,
+                                  matchedPath[kLayerNormVarianceName]->nodeIdx,
+                                  matchedPath[kLayerNormAddEpsilonName]->nodeIdx,
+                                  matchedPath[kLayerNormSqrtName]->nodeIdx, matchedPath[kLayerNormDivName]->nodeIdx,
+                                  matchedPath[kLayerNormGammaName]->nodeIdx});
+}
+
+STATUS CompositeFusionPass::DoGeluFusion(schema::MetaGraphT *graph,
+                                         std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) {
+  auto &powNode = graph->nodes.at(matchedPath[kGeluPowName]->nodeIdx);
+  auto &tanhNode = graph->nodes.at(matchedPath[kGeluTanhName]->nodeIdx);
+  auto &addInputNode = graph->nodes.at(matchedPath[kGeluAddInputName]->nodeIdx);
+  auto &mulInputNode = graph->nodes.at(matchedPath[kGeluMulInputName]->nodeIdx);
+  if (AnyHasActivation(*graph, matchedPath,
+                       {kGeluMulCoeffName, kGeluAddInputName, kGeluMulSqrtName, kGeluAddOneName, kGeluMulHalfName,
+                        kGeluMulInputName})) {
+    return RET_NO_CHANGE;
+  }
+  if (powNode->inputIndex.empty()) {
+    return RET_NO_CHANGE;
+  }
+  auto inputIdx = powNode->inputIndex.front();
+  if (!IsContain(addInputNode->inputIndex, inputIdx) || !IsContain(mulInputNode->inputIndex, inputIdx)) {
+    return RET_NO_CHANGE;
+  }
+  auto tanhAttr = tanhNode->primitive->value.AsActivation();
+  if (tanhAttr == nullptr || tanhAttr->type != schema::ActivationType_TANH ||
+      !PowerExponentEqual(*graph, *powNode, 3.0f) ||
+      !ConstInputEqual(*graph, *graph->nodes.at(matchedPath[kGeluMulCoeffName]->nodeIdx), kGeluCoeff) ||
+      !ConstInputEqual(*graph, *graph->nodes.at(matchedPath[kGeluMulSqrtName]->nodeIdx), kGeluSqrtTwoOverPi) ||
+      !ConstInputEqual(*graph, *graph->nodes.at(matchedPath[kGeluAddOneName]->nodeIdx), 1.0f) ||
+      !ConstInputEqual(*graph, *graph->nodes.at(matchedPath[kGeluMulHalfName]->nodeIdx), 0.5f)) {
+    return RET_NO_CHANGE;
+  }
+
+  std::unique_ptr<schema::ActivationT> attr(new (std::nothrow) schema::ActivationT());
+  if (attr == nullptr) {
+    MS_LOG(ERROR) << "new ActivationT failed";
+    return RET_ERROR;
+  }
+  attr->type = schema::ActivationType_GELU;
+  mulInputNode->primitive = std::make_unique<schema::PrimitiveT>();
+  mulInputNode->primitive->value.type = schema::PrimitiveType_Activation;
+  mulInputNode->primitive->value.value = attr.release();
+  mulInputNode->inputIndex = {inputIdx};
+  return RemoveFusedNodes(graph, {matchedPath[kGeluPowName]->nodeIdx, matchedPath[kGeluMulCoeffName]->nodeIdx,
+                                  matchedPath[kGeluAddInputName]->nodeIdx, matchedPath[kGeluMulSqrtName]->nodeIdx,
+                                  matchedPath[kGeluTanhName]->nodeIdx, matchedPath[kGeluAddOneName]->nodeIdx,
+                                  matchedPath[kGeluMulHalfName]->nodeIdx});
+}
+
+// the residual add runs the activation on its output, which the arithmetic kernels do in the same loop
+STATUS CompositeFusionPass::DoConvAddActivationFusion(
+  schema::MetaGraphT *graph, std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) {
+  auto addPath = matchedPath[kAddName];
+  auto actPath = matchedPath[ACTIVATION_NAME];
+  auto &addNode = graph->nodes.at(addPath->nodeIdx);
+  auto &actNode = graph->nodes.at(actPath->nodeIdx);
+  auto actAttr = actNode->primitive->value.AsActivation();
+  if (actAttr == nullptr ||
+      (actAttr->type != schema::ActivationType_RELU && actAttr->type != schema::ActivationType_RELU6)) {
+    return RET_NO_CHANGE;
+  }
+  // the int8 add kernel does not run the activation
+  if (addNode->quantType != schema::QuantType_QUANT_NONE) {
+    return RET_NO_CHANGE;
+  }
+  if (addNode->primitive->value.AsAdd() == nullptr) {
+    std::unique_ptr<schema::AddT> addAttr(new (std::nothrow) schema::AddT());
+    if (addAttr == nullptr) {
+      MS_LOG(ERROR) << "new AddT failed";
+      return RET_ERROR;
+    }
+    addNode->primitive->value.value = addAttr.release();
+  }
+  auto addAttr = addNode->primitive->value.AsAdd();
+  if (addAttr->activationType != schema::ActivationType_NO_ACTIVATION) {
+    return RET_NO_CHANGE;
+  }
+  addAttr->activationType = actAttr->type;
+
+  MergeNodeAttrFromPost(addNode, actNode);
+  auto status = IsolateOneWayNode(graph, actPath->nodeIdx);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "IsolateOneWayNode failed, subGraph: " << actPath->subGraphIdx << ", node: " << actPath->nodeIdx
+                  << ", error: " << status;
+    return status;
+  }
+  return RET_OK;
+}
+
+STATUS CompositeFusionPass::RemoveFusedNodes(schema::MetaGraphT *graph, const std::vector<size_t> &nodeIdxes) {
+  std::vector<uint32_t> tensorIdxes;
+  for (auto nodeIdx : nodeIdxes) {
+    auto &node = graph->nodes.at(nodeIdx);
+    tensorIdxes.insert(tensorIdxes.end(), node->inputIndex.begin(), node->inputIndex.end());
+    tensorIdxes.insert(tensorIdxes.end(), node->outputIndex.begin(), node->outputIndex.end());
+    node->inputIndex.clear();
+    node->outputIndex.clear();
+  }
+  std::sort(tensorIdxes.begin(), tensorIdxes.end());
+  tensorIdxes.erase(std::unique(tensorIdxes.begin(), tensorIdxes.end()), tensorIdxes.end());
+  // the input of the pattern and the weights of the fused node are still used
+  std::vector<uint32_t> unusedTensorIdxes;
+  for (auto tensorIdx : tensorIdxes) {
+    if (GetRefCount(graph, tensorIdx) == 0 && !IsContain(graph->inputIndex, tensorIdx) &&
+        !IsContain(graph->outputIndex, tensorIdx)) {
+      unusedTensorIdxes.emplace_back(tensorIdx);
+    }
+  }
+  auto status = RemoveTensor(graph, unusedTensorIdxes);
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "RemoveTensor failed, error: " << status;
+    return status;
+  }
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
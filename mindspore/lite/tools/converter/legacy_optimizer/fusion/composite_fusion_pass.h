@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_PREDICT_COMPOSITE_FUSION_PASS_H
+#define MINDSPORE_PREDICT_COMPOSITE_FUSION_PASS_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tools/converter/legacy_optimizer/fusion/fusion_pass.h"
+
+namespace mindspore {
+namespace lite {
+// Pattern names
+constexpr const char *kLayerNormFusionPattern = "LayerNormFusionPattern";
+constexpr const char *kGeluFusionPattern = "GeluFusionPattern";
+constexpr const char *kConvAddActivationFusionPattern = "ConvAddActivationFusionPattern";
+
+// PatternOp Ids
+constexpr const char *kInputName = "INPUT";
+constexpr const char *kLayerNormMeanName = "LAYERNORM_MEAN";
+constexpr const char *kLayerNormSubName = "LAYERNORM_SUB";
+constexpr const char *kLayerNormSquareName = "LAYERNORM_SQUARE";
+constexpr const char *kLayerNormVarianceName = "LAYERNORM_VARIANCE";
+constexpr const char *kLayerNormAddEpsilonName = "LAYERNORM_ADD_EPSILON";
+constexpr const char *kLayerNormSqrtName = "LAYERNORM_SQRT";
+constexpr const char *kLayerNormDivName = "LAYERNORM_DIV";
+constexpr const char *kLayerNormGammaName = "LAYERNORM_GAMMA";
+constexpr const char *kLayerNormBetaName = "LAYERNORM_BETA";
+constexpr const char *kGeluPowName = "GELU_POW";
+constexpr const char *kGeluMulCoeffName = "GELU_MUL_COEFF";
+constexpr const char *kGeluAddInputName = "GELU_ADD_INPUT";
+constexpr const char *kGeluMulSqrtName = "GELU_MUL_SQRT";
+constexpr const char *kGeluTanhName = "GELU_TANH";
+constexpr const char *kGeluAddOneName = "GELU_ADD_ONE";
+constexpr const char *kGeluMulHalfName = "GELU_MUL_HALF";
+constexpr const char *kGeluMulInputName = "GELU_MUL_INPUT";
+constexpr const char *kResidualName = "RESIDUAL";
+constexpr const char *kAddName = "ADD";
+
+// Fuses the subgraphs transformer and residual models are exported as into composite kernels, all the patterns are
+// matched in one traversal of the graph:
+// 1. mean, sub, square, mean, add epsilon, sqrt, div, mul gamma and add beta into LayerNorm
+// 2. the tanh approximation of gelu into Activation GELU
+// 3. conv, optional biasadd, add residual and relu/relu6 into conv and Add with the activation fused
+class CompositeFusionPass : public FusionPass {
+ public:
+  CompositeFusionPass() = default;
+
+  ~CompositeFusionPass() override = default;
+
+  STATUS DefinePattern() override;
+
+  STATUS DoFusion(schema::MetaGraphT *graph, const std::string &patternName,
+                  std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) override;
+
+ private:
+  STATUS DefineLayerNormPattern();
+
+  STATUS DefineGeluPattern();
+
+  STATUS DefineConvAddActivationPattern();
+
+  STATUS DoLayerNormFusion(schema::MetaGraphT *graph,
+                           std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath);
+
+  STATUS DoGeluFusion(schema::MetaGraphT *graph, std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath);
+
+  STATUS DoConvAddActivationFusion(schema::MetaGraphT *graph,
+                                   std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath);
+
+  // isolate the fused nodes and remove the tensors nothing uses any more
+  static STATUS RemoveFusedNodes(schema::MetaGraphT *graph, const std::vector<size_t> &nodeIdxes);
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_PREDICT_COMPOSITE_FUSION_PASS_H
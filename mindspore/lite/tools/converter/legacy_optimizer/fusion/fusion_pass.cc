@@ -71,124 +71,132 @@ STATUS FusionPass::Run(schema::MetaGraphT *graph) {
 STATUS FusionPass::MatchPatterns(schema::MetaGraphT *graph) {
   MS_ASSERT(graph != nullptr);
   this->matchedPaths.clear();
-  STATUS status;
+  // patterns are indexed by the types of their output patternOps, a node is only tried against the patterns it can be
+  // the output of, in the order the patterns are defined
+  std::map<schema::PrimitiveType, std::vector<std::pair<FusionPattern *, std::shared_ptr<PatternOp>>>> typePatterns;
   for (auto pattern : patterns) {
-    status = MatchOnePattern(graph, pattern);
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "MatchOnePatternInSubGraph failed: " << status;
-      return status;
+    auto outputOp = pattern->GetPatternOp(pattern->GetOutput());
+    if (outputOp == nullptr) {
+      MS_LOG(ERROR) << "Can not find the output of the pattern";
+      return RET_NULL_PTR;
     }
-  }
-  this->mapedMatchedPaths.clear();
-  for (auto iter = matchedPaths.begin(); iter != matchedPaths.end(); iter++) {
-    auto patternName = iter->first;
-    auto patternOps = iter->second;
-    std::vector<std::unordered_map<std::string, std::shared_ptr<Path>>> mapedPaths;
-    for (const auto &patternOp : patternOps) {
-      std::queue<std::shared_ptr<PatternOp>> opQueue;
-      std::unordered_map<std::string, std::shared_ptr<Path>> mapedPath;
-      opQueue.push(patternOp);
-      while (!opQueue.empty()) {
-        auto curPatternOp = opQueue.front();
-        opQueue.pop();
-        MS_ASSERT(curPatternOp != nullptr);
-        mapedPath.insert(std::make_pair(curPatternOp->id, curPatternOp->path));
-        if (curPatternOp->left != nullptr) {
-          opQueue.push(curPatternOp->left);
-        }
-        if (curPatternOp->right != nullptr) {
-          opQueue.push(curPatternOp->right);
-        }
-      }
-      mapedPaths.emplace_back(mapedPath);
+    MS_ASSERT(outputOp->isTail);
+    this->matchedPaths[pattern->GetName()];
+    for (auto type : outputOp->types) {
+      typePatterns[type].emplace_back(pattern, outputOp);
     }
-    this->mapedMatchedPaths.insert(std::make_pair(patternName, mapedPaths));
-  }
-  return RET_OK;
-}
-
-// assume that all nodes have only one output. if node has multi-outputs,
-// some errors may happen
-STATUS FusionPass::MatchOnePattern(schema::MetaGraphT *graph, FusionPattern *pattern) {
-  MS_ASSERT(graph != nullptr);
-  MS_ASSERT(pattern != nullptr);
-  //  std::vector<std::unordered_map<std::string, Path *>> patternMatchPaths;
-  auto outputOp = pattern->GetPatternOp(pattern->GetOutput());
-  if (outputOp == nullptr) {
-    MS_LOG(ERROR) << "Can not find the output of the pattern";
-    return RET_NULL_PTR;
-  }
-  MS_ASSERT(outputOp->isTail);
-  if (graph->nodes.empty()) {
-    return RET_OK;
   }
-  // find all matched entries
+  // find all entries, from the outputs of the graph to its inputs
   std::vector<size_t> entries;
+  std::vector<bool> visited(graph->nodes.size(), false);
   std::queue<size_t> nodeQueue;
-  std::vector<size_t> sinkIdes;
   for (auto index : graph->outputIndex) {
     auto subGraphOutputNodeIdxes = GetLinkedPreIdx(*graph, index);
     for (auto subGraphOutputNodeIdx : subGraphOutputNodeIdxes) {
-      MS_ASSERT((subGraph->nodes.size() > subGraphOutputNodeIdx));
+      MS_ASSERT((graph->nodes.size() > subGraphOutputNodeIdx));
       nodeQueue.push(subGraphOutputNodeIdx);
     }
   }
   while (!nodeQueue.empty()) {
     auto nodeIdx = nodeQueue.front();
     nodeQueue.pop();
-    if (IsContain(sinkIdes, nodeIdx)) {
+    if (visited.at(nodeIdx)) {
       continue;
     }
-    MS_ASSERT(subGraph->nodes.size() > nodeIdx);
-    auto &node = graph->nodes.at(nodeIdx);
-    sinkIdes.emplace_back(nodeIdx);
-
-    MS_ASSERT(nullptr != node->primitive);
-    if (IsContain(outputOp->types, node->primitive->value.type)) {
-      entries.emplace_back(nodeIdx);
-    }
+    visited.at(nodeIdx) = true;
+    entries.emplace_back(nodeIdx);
     auto preNodeIdxes = GetInputNodeIdx(*graph, nodeIdx);
     for (auto preNodeIdx : preNodeIdxes) {
-      MS_ASSERT((subGraph->nodes.size() > preNodeIdx));
+      MS_ASSERT((graph->nodes.size() > preNodeIdx));
       nodeQueue.push(preNodeIdx);
     }
   }
 
-  // check each entry
-  std::vector<std::shared_ptr<PatternOp>> paths;
-  sinkIdes.clear();
-  std::vector<size_t> pathSinkIdes;
+  // check each entry, the nodes of a match can not be taken by the following ones
+  std::vector<size_t> sinkIdes;
+  std::vector<std::shared_ptr<PatternOp>> pathOps;
   for (auto nodeIdx : entries) {
     if (IsContain(sinkIdes, nodeIdx)) {
       continue;
     }
-    pathSinkIdes.clear();
-    auto path = PatternOp::Copy(outputOp);
-    auto ret = MatchTree(graph, nodeIdx, path, sinkIdes, pathSinkIdes);
-    if (ret && CheckMatch(graph, path)) {
-      paths.emplace_back(path);
+    auto &node = graph->nodes.at(nodeIdx);
+    MS_ASSERT(nullptr != node->primitive);
+    auto iter = typePatterns.find(node->primitive->value.type);
+    if (iter == typePatterns.end()) {
+      continue;
+    }
+    for (const auto &typePattern : iter->second) {
+      pathOps.clear();
+      auto path = PatternOp::Copy(typePattern.second);
+      if (MatchTree(graph, nodeIdx, path, sinkIdes, pathOps) && CheckMatch(graph, path)) {
+        this->matchedPaths[typePattern.first->GetName()].emplace_back(path);
+        break;
+      }
+      RollBack(0, sinkIdes, pathOps);
     }
   }
-  auto patternName = pattern->GetName();
-  this->matchedPaths.insert(std::make_pair(patternName, paths));
+
+  this->mapedMatchedPaths.clear();
+  for (auto iter = matchedPaths.begin(); iter != matchedPaths.end(); iter++) {
+    auto patternName = iter->first;
+    auto patternOps = iter->second;
+    std::vector<std::unordered_map<std::string, std::shared_ptr<Path>>> mapedPaths;
+    for (const auto &patternOp : patternOps) {
+      std::queue<std::shared_ptr<PatternOp>> opQueue;
+      std::unordered_map<std::string, std::shared_ptr<Path>> mapedPath;
+      opQueue.push(patternOp);
+      while (!opQueue.empty()) {
+        auto curPatternOp = opQueue.front();
+        opQueue.pop();
+        MS_ASSERT(curPatternOp != nullptr);
+        mapedPath.insert(std::make_pair(curPatternOp->id, curPatternOp->path));
+        if (curPatternOp->left != nullptr) {
+          opQueue.push(curPatternOp->left);
+        }
+        if (curPatternOp->right != nullptr) {
+          opQueue.push(curPatternOp->right);
+        }
+      }
+      mapedPaths.emplace_back(mapedPath);
+    }
+    this->mapedMatchedPaths.insert(std::make_pair(patternName, mapedPaths));
+  }
   return RET_OK;
 }
 
-bool FusionPass::CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<PatternOp>& patternOp) {
+bool FusionPass::CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<PatternOp> &patternOp) {
   MS_ASSERT(graph != nullptr);
   MS_ASSERT(patternOp != nullptr);
   // find included nodes
   std::queue<std::shared_ptr<PatternOp>> opQueue;
   std::vector<size_t> matchedNodeIdxes;
   std::vector<std::shared_ptr<PatternOp>> inputNodes;
+  std::vector<std::shared_ptr<PatternOp>> innerNodes;
   std::shared_ptr<PatternOp> outputNode = nullptr;
   opQueue.push(patternOp);
   while (!opQueue.empty()) {
     auto curPatternOp = opQueue.front();
     opQueue.pop();
+    if (curPatternOp->left != nullptr) {
+      opQueue.push(curPatternOp->left);
+    }
+    if (curPatternOp->right != nullptr) {
+      opQueue.push(curPatternOp->right);
+    }
+    // a skipped optional patternOp has no node
+    if (!curPatternOp->pathSetted) {
+      continue;
+    }
+    // a placeHold matched to a graph input has no node either
+    if (curPatternOp->path->nodeIdx < 0) {
+      MS_ASSERT(curPatternOp->isPlaceHold);
+      continue;
+    }
     matchedNodeIdxes.push_back(curPatternOp->path->nodeIdx);
     if (curPatternOp->isHead) {
       inputNodes.emplace_back(curPatternOp);
+    } else if (!curPatternOp->isTail && !curPatternOp->isPlaceHold) {
+      innerNodes.emplace_back(curPatternOp);
     }
     if (curPatternOp->isTail) {
       if (outputNode != nullptr && outputNode != curPatternOp) {
@@ -196,15 +204,9 @@ bool FusionPass::CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<Pat
       }
       outputNode = curPatternOp;
     }
-    if (curPatternOp->left != nullptr) {
-      opQueue.push(curPatternOp->left);
-    }
-    if (curPatternOp->right != nullptr) {
-      opQueue.push(curPatternOp->right);
-    }
   }
   // all post node of input node should be in path except input node is placeHold
-  for (const auto& inputNode : inputNodes) {
+  for (const auto &inputNode : inputNodes) {
     if (inputNode->isPlaceHold) {
       continue;
     }
@@ -215,6 +217,21 @@ bool FusionPass::CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<Pat
       }
     }
   }
+  // the outputs of the inner nodes are dropped by the fusion, so they should only be used in path
+  for (const auto &innerNode : innerNodes) {
+    auto &node = graph->nodes.at(innerNode->path->nodeIdx);
+    for (auto outputIndex : node->outputIndex) {
+      if (IsContain(graph->outputIndex, outputIndex)) {
+        return false;
+      }
+    }
+    auto innerNodePostNodeIdxes = GetOutputNodeIdx(*graph, innerNode->path->nodeIdx);
+    for (auto innerNodePostNodeIdx : innerNodePostNodeIdxes) {
+      if (!IsContain(matchedNodeIdxes, innerNodePostNodeIdx)) {
+        return false;
+      }
+    }
+  }
   // all pre node of output node should be in path
   auto outputNodePreNodeIdxes = GetInputNodeIdx(*graph, outputNode->path->nodeIdx);
   for (auto outputNodePreNodeIdx : outputNodePreNodeIdxes) {
@@ -226,68 +243,156 @@ bool FusionPass::CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<Pat
 }
 
 bool FusionPass::MatchTree(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
-                           std::vector<size_t> &sinkIdes, std::vector<size_t> &pathSinkIdes) {
+                           std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps) {
   MS_ASSERT(graph != nullptr);
-  MS_ASSERT(nodeIdx < subGraph->nodes.size());
-  auto &scope = graph->nodes.at(nodeIdx);
-  MS_ASSERT(scope != nullptr);
+  MS_ASSERT(nodeIdx < graph->nodes.size());
   // if target(except target is marked head) is nullptr, it means the preNode
   // has no left or right, but scope is not nullptr
   if (target == nullptr) {
     return false;
   }
-  // if node is sinked and not in the pathSinkId, then return false
-  if (IsContain(sinkIdes, nodeIdx) && !IsContain(pathSinkIdes, nodeIdx)) {
-    return false;
-  }
-  // type not match
-  if (!target->isPlaceHold && !IsContain(target->types, scope->primitive->value.type)) {
-    return false;
-  }
-  // path is setted and not pointer to this node
+  // target is the input of several patternOps and has been matched through another one
   if (target->pathSetted) {
     MS_ASSERT(target->path != nullptr);
-    if (target->path->nodeIdx != nodeIdx) {
+    return target->path->nodeIdx == static_cast<int32_t>(nodeIdx);
+  }
+  auto pathSize = pathOps.size();
+  if (MatchNode(graph, nodeIdx, target, sinkIdes, pathOps)) {
+    return true;
+  }
+  RollBack(pathSize, sinkIdes, pathOps);
+  // skip the optional target, the node is matched by its input
+  if (target->isOptional) {
+    return MatchTree(graph, nodeIdx, target->left, sinkIdes, pathOps);
+  }
+  return false;
+}
+
+bool FusionPass::MatchNode(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
+                           std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps) {
+  auto &scope = graph->nodes.at(nodeIdx);
+  MS_ASSERT(scope != nullptr);
+  // if node is sinked and not in the path, then return false. placeHold is not fused, so it does not take the node
+  if (!target->isPlaceHold && IsContain(sinkIdes, nodeIdx)) {
+    auto inPath = std::any_of(pathOps.begin(), pathOps.end(), [nodeIdx](const std::shared_ptr<PatternOp> &op) {
+      return op->path->nodeIdx == static_cast<int32_t>(nodeIdx);
+    });
+    if (!inPath) {
       return false;
     }
   }
+  // type not match
+  if (!target->isPlaceHold && !IsContain(target->types, scope->primitive->value.type)) {
+    return false;
+  }
   target->SetPath(-1, nodeIdx);
-  sinkIdes.push_back(nodeIdx);
-  pathSinkIdes.push_back(nodeIdx);
+  if (!target->isPlaceHold) {
+    sinkIdes.push_back(nodeIdx);
+  }
+  pathOps.push_back(target);
   // target is marked head, no need to check left and right. head-target's left
   // and right is always nullptr
   if (target->isHead) {
     return true;
   }
+  return MatchInputs(graph, nodeIdx, target, sinkIdes, pathOps);
+}
+
+bool FusionPass::MatchInputs(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
+                             std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps) {
+  auto &scope = graph->nodes.at(nodeIdx);
+  if (!target->isCommutative) {
+    const std::shared_ptr<PatternOp> inputOps[] = {target->left, target->right};
+    for (size_t i = 0; i < sizeof(inputOps) / sizeof(inputOps[0]); i++) {
+      if (inputOps[i] == nullptr) {
+        continue;
+      }
+      if (scope->inputIndex.size() <= i) {
+        return false;
+      }
+      auto preNodeIdxes = GetInputNodeIdx(*graph, nodeIdx, i);
+      if (preNodeIdxes.empty()) {
+        if (!MatchGraphInput(graph, scope->inputIndex.at(i), inputOps[i], pathOps)) {
+          return false;
+        }
+        continue;
+      }
+      if (preNodeIdxes.size() != 1 || !MatchTree(graph, preNodeIdxes.front(), inputOps[i], sinkIdes, pathOps)) {
+        return false;
+      }
+    }
+    return true;
+  }
   auto preNodeIdxes = GetInputNodeIdx(*graph, nodeIdx);
   if (preNodeIdxes.empty() && target->left == nullptr && target->right == nullptr) {
     return true;
   }
-  for (auto preNodeIdx : preNodeIdxes) {
-    MS_ASSERT(subGraph->nodes.size() > preNodeIdx);
+  // the graph inputs read by the node are tried after its pre nodes, only a placeHold can match them
+  std::vector<uint32_t> graphInputIdxes;
+  for (auto inputIdx : scope->inputIndex) {
+    if (IsContain(graph->inputIndex, inputIdx) && !IsContain(graphInputIdxes, inputIdx)) {
+      graphInputIdxes.emplace_back(inputIdx);
+    }
+  }
+  auto matchInput = [&](size_t inputIdx, const std::shared_ptr<PatternOp> &inputOp) {
+    if (inputIdx < preNodeIdxes.size()) {
+      MS_ASSERT(graph->nodes.size() > preNodeIdxes.at(inputIdx));
+      return MatchTree(graph, preNodeIdxes.at(inputIdx), inputOp, sinkIdes, pathOps);
+    }
+    return MatchGraphInput(graph, graphInputIdxes.at(inputIdx - preNodeIdxes.size()), inputOp, pathOps);
+  };
+  auto inputNum = preNodeIdxes.size() + graphInputIdxes.size();
+  auto pathSize = pathOps.size();
+  for (size_t i = 0; i < inputNum; i++) {
     // match left
-    if (MatchTree(graph, preNodeIdx, target->left, sinkIdes, pathSinkIdes)) {
+    if (matchInput(i, target->left)) {
       // match right
-      if (preNodeIdxes.size() == 1 && target->right == nullptr) {
+      if (preNodeIdxes.size() <= 1 && target->right == nullptr) {
         return true;
       }
-      for (auto preNodeIdxInner : preNodeIdxes) {
-        if (preNodeIdxInner == preNodeIdx) {
+      for (size_t j = 0; j < inputNum; j++) {
+        if (j == i) {
           continue;
         }
-        MS_ASSERT(subGraph->nodes.size() > preNodeIdxInner);
-        if (MatchTree(graph, preNodeIdxInner, target->right, sinkIdes, pathSinkIdes)) {
+        if (matchInput(j, target->right)) {
           return true;  // ignore follow match, pick the first match
         }
       }
     }
+    RollBack(pathSize, sinkIdes, pathOps);
   }
-  sinkIdes.erase((sinkIdes.end() - 1));
-  pathSinkIdes.erase((pathSinkIdes.end() - 1));
-  target->UnSetPath();
   return false;
 }
 
+bool FusionPass::MatchGraphInput(schema::MetaGraphT *graph, uint32_t tensorIdx,
+                                 const std::shared_ptr<PatternOp> &target,
+                                 std::vector<std::shared_ptr<PatternOp>> &pathOps) {
+  MS_ASSERT(graph != nullptr);
+  if (target == nullptr || !target->isPlaceHold || !IsContain(graph->inputIndex, tensorIdx)) {
+    return false;
+  }
+  // target is the input of several patternOps and has been matched through another one
+  if (target->pathSetted) {
+    MS_ASSERT(target->path != nullptr);
+    return target->path->nodeIdx < 0 && target->path->tensorIdx == static_cast<int32_t>(tensorIdx);
+  }
+  target->SetInputPath(tensorIdx);
+  pathOps.push_back(target);
+  return true;
+}
+
+void FusionPass::RollBack(size_t pathSize, std::vector<size_t> &sinkIdes,
+                          std::vector<std::shared_ptr<PatternOp>> &pathOps) {
+  while (pathOps.size() > pathSize) {
+    if (!pathOps.back()->isPlaceHold) {
+      MS_ASSERT(!sinkIdes.empty());
+      sinkIdes.pop_back();
+    }
+    pathOps.back()->UnSetPath();
+    pathOps.pop_back();
+  }
+}
+
 STATUS FusionPass::Fuse(schema::MetaGraphT *graph) {
   STATUS ret;
   bool isChange = false;
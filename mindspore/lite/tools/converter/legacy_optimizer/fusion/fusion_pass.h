@@ -60,12 +60,27 @@ class FusionPass : public GraphPass {
                           std::unordered_map<std::string, std::shared_ptr<Path>> &matchedPath) = 0;
 
  protected:
+  // match all the patterns in one traversal of the graph, every node is only tried as the output of the patterns
+  // whose output types contain its type
   STATUS MatchPatterns(schema::MetaGraphT *graph);
 
-  STATUS MatchOnePattern(schema::MetaGraphT *graph, FusionPattern *pattern);
-
+  // sinkIdes are the nodes taken by the matches so far, pathOps the patternOps matched in the current match. On
+  // failure, the nodes and paths set by this call are rolled back.
   bool MatchTree(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
-                 std::vector<size_t> &sinkIdes, std::vector<size_t> &pathSinkIdes);
+                 std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps);
+
+  bool MatchNode(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
+                 std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps);
+
+  bool MatchInputs(schema::MetaGraphT *graph, size_t nodeIdx, const std::shared_ptr<PatternOp> &target,
+                   std::vector<size_t> &sinkIdes, std::vector<std::shared_ptr<PatternOp>> &pathOps);
+
+  // a graph input has no node, so only a placeHold matches it, by its tensor
+  static bool MatchGraphInput(schema::MetaGraphT *graph, uint32_t tensorIdx, const std::shared_ptr<PatternOp> &target,
+                              std::vector<std::shared_ptr<PatternOp>> &pathOps);
+
+  static void RollBack(size_t pathSize, std::vector<size_t> &sinkIdes,
+                       std::vector<std::shared_ptr<PatternOp>> &pathOps);
 
   static bool CheckMatch(schema::MetaGraphT *graph, const std::shared_ptr<PatternOp>& patternOp);
 
@@ -137,6 +137,11 @@ FusionPattern &FusionPattern::Finish() {
       return *this;
     }
     ids.emplace_back(patternOp->id);
+    if (patternOp->isOptional && (patternOp->left == nullptr || patternOp->right != nullptr)) {
+      MS_LOG(ERROR) << "Optional patternOp " << patternOp->id << " should have only the left input";
+      hasError = true;
+      return *this;
+    }
     if (patternOp->left != nullptr) {
       nodeInputIds.insert(patternOp->left->id);
     }
@@ -167,6 +172,11 @@ FusionPattern &FusionPattern::Finish() {
   this->outputOpId = ids.front();
   auto outputNode = GetPatternOp(this->outputOpId);
   MS_ASSERT(outputNode != nullptr);
+  if (outputNode->isOptional) {
+    MS_LOG(ERROR) << "The output patternOp " << outputNode->id << " can not be optional";
+    hasError = true;
+    return *this;
+  }
   outputNode->isTail = true;
 
   for (auto inputNodeId : inputNodeIds) {
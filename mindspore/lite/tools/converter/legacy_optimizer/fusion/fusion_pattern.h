@@ -34,6 +34,8 @@ struct Path {
   Path(int32_t subGraphIdx, int32_t nodeIdx) : subGraphIdx(subGraphIdx), nodeIdx(nodeIdx) {}
   int32_t subGraphIdx = -1;
   int32_t nodeIdx = -1;
+  // the graph input matched by a placeHold, which has no node, nodeIdx is -1 then
+  int32_t tensorIdx = -1;
 };
 
 // Op description in pattern
@@ -49,6 +51,11 @@ struct PatternOp {
   bool isHead = false;
   bool isTail = false;
   bool isPlaceHold = false;
+  // left and right can match the pre-nodes in either order, otherwise left matches the node producing the first input
+  // and right the node producing the second one
+  bool isCommutative = true;
+  // an optional op has only the left input, it is skipped if no node matches it and its path stays unset
+  bool isOptional = false;
 
   PatternOp() = default;
   explicit PatternOp(const std::string &inId) : id(inId) {}
@@ -59,28 +66,51 @@ struct PatternOp {
     this->path->nodeIdx = nodeIdx;
     this->pathSetted = true;
   }
+  void SetInputPath(size_t tensorIdx) {
+    MS_ASSERT(this->path != nullptr);
+    MS_ASSERT(this->isPlaceHold);
+    this->path->nodeIdx = -1;
+    this->path->tensorIdx = tensorIdx;
+    this->pathSetted = true;
+  }
   void UnSetPath() {
     MS_ASSERT(this->path != nullptr);
     this->path->subGraphIdx = -1;
     this->path->nodeIdx = -1;
+    this->path->tensorIdx = -1;
     this->pathSetted = false;
   }
-  static std::shared_ptr<PatternOp> Copy(const std::shared_ptr<PatternOp>& src) {
+  // a patternOp shared by several ops of the pattern is copied once, so that it is matched to one node
+  static std::shared_ptr<PatternOp> Copy(const std::shared_ptr<PatternOp> &src) {
+    std::map<const PatternOp *, std::shared_ptr<PatternOp>> copied;
+    return Copy(src, &copied);
+  }
+
+ private:
+  static std::shared_ptr<PatternOp> Copy(const std::shared_ptr<PatternOp> &src,
+                                         std::map<const PatternOp *, std::shared_ptr<PatternOp>> *copied) {
     if (src == nullptr) {
       return nullptr;
     }
+    auto iter = copied->find(src.get());
+    if (iter != copied->end()) {
+      return iter->second;
+    }
     auto dst = std::make_shared<PatternOp>();
+    (*copied)[src.get()] = dst;
     dst->id = src->id;
     dst->types = src->types;
     if (src->path != nullptr) {
-      dst->path = std::make_shared<Path>(src->path->subGraphIdx, src->path->nodeIdx);
+      dst->path = std::make_shared<Path>(*src->path);
     }
     dst->pathSetted = src->pathSetted;
     dst->isTail = src->isTail;
     dst->isHead = src->isHead;
     dst->isPlaceHold = src->isPlaceHold;
-    dst->left = PatternOp::Copy(src->left);
-    dst->right = PatternOp::Copy(src->right);
+    dst->isCommutative = src->isCommutative;
+    dst->isOptional = src->isOptional;
+    dst->left = PatternOp::Copy(src->left, copied);
+    dst->right = PatternOp::Copy(src->right, copied);
     return dst;
   }
 };
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/converter/legacy_optimizer/graph/weight_prepack_pass.h"
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "src/runtime/kernel/arm/nnacl/pack.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr size_t kConvWeightIndex = 1;
+constexpr size_t kKHWCDimNum = 4;
+
+// the common conv kernel is only selected for the convs which are neither 1x1 nor 3x3 with stride 1 and dilation 1
+bool UseCommonConvKernel(const schema::Conv2DT &conv) {
+  if (conv.group > 1) {
+    return false;
+  }
+  if (conv.kernelH == 1 && conv.kernelW == 1) {
+    return false;
+  }
+  return !(conv.kernelH == 3 && conv.kernelW == 3 && conv.strideH == 1 && conv.strideW == 1 && conv.dilateH == 1 &&
+           conv.dilateW == 1);
+}
+
+STATUS PrepackConvWeight(const schema::Conv2DT &conv, schema::TensorT *weight) {
+  MS_ASSERT(weight != nullptr);
+  ConvParameter conv_param{};
+  conv_param.output_channel_ = weight->dims[0];
+  conv_param.kernel_h_ = weight->dims[1];
+  conv_param.kernel_w_ = weight->dims[2];
+  conv_param.input_channel_ = weight->dims[3];
+  if (conv_param.kernel_h_ != conv.kernelH || conv_param.kernel_w_ != conv.kernelW) {
+    MS_LOG(WARNING) << "Kernel size of weight does not match the conv, weight is not packed";
+    return RET_NO_CHANGE;
+  }
+  size_t weight_num = static_cast<size_t>(conv_param.output_channel_) * conv_param.kernel_h_ * conv_param.kernel_w_ *
+                      conv_param.input_channel_;
+  if (weight_num == 0 || weight->data.size() != weight_num * sizeof(float)) {
+    MS_LOG(WARNING) << "Data size of weight does not match its dims, weight is not packed";
+    return RET_NO_CHANGE;
+  }
+  int oc_block_num = UP_DIV(conv_param.output_channel_, C8NUM);
+  int ic4 = UP_DIV(conv_param.input_channel_, C4NUM);
+  size_t pack_weight_num =
+    static_cast<size_t>(oc_block_num) * C8NUM * ic4 * C4NUM * conv_param.kernel_h_ * conv_param.kernel_w_;
+  std::vector<uint8_t> packed_data(pack_weight_num * sizeof(float), 0);
+  PackWeightFp32(reinterpret_cast<float *>(weight->data.data()), &conv_param,
+                 reinterpret_cast<float *>(packed_data.data()), C8NUM, oc_block_num);
+  weight->packedLayout = schema::PackedWeightLayout_CONV_FP32_OC8_IC4;
+  weight->packedData = std::move(packed_data);
+  return RET_OK;
+}
+}  // namespace
+
+STATUS WeightPrepackPass::Run(schema::MetaGraphT *graph) {
+  MS_ASSERT(graph != nullptr);
+  bool ifChanged = false;
+  for (auto &node : graph->nodes) {
+    MS_ASSERT(node != nullptr && node->primitive != nullptr);
+    if (node->primitive->value.type != schema::PrimitiveType_Conv2D || node->quantType != schema::QuantType_QUANT_NONE) {
+      continue;
+    }
+    auto conv = node->primitive->value.AsConv2D();
+    MS_ASSERT(conv != nullptr);
+    if (!UseCommonConvKernel(*conv) || node->inputIndex.size() <= kConvWeightIndex) {
+      continue;
+    }
+    auto weightIndex = node->inputIndex.at(kConvWeightIndex);
+    MS_ASSERT(graph->allTensors.size() > weightIndex);
+    auto &weight = graph->allTensors.at(weightIndex);
+    // a weight shared by several convs is packed by the first one
+    if (weight->nodeType != schema::NodeType_ValueNode || weight->dataType != kNumberTypeFloat32 ||
+        weight->format != schema::Format_KHWC || weight->dims.size() != kKHWCDimNum ||
+        weight->packedLayout != schema::PackedWeightLayout_NONE) {
+      continue;
+    }
+    auto status = PrepackConvWeight(*conv, weight.get());
+    if (status == RET_OK) {
+      ifChanged = true;
+    } else if (status != RET_NO_CHANGE) {
+      MS_LOG(ERROR) << "Prepack weight of node " << node->name << " failed: " << status;
+      return status;
+    }
+  }
+  return ifChanged ? RET_OK : RET_NO_CHANGE;
+}
+}  // namespace lite
+}  // namespace mindspore
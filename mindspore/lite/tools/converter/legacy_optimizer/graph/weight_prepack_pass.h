@@ -0,0 +1,38 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_PREDICT_WEIGHT_PREPACK_PASS_H
+#define MINDSPORE_PREDICT_WEIGHT_PREPACK_PASS_H
+
+#include "tools/converter/optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// Stores the fp32 conv weights packed the way the common cpu conv kernel packs them at Init besides the original ones,
+// so the kernel adopts them from the model buffer. The original weights are kept for the kernels selected by the input
+// shape at runtime, like winograd, which pack them differently. Must run after WeightFormatPass.
+class WeightPrepackPass : public GraphPass {
+ public:
+  WeightPrepackPass() = default;
+
+  ~WeightPrepackPass() override = default;
+
+  STATUS Run(schema::MetaGraphT *graph) override;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_PREDICT_WEIGHT_PREPACK_PASS_H
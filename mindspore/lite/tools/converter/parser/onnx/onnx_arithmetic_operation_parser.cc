@@ -232,8 +232,11 @@ STATUS OnnxAsinParser::Parse(const onnx::GraphProto &onnx_graph, const onnx::Nod
 
 STATUS OnnxTanhParser::Parse(const onnx::GraphProto &onnx_graph, const onnx::NodeProto &onnx_node, schema::CNodeT *op) {
   if (op != nullptr) {
+    std::unique_ptr<schema::ActivationT> attr(new schema::ActivationT());
+    attr->type = schema::ActivationType_TANH;
     op->primitive = std::make_unique<schema::PrimitiveT>();
-    op->primitive->value.value = nullptr;
+    op->primitive->value.type = schema::PrimitiveType_Activation;
+    op->primitive->value.value = attr.release();
   }
   return RET_OK;
 }
@@ -25,6 +25,9 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <atomic>
+#include <functional>
+#include <thread>
 #include "schema/inner/model_generated.h"
 #include "src/ir/tensor.h"
 #include "src/common/anf_exporter/anf_exporter.h"
@@ -42,6 +45,31 @@ using std::vector;
 namespace mindspore {
 namespace lite {
 namespace quant {
+namespace {
+// Run func(0) .. func(num - 1) on up to thread_num threads, returns the first error.
+STATUS ParallelRun(size_t num, size_t thread_num, const std::function<STATUS(size_t)> &func) {
+  std::atomic<size_t> next{0};
+  std::atomic<int> status{RET_OK};
+  auto run = [&]() {
+    for (auto index = next++; index < num; index = next++) {
+      auto ret = func(index);
+      if (ret != RET_OK) {
+        int expected = RET_OK;
+        (void)status.compare_exchange_strong(expected, ret);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(thread_num, num); ++i) {
+    threads.emplace_back(run);
+  }
+  run();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return status;
+}
+}  // namespace
 
 struct DivergInfo {
   std::vector<float> histogram;
@@ -66,11 +94,26 @@ struct DivergInfo {
     std::fill(histogram.begin(), histogram.end(), 1.0e-7);
   }
 
-  STATUS RecordMaxValue(const std::vector<float> &datas) {
-    for (float data : datas) {
-      max = std::max(data, max);
-      min = std::min(data, min);
+  STATUS RecordMaxValue(const float *data, size_t size) {
+    // independent lanes let the loop be vectorized
+    constexpr size_t kLaneNum = 8;
+    float lane_max[kLaneNum];
+    float lane_min[kLaneNum];
+    std::fill(lane_max, lane_max + kLaneNum, max);
+    std::fill(lane_min, lane_min + kLaneNum, min);
+    size_t i = 0;
+    for (; i + kLaneNum <= size; i += kLaneNum) {
+      for (size_t j = 0; j < kLaneNum; ++j) {
+        lane_max[j] = std::max(data[i + j], lane_max[j]);
+        lane_min[j] = std::min(data[i + j], lane_min[j]);
+      }
+    }
+    for (; i < size; ++i) {
+      lane_max[0] = std::max(data[i], lane_max[0]);
+      lane_min[0] = std::min(data[i], lane_min[0]);
     }
+    max = *std::max_element(lane_max, lane_max + kLaneNum);
+    min = *std::min_element(lane_min, lane_min + kLaneNum);
     return RET_OK;
   }
 
@@ -79,14 +122,33 @@ struct DivergInfo {
     this->interval = max_value / static_cast<float>(bin_num);
   }
 
-  STATUS UpdateHistogram(const std::vector<float> &data, const std::vector<int> &shape) {
-    for (auto value : data) {
-      int bin_index = std::min(static_cast<int>(std::fabs(value) / this->interval), bin_num - 1);
+  STATUS UpdateHistogram(const float *data, size_t size) {
+    // a tensor of zeros has no interval, or a denormal one, all its values fall in the first bin
+    float scale = this->interval > 0 ? 1.0f / this->interval : 0.0f;
+    if (!std::isfinite(scale)) {
+      scale = 0.0f;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      int bin_index = std::min(static_cast<int>(std::fabs(data[i]) * scale), bin_num - 1);
       this->histogram[bin_index]++;
     }
     return RET_OK;
   }
 
+  std::unique_ptr<DivergInfo> NewLocal() const {
+    std::unique_ptr<DivergInfo> local(new DivergInfo(*this));
+    std::fill(local->histogram.begin(), local->histogram.end(), 0.0f);
+    return local;
+  }
+
+  void Merge(const DivergInfo &local) {
+    max = std::max(local.max, max);
+    min = std::min(local.min, min);
+    for (int i = 0; i < bin_num; ++i) {
+      this->histogram[i] += local.histogram[i];
+    }
+  }
+
   void DumpHistogram() {
     MS_LOG(INFO) << "Print node " << cnode->fullname_with_scope() << " histogram";
     for (float item : this->histogram) {
@@ -98,100 +160,112 @@ struct DivergInfo {
   STATUS ComputeThreshold() {
     constexpr int quant_bint_nums = 128;
     int threshold = quant_bint_nums;
-    float min_kl = FLT_MAX;
-    float after_threshold_sum = std::accumulate(this->histogram.begin() + quant_bint_nums, this->histogram.end(), 0.0f);
+    double min_kl = DBL_MAX;
+    // prefix sums of the histogram, of h * log(h) and of the non-empty bins, with them the divergence of a threshold
+    // is summed up over the quantized bins instead of over the reference bins
+    std::vector<double> sums(this->bin_num + 1, 0);
+    std::vector<double> log_sums(this->bin_num + 1, 0);
+    std::vector<double> nonzero_nums(this->bin_num + 1, 0);
+    for (int k = 0; k < this->bin_num; ++k) {
+      const double item = this->histogram[k];
+      sums[k + 1] = sums[k] + item;
+      log_sums[k + 1] = log_sums[k] + (item > 0 ? item * std::log(item) : 0);
+      nonzero_nums[k + 1] = nonzero_nums[k] + (item != 0 ? 1 : 0);
+    }
+    const double total_sum = sums[this->bin_num];
+    // the expanded bins shared by two quantized bins, the others hold the average of their quantized bin
+    std::vector<double> expanded_histogram(this->bin_num, 0);
+    std::vector<int> edges;
+    std::vector<double> averages(quant_bint_nums, 0);
 
     for (int i = quant_bint_nums; i < this->bin_num; ++i) {
-      std::vector<float> quantized_histogram(quant_bint_nums, 0);
-      std::vector<float> reference_histogram(this->histogram.begin(), this->histogram.begin() + i);
-      std::vector<float> expanded_histogram(i, 0);
-      reference_histogram[i - 1] += after_threshold_sum;
-      after_threshold_sum -= this->histogram[i];
-
-      const float bin_interval = static_cast<float>(i) / static_cast<float>(quant_bint_nums);
-
-      // merge i bins to target bins
-      for (int j = 0; j < quant_bint_nums; ++j) {
-        const float start = j * bin_interval;
-        const float end = start + bin_interval;
-        const int left_upper = static_cast<int>(std::ceil(start));
-        if (left_upper > start) {
-          const double left_scale = left_upper - start;
-          quantized_histogram[j] += left_scale * this->histogram[left_upper - 1];
+      double expanded_sum = 0;
+      double last_expanded = 0;
+      edges.clear();
+      auto add_edge = [&](int index, double value) {
+        if (index >= i) {
+          return;
         }
-        const int right_lower = static_cast<int>(std::floor(end));
-        if (right_lower < end) {
-          const double right_scale = end - right_lower;
-          quantized_histogram[j] += right_scale * this->histogram[right_lower];
+        if (expanded_histogram[index] == 0) {
+          edges.emplace_back(index);
         }
-        std::for_each(this->histogram.begin() + left_upper, this->histogram.begin() + right_lower,
-                      [&quantized_histogram, j](float item) { quantized_histogram[j] += item; });
-      }
-      // expand target bins to i bins in order to calculate KL with reference_histogram
+        expanded_histogram[index] += value;
+        expanded_sum += value;
+      };
+      // merge i bins to target bins and expand them back
       for (int j = 0; j < quant_bint_nums; ++j) {
-        const float start = j * bin_interval;
-        const float end = start + bin_interval;
-        float count = 0;
-        const int left_upper = static_cast<int>(std::ceil(start));
-        float left_scale = 0.0f;
-        if (left_upper > start) {
-          left_scale = left_upper - start;
-          if (this->histogram[left_upper - 1] != 0) {
-            count += left_scale;
-          }
+        // the target bin j covers [j * i / 128, (j + 1) * i / 128) of the i bins
+        const int left_upper = (j * i + quant_bint_nums - 1) / quant_bint_nums;
+        const int right_lower = (j + 1) * i / quant_bint_nums;
+        double merged = sums[right_lower] - sums[left_upper];
+        double count = nonzero_nums[right_lower] - nonzero_nums[left_upper];
+        const double left_scale = static_cast<double>(left_upper * quant_bint_nums - j * i) / quant_bint_nums;
+        const double right_scale = static_cast<double>((j + 1) * i - right_lower * quant_bint_nums) / quant_bint_nums;
+        if (left_scale > 0) {
+          merged += left_scale * this->histogram[left_upper - 1];
+          count += this->histogram[left_upper - 1] != 0 ? left_scale : 0;
         }
-        const int right_lower = static_cast<int>(std::floor(end));
-        double right_scale = 0.0f;
-        if (right_lower < end) {
-          right_scale = end - right_lower;
-          if (this->histogram[right_lower] != 0) {
-            count += right_scale;
-          }
+        if (right_scale > 0) {
+          merged += right_scale * this->histogram[right_lower];
+          count += this->histogram[right_lower] != 0 ? right_scale : 0;
         }
-        std::for_each(this->histogram.begin() + left_upper, this->histogram.begin() + right_lower,
-                      [&count](float item) {
-                        if (item != 0) {
-                          count += 1;
-                        }
-                      });
+        averages[j] = 0;
         if (count == 0) {
           continue;
         }
-        const float average_num = quantized_histogram[j] / count;
-        if (left_upper > start && this->histogram[left_upper - 1] != 0) {
-          expanded_histogram[left_upper - 1] += average_num * left_scale;
+        const double average_num = merged / count;
+        averages[j] = average_num;
+        if (left_scale > 0 && this->histogram[left_upper - 1] != 0) {
+          add_edge(left_upper - 1, average_num * left_scale);
         }
-        if (right_lower < end && this->histogram[right_lower] != 0) {
-          expanded_histogram[right_lower] += average_num * right_scale;
+        if (right_scale > 0 && this->histogram[right_lower] != 0) {
+          add_edge(right_lower, average_num * right_scale);
         }
-        for (int k = left_upper; k < right_lower; ++k) {
-          if (this->histogram[k] != 0) {
-            expanded_histogram[k] += average_num;
-          }
+        expanded_sum += average_num * (nonzero_nums[std::min(right_lower, i)] - nonzero_nums[left_upper]);
+        if (left_upper <= i - 1 && i - 1 < right_lower && this->histogram[i - 1] != 0) {
+          last_expanded = average_num;
         }
       }
-      auto KLDivergence = [](std::vector<float> p, std::vector<float> q) {
-        auto sum = 0.0f;
-        std::for_each(p.begin(), p.end(), [&sum](float item) { sum += item; });
-        std::for_each(p.begin(), p.end(), [sum](float &item) { item /= sum; });
-        sum = 0.0f;
-        std::for_each(q.begin(), q.end(), [&sum](float item) { sum += item; });
-        std::for_each(q.begin(), q.end(), [sum](float &item) { item /= sum; });
-
-        float result = 0.0f;
-        const int size = p.size();
-        for (int i = 0; i < size; ++i) {
-          if (p[i] != 0) {
-            if (q[i] == 0) {
-              result += 1.0f;
-            } else {
-              result += (p[i] * std::log((p[i]) / (q[i])));
-            }
-          }
+      if (expanded_sum <= 0) {
+        continue;
+      }
+      // kl(p, q) with p the first i bins, the bins after them counted in the last one, and q the expanded bins
+      const double log_ratio = std::log(expanded_sum) - std::log(total_sum);
+      // a reference bin expanded to nothing costs 1 as a whole
+      double missed = 0;
+      auto divergence = [log_ratio, &missed](double p, double q) {
+        if (q == 0) {
+          missed += 1;
+          return 0.0;
         }
-        return result;
+        return p * (std::log(p / q) + log_ratio);
       };
-      const float kl = KLDivergence(reference_histogram, expanded_histogram);
+      double kl = 0;
+      for (int j = 0; j < quant_bint_nums; ++j) {
+        if (averages[j] == 0) {
+          continue;
+        }
+        const int left_upper = (j * i + quant_bint_nums - 1) / quant_bint_nums;
+        const int right_lower = std::min((j + 1) * i / quant_bint_nums, i - 1);
+        if (right_lower <= left_upper) {
+          continue;
+        }
+        const double item_sum = sums[right_lower] - sums[left_upper];
+        kl += (log_sums[right_lower] - log_sums[left_upper]) - item_sum * (std::log(averages[j]) - log_ratio);
+      }
+      for (auto index : edges) {
+        if (index == i - 1) {
+          last_expanded = expanded_histogram[index];
+        } else {
+          kl += divergence(this->histogram[index], expanded_histogram[index]);
+        }
+        expanded_histogram[index] = 0;
+      }
+      const double last_reference = this->histogram[i - 1] + (total_sum - sums[i]);
+      if (last_reference != 0) {
+        kl += divergence(last_reference, last_expanded);
+      }
+      kl = kl / total_sum + missed;
       if (kl < min_kl) {
         min_kl = kl;
         threshold = i;
@@ -289,43 +363,57 @@ std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *Calibrator::GetOut
   return &this->output_diverg_info_;
 }
 
-STATUS Calibrator::RecordMaxValue(std::string opName, vector<float> data,
-                                  std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *mDivergInfo) {
-  auto got = (*mDivergInfo).find(opName);
-  if (got != (*mDivergInfo).end()) {
-    ((*got).second)->RecordMaxValue(data);
+STATUS Calibrator::RecordMaxValue(const std::string &op_name, const float *data, size_t size,
+                                  DivergInfoMap *diverg_info) {
+  auto got = diverg_info->find(op_name);
+  if (got != diverg_info->end()) {
+    got->second->RecordMaxValue(data, size);
   }
   return RET_OK;
 }
 
 STATUS Calibrator::ComputeThreshold() {
+  // node A's input may be node B's output, no need to re-compute the node A's input quant param which is the same as
+  // node B's output one
+  std::vector<DivergInfo *> to_compute;
+  std::vector<std::pair<DivergInfo *, DivergInfo *>> to_copy;
   for (auto iter = this->output_diverg_info_.begin(); iter != this->output_diverg_info_.end(); iter++) {
-    DivergInfo *info = iter->second.get();
-    info->ComputeThreshold();
+    to_compute.emplace_back(iter->second.get());
   }
-  // node A's input may be node B's output, no need to re-compute the node A's input quant param which is the same as
   for (auto iter = this->input_diverg_info_.begin(); iter != this->input_diverg_info_.end(); iter++) {
     DivergInfo *info = iter->second.get();
     auto cnode = info->cnode;
 
-    bool already_computed = false;
+    DivergInfo *computed = nullptr;
     auto input = cnode->input(1);
     if (input->isa<mindspore::CNode>()) {
       auto input_cnode = std::dynamic_pointer_cast<mindspore::CNode>(input);
       for (const auto &output_diverg_info : output_diverg_info_) {
         auto output_diverg_cnode = output_diverg_info.second->cnode;
         if (output_diverg_cnode == input_cnode) {
-          *info = *(output_diverg_info.second);
-          info->cnode = cnode;
-          already_computed = true;
+          computed = output_diverg_info.second.get();
           break;
         }
       }
     }
-    if (!already_computed) {
-      info->ComputeThreshold();
+    if (computed != nullptr) {
+      to_copy.emplace_back(info, computed);
+    } else {
+      to_compute.emplace_back(info);
     }
   }
+  // the thresholds of the tensors are searched independently
+  auto status = ParallelRun(to_compute.size(), config_param_.thread_num,
+                            [&to_compute](size_t index) { return to_compute[index]->ComputeThreshold(); });
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "compute threshold failed: " << status;
+    return status;
+  }
+  for (auto &item : to_copy) {
+    auto cnode = item.first->cnode;
+    *(item.first) = *(item.second);
+    item.first->cnode = cnode;
+  }
   return RET_OK;
 }
 
@@ -337,15 +425,33 @@ STATUS Calibrator::UpdateDivergInverval(std::unordered_map<std::string, std::uni
   return RET_OK;
 }
 
-STATUS Calibrator::UpdateDataFrequency(std::string op_name, vector<float> data, vector<int> shape,
-                                       std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *diverg_info) {
-  auto got = (*diverg_info).find(op_name);
-  if (got != (*diverg_info).end()) {
-    ((*got).second)->UpdateHistogram(data, shape);
+STATUS Calibrator::UpdateDataFrequency(const std::string &op_name, const float *data, size_t size,
+                                       DivergInfoMap *diverg_info) {
+  auto got = diverg_info->find(op_name);
+  if (got != diverg_info->end()) {
+    got->second->UpdateHistogram(data, size);
   }
   return RET_OK;
 }
 
+void Calibrator::NewLocalDivergInfo(DivergInfoMap *input_diverg_info, DivergInfoMap *output_diverg_info) const {
+  for (const auto &item : input_diverg_info_) {
+    (*input_diverg_info)[item.first] = item.second->NewLocal();
+  }
+  for (const auto &item : output_diverg_info_) {
+    (*output_diverg_info)[item.first] = item.second->NewLocal();
+  }
+}
+
+void Calibrator::MergeDivergInfo(const DivergInfoMap &input_diverg_info, const DivergInfoMap &output_diverg_info) {
+  for (const auto &item : input_diverg_info) {
+    input_diverg_info_[item.first]->Merge(*item.second);
+  }
+  for (const auto &item : output_diverg_info) {
+    output_diverg_info_[item.first]->Merge(*item.second);
+  }
+}
+
 STATUS Calibrator::AddQuantizedOp(CNodePtr node) {
   if (node == nullptr) {
     MS_LOG(ERROR) << "To be quantized node is null";
@@ -378,15 +484,23 @@ void Calibrator::AddImage(const string file) {
 STATUS Calibrator::GenerateInputData(const int index, mindspore::tensor::MSTensor *tensor) const {
   string path = images_[index];
   MS_LOG(INFO) << "read image: " << path;
-  size_t size;
-  char *binBuf = ReadFile(path.c_str(), &size);
-
-  //  auto *rawinputDatas = reinterpret_cast<const float *>(binBuf);
-  //  auto mobilenet_input = const_cast<float *>(rawinputDatas);
+  size_t size = 0;
+  std::unique_ptr<char[]> binBuf(ReadFile(path.c_str(), &size));
+  if (binBuf == nullptr) {
+    MS_LOG(ERROR) << "read image failed: " << path;
+    return RET_ERROR;
+  }
+  if (size > tensor->Size()) {
+    MS_LOG(ERROR) << "image " << path << " has " << size << " bytes, more than " << tensor->Size()
+                  << " bytes of the input tensor";
+    return RET_ERROR;
+  }
   auto data = tensor->MutableData();
-  memcpy(data, binBuf, size);
-
-  //  tensor->SetData(mobilenet_input);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "malloc input data failed";
+    return RET_ERROR;
+  }
+  memcpy(data, binBuf.get(), size);
   return RET_OK;
 }
 
@@ -454,13 +568,22 @@ STATUS Calibrator::ReadConfig() {
       config_param_.batch_count = std::stoul(value);
     } else if (key == "thread_num") {
       config_param_.thread_num = std::stoul(value);
+    } else if (key == "per_channel") {
+      config_param_.per_channel = value == "true" || value == "1";
+      // the int8 kernels read the first quant param of a weight only
+      if (config_param_.per_channel) {
+        MS_LOG(ERROR) << "per_channel quantization is not supported by the int8 kernels yet, set per_channel=false";
+        delete[] resolved_path;
+        return RET_PARAM_INVALID;
+      }
     } else {
       MS_LOG(WARNING) << "unsupported parameter";
     }
   }
   MS_LOG(INFO) << "image_path: " << config_param_.image_path << "  "
                << "batch_count: " << config_param_.batch_count << "  "
-               << "thread_num: " << config_param_.thread_num;
+               << "thread_num: " << config_param_.thread_num << "  "
+               << "per_channel: " << config_param_.per_channel;
 
   delete[] resolved_path;
   fs.close();
@@ -533,7 +656,8 @@ STATUS PostTrainingQuantizer::DoWeightQuant(AnfNodePtr node) {
   }
   auto parameter = std::dynamic_pointer_cast<Parameter>(node);
   ParamValueLitePtr paramValue = std::dynamic_pointer_cast<ParamValueLite>(parameter->default_param());
-  auto status = QuantFilter(paramValue, QuantType_PostTraining, quant_max, quant_min, bit_num);
+  auto status =
+    QuantFilter(paramValue, QuantType_PostTraining, quant_max, quant_min, bit_num, calibrator_->GetPerChannel());
   if (status != RET_OK) {
     MS_LOG(ERROR) << "QuantFilter failed: " << status;
     return status;
@@ -767,25 +891,87 @@ STATUS PostTrainingQuantizer::CheckTensorVec(const std::string &nodeName,
   return RET_OK;
 }
 
+STATUS PostTrainingQuantizer::CreateSessions(FuncGraphPtr funcGraph) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, Export(funcGraph));
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  auto *content = reinterpret_cast<const char *>(builder.GetBufferPointer());
+  if (content == nullptr) {
+    MS_LOG(ERROR) << "GetBufferPointer nullptr";
+    return RET_ERROR;
+  }
+  model_ = lite::Model::Import(content, size);
+  if (model_ == nullptr) {
+    MS_LOG(ERROR) << "import model failed";
+    return RET_ERROR;
+  }
+  // batches run faster side by side on single threaded sessions than one by one on a parallel one, the sessions share
+  // the packed weights of the model
+  size_t thread_num = std::max(calibrator_->GetThreadNum(), 1u);
+  size_t session_num = std::max(std::min(thread_num, calibrator_->GetBatchNum()), static_cast<size_t>(1));
+  for (size_t i = 0; i < session_num; i++) {
+    Context ctx;
+    ctx.device_ctx_.type = DT_CPU;
+    ctx.thread_num_ = static_cast<int>(thread_num / session_num);
+    ctx.cpu_bind_mode_ = session_num > 1 ? NO_BIND : MID_CPU;
+    std::unique_ptr<session::LiteSession> session(session::LiteSession::CreateSession(&ctx));
+    if (session == nullptr) {
+      MS_LOG(ERROR) << "create session failed!";
+      return RET_ERROR;
+    }
+    auto ret = session->CompileGraph(model_.get());
+    if (ret != lite::RET_OK) {
+      MS_LOG(ERROR) << "compile graph error";
+      return RET_ERROR;
+    }
+    sessions_.emplace_back(std::move(session));
+  }
+  MS_LOG(INFO) << "calibrate on " << session_num << " sessions of " << thread_num / session_num << " threads";
+  return RET_OK;
+}
+
 /**
  * 1. create input tensor
  * 2. insert callback to session
  * 3. run session
+ * Batch i runs on session i % session_num, each session on a thread of its own records into diverg info of its own,
+ * which are merged into the calibrator after all batches.
  **/
-STATUS PostTrainingQuantizer::DoInference() {
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
-    // TODO(x) when model has inputs count > 1
-    // get input tensor
-    vector<mindspore::tensor::MSTensor *> inputs = session_->GetInputs();
-    if (inputs.size() > 1) {
-      MS_LOG(ERROR) << "model's input tensor size: " << inputs.size() << " >1";
+STATUS PostTrainingQuantizer::RunCalibration(bool update_histogram) {
+  // TODO(x) when model has inputs count > 1
+  for (auto &session : sessions_) {
+    if (session->GetInputs().size() > 1) {
+      MS_LOG(ERROR) << "model's input tensor size: " << session->GetInputs().size() << " > 1";
       return RET_ERROR;
     }
-    STATUS status = calibrator_->GenerateInputData(i, inputs.front());
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "generate input data from images failed!";
-      return RET_ERROR;
+  }
+  size_t session_num = sessions_.size();
+  std::vector<DivergInfoMap> input_diverg_infos(session_num);
+  std::vector<DivergInfoMap> output_diverg_infos(session_num);
+  for (size_t i = 0; i < session_num; i++) {
+    calibrator_->NewLocalDivergInfo(&input_diverg_infos[i], &output_diverg_infos[i]);
+  }
+  auto record = [this, update_histogram](const std::string &node_name,
+                                         const std::vector<mindspore::tensor::MSTensor *> &tensors,
+                                         DivergInfoMap *diverg_info) {
+    if (PostTrainingQuantizer::CheckTensorVec(node_name, tensors) != RET_OK) {
+      return false;
+    }
+    auto tensor = tensors[0];
+    const float *tensor_data = static_cast<const float *>(tensor->MutableData());
+    size_t shape_size = tensor->ElementsNum();
+    if (update_histogram) {
+      this->calibrator_->UpdateDataFrequency(node_name, tensor_data, shape_size, diverg_info);
+    } else {
+      this->calibrator_->RecordMaxValue(node_name, tensor_data, shape_size, diverg_info);
     }
+    return true;
+  };
+  auto status = ParallelRun(session_num, session_num, [&](size_t index) {
+    auto &session = sessions_[index];
+    auto input_diverg_info = &input_diverg_infos[index];
+    auto output_diverg_info = &output_diverg_infos[index];
     /**
      * struct CallBackParam {
          std::string nodeType;
@@ -794,100 +980,45 @@ STATUS PostTrainingQuantizer::DoInference() {
          int opExecResult;
        };
     */
-    mindspore::session::KernelCallBack beforeCallBack =
-      [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
-          const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
-          const mindspore::session::CallBackParam &callParam) -> bool {
-      if (PostTrainingQuantizer::CheckTensorVec(callParam.name_callback_param, beforeInputs) != RET_OK) {
-        return false;
-      }
-      auto tensor = beforeInputs[0];
-      const float *tData = static_cast<const float *>(tensor->MutableData());
-      size_t shapeSize = tensor->ElementsNum();
-      vector<float> data(tData, tData + shapeSize);
-      this->calibrator_->RecordMaxValue(callParam.name_callback_param, data, this->calibrator_->GetInputDivergInfo());
-      return true;
-    };
-    // func
-    mindspore::session::KernelCallBack afterCallBack = [&](
-                                                         const std::vector<mindspore::tensor::MSTensor *> &afterInputs,
-                                                         const std::vector<mindspore::tensor::MSTensor *> &afterOutputs,
-                                                         const mindspore::session::CallBackParam &callParam) -> bool {
-      if (PostTrainingQuantizer::CheckTensorVec(callParam.name_callback_param, afterOutputs) != RET_OK) {
-        return false;
-      }
-      auto tensor = afterOutputs[0];
-      const float *tensor_data = static_cast<const float *>(tensor->MutableData());
-      size_t shape_size = tensor->ElementsNum();
-      vector<float> data(tensor_data, tensor_data + shape_size);
-      this->calibrator_->RecordMaxValue(callParam.name_callback_param, data, this->calibrator_->GetOutputDivergInfo());
-      return true;
-    };
-    status = session_->RunGraph(beforeCallBack, afterCallBack);
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "run model failed!";
-      return RET_ERROR;
-    }
-  }
-  return RET_OK;
-}
-
-STATUS PostTrainingQuantizer::CollectDataFrequency() {
-  for (size_t i = 0; i < calibrator_->GetBatchNum(); i++) {
-    // TODO(x) when model has inputs count > 1
-    // get input tensor
-    vector<mindspore::tensor::MSTensor *> inputs = session_->GetInputs();
-    if (inputs.size() > 1) {
-      MS_LOG(ERROR) << "model's input tensor size: " << inputs.size() << " > 1";
-      return RET_ERROR;
-    }
-    STATUS status = calibrator_->GenerateInputData(i, inputs.front());
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "generate input data from images failed!";
-      return RET_ERROR;
-    }
-
     mindspore::session::KernelCallBack beforeCallBack =
       [&](const std::vector<mindspore::tensor::MSTensor *> &beforeInputs,
           const std::vector<mindspore::tensor::MSTensor *> &beforeOutputs,
           const mindspore::session::CallBackParam &callParam) {
-        if (PostTrainingQuantizer::CheckTensorVec(callParam.name_callback_param, beforeInputs) != RET_OK) {
-          return false;
-        }
-        auto tensor = beforeInputs[0];
-        const float *tensor_data = static_cast<const float *>(tensor->MutableData());
-        size_t shape_size = tensor->ElementsNum();
-        vector<float> data(tensor_data, tensor_data + shape_size);
-        this->calibrator_->UpdateDataFrequency(callParam.name_callback_param, data, tensor->shape(),
-                                               this->calibrator_->GetInputDivergInfo());
-        return true;
+        return record(callParam.name_callback_param, beforeInputs, input_diverg_info);
       };
-
     mindspore::session::KernelCallBack afterCallBack =
-      [&](const std::vector<mindspore::tensor::MSTensor *> &after_inputs,
-          const std::vector<mindspore::tensor::MSTensor *> &after_outputs,
-          const mindspore::session::CallBackParam &call_param) {
-        if (PostTrainingQuantizer::CheckTensorVec(call_param.name_callback_param, after_outputs) != RET_OK) {
-          return false;
-        }
-        auto tensor = after_outputs[0];
-        const float *tenosr_data = static_cast<const float *>(tensor->MutableData());
-        size_t shape_size = tensor->ElementsNum();
-        vector<float> data(tenosr_data, tenosr_data + shape_size);
-        this->calibrator_->UpdateDataFrequency(call_param.name_callback_param, data, tensor->shape(),
-                                               this->calibrator_->GetOutputDivergInfo());
-        return true;
+      [&](const std::vector<mindspore::tensor::MSTensor *> &afterInputs,
+          const std::vector<mindspore::tensor::MSTensor *> &afterOutputs,
+          const mindspore::session::CallBackParam &callParam) {
+        return record(callParam.name_callback_param, afterOutputs, output_diverg_info);
       };
-    status = session_->RunGraph(beforeCallBack, afterCallBack);
-    if (status != RET_OK) {
-      MS_LOG(ERROR) << "run model failed!";
-      return RET_ERROR;
+    for (size_t i = index; i < calibrator_->GetBatchNum(); i += session_num) {
+      STATUS ret = calibrator_->GenerateInputData(i, session->GetInputs().front());
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "generate input data from images failed!";
+        return RET_ERROR;
+      }
+      ret = session->RunGraph(beforeCallBack, afterCallBack);
+      if (ret != RET_OK) {
+        MS_LOG(ERROR) << "run model failed!";
+        return RET_ERROR;
+      }
     }
+    return RET_OK;
+  });
+  if (status != RET_OK) {
+    return status;
+  }
+  for (size_t i = 0; i < session_num; i++) {
+    calibrator_->MergeDivergInfo(input_diverg_infos[i], output_diverg_infos[i]);
   }
-
   return RET_OK;
 }
 
+STATUS PostTrainingQuantizer::DoInference() { return RunCalibration(false); }
+
+STATUS PostTrainingQuantizer::CollectDataFrequency() { return RunCalibration(true); }
+
 STATUS PostTrainingQuantizer::ComputeThreshold() { return this->calibrator_->ComputeThreshold(); }
 
 STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr funcGraph) {
@@ -898,32 +1029,9 @@ STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr funcGraph) {
     return status;
   }
   MS_LOG(INFO) << "start create session";
-  flatbuffers::FlatBufferBuilder builder(1024);
-  auto offset = schema::MetaGraph::Pack(builder, Export(funcGraph));
-  builder.Finish(offset);
-  size_t size = builder.GetSize();
-  auto *content = reinterpret_cast<const char *>(builder.GetBufferPointer());
-  if (content == nullptr) {
-    MS_LOG(ERROR) << "GetBufferPointer nullptr";
-    return RET_ERROR;
-  }
-  auto model = lite::Model::Import(content, size);
-
-  Context ctx;
-  ctx.device_ctx_.type = DT_CPU;
-  ctx.thread_num_ = calibrator_->GetThreadNum();
-  ctx.cpu_bind_mode_ = MID_CPU;
-
-  session_ = dynamic_cast<mindspore::lite::LiteSession *>(session::LiteSession::CreateSession(&ctx));
-  if (session_ == nullptr) {
-    MS_LOG(ERROR) << "create session failed!";
-    return RET_ERROR;
-  }
-
-  auto ret = session_->CompileGraph(model.get());
-  if (ret != lite::RET_OK) {
-    MS_LOG(ERROR) << "compile graph error";
-    return RET_ERROR;
+  status = CreateSessions(funcGraph);
+  if (status != RET_OK) {
+    return status;
   }
 
   MS_LOG(INFO) << "start to update divergence's max value";
@@ -951,6 +1059,8 @@ STATUS PostTrainingQuantizer::DoQuantize(FuncGraphPtr funcGraph) {
   if (status != RET_OK) {
     return status;
   }
+  sessions_.clear();
+  model_ = nullptr;
   return RET_OK;
 }
 }  // namespace quant
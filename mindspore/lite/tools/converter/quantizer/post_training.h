@@ -49,10 +49,16 @@ enum ImageFormat {
 struct ConfigParam {
   // ImageFormat imageFormat;
   std::string image_path;
-  uint32_t batch_count;
-  uint32_t thread_num;
+  uint32_t batch_count{0};
+  // the calibration batches run on up to thread_num single threaded sessions at once
+  uint32_t thread_num{1};
+  // quantize the weights channel by channel instead of layer by layer
+  bool per_channel{false};
 };
 
+struct DivergInfo;
+using DivergInfoMap = std::unordered_map<std::string, std::unique_ptr<DivergInfo>>;
+
 class PostTrainingQuantizer : public Quantizer {
  public:
   PostTrainingQuantizer(FuncGraphPtr graph, std::string path, int bit_num, TypeId target_type = kNumberTypeInt8);
@@ -68,10 +74,16 @@ class PostTrainingQuantizer : public Quantizer {
 
   std::unique_ptr<Calibrator> calibrator_;
 
-  mindspore::lite::LiteSession *session_;
+  std::shared_ptr<lite::Model> model_;
+  // declared after the model, the sessions are freed before it
+  std::vector<std::unique_ptr<session::LiteSession>> sessions_;
 
   STATUS PreProcess();
 
+  STATUS CreateSessions(FuncGraphPtr funcGraph);
+
+  STATUS RunCalibration(bool update_histogram);
+
   STATUS CheckTensorVec(const std::string &nodeName, const std::vector<mindspore::tensor::MSTensor *> &tensorVec) const;
 
   STATUS DoInference();
@@ -94,8 +106,6 @@ class PostTrainingQuantizer : public Quantizer {
   STATUS DoBiasQuant(std::shared_ptr<PrimitiveTValue> input, AnfNodePtr weight, AnfNodePtr bias);
 };
 
-struct DivergInfo;
-
 class Calibrator {
  public:
   explicit Calibrator(std::string path, size_t quant_size, int quant_max, int quant_msin);
@@ -112,15 +122,21 @@ class Calibrator {
 
   uint32_t GetThreadNum() const { return config_param_.thread_num; }
 
+  bool GetPerChannel() const { return config_param_.per_channel; }
+
   STATUS AddQuantizedOp(CNodePtr node);
 
-  STATUS RecordMaxValue(std::string opName, std::vector<float> data,
-                        std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *diverg_info);
+  STATUS RecordMaxValue(const std::string &op_name, const float *data, size_t size, DivergInfoMap *diverg_info);
 
   STATUS UpdateDivergInverval(std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *diverg_info);
 
-  STATUS UpdateDataFrequency(std::string op_name, std::vector<float> data, std::vector<int> shape,
-                             std::unordered_map<std::string, std::unique_ptr<DivergInfo>> *diverg_info);
+  STATUS UpdateDataFrequency(const std::string &op_name, const float *data, size_t size, DivergInfoMap *diverg_info);
+
+  // Copies of the diverg info with nothing recorded yet, for a calibration session to record into.
+  void NewLocalDivergInfo(DivergInfoMap *input_diverg_info, DivergInfoMap *output_diverg_info) const;
+
+  // Merge what a calibration session recorded into its copies.
+  void MergeDivergInfo(const DivergInfoMap &input_diverg_info, const DivergInfoMap &output_diverg_info);
   void Dump();
 
   STATUS ComputeThreshold();
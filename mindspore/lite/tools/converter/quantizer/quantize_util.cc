@@ -242,13 +242,14 @@ STATUS CalQuantizationParams(std::unique_ptr<AnfQuantParam> &quantParam, double
     return RET_OK;
 }
 
-STATUS QuantFilter(ParamValueLitePtr &weightPtr, QuantType quantType, int quant_max, int quant_min, size_t bitNum) {
+STATUS QuantFilter(ParamValueLitePtr &weightPtr, QuantType quantType, int quant_max, int quant_min, size_t bitNum,
+                   bool perChannel) {
     auto dims = weightPtr->tensor_shape();
     if (dims.size() < 1) {
         MS_LOG(ERROR) << "weight dims size error";
         return RET_ERROR;
     }
-    uint32_t channels = dims[0];
+    uint32_t channels = perChannel ? dims[0] : 1;
     if (channels == 0) {
         MS_LOG(ERROR) << "channels error 0";
         return RET_ERROR;
@@ -282,7 +283,9 @@ STATUS QuantFilter(ParamValueLitePtr &weightPtr, QuantType quantType, int quant_
         // update data and datatype
         for (uint32_t j = 0; j < oneFilterSize; j++) {
             float rawData = rawDatas[j + i * oneFilterSize];
-            auto qData = QuantizeData<uint8_t>(rawData, quantParam.get());
+            // a channel of zeros has no scale
+            auto qData = quantParam->scale == 0 ? static_cast<uint8_t>(quantParam->zeroPoint)
+                                                : QuantizeData<uint8_t>(rawData, quantParam.get());
             qDatas[j + i * oneFilterSize] = qData;
         }
 
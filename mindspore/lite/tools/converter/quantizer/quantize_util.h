@@ -96,8 +96,9 @@ T QuantizeData(const float originData, const AnfQuantParam *quantParam) {
 
 void CalFakeNode(const AnfNodePtr &inTensor);
 
+// Quantize the weight channel by channel along its first dimension if perChannel, else by one quant param.
 STATUS QuantFilter(ParamValueLitePtr &weightPtr, QuantType quantType, int quant_max, int quant_min,
-                   size_t bitNum = UINT8_QUANTIZATION);
+                   size_t bitNum = UINT8_QUANTIZATION, bool perChannel = true);
 
 STATUS PostBitPack(float *weights, size_t shapeSize, size_t bitNum = UINT8_QUANTIZATION);
 
@@ -14,7 +14,7 @@
 # ============================================================================
 """Utils of auto parallel"""
 
-from mindspore._c_expression import reset_op_id
+from mindspore._c_expression import reset_op_id, save_ps_checkpoint, load_ps_checkpoint
 from mindspore.communication.management import get_group_size, get_rank
 from mindspore.parallel._auto_parallel_context import auto_parallel_context
 
@@ -134,3 +134,16 @@ def _get_python_op(op_name, op_path, instance_name, arglist):
 def _reset_op_id():
     """Reset op id."""
     reset_op_id()
+
+
+def _save_ps_checkpoint(incremental=False):
+    """
+    Ask the parameter servers to save their weight shards and optimizer states to MS_PS_CKPT_PATH, to be called by
+    one worker. An incremental checkpoint only holds the rows of sparse weights updated since the previous one.
+    """
+    save_ps_checkpoint(incremental)
+
+
+def _load_ps_checkpoint():
+    """Ask the parameter servers to restore the newest checkpoint in MS_PS_CKPT_PATH, to be called by one worker."""
+    load_ps_checkpoint()
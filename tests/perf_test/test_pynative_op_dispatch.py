@@ -0,0 +1,76 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Pynative single op dispatch test."""
+
+import time
+
+import numpy as np
+
+from mindspore import Tensor
+from mindspore import context
+from mindspore._c_expression import PynativeExecutor_
+from mindspore.ops import operations as P
+
+warmup_steps = 10
+steps = 1000
+
+
+def dispatch_time_us(op, *inputs):
+    """Average time of running a cached single op graph, in microseconds."""
+    for _ in range(warmup_steps):
+        op(*inputs)
+    start = time.perf_counter()
+    for _ in range(steps):
+        out = op(*inputs)
+    # Waits for the ops dispatched to the backend thread.
+    out.asnumpy()
+    return (time.perf_counter() - start) * 1e6 / steps
+
+
+def test_op_dispatch():
+    """Run small ops repeatedly, only the first run builds their graphs"""
+    mode = context.get_context("mode")
+    enable_async = context.get_context("enable_pynative_async")
+    context.set_context(mode=context.PYNATIVE_MODE)
+    try:
+        x = Tensor(np.arange(6).reshape([2, 3]).astype(np.float32))
+        y = Tensor(np.ones([2, 3]).astype(np.float32))
+        w = Tensor(np.arange(12).reshape([3, 4]).astype(np.float32))
+        cases = {
+            "TensorAdd": (P.TensorAdd(), (x, y)),
+            "MatMul": (P.MatMul(), (x, w)),
+            "ReduceSum": (P.ReduceSum(keep_dims=True), (x, 1)),
+        }
+        context.set_context(enable_pynative_async=False)
+        expects = {name: op(*inputs).asnumpy() for name, (op, inputs) in cases.items()}
+        assert np.allclose(expects["TensorAdd"], x.asnumpy() + y.asnumpy())
+        assert np.allclose(expects["MatMul"], np.matmul(x.asnumpy(), w.asnumpy()))
+        assert np.allclose(expects["ReduceSum"], np.sum(x.asnumpy(), axis=1, keepdims=True))
+
+        executor = PynativeExecutor_.get_instance()
+        for enable in (False, True):
+            context.set_context(enable_pynative_async=enable)
+            for name, (op, inputs) in cases.items():
+                hits = executor.single_op_cache_hits()
+                misses = executor.single_op_cache_misses()
+                cost = dispatch_time_us(op, *inputs)
+                # Every run finds the graph built by the first run.
+                assert executor.single_op_cache_hits() - hits == warmup_steps + steps
+                assert executor.single_op_cache_misses() == misses
+                assert np.allclose(op(*inputs).asnumpy(), expects[name])
+                print("op {} dispatch {:.1f} us, async {}".format(name, cost, enable))
+    finally:
+        context.set_context(mode=mode, enable_pynative_async=enable_async)
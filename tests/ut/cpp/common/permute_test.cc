@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "common/permute.h"
+#include "common/trans.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace common {
+class PermuteTest : public UT::Common {
+ public:
+  PermuteTest() = default;
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// Element-by-element transpose used as the reference.
+template <typename T>
+std::vector<T> NaivePermute(const std::vector<T> &src, const std::vector<size_t> &shape,
+                            const std::vector<size_t> &perm) {
+  size_t rank = shape.size();
+  std::vector<size_t> src_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    src_strides[i - 1] = src_strides[i] * shape[i];
+  }
+  std::vector<T> dst(src.size());
+  std::vector<size_t> index(rank, 0);
+  for (size_t d = 0; d < dst.size(); ++d) {
+    size_t offset = 0;
+    for (size_t i = 0; i < rank; ++i) {
+      offset += index[i] * src_strides[perm[i]];
+    }
+    dst[d] = src[offset];
+    for (size_t i = rank; i > 0; --i) {
+      if (++index[i - 1] < shape[perm[i - 1]]) {
+        break;
+      }
+      index[i - 1] = 0;
+    }
+  }
+  return dst;
+}
+
+template <typename T>
+void CheckPermute(const std::vector<size_t> &shape, const std::vector<size_t> &perm) {
+  size_t size = 1;
+  for (auto dim : shape) {
+    size *= dim;
+  }
+  std::vector<T> src(size);
+  for (size_t i = 0; i < size; ++i) {
+    src[i] = static_cast<T>(i * 7 + 3);
+  }
+  std::vector<T> dst(size);
+  Permute(src.data(), dst.data(), shape, perm, sizeof(T));
+  EXPECT_EQ(dst, NaivePermute(src, shape, perm));
+}
+
+TEST_F(PermuteTest, transpose_2d) {
+  CheckPermute<float>({4, 4}, {1, 0});
+  CheckPermute<float>({67, 133}, {1, 0});
+  CheckPermute<uint16_t>({512, 300}, {1, 0});
+  CheckPermute<double>({3, 1000}, {1, 0});
+}
+
+TEST_F(PermuteTest, transpose_nd) {
+  CheckPermute<float>({2, 3, 4, 5}, {0, 2, 3, 1});
+  CheckPermute<float>({8, 33, 17, 19}, {0, 3, 1, 2});
+  CheckPermute<uint8_t>({5, 1, 7, 1, 9}, {4, 2, 0, 3, 1});
+  CheckPermute<int64_t>({16, 16, 16}, {2, 1, 0});
+  CheckPermute<int32_t>({6, 7, 8, 9}, {0, 1, 2, 3});
+}
+
+TEST_F(PermuteTest, invalid_perm) {
+  std::vector<float> data(6);
+  EXPECT_ANY_THROW(Permute(data.data(), data.data(), {2, 3}, {0, 0}, sizeof(float)));
+  EXPECT_ANY_THROW(Permute(data.data(), data.data(), {2, 3}, {0, 2}, sizeof(float)));
+  EXPECT_ANY_THROW(Permute(data.data(), data.data(), {2, 3}, {0}, sizeof(float)));
+}
+
+TEST_F(PermuteTest, strided_copy_concat) {
+  // Concat [2, 3] and [2, 5] along the last axis.
+  std::vector<float> a{1, 2, 3, 4, 5, 6};
+  std::vector<float> b{10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  std::vector<float> out(16);
+  StridedCopy(a.data(), out.data(), {{2, 3, 8}, {3, 1, 1}}, sizeof(float));
+  StridedCopy(b.data(), out.data() + 3, {{2, 5, 8}, {5, 1, 1}}, sizeof(float));
+  std::vector<float> expect{1, 2, 3, 10, 11, 12, 13, 14, 4, 5, 6, 15, 16, 17, 18, 19};
+  EXPECT_EQ(out, expect);
+}
+
+TEST_F(PermuteTest, frac_z_round_trip_unaligned) {
+  // 17 kernels of 20 channels do not fill whole cubes, the padding has to be zero and dropped on the way back.
+  size_t n = 17, c = 20, h = 3, w = 2;
+  std::vector<uint16_t> data(n * c * h * w);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint16_t>(i + 1);
+  }
+  std::vector<size_t> device_shape{2 * h * w, 2, 16, 16};
+  size_t device_size = 2 * h * w * 2 * 16 * 16 * sizeof(uint16_t);
+  std::vector<uint16_t> frac_z(device_size / sizeof(uint16_t), 1);
+  trans::FormatArgs to_device{data.data(), device_size, kOpFormat_NCHW, kOpFormat_FRAC_Z,
+                              {n, c, h, w}, device_shape, kNumberTypeFloat16};
+  EXPECT_TRUE(trans::TransFormat(to_device, frac_z.data()));
+  size_t non_zero = 0;
+  for (auto value : frac_z) {
+    non_zero += value != 0 ? 1 : 0;
+  }
+  EXPECT_EQ(non_zero, data.size());
+
+  std::vector<uint16_t> back(data.size());
+  trans::FormatArgs to_host{frac_z.data(), device_size, kOpFormat_NCHW, kOpFormat_FRAC_Z,
+                            {n, c, h, w}, device_shape, kNumberTypeFloat16};
+  EXPECT_TRUE(trans::TransFormatFromDeviceToHost(to_host, back.data()));
+  EXPECT_EQ(back, data);
+}
+}  // namespace common
+}  // namespace mindspore
@@ -15,6 +15,7 @@
  */
 
 #include <vector>
+#include <chrono>
 #include "common/common_test.h"
 #include "common/trans.h"
 #include "utils/utils.h"
@@ -106,8 +107,65 @@ TEST_F(FormatTransTest, nhwc_to_nchw) {
     EXPECT_EQ((reinterpret_cast<uint16_t *>(trans_tmp.data()))[i], res[i]);
   }
 }
-}  // namespace trans
-}  // namespace mindspore
-
 
+// Round trip every device format and log the cost of each direction, the shape is a typical conv weight.
+TEST_F(FormatTransTest, all_formats_round_trip_perf) {
+  std::vector<size_t> host_shape{256, 192, 3, 3};
+  const std::vector<std::string> formats{kOpFormat_NHWC,       kOpFormat_HWCN,        kOpFormat_FRAC_Z,
+                                         kOpFormat_NC1HWC0,    kOpFormat_C1HWNCoC0,   kOpFormat_NC1HWC0_C04,
+                                         kOpFormat_FRAC_NZ,    kOpFormat_FRACTAL_Z_C04};
+  const std::vector<TypeId> types{kNumberTypeFloat16, kNumberTypeFloat32};
+  size_t host_num = trans::ShapeSize(host_shape);
+  for (auto type : types) {
+    auto type_size = trans::TypeIdSize(type);
+    std::vector<uint8_t> host(host_num * type_size);
+    for (size_t i = 0; i < host.size(); ++i) {
+      host[i] = static_cast<uint8_t>(i * 13 + 7);
+    }
+    for (auto &format : formats) {
+      auto device_shape = trans::TransShapeToDevice(host_shape, format);
+      size_t device_size = trans::ShapeSize(device_shape) * type_size;
+      std::vector<uint8_t> device(device_size);
+      FormatArgs to_device{host.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, type};
+      auto start = std::chrono::steady_clock::now();
+      EXPECT_TRUE(trans::TransFormat(to_device, device.data()));
+      auto middle = std::chrono::steady_clock::now();
+      MS_LOG(INFO) << "NCHW to " << format << " of " << TypeIdLabel(type) << " costs "
+                   << std::chrono::duration<double, std::micro>(middle - start).count() << " us";
+      if (format == kOpFormat_FRACTAL_Z_C04) {
+        continue;
+      }
+      std::vector<uint8_t> back(host.size());
+      FormatArgs to_host{device.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, type};
+      EXPECT_TRUE(trans::TransFormatFromDeviceToHost(to_host, back.data()));
+      MS_LOG(INFO) << format << " to NCHW of " << TypeIdLabel(type) << " costs "
+                   << std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - middle).count()
+                   << " us";
+      EXPECT_EQ(back, host);
+    }
+  }
+}
 
+TEST_F(FormatTransTest, float_half_round_trip_perf) {
+  size_t num = 1 << 20;
+  std::vector<float> data(num);
+  for (size_t i = 0; i < num; ++i) {
+    // Small integers and halves are exact in fp16.
+    data[i] = static_cast<float>(static_cast<int>(i % 4096) - 2048) * 0.5f;
+  }
+  std::vector<uint16_t> half(num);
+  TypeIdArgs to_half{data.data(), num, kNumberTypeFloat32, kNumberTypeFloat16, num * sizeof(float)};
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(trans::TransDataType(to_half, half.data()));
+  auto middle = std::chrono::steady_clock::now();
+  std::vector<float> back(num);
+  TypeIdArgs to_float{half.data(), num, kNumberTypeFloat16, kNumberTypeFloat32, num * sizeof(uint16_t)};
+  EXPECT_TRUE(trans::TransDataType(to_float, back.data()));
+  auto end = std::chrono::steady_clock::now();
+  MS_LOG(INFO) << "Float to half of " << num << " elements costs "
+               << std::chrono::duration<double, std::micro>(middle - start).count() << " us, half to float costs "
+               << std::chrono::duration<double, std::micro>(end - middle).count() << " us";
+  EXPECT_EQ(back, data);
+}
+}  // namespace trans
+}  // namespace mindspore
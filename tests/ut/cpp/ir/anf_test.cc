@@ -72,4 +72,22 @@ TEST_F(TestAnf, is_exception) {
   assert(!a.isa<ValueNode>());
 }
 
+TEST_F(TestAnf, test_evaluate_added_attrs_key) {
+  auto prim = std::make_shared<Primitive>("ReduceSum");
+  ASSERT_EQ(prim->evaluate_added_attrs_key(), "");
+  prim->BeginRecordAddAttr();
+  prim->AddAttr("keep_dims", MakeValue(true));
+  prim->AddAttr("axis", MakeValue(1));
+  prim->EndRecordAddAttr();
+  auto key = prim->evaluate_added_attrs_key();
+  ASSERT_EQ(key, "axis=1_keep_dims=true_");
+  // Attrs set out of a record do not change the key.
+  prim->AddAttr("input_names", MakeValue(std::string("x")));
+  ASSERT_EQ(prim->evaluate_added_attrs_key(), key);
+  prim->BeginRecordAddAttr();
+  prim->AddAttr("keep_dims", MakeValue(false));
+  prim->EndRecordAddAttr();
+  ASSERT_EQ(prim->evaluate_added_attrs_key(), "keep_dims=false_");
+}
+
 }  // namespace mindspore
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/gather_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class EmbeddingLookUpCpuKernelTest : public UT::Common {
+ public:
+  EmbeddingLookUpCpuKernelTest() : embedding_(std::make_shared<EmbeddingLookUpCPUKernel>()) {}
+
+  void SetUp() override {
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  // Indices drawn from a zipf-like distribution, the access pattern of real embedding tables.
+  template <typename S>
+  std::vector<S> SkewedIndices(size_t num, size_t row_count) {
+    std::mt19937 engine(0);
+    std::vector<double> weights(row_count);
+    for (size_t i = 0; i < row_count; ++i) {
+      weights[i] = 1.0 / (i + 1);
+    }
+    std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+    std::vector<S> indices(num);
+    for (auto &index : indices) {
+      index = static_cast<S>(dist(engine));
+    }
+    return indices;
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<EmbeddingLookUpCPUKernel> embedding_;
+};
+
+TEST_F(EmbeddingLookUpCpuKernelTest, offset_test) {
+  std::vector<float> table(4 * 3);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = i;
+  }
+  std::vector<int> indices{11, 10, 14, 13, 9};
+  std::vector<float> output(indices.size() * 3, -1);
+  embedding_->first_dim_size_ = 4;
+  embedding_->outer_dim_size_ = 3;
+  embedding_->indices_lens_ = indices.size();
+  embedding_->offset_ = 10;
+  inputs_.push_back(CreateKernelAddress(table.data(), table.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(indices.data(), indices.size() * sizeof(int)));
+  outputs_.push_back(CreateKernelAddress(output.data(), output.size() * sizeof(float)));
+  embedding_->Launch(inputs_, workspace_, outputs_);
+  std::vector<float> expect{3, 4, 5, 0, 1, 2, 0, 0, 0, 9, 10, 11, 0, 0, 0};
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, int64_float16_test) {
+  std::vector<uint16_t> table(8 * 16);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<uint16_t>(i);
+  }
+  std::vector<int64_t> indices{7, 0, 3};
+  std::vector<uint16_t> output(indices.size() * 16);
+  embedding_->first_dim_size_ = 8;
+  embedding_->outer_dim_size_ = 16;
+  embedding_->indices_lens_ = indices.size();
+  embedding_->input_dtype_ = kNumberTypeFloat16;
+  embedding_->indices_dtype_ = kNumberTypeInt64;
+  inputs_.push_back(CreateKernelAddress(table.data(), table.size() * sizeof(uint16_t)));
+  inputs_.push_back(CreateKernelAddress(indices.data(), indices.size() * sizeof(int64_t)));
+  outputs_.push_back(CreateKernelAddress(output.data(), output.size() * sizeof(uint16_t)));
+  embedding_->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    for (size_t j = 0; j < 16; ++j) {
+      EXPECT_EQ(output[i * 16 + j], table[indices[i] * 16 + j]);
+    }
+  }
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, skewed_large_table_test) {
+  const size_t row_count = 1 << 18;
+  const size_t row_size = 64;
+  const size_t indices_num = 1 << 16;
+  std::vector<float> table(row_count * row_size);
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i % 1021);
+  }
+  std::vector<int> indices = SkewedIndices<int>(indices_num, row_count);
+  std::vector<float> output(indices_num * row_size);
+  embedding_->first_dim_size_ = row_count;
+  embedding_->outer_dim_size_ = row_size;
+  embedding_->indices_lens_ = indices_num;
+  inputs_.push_back(CreateKernelAddress(table.data(), table.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(indices.data(), indices.size() * sizeof(int)));
+  outputs_.push_back(CreateKernelAddress(output.data(), output.size() * sizeof(float)));
+
+  const size_t loop = 10;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < loop; ++i) {
+    embedding_->Launch(inputs_, workspace_, outputs_);
+  }
+  auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / loop;
+  MS_LOG(INFO) << "EmbeddingLookup of " << indices_num << " skewed rows of width " << row_size << " costs " << cost
+               << " us, " << indices_num * row_size * sizeof(float) / cost / 1e3 << " GB/s";
+  for (size_t i = 0; i < indices_num; i += 97) {
+    for (size_t j = 0; j < row_size; ++j) {
+      EXPECT_EQ(output[i * row_size + j], table[indices[i] * row_size + j]);
+    }
+  }
+}
+
+TEST_F(EmbeddingLookUpCpuKernelTest, gather_middle_axis_test) {
+  // input [2, 3, 2], gather axis 1 with indices [2, 0, 5]
+  auto gather = std::make_shared<GatherV2CPUKernel>();
+  std::vector<float> input{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  std::vector<int> indices{2, 0, 5};
+  std::vector<float> output(2 * 3 * 2, -1);
+  gather->outer_size_ = 2;
+  gather->axis_dim_size_ = 3;
+  gather->inner_size_ = 2;
+  gather->indices_num_ = indices.size();
+  inputs_.push_back(CreateKernelAddress(input.data(), input.size() * sizeof(float)));
+  inputs_.push_back(CreateKernelAddress(indices.data(), indices.size() * sizeof(int)));
+  outputs_.push_back(CreateKernelAddress(output.data(), output.size() * sizeof(float)));
+  gather->Launch(inputs_, workspace_, outputs_);
+  std::vector<float> expect{4, 5, 0, 1, 0, 0, 10, 11, 6, 7, 0, 0};
+  EXPECT_EQ(output, expect);
+}
+}  // namespace kernel
+}  // namespace mindspore
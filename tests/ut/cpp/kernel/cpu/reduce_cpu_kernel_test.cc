@@ -0,0 +1,146 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include <chrono>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/reduce_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/bias_add_grad_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class ReduceCpuKernelTest : public UT::Common {
+ public:
+  ReduceCpuKernelTest() : reduce_(std::make_shared<ReduceCPUKernel>()) {}
+
+  void SetUp() override {
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  template <typename T>
+  void Run(const std::vector<size_t> &shape, const std::vector<size_t> &axis, ReduceType type, std::vector<T> *input,
+           std::vector<T> *output) {
+    reduce_->shape_ = shape;
+    reduce_->axis_ = axis;
+    reduce_->reduce_type_ = type;
+    reduce_->plan_.Init(shape, axis);
+    output->resize(reduce_->plan_.output_size());
+    inputs_.push_back(CreateKernelAddress(input->data(), input->size() * sizeof(T)));
+    outputs_.push_back(CreateKernelAddress(output->data(), output->size() * sizeof(T)));
+    reduce_->Launch(inputs_, workspace_, outputs_);
+  }
+
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<ReduceCPUKernel> reduce_;
+};
+
+TEST_F(ReduceCpuKernelTest, sum_outer_axis_test) {
+  // input [2, 3, 4], reduce axis 0
+  std::vector<float> input(24);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = i;
+  }
+  std::vector<float> output;
+  Run<float>({2, 3, 4}, {0}, kReduceSum, &input, &output);
+  EXPECT_EQ(reduce_->plan_.strategy(), kReduceStridedOuter);
+  std::vector<float> expect{12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32, 34};
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(ReduceCpuKernelTest, mean_inner_axes_test) {
+  // input [2, 3, 4], reduce axes 0 and 2
+  std::vector<float> input(24);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = i;
+  }
+  std::vector<float> output;
+  Run<float>({2, 3, 4}, {0, 2}, kReduceMean, &input, &output);
+  EXPECT_EQ(reduce_->plan_.strategy(), kReduceContiguousInner);
+  std::vector<float> expect{7.5, 11.5, 15.5};
+  EXPECT_EQ(output, expect);
+}
+
+TEST_F(ReduceCpuKernelTest, max_min_int_test) {
+  // input [3, 2], reduce axis 1
+  std::vector<int> input{1, -4, 7, 3, -2, -9};
+  std::vector<int> output;
+  reduce_->dtype_ = kNumberTypeInt32;
+  Run<int>({3, 2}, {1}, kReduceMax, &input, &output);
+  std::vector<int> expect_max{1, 7, -2};
+  EXPECT_EQ(output, expect_max);
+
+  SetUp();
+  Run<int>({3, 2}, {1}, kReduceMin, &input, &output);
+  std::vector<int> expect_min{-4, 3, -9};
+  EXPECT_EQ(output, expect_min);
+}
+
+TEST_F(ReduceCpuKernelTest, large_wide_row_test) {
+  // input [256, 4096], reduce axis 0, rows are wider than one tile
+  const size_t rows = 256;
+  const size_t cols = 4096;
+  std::vector<float> input(rows * cols);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i % cols);
+  }
+  std::vector<float> output;
+  Run<float>({rows, cols}, {0}, kReduceSum, &input, &output);
+  EXPECT_EQ(reduce_->plan_.strategy(), kReduceTiled);
+
+  const size_t loop = 10;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < loop; ++i) {
+    reduce_->Launch(inputs_, workspace_, outputs_);
+  }
+  auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / loop;
+  MS_LOG(INFO) << "ReduceSum of [" << rows << ", " << cols << "] over axis 0 costs " << cost << " us";
+  for (size_t j = 0; j < cols; ++j) {
+    EXPECT_EQ(output[j], static_cast<float>(j * rows));
+  }
+}
+
+TEST_F(ReduceCpuKernelTest, bias_add_grad_test) {
+  // input [2, 3, 2, 2], sum over all axes except the channel axis
+  auto bias_add_grad = std::make_shared<BiasAddGradCPUKernel>();
+  std::vector<float> input(24);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = i;
+  }
+  std::vector<float> output(3);
+  bias_add_grad->input_shape_ = {2, 3, 2, 2};
+  bias_add_grad->plan_.Init(bias_add_grad->input_shape_, {0, 2, 3});
+  inputs_.push_back(CreateKernelAddress(input.data(), input.size() * sizeof(float)));
+  outputs_.push_back(CreateKernelAddress(output.data(), output.size() * sizeof(float)));
+  bias_add_grad->Launch(inputs_, workspace_, outputs_);
+  std::vector<float> expect{60, 92, 124};
+  EXPECT_EQ(output, expect);
+}
+}  // namespace kernel
+}  // namespace mindspore
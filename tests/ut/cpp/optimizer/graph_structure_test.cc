@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+
+#include "ir/func_graph.h"
+#include "frontend/operator/ops.h"
+#include "frontend/optimizer/graph_structure.h"
+
+namespace mindspore {
+namespace opt {
+class TestGraphStructure : public UT::Common {
+ public:
+  TestGraphStructure() {}
+  void SetUp() override { top_graph_ = std::make_shared<FuncGraph>(); }
+
+  ParameterPtr AddWeight(const std::string &name) {
+    auto weight = top_graph_->add_parameter();
+    weight->set_name(name);
+    weight->set_default_param(MakeValue(1));
+    return weight;
+  }
+
+  // cell(x) { MatMul(x, inner(x)) }, inner(y) { Mul(y, make_ref(weight)) }
+  FuncGraphPtr MakeCellGraph(const ParameterPtr &weight, bool transpose_b, const PrimitivePtr &inner_prim) {
+    auto inner = std::make_shared<FuncGraph>();
+    auto y = inner->add_parameter();
+    auto ref = inner->NewCNode(
+      {NewValueNode(prim::kPrimMakeRef), NewValueNode(std::make_shared<RefKey>(weight->name())), weight, weight});
+    inner->add_parameter_obj_node(ref);
+    inner->set_output(inner->NewCNode({NewValueNode(inner_prim), y, ref}));
+
+    auto cell = std::make_shared<FuncGraph>();
+    auto x = cell->add_parameter();
+    auto matmul = std::make_shared<Primitive>("MatMul");
+    matmul->AddAttr("transpose_b", MakeValue(transpose_b));
+    auto call = cell->NewCNode({NewValueNode(inner), x});
+    cell->set_output(cell->NewCNode({NewValueNode(matmul), x, call}));
+    return cell;
+  }
+
+ protected:
+  FuncGraphPtr top_graph_;
+};
+
+TEST_F(TestGraphStructure, SameStructureDifferentWeights) {
+  auto weight1 = AddWeight("weight1");
+  auto weight2 = AddWeight("weight2");
+  GraphStructure structure1(MakeCellGraph(weight1, false, prim::kPrimMul));
+  GraphStructure structure2(MakeCellGraph(weight2, false, prim::kPrimMul));
+  ASSERT_TRUE(structure1.valid());
+  ASSERT_TRUE(structure2.valid());
+  ASSERT_EQ(structure1.graphs().size(), 2U);
+  ASSERT_EQ(structure1.hash(), structure2.hash());
+  ASSERT_TRUE(structure1.IsSameStructure(structure2));
+
+  // The weights are read in the inner graph, they are holes of the cell structure.
+  ASSERT_EQ(structure1.holes().size(), 1U);
+  ASSERT_EQ(structure2.holes().size(), 1U);
+  ASSERT_EQ(structure1.holes()[0]->cast<CNodePtr>()->input(3), weight1);
+  ASSERT_EQ(structure2.holes()[0]->cast<CNodePtr>()->input(3), weight2);
+}
+
+TEST_F(TestGraphStructure, DifferentAttrsOrPrims) {
+  auto weight = AddWeight("weight");
+  GraphStructure structure(MakeCellGraph(weight, false, prim::kPrimMul));
+  GraphStructure other_attrs(MakeCellGraph(weight, true, prim::kPrimMul));
+  GraphStructure other_prim(MakeCellGraph(weight, false, std::make_shared<Primitive>("Add")));
+  ASSERT_FALSE(structure.IsSameStructure(other_attrs));
+  ASSERT_FALSE(structure.IsSameStructure(other_prim));
+}
+
+TEST_F(TestGraphStructure, HookIsNotShared) {
+  auto weight = AddWeight("weight");
+  GraphStructure structure(MakeCellGraph(weight, false, prim::kPrimHookBackward));
+  ASSERT_FALSE(structure.valid());
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -177,6 +177,21 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, MultiPatternOneWalk) {
+  // R(P(P(Q(1)))) is reduced to P(1) by substitutions indexed by different primitives in one list.
+  FuncGraphPtr before = std::make_shared<FuncGraph>();
+  auto q = before->NewCNode({NewValueNode(Q), NewValueNode(1)});
+  auto p1 = before->NewCNode({NewValueNode(P), q});
+  auto p2 = before->NewCNode({NewValueNode(P), p1});
+  before->set_output(before->NewCNode({NewValueNode(R), p2}));
+
+  FuncGraphPtr after = std::make_shared<FuncGraph>();
+  after->set_output(after->NewCNode({NewValueNode(P), NewValueNode(1)}));
+
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_R, idempotent_P, Qct_to_P})));
+  ASSERT_FALSE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_R})));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
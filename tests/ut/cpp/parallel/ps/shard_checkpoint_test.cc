@@ -0,0 +1,168 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/shard_checkpoint.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+class TestShardCheckpoint : public UT::Common {
+ public:
+  TestShardCheckpoint() {}
+  void SetUp() override {
+    char dir[] = "/tmp/shard_checkpoint_test_XXXXXX";
+    ASSERT_TRUE(mkdtemp(dir) != nullptr);
+    dir_ = dir;
+  }
+  void TearDown() override { (void)system(("rm -rf " + dir_).c_str()); }
+
+  // A weight shard of rows x cols with two optimizer states, each element set apart by the tensor it belongs to.
+  static std::vector<std::vector<float>> MakeShard(size_t rows, size_t cols) {
+    std::vector<std::vector<float>> shard(3, std::vector<float>(rows * cols));
+    for (size_t t = 0; t < shard.size(); t++) {
+      for (size_t i = 0; i < shard[t].size(); i++) {
+        shard[t][i] = 100.0f * t + i;
+      }
+    }
+    return shard;
+  }
+
+  static std::vector<const float *> Sources(const std::vector<std::vector<float>> &shard) {
+    std::vector<const float *> sources;
+    for (const auto &tensor : shard) {
+      sources.push_back(tensor.data());
+    }
+    return sources;
+  }
+
+ protected:
+  std::string dir_;
+};
+
+TEST_F(TestShardCheckpoint, CountLocalRowsOfShardedAndGlobalShapes) {
+  // Rank 1 of 2 servers holds 5 of the 10 rows of a 10 x 4 embedding.
+  size_t shard_size = 5 * 4;
+  // The Adam kernels shard the var shape in place.
+  ASSERT_EQ(CountShardRows({5, 4}, shard_size), 5U);
+  // The Ftrl kernel keeps the global var shape.
+  ASSERT_EQ(CountShardRows({10, 4}, shard_size), 5U);
+  ASSERT_EQ(CountShardRows({10}, 5), 5U);
+  // Shapes which do not describe the shard save it as a single row.
+  ASSERT_EQ(CountShardRows({10, 3}, shard_size), 1U);
+  ASSERT_EQ(CountShardRows({10, 0}, shard_size), 1U);
+  ASSERT_EQ(CountShardRows({}, shard_size), 1U);
+}
+
+TEST_F(TestShardCheckpoint, MarkOnlyRowsOfTheShardDirty) {
+  std::vector<bool> dirty(5, false);
+  std::vector<int> ids = {-6, 0, 3, 3, 5, 9};
+  MarkRowsDirty(ids.data(), ids.size(), &dirty);
+  std::vector<bool> expect = {true, false, false, true, false};
+  ASSERT_EQ(dirty, expect);
+}
+
+TEST_F(TestShardCheckpoint, SaveDeltaOfDirtyRowsAndLoadMerged) {
+  const size_t rows = 5;
+  const size_t cols = 4;
+  auto sparse = MakeShard(rows, cols);
+  std::vector<std::vector<float>> dense = {{1.0f, 2.0f, 3.0f}};
+  // A Ftrl embedding, its var shape is the global one of 2 servers.
+  size_t row_count = CountShardRows({2 * rows, cols}, rows * cols);
+  ASSERT_EQ(row_count, rows);
+
+  ShardCheckpoint checkpoint(dir_, 1);
+  ASSERT_FALSE(checkpoint.HasCheckpoint());
+  std::vector<ShardSnapshotPtr> full = {MakeShardSnapshot(1, row_count, rows * cols, Sources(sparse), nullptr),
+                                        MakeShardSnapshot(2, 1, dense[0].size(), Sources(dense), nullptr)};
+  ASSERT_TRUE(checkpoint.Save(full, false));
+  ASSERT_TRUE(checkpoint.HasCheckpoint());
+
+  // Update rows 1 and 4 of the weight and both states, the local row ids come from the optimizer kernel.
+  std::vector<bool> dirty(row_count, false);
+  std::vector<int> ids = {1, 4};
+  MarkRowsDirty(ids.data(), ids.size(), &dirty);
+  for (auto &tensor : sparse) {
+    for (int id : ids) {
+      for (size_t col = 0; col < cols; col++) {
+        tensor[id * cols + col] = -tensor[id * cols + col] - 1.0f;
+      }
+    }
+  }
+  dense[0][1] = 20.0f;
+  auto delta = MakeShardSnapshot(1, row_count, rows * cols, Sources(sparse), &dirty);
+  ASSERT_TRUE(delta->incremental);
+  ASSERT_EQ(delta->row_ids, std::vector<size_t>({1, 4}));
+  ASSERT_EQ(delta->tensors.size(), sparse.size());
+  ASSERT_EQ(delta->tensors[0].size(), ids.size() * cols);
+  std::vector<ShardSnapshotPtr> deltas = {delta, MakeShardSnapshot(2, 1, dense[0].size(), Sources(dense), nullptr)};
+  ASSERT_TRUE(checkpoint.Save(deltas, true));
+
+  // A new server of the same rank restores the full checkpoint followed by the delta.
+  ShardCheckpoint restored(dir_, 1);
+  std::unordered_map<uint64_t, ShardSnapshotPtr> shards;
+  ASSERT_TRUE(restored.Load(&shards));
+  ASSERT_EQ(shards.size(), 2U);
+  ASSERT_FALSE(shards[1]->incremental);
+  ASSERT_EQ(shards[1]->row_count, rows);
+  ASSERT_EQ(shards[1]->row_size, cols);
+  ASSERT_EQ(shards[1]->tensors, sparse);
+  ASSERT_EQ(shards[2]->tensors, dense);
+}
+
+TEST_F(TestShardCheckpoint, FullSnapshotReplacesReshapedShard) {
+  auto before = MakeShard(5, 4);
+  auto after = MakeShard(3, 4);
+  ShardCheckpoint checkpoint(dir_, 0);
+  ASSERT_TRUE(checkpoint.Save({MakeShardSnapshot(1, 5, before[0].size(), Sources(before), nullptr)}, false));
+  ASSERT_TRUE(checkpoint.Save({MakeShardSnapshot(1, 3, after[0].size(), Sources(after), nullptr)}, true));
+
+  std::unordered_map<uint64_t, ShardSnapshotPtr> shards;
+  ASSERT_TRUE(checkpoint.Load(&shards));
+  ASSERT_EQ(shards[1]->row_count, 3U);
+  ASSERT_EQ(shards[1]->tensors, after);
+}
+
+TEST_F(TestShardCheckpoint, RejectDeltaWithoutFullCheckpoint) {
+  auto shard = MakeShard(5, 4);
+  std::vector<bool> dirty = {true, false, false, false, false};
+  ShardCheckpoint checkpoint(dir_, 0);
+  ASSERT_FALSE(checkpoint.Save({MakeShardSnapshot(1, 5, shard[0].size(), Sources(shard), &dirty)}, true));
+  ASSERT_FALSE(checkpoint.HasCheckpoint());
+  std::unordered_map<uint64_t, ShardSnapshotPtr> shards;
+  ASSERT_FALSE(checkpoint.Load(&shards));
+}
+
+TEST_F(TestShardCheckpoint, RejectCorruptedShard) {
+  auto shard = MakeShard(5, 4);
+  ShardCheckpoint checkpoint(dir_, 0);
+  ASSERT_TRUE(checkpoint.Save({MakeShardSnapshot(1, 5, shard[0].size(), Sources(shard), nullptr)}, false));
+  {
+    std::fstream file(dir_ + "/server_0/0/1.ckpt", std::ios::binary | std::ios::in | std::ios::out);
+    ASSERT_TRUE(file.is_open());
+    file.seekp(-8, std::ios::end);
+    file.put('x');
+  }
+  std::unordered_map<uint64_t, ShardSnapshotPtr> shards;
+  ASSERT_FALSE(checkpoint.Load(&shards));
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
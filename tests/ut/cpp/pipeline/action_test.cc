@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+
+#include "ir/func_graph.h"
+#include "frontend/operator/ops.h"
+#include "pipeline/jit/action.h"
+#include "pipeline/jit/parse/data_converter.h"
+#include "utils/primitive_py.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestAction : public UT::Common {
+ public:
+  TestAction() {}
+  void SetUp() override {
+    parse::data_converter::ClearObjectCache();
+    top_graph_ = std::make_shared<FuncGraph>();
+    x_ = top_graph_->add_parameter();
+  }
+
+  // cell(x) { MatMul(x, inner(x)) }, inner(y) { prim(y, make_ref(weight)) }
+  FuncGraphPtr MakeCellGraph(const std::string &weight_name, const PrimitivePtr &inner_prim) {
+    auto weight = top_graph_->add_parameter();
+    weight->set_name(weight_name);
+    weight->set_default_param(MakeValue(1));
+    auto inner = std::make_shared<FuncGraph>();
+    auto y = inner->add_parameter();
+    auto ref = inner->NewCNode(
+      {NewValueNode(prim::kPrimMakeRef), NewValueNode(std::make_shared<RefKey>(weight_name)), weight, weight});
+    inner->add_parameter_obj_node(ref);
+    inner->set_output(inner->NewCNode({NewValueNode(inner_prim), y, ref}));
+
+    auto cell = std::make_shared<FuncGraph>();
+    auto x = cell->add_parameter();
+    auto call = cell->NewCNode({NewValueNode(inner), x});
+    cell->set_output(cell->NewCNode({NewValueNode(std::make_shared<Primitive>("MatMul")), x, call}));
+    return cell;
+  }
+
+  // top(x) { make_tuple(cell1(x), cell2(x), ...) }
+  ResourcePtr MakeResource(const std::vector<FuncGraphPtr> &cells) {
+    std::vector<AnfNodePtr> outputs = {NewValueNode(prim::kPrimMakeTuple)};
+    for (auto &cell : cells) {
+      outputs.push_back(top_graph_->NewCNode({NewValueNode(cell), x_}));
+    }
+    top_graph_->set_output(top_graph_->NewCNode(outputs));
+    auto res = std::make_shared<Resource>();
+    res->manager()->AddFuncGraph(top_graph_);
+    res->set_func_graph(top_graph_);
+    return res;
+  }
+
+  static PrimitivePtr MakePyPrim(bool keep_first_dim) {
+    py::object obj = py::module::import("gtest_input.pipeline.infer.primitive_test").attr("InstanceStatePrim")();
+    py::setattr(obj, "keep_first_dim", py::bool_(keep_first_dim));
+    return std::make_shared<PrimitivePy>(py::str("InstanceStatePrim"), obj);
+  }
+
+ protected:
+  FuncGraphPtr top_graph_;
+  ParameterPtr x_;
+};
+
+TEST_F(TestAction, CombineStructurallyLikeGraphs) {
+  std::vector<FuncGraphPtr> cells = {MakeCellGraph("weight1", prim::kPrimMul), MakeCellGraph("weight2", prim::kPrimMul),
+                                     MakeCellGraph("weight3", prim::kPrimMul)};
+  auto res = MakeResource(cells);
+  ASSERT_TRUE(CombineLikeGraphs(res));
+
+  // Every cell calls one shared graph with its own input and the weight it reads.
+  FuncGraphPtr base_graph = nullptr;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    auto output = cells[i]->output()->cast<CNodePtr>();
+    ASSERT_TRUE(output != nullptr);
+    ASSERT_TRUE(IsValueNode<FuncGraph>(output->input(0)));
+    auto callee = GetValueNode<FuncGraphPtr>(output->input(0));
+    ASSERT_TRUE(callee != cells[i]);
+    if (base_graph == nullptr) {
+      base_graph = callee;
+    }
+    ASSERT_EQ(callee, base_graph);
+    ASSERT_EQ(output->size(), 3U);
+    ASSERT_EQ(output->input(1), cells[i]->parameters()[0]);
+    auto ref = output->input(2)->cast<CNodePtr>();
+    ASSERT_TRUE(ref != nullptr && IsPrimitiveCNode(ref, prim::kPrimMakeRef));
+    ASSERT_EQ(ref->input(3)->cast<ParameterPtr>()->name(), "weight" + std::to_string(i + 1));
+  }
+  ASSERT_EQ(base_graph->parameters().size(), 2U);
+}
+
+TEST_F(TestAction, NotCombinePyPrimsWithDifferentMembers) {
+  std::vector<FuncGraphPtr> cells = {MakeCellGraph("weight1", MakePyPrim(true)),
+                                     MakeCellGraph("weight2", MakePyPrim(true)),
+                                     MakeCellGraph("weight3", MakePyPrim(true)),
+                                     MakeCellGraph("weight4", MakePyPrim(false))};
+  auto res = MakeResource(cells);
+  ASSERT_TRUE(CombineLikeGraphs(res));
+
+  // The primitives have equal attributes, but the last one has another python member its infer reads.
+  auto combined = cells[0]->output()->cast<CNodePtr>();
+  ASSERT_TRUE(combined != nullptr && IsValueNode<FuncGraph>(combined->input(0)));
+  auto base_graph = GetValueNode<FuncGraphPtr>(combined->input(0));
+  for (size_t i = 1; i < 3; ++i) {
+    auto output = cells[i]->output()->cast<CNodePtr>();
+    ASSERT_TRUE(output != nullptr && IsValueNode<FuncGraph>(output->input(0)));
+    ASSERT_EQ(GetValueNode<FuncGraphPtr>(output->input(0)), base_graph);
+  }
+  ASSERT_TRUE(IsPrimitiveCNode(cells[3]->output(), std::make_shared<Primitive>("MatMul")));
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -479,6 +479,38 @@ TEST_F(TestPrim, test_relu) {
   ASSERT_TRUE(*res == *expected);
 }
 
+TEST_F(TestPrim, test_python_infer_instance_state) {
+  auto infer_count = []() {
+    return py::cast<int>(
+      python_adapter::CallPyFn("gtest_input.pipeline.infer.primitive_test", "get_instance_state_infer_count"));
+  };
+  auto x = UTPrimUtils::ArrayFloat32Of({2, 3});
+  AbstractBasePtrList args_spec_list = {x};
+
+  // The instances have the same attributes, but their infers read different python members.
+  FuncGraphPtr func_graph = getPyFun.CallAndParseRet("test_instance_state", true, false);
+  ASSERT_TRUE(func_graph != nullptr);
+  AbstractBasePtr ret = engine_->Run(func_graph, args_spec_list).inferred->abstract();
+  auto res = dyn_cast<AbstractTuple>(ret);
+  ASSERT_TRUE(res != nullptr && res->size() == 2);
+  auto keep = dyn_cast<AbstractTensor>(res->elements()[0]);
+  auto drop = dyn_cast<AbstractTensor>(res->elements()[1]);
+  ASSERT_TRUE(keep != nullptr && drop != nullptr);
+  ASSERT_TRUE(*(keep->GetShapeTrack()) == *(UTPrimUtils::ArrayFloat32Of({2, 3})->GetShapeTrack()));
+  ASSERT_TRUE(*(drop->GetShapeTrack()) == *(UTPrimUtils::ArrayFloat32Of({3})->GetShapeTrack()));
+
+  // Instances configured alike still share one python infer.
+  engine_ = SetupAnalysisEngine();
+  int count_before = infer_count();
+  func_graph = getPyFun.CallAndParseRet("test_instance_state", false, false);
+  ASSERT_TRUE(func_graph != nullptr);
+  ret = engine_->Run(func_graph, args_spec_list).inferred->abstract();
+  res = dyn_cast<AbstractTuple>(ret);
+  ASSERT_TRUE(res != nullptr && res->size() == 2);
+  ASSERT_TRUE(*(res->elements()[0]) == *(res->elements()[1]));
+  ASSERT_EQ(infer_count() - count_before, 1);
+}
+
 /*
 TEST_F(TestPrim, test_relu2) {
   FuncGraphPtr func_graph = getPyFun("get_relu");
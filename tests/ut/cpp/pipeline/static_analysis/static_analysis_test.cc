@@ -167,6 +167,29 @@ TEST_F(TestInfer, test_inferred_scalar_add) {
   ASSERT_TRUE(abs_base_got.get() == abstract_v1.get());
 }
 
+TEST_F(TestInfer, test_prim_eval_cache) {
+  PrimitiveEvalCache cache;
+  AbstractBasePtrList args_spec_list = {FromValue(1, false), FromValue(2, false)};
+  AttrValueMap attrs = {{"axis", MakeValue(0)}};
+  auto result = std::make_shared<EvalResult>(FromValue(3, false), std::make_shared<AttrValueMap>());
+  cache.Put("Add", attrs, args_spec_list, result);
+
+  // Equal attributes held by another primitive instance hit the same entry.
+  AttrValueMap same_attrs = {{"axis", MakeValue(0)}};
+  AbstractBasePtrList same_args = {FromValue(1, false), FromValue(2, false)};
+  ASSERT_TRUE(cache.Get("Add", same_attrs, same_args) == result);
+
+  AttrValueMap other_attrs = {{"axis", MakeValue(1)}};
+  ASSERT_TRUE(cache.Get("Add", other_attrs, args_spec_list) == nullptr);
+  ASSERT_TRUE(cache.Get("Add", AttrValueMap(), args_spec_list) == nullptr);
+  ASSERT_TRUE(cache.Get("Sub", attrs, args_spec_list) == nullptr);
+  AbstractBasePtrList other_args = {FromValue(1, false), FromValue(3, false)};
+  ASSERT_TRUE(cache.Get("Add", attrs, other_args) == nullptr);
+
+  cache.Clear();
+  ASSERT_TRUE(cache.Get("Add", attrs, args_spec_list) == nullptr);
+}
+
 class TestInferGraph : public UT::Common {
  public:
   void SetUp();
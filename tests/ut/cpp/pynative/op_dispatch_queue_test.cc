@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "pipeline/pynative/op_dispatch_queue.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace pynative {
+class TestOpDispatchQueue : public UT::Common {
+ public:
+  TestOpDispatchQueue() {}
+  void TearDown() override { OpDispatchQueue::GetInstance().Stop(); }
+};
+
+TEST_F(TestOpDispatchQueue, test_run_in_order) {
+  auto &queue = OpDispatchQueue::GetInstance();
+  std::vector<int> order;
+  std::vector<tensor::WaitEventPtr> events;
+  for (int i = 0; i < 100; i++) {
+    auto event = std::make_shared<tensor::WaitEvent>();
+    queue.Push("TensorAdd", [&order, i]() { order.push_back(i); }, event);
+    events.push_back(event);
+  }
+  events.back()->Wait();
+  queue.Wait();
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_EQ(order[i], i);
+    ASSERT_TRUE(events[i]->done());
+  }
+}
+
+TEST_F(TestOpDispatchQueue, test_stop_runs_pushed_ops_in_order) {
+  auto &queue = OpDispatchQueue::GetInstance();
+  std::vector<int> order;
+  for (int i = 0; i < 100; i++) {
+    queue.Push("TensorAdd", [&order, i]() { order.push_back(i); }, std::make_shared<tensor::WaitEvent>());
+  }
+  // Stopping at exit runs the ops left in the queue, the next push starts the backend thread again.
+  queue.Stop();
+  ASSERT_EQ(order.size(), 100);
+  queue.Push("TensorAdd", [&order]() { order.push_back(100); }, std::make_shared<tensor::WaitEvent>());
+  queue.Wait();
+  ASSERT_EQ(order.size(), 101);
+  for (int i = 0; i < 101; i++) {
+    ASSERT_EQ(order[i], i);
+  }
+}
+
+TEST_F(TestOpDispatchQueue, test_pynative_infer_on_backend_thread) {
+  auto ms_context = MsContext::GetInstance();
+  ASSERT_TRUE(ms_context != nullptr);
+  ms_context->set_enable_pynative_infer(false);
+  auto &queue = OpDispatchQueue::GetInstance();
+  bool infer_on_backend = false;
+  queue.Push("TensorAdd", [&infer_on_backend, ms_context]() { infer_on_backend = ms_context->enable_pynative_infer(); },
+             std::make_shared<tensor::WaitEvent>());
+  queue.Wait();
+  // The ops on the backend thread run with the flag on, it stays off for the python thread.
+  ASSERT_TRUE(infer_on_backend);
+  ASSERT_FALSE(ms_context->enable_pynative_infer());
+}
+
+TEST_F(TestOpDispatchQueue, test_error_of_failed_op) {
+  auto &queue = OpDispatchQueue::GetInstance();
+  auto ok_event = std::make_shared<tensor::WaitEvent>();
+  auto failed_event = std::make_shared<tensor::WaitEvent>();
+  queue.Push("TensorAdd", []() {}, ok_event);
+  queue.Push("MatMul", []() { throw std::runtime_error("shape mismatch"); }, failed_event);
+  ok_event->Wait();
+  // Reading an output of the failed op raises its error.
+  try {
+    failed_event->Wait();
+    FAIL();
+  } catch (const std::exception &ex) {
+    ASSERT_NE(std::string(ex.what()).find("Run op[MatMul] failed"), std::string::npos);
+  }
+  // The error is raised once on the python thread, then the queue runs ops again.
+  ASSERT_ANY_THROW(queue.Wait());
+  bool run = false;
+  auto event = std::make_shared<tensor::WaitEvent>();
+  queue.Push("TensorAdd", [&run]() { run = true; }, event);
+  queue.Wait();
+  ASSERT_TRUE(run);
+}
+}  // namespace pynative
+}  // namespace mindspore
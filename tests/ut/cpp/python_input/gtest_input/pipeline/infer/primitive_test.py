@@ -111,3 +111,41 @@ def test_dropout():
         return y
 
     return get_dropout
+
+
+class InstanceStatePrim(PrimitiveWithInfer):
+    """this is a test primitive whose infer reads a python member which is not a primitive attribute"""
+    infer_count = 0
+
+    @prim_attr_register
+    def __init__(self):
+        """init"""
+        self.keep_first_dim = True
+
+    def __call__(self, x):
+        raise NotImplementedError
+
+    def infer_shape(self, x_shape):
+        InstanceStatePrim.infer_count += 1
+        if self.keep_first_dim:
+            return x_shape
+        return x_shape[1:]
+
+    def infer_dtype(self, x_type):
+        return x_type
+
+
+def test_instance_state(keep_first_dim_a, keep_first_dim_b):
+    prim_a = InstanceStatePrim()
+    prim_a.keep_first_dim = keep_first_dim_a
+    prim_b = InstanceStatePrim()
+    prim_b.keep_first_dim = keep_first_dim_b
+
+    def get_instance_state(x):
+        return prim_a(x), prim_b(x)
+
+    return get_instance_state
+
+
+def get_instance_state_infer_count():
+    return InstanceStatePrim.infer_count
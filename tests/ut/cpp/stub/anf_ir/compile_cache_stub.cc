@@ -0,0 +1,32 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pipeline/jit/compile_cache.h"
+
+namespace mindspore {
+namespace pipeline {
+std::string CompileCache::GetCachePath(const std::string &phase, bool use_vm) { return ""; }
+
+std::vector<ActionItem> CompileCache::WrapActions(const CompileCachePtr &cache, const std::vector<ActionItem> &actions) {
+  return actions;
+}
+
+bool CompileCache::Load(const ResourcePtr &res) { return false; }
+
+bool CompileCache::Save(const ResourcePtr &res) { return false; }
+
+std::string CompileCache::GenerateKey(const ResourcePtr &res) const { return ""; }
+}  // namespace pipeline
+}  // namespace mindspore
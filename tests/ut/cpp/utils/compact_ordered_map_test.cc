@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "utils/compact_ordered_map.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+class TestCompactOrderedMap : public UT::Common {
+ public:
+  TestCompactOrderedMap() {}
+
+  template <typename C>
+  std::vector<int> Keys(const C &c) {
+    std::vector<int> res;
+    for (auto &item : c) {
+      res.push_back(item.first);
+    }
+    return res;
+  }
+};
+
+TEST_F(TestCompactOrderedMap, test_set_keep_insertion_order) {
+  CompactOrderedSet<int> set;
+  for (int i = 0; i < 100; i++) {
+    set.add(i);
+  }
+  ASSERT_FALSE(set.insert(10).second);
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_TRUE(set.erase(i));
+  }
+  ASSERT_FALSE(set.erase(0));
+  // Erased slots are reused, the order is still the insertion order.
+  set.add(0);
+  std::vector<int> expect;
+  for (int i = 1; i < 100; i += 2) {
+    expect.push_back(i);
+  }
+  expect.push_back(0);
+  ASSERT_EQ(std::vector<int>(set.begin(), set.end()), expect);
+  ASSERT_EQ(set.size(), expect.size());
+  ASSERT_TRUE(set.contains(99));
+  ASSERT_FALSE(set.contains(98));
+  ASSERT_EQ(set.back(), 0);
+  ASSERT_EQ(set.pop(), 1);
+
+  CompactOrderedSet<int> copy = set;
+  ASSERT_TRUE(copy == set);
+  copy.clear();
+  ASSERT_TRUE(copy.empty());
+  ASSERT_EQ(set.size(), expect.size() - 1);
+}
+
+TEST_F(TestCompactOrderedMap, test_set_algebra) {
+  CompactOrderedSet<int> a(std::vector<int>{1, 2, 3, 4});
+  CompactOrderedSet<int> b(std::vector<int>{3, 4, 5});
+  ASSERT_EQ((a | b).size(), 5);
+  ASSERT_EQ((a & b).size(), 2);
+  ASSERT_EQ((a - b).size(), 2);
+  ASSERT_EQ((a ^ b).size(), 3);
+  ASSERT_TRUE((a & b).is_subset(a));
+  ASSERT_TRUE((a - b).is_disjoint(b));
+}
+
+TEST_F(TestCompactOrderedMap, test_map_references_are_stable) {
+  CompactOrderedMap<int, std::vector<int>> map;
+  auto &first = map[0];
+  first.push_back(1);
+  // Growing the map allocates new chunks, it never moves existing elements.
+  for (int i = 1; i < 1000; i++) {
+    map[i].push_back(i);
+  }
+  ASSERT_EQ(&first, &map[0]);
+  ASSERT_EQ(map.size(), 1000);
+
+  auto iter = map.find(500);
+  for (int i = 0; i < 1000; i += 3) {
+    (void)map.erase(i);
+  }
+  ASSERT_EQ(iter->first, 500);
+  ASSERT_EQ(iter->second[0], 500);
+  ASSERT_EQ(map.count(3), 0);
+  ASSERT_EQ(map.count(4), 1);
+  ASSERT_TRUE(map.find(999) == map.end());
+}
+
+TEST_F(TestCompactOrderedMap, test_map_iteration) {
+  CompactOrderedMap<int, int> map;
+  for (int i = 0; i < 20; i++) {
+    (void)map.insert(std::make_pair(i, i * i));
+  }
+  ASSERT_FALSE(map.insert(std::make_pair(1, 0)).second);
+  for (auto iter = map.begin(); iter != map.end();) {
+    if (iter->first % 2 == 0) {
+      iter = map.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  ASSERT_EQ(Keys(map), std::vector<int>({1, 3, 5, 7, 9, 11, 13, 15, 17, 19}));
+  ASSERT_EQ(map.rbegin()->first, 19);
+  ASSERT_EQ(std::prev(map.end())->second, 361);
+  map.pop_front();
+  map.pop_back();
+  ASSERT_EQ(map.front().first, 3);
+  ASSERT_EQ(map.back().first, 17);
+
+  CompactOrderedMap<int, int> other;
+  other.swap(map);
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(other.size(), 8);
+}
+}  // namespace mindspore
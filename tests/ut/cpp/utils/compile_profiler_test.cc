@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/compile_profiler.h"
+
+namespace mindspore {
+class TestCompileProfiler : public UT::Common {
+ public:
+  TestCompileProfiler() {}
+  void TearDown() override { CompileProfiler::GetInstance().End(); }
+};
+
+TEST_F(TestCompileProfiler, test_disabled) {
+  auto &profiler = CompileProfiler::GetInstance();
+  profiler.Begin("train.1", false);
+  bool counted = false;
+  {
+    CompileProfileScope scope("parse", "action", [&counted]() -> int64_t {
+      counted = true;
+      return 1;
+    });
+  }
+  ASSERT_FALSE(counted);
+  ASSERT_TRUE(profiler.events().empty());
+}
+
+TEST_F(TestCompileProfiler, test_nested_events) {
+  auto &profiler = CompileProfiler::GetInstance();
+  profiler.Begin("train.1", true);
+  int64_t nodes = 10;
+  {
+    CompileProfileScope action("opt_a", "action", [&nodes]() { return nodes; });
+    {
+      CompileProfileScope optimizer("opt_a", "optimizer", [&nodes]() { return nodes; });
+      CompileProfileScope pass("inline", "pass", [&nodes]() { return nodes; });
+      nodes = 6;
+    }
+    CompileProfileScope pass("cse", "pass");
+  }
+  const auto &events = profiler.events();
+  ASSERT_EQ(events.size(), 4);
+  ASSERT_EQ(events[0].depth, 0);
+  ASSERT_EQ(events[1].depth, 1);
+  ASSERT_EQ(events[2].depth, 2);
+  ASSERT_EQ(events[3].depth, 1);
+  ASSERT_EQ(events[2].nodes_before, 10);
+  ASSERT_EQ(events[2].nodes_after, 6);
+  ASSERT_EQ(events[3].nodes_before, -1);
+  ASSERT_GE(events[0].duration, events[1].duration);
+  ASSERT_GT(events[0].rss_kb, 0);
+
+  // a new profile drops the events of the last one
+  profiler.Begin("train.2", true);
+  ASSERT_TRUE(profiler.events().empty());
+}
+
+TEST_F(TestCompileProfiler, test_memory_growth) {
+  auto &profiler = CompileProfiler::GetInstance();
+  profiler.Begin("train.1", true);
+  const size_t buffer_size = 64 << 20;
+  std::vector<char> buffer;
+  { CompileProfileScope scope("opt_a", "action"); }
+  {
+    CompileProfileScope scope("grow", "pass");
+    buffer.assign(buffer_size, 1);
+  }
+  const auto &events = profiler.events();
+  ASSERT_EQ(events.size(), 2);
+  // The growth is measured per event, it does not include the memory held before the event begins.
+  ASSERT_LT(events[0].rss_delta_kb, static_cast<int64_t>(buffer_size >> 11));
+  ASSERT_GE(events[1].rss_delta_kb, static_cast<int64_t>(buffer_size >> 11));
+}
+
+TEST_F(TestCompileProfiler, test_export) {
+  auto &profiler = CompileProfiler::GetInstance();
+  profiler.Begin("train.\"1\"", true);
+  { CompileProfileScope scope("symbol_resolve", "action"); }
+  profiler.AddStat("opt_a.inline", 0.5, 4, 1);
+  profiler.AddStat("opt_a.inline", 0.25, 2, 1);
+  ASSERT_EQ(profiler.stats().at("opt_a.inline").tries, 6);
+  ASSERT_EQ(profiler.stats().at("opt_a.inline").hits, 2);
+
+  auto trace = profiler.ChromeTrace();
+  ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  ASSERT_NE(trace.find("\"name\": \"symbol_resolve\", \"cat\": \"action\", \"ph\": \"X\""), std::string::npos);
+  ASSERT_NE(trace.find("train.\\\"1\\\""), std::string::npos);
+
+  auto summary = profiler.Summary();
+  ASSERT_NE(summary.find("\"substitutions\": [{\"name\": \"opt_a.inline\", \"time\": 0.750000, \"tries\": 6"),
+            std::string::npos);
+}
+}  // namespace mindspore
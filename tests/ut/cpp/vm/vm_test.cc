@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include "vm/vm.h"
 #include "common/common_test.h"
 #include "frontend/operator/ops.h"
@@ -56,5 +57,108 @@ TEST_F(TestCompileVM, FinalVM) {
   vm = nullptr;
 }
 
+namespace {
+BaseRef MakeExternal(const std::function<int(const VectorRef &)> &fn) {
+  auto run = std::make_shared<RunFunc>([fn](const VectorRef &args) { return VectorRef({fn(args)}); });
+  return BaseRef(run);
+}
+
+// f(n) = n == 0 ? 0 : f(n - 1) + 1, the branches are called and return to f.
+InstSet RecursionInsts(int depth) {
+  const int f = 5;
+  const int base_branch = 11;
+  const int rec_branch = 13;
+  auto is_zero = MakeExternal([](const VectorRef &args) { return static_cast<int>(utils::cast<int>(args[0]) == 0); });
+  auto dec = MakeExternal([](const VectorRef &args) { return utils::cast<int>(args[0]) - 1; });
+  auto inc = MakeExternal([](const VectorRef &args) { return utils::cast<int>(args[0]) + 1; });
+  const int frame_size = 10;
+  return {{Instruction::kPadStack, VectorRef({(depth + 1) * frame_size})},
+          {Instruction::kPush, VectorRef({f})},
+          {Instruction::kInput, VectorRef({-2})},
+          {Instruction::kCall, VectorRef({-2})},
+          {Instruction::kReturn, VectorRef({-1, 3})},
+          // f
+          {Instruction::kExternal, VectorRef({is_zero, 0, -1})},
+          {Instruction::kPush, VectorRef({base_branch})},
+          {Instruction::kPush, VectorRef({rec_branch})},
+          {Instruction::kSwitch, VectorRef({-3, -2, -1})},
+          {Instruction::kCall, VectorRef({-1})},
+          {Instruction::kReturn, VectorRef({-1, 6})},
+          // base branch
+          {Instruction::kPush, VectorRef({0})},
+          {Instruction::kReturn, VectorRef({-1, 1})},
+          // recursive branch
+          {Instruction::kExternal, VectorRef({dec, 0, -5})},
+          {Instruction::kPush, VectorRef({f})},
+          {Instruction::kInput, VectorRef({-2})},
+          {Instruction::kCall, VectorRef({-2})},
+          {Instruction::kExternal, VectorRef({inc, 0, -1})},
+          {Instruction::kReturn, VectorRef({-1, 4})}};
+}
+
+// g(acc, i) = i == 0 ? acc : g(acc + i, i - 1), the branches and the recursion are tail calls.
+InstSet LoopInsts() {
+  const int g = 7;
+  const int base_branch = 14;
+  const int rec_branch = 15;
+  auto is_zero = MakeExternal([](const VectorRef &args) { return static_cast<int>(utils::cast<int>(args[0]) == 0); });
+  auto add = MakeExternal([](const VectorRef &args) { return utils::cast<int>(args[0]) + utils::cast<int>(args[1]); });
+  auto dec = MakeExternal([](const VectorRef &args) { return utils::cast<int>(args[0]) - 1; });
+  const int stack_size = 16;
+  return {{Instruction::kPadStack, VectorRef({stack_size})},
+          {Instruction::kPush, VectorRef({0})},
+          {Instruction::kPush, VectorRef({g})},
+          {Instruction::kInput, VectorRef({-2})},
+          {Instruction::kInput, VectorRef({-4})},
+          {Instruction::kCall, VectorRef({-3})},
+          {Instruction::kReturn, VectorRef({-1, 4})},
+          // g
+          {Instruction::kExternal, VectorRef({is_zero, 0, -1})},
+          {Instruction::kPush, VectorRef({base_branch})},
+          {Instruction::kPush, VectorRef({rec_branch})},
+          {Instruction::kSwitch, VectorRef({-3, -2, -1})},
+          {Instruction::kInput, VectorRef({-6})},
+          {Instruction::kInput, VectorRef({-6})},
+          {Instruction::kTailCall, VectorRef({-3, 8, 2})},
+          // base branch
+          {Instruction::kReturn, VectorRef({-2, 2})},
+          // recursive branch
+          {Instruction::kPush, VectorRef({g})},
+          {Instruction::kExternal, VectorRef({add, 0, -3, -2})},
+          {Instruction::kExternal, VectorRef({dec, 0, -3})},
+          {Instruction::kTailCall, VectorRef({-3, 5, 2})}};
+}
+}  // namespace
+
+TEST_F(TestCompileVM, FinalVMRecursion) {
+  const int depth = 2000;
+  const size_t loop = 10;
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  FinalVM vm(RecursionInsts(depth), backend);
+  BaseRef out;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < loop; ++i) {
+    out = vm.Eval(VectorRef({depth}));
+  }
+  auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / loop;
+  MS_LOG(INFO) << "FinalVM recursion of depth " << depth << " costs " << cost << " us";
+  EXPECT_EQ(utils::cast<int>(out), depth);
+}
+
+TEST_F(TestCompileVM, FinalVMLoop) {
+  const int count = 10000;
+  const size_t loop = 10;
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  FinalVM vm(LoopInsts(), backend);
+  BaseRef out;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < loop; ++i) {
+    out = vm.Eval(VectorRef({count}));
+  }
+  auto cost = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / loop;
+  MS_LOG(INFO) << "FinalVM loop of " << count << " iterations costs " << cost << " us";
+  EXPECT_EQ(utils::cast<int>(out), count * (count + 1) / 2);
+}
+
 }  // namespace compile
 }  // namespace mindspore
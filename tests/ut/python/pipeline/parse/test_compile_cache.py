@@ -0,0 +1,85 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+@File  : test_compile_cache.py
+@Desc  : test the compile cache enabled by MS_COMPILE_CACHE_PATH
+"""
+import os
+import shutil
+import tempfile
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.common.api import _executor
+from mindspore.ops import operations as P
+
+
+class AddNet(nn.Cell):
+    """ AddNet definition """
+
+    def __init__(self, value):
+        super(AddNet, self).__init__()
+        self.add = P.TensorAdd()
+        self.mul = P.Mul()
+        self.bias = Tensor(np.full([2, 3], value).astype(np.float32))
+        self.weight = Parameter(Tensor(np.ones([2, 3]).astype(np.float32)), name="weight")
+
+    def construct(self, x):
+        return self.add(self.mul(x, self.weight), self.bias)
+
+
+def cache_files(cache_path):
+    return sorted(os.path.join(cache_path, f) for f in os.listdir(cache_path) if f.endswith(".mindir"))
+
+
+def read_file(file_name):
+    with open(file_name, "rb") as f:
+        return f.read()
+
+
+def test_compile_cache_save_load_mismatch():
+    """ test_compile_cache_save_load_mismatch """
+    cache_path = tempfile.mkdtemp()
+    os.environ["MS_COMPILE_CACHE_PATH"] = cache_path
+    try:
+        x = Tensor(np.ones([2, 3]).astype(np.float32))
+        _executor.compile(AddNet(1.0), x)
+        files = cache_files(cache_path)
+        assert len(files) == 1
+        add_one_file = files[0]
+
+        # A hit reads the entry and does not write it again.
+        os.utime(add_one_file, (0, 0))
+        _executor.compile(AddNet(1.0), x)
+        assert os.stat(add_one_file).st_mtime == 0
+        assert cache_files(cache_path) == [add_one_file]
+
+        # The constant tensor data is part of the key.
+        _executor.compile(AddNet(2.0), x)
+        files = cache_files(cache_path)
+        assert len(files) == 2
+        add_two_file = files[0] if files[1] == add_one_file else files[1]
+
+        # An entry saved for another graph under the same file name is not loaded, the graph is compiled and the
+        # entry is saved again.
+        shutil.copyfile(add_two_file, add_one_file)
+        os.utime(add_one_file, (0, 0))
+        _executor.compile(AddNet(1.0), x)
+        assert os.stat(add_one_file).st_mtime != 0
+        assert read_file(add_one_file) != read_file(add_two_file)
+    finally:
+        del os.environ["MS_COMPILE_CACHE_PATH"]
+        shutil.rmtree(cache_path)
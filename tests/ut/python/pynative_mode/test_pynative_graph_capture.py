@@ -0,0 +1,104 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test replaying the captured grad graph of a cell in pynative mode """
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import composite as C
+from mindspore.ops import operations as P
+from ..ut_filter import non_graph_engine
+
+
+def setup_module(module):
+    context.set_context(mode=context.PYNATIVE_MODE)
+
+
+class SquareNet(nn.Cell):
+    """ SquareNet definition """
+
+    def __init__(self):
+        super(SquareNet, self).__init__()
+        self.mul = P.Mul()
+
+    def construct(self, x):
+        return self.mul(x, x)
+
+
+class BranchNet(nn.Cell):
+    """ BranchNet definition """
+
+    def __init__(self):
+        super(BranchNet, self).__init__()
+        self.mul = P.Mul()
+        self.add = P.TensorAdd()
+        self.use_mul = True
+        self.calls = 0
+
+    def construct(self, x):
+        self.calls += 1
+        if self.use_mul:
+            return self.mul(x, x)
+        return self.add(x, x)
+
+
+@non_graph_engine
+def test_replay_with_same_inputs():
+    """ test_replay_with_same_inputs """
+    net = SquareNet()
+    grad_fn = C.grad_all(net)
+    for _ in range(3):
+        x = np.random.randn(2, 3).astype(np.float32)
+        grads = grad_fn(Tensor(x))
+        assert np.allclose(grads[0].asnumpy(), 2 * x)
+
+
+@non_graph_engine
+def test_capture_again_when_shape_changes():
+    """ test_capture_again_when_shape_changes """
+    net = SquareNet()
+    grad_fn = C.grad_all(net)
+    for shape in [(2, 3), (4, 3), (2, 3)]:
+        x = np.random.randn(*shape).astype(np.float32)
+        grads = grad_fn(Tensor(x))
+        assert grads[0].asnumpy().shape == shape
+        assert np.allclose(grads[0].asnumpy(), 2 * x)
+
+
+@non_graph_engine
+def test_capture_again_when_branch_changes():
+    """ test_capture_again_when_branch_changes """
+    net = BranchNet()
+    grad_fn = C.grad_all(net)
+    x = np.ones([2, 3]).astype(np.float32) * 3
+    for use_mul, expect in [(True, 2 * x), (False, np.ones([2, 3]) * 2), (True, 2 * x)]:
+        net.use_mul = use_mul
+        grads = grad_fn(Tensor(x))
+        assert np.allclose(grads[0].asnumpy(), expect)
+
+
+@non_graph_engine
+def test_run_once_when_branch_changes():
+    """ test_run_once_when_branch_changes """
+    net = BranchNet()
+    grad_fn = C.grad_all(net)
+    x = np.ones([2, 3]).astype(np.float32) * 3
+    grad_fn(Tensor(x))
+    # The step taking another branch compiles the graph recorded while it ran, the cell is not run again.
+    net.use_mul = False
+    grads = grad_fn(Tensor(x))
+    assert net.calls == 2
+    assert np.allclose(grads[0].asnumpy(), np.ones([2, 3]) * 2)